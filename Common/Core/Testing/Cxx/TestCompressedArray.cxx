@@ -0,0 +1,190 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Checks that vtkCompressedArray gives back the values it was built from, from one or several
+// threads and through vtkArrayDispatch.
+
+#include "vtkCompressedArray.h"
+
+#include "vtkArrayDispatch.h"
+#include "vtkDataArrayRange.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkIntArray.h"
+#include "vtkSMPTools.h"
+
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+
+namespace
+{
+template <typename ValueType>
+bool CheckValues(vtkDataArray* expected, vtkCompressedArray<ValueType>* compressed)
+{
+  if (compressed->GetNumberOfValues() != expected->GetNumberOfValues())
+  {
+    std::cerr << "Wrong number of values" << std::endl;
+    return false;
+  }
+  const auto values = vtk::DataArrayValueRange(expected);
+  for (vtkIdType i = 0; i < expected->GetNumberOfValues(); ++i)
+  {
+    // compare the bits so that NaNs and signed zeros are checked too
+    const ValueType value = compressed->GetValue(i);
+    const ValueType expectedValue = static_cast<ValueType>(values[i]);
+    if (std::memcmp(&value, &expectedValue, sizeof(ValueType)) != 0)
+    {
+      std::cerr << "Wrong value " << value << " at index " << i << ", expected " << expectedValue
+                << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename ValueType>
+vtkSmartPointer<vtkCompressedArray<ValueType>> Compress(
+  vtkDataArray* array, vtkIdType blockSize = 4096, int numberOfCachedBlocks = 16)
+{
+  auto compressed = vtkSmartPointer<vtkCompressedArray<ValueType>>::New();
+  compressed->SetBackend(std::make_shared<vtkCompressedImplicitBackend<ValueType>>(
+    array, blockSize, numberOfCachedBlocks));
+  compressed->SetNumberOfComponents(array->GetNumberOfComponents());
+  compressed->SetNumberOfTuples(array->GetNumberOfTuples());
+  return compressed;
+}
+
+struct SumWorker
+{
+  template <typename ArrayT>
+  void operator()(ArrayT* array, double& sum)
+  {
+    sum = 0.0;
+    for (const auto value : vtk::DataArrayValueRange<3>(array))
+    {
+      sum += value;
+    }
+  }
+};
+
+bool Sum(vtkDataArray* array, double& sum)
+{
+  using Dispatcher = vtkArrayDispatch::DispatchByArray<vtkTypeList::Create<vtkDoubleArray,
+    vtkCompressedArray<double>>>;
+  SumWorker worker;
+  if (!Dispatcher::Execute(array, worker, sum))
+  {
+    std::cerr << "Dispatch failed for " << array->GetClassName() << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestCompressedArray(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  int res = EXIT_SUCCESS;
+
+  // a smooth vector field, which is the typical use case
+  const vtkIdType numberOfTuples = 300000;
+  vtkNew<vtkDoubleArray> field;
+  field->SetNumberOfComponents(3);
+  field->SetNumberOfTuples(numberOfTuples);
+  for (vtkIdType i = 0; i < numberOfTuples; ++i)
+  {
+    const double t = 1e-4 * static_cast<double>(i);
+    field->SetTuple3(i, std::sin(t), std::cos(t), 2.0);
+  }
+  auto compressedField = Compress<double>(field);
+  if (!CheckValues(field, compressedField.Get()))
+  {
+    std::cerr << "vtkCompressedArray<double> does not match its input" << std::endl;
+    res = EXIT_FAILURE;
+  }
+  if (compressedField->GetActualMemorySize() >= field->GetActualMemorySize())
+  {
+    std::cerr << "vtkCompressedArray<double> uses " << compressedField->GetActualMemorySize()
+              << " KiB, more than the " << field->GetActualMemorySize() << " KiB of its input"
+              << std::endl;
+    res = EXIT_FAILURE;
+  }
+
+  // random access with small blocks and a single cached block per shard
+  vtkNew<vtkIntArray> ids;
+  ids->SetNumberOfValues(1000);
+  for (vtkIdType i = 0; i < 1000; ++i)
+  {
+    ids->SetValue(i, static_cast<int>((i * 7919) % 1000) - 500);
+  }
+  auto compressedIds = Compress<int>(ids, 7, 1);
+  for (vtkIdType i = 0; i < 1000; ++i)
+  {
+    const vtkIdType idx = (i * 389) % 1000;
+    if (compressedIds->GetValue(idx) != ids->GetValue(idx))
+    {
+      std::cerr << "Wrong value at index " << idx << " with random access" << std::endl;
+      res = EXIT_FAILURE;
+      break;
+    }
+  }
+
+  // blocks which are not a multiple of the number of components are extended to whole tuples
+  if (!CheckValues(field, Compress<double>(field, 7, 1).Get()))
+  {
+    std::cerr << "vtkCompressedArray<double> does not match its input with blocks of 7 values"
+              << std::endl;
+    res = EXIT_FAILURE;
+  }
+
+  // special floating point values and conversion from another value type
+  vtkNew<vtkFloatArray> special;
+  special->SetNumberOfValues(6);
+  special->SetValue(0, -0.0f);
+  special->SetValue(1, std::numeric_limits<float>::quiet_NaN());
+  special->SetValue(2, std::numeric_limits<float>::infinity());
+  special->SetValue(3, -std::numeric_limits<float>::infinity());
+  special->SetValue(4, std::numeric_limits<float>::denorm_min());
+  special->SetValue(5, std::numeric_limits<float>::max());
+  if (!CheckValues(special, Compress<float>(special).Get()) ||
+    !CheckValues(ids, Compress<double>(ids).Get()))
+  {
+    std::cerr << "vtkCompressedArray does not match its input" << std::endl;
+    res = EXIT_FAILURE;
+  }
+
+  // concurrent reads, each thread reading its own range of blocks
+  std::atomic<vtkIdType> errors(0);
+  vtkSMPTools::For(0, numberOfTuples,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        for (int comp = 0; comp < 3; ++comp)
+        {
+          if (compressedField->GetTypedComponent(i, comp) != field->GetTypedComponent(i, comp))
+          {
+            ++errors;
+          }
+        }
+      }
+    });
+  if (errors != 0)
+  {
+    std::cerr << errors << " wrong values read from several threads" << std::endl;
+    res = EXIT_FAILURE;
+  }
+
+  // the compressed array feeds vtkArrayDispatch based code like any other array
+  double sum = 0.0, compressedSum = 0.0;
+  if (!Sum(field, sum) || !Sum(compressedField, compressedSum) || sum != compressedSum)
+  {
+    std::cerr << "Sum of the compressed values is " << compressedSum << " instead of " << sum
+              << std::endl;
+    res = EXIT_FAILURE;
+  }
+
+  return res;
+}
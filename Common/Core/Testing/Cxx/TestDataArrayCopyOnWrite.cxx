@@ -0,0 +1,162 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Checks that the modifications of a vtkAOSDataArrayTemplate shallow copied with CopyOnWrite on
+// leave the arrays sharing its buffer untouched.
+
+#include "vtkAOSDataArrayTemplate.h"
+#include "vtkFloatArray.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkSmartPointer.h"
+
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <string>
+
+namespace
+{
+const vtkIdType NumberOfTuples = 1000;
+
+vtkSmartPointer<vtkFloatArray> MakeSource()
+{
+  auto source = vtkSmartPointer<vtkFloatArray>::New();
+  source->SetNumberOfComponents(3);
+  source->SetNumberOfTuples(NumberOfTuples);
+  for (vtkIdType i = 0; i < source->GetNumberOfValues(); ++i)
+  {
+    source->SetValue(i, static_cast<float>(i));
+  }
+  return source;
+}
+
+bool IsUnchanged(vtkFloatArray* source)
+{
+  if (source->GetNumberOfTuples() != NumberOfTuples)
+  {
+    return false;
+  }
+  for (vtkIdType i = 0; i < source->GetNumberOfValues(); ++i)
+  {
+    if (source->GetValue(i) != static_cast<float>(i))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool TestModification(const std::string& name, const std::function<void(vtkFloatArray*)>& modify)
+{
+  auto source = MakeSource();
+  vtkNew<vtkFloatArray> copy;
+  copy->CopyOnWriteOn();
+  copy->ShallowCopy(source);
+  if (!copy->HasSharedBuffer() || copy->GetPointer(0) != source->GetPointer(0))
+  {
+    std::cerr << name << ": ShallowCopy does not share the buffer" << std::endl;
+    return false;
+  }
+  modify(copy);
+  if (!IsUnchanged(source))
+  {
+    std::cerr << name << ": the source array was modified" << std::endl;
+    return false;
+  }
+  if (copy->HasSharedBuffer() || source->HasSharedBuffer())
+  {
+    std::cerr << name << ": the buffer is still shared" << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestDataArrayCopyOnWrite(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  int res = EXIT_SUCCESS;
+
+  // without CopyOnWrite, shallow copies share their modifications
+  auto source = MakeSource();
+  vtkNew<vtkFloatArray> copy;
+  copy->ShallowCopy(source);
+  copy->SetValue(0, -1.0f);
+  if (source->GetValue(0) != -1.0f)
+  {
+    std::cerr << "Without CopyOnWrite, the buffer should stay shared" << std::endl;
+    res = EXIT_FAILURE;
+  }
+
+  const std::pair<std::string, std::function<void(vtkFloatArray*)>> modifications[] = {
+    { "SetValue", [](vtkFloatArray* a) { a->SetValue(5, -1.0f); } },
+    { "SetTypedComponent", [](vtkFloatArray* a) { a->SetTypedComponent(5, 2, -1.0f); } },
+    { "SetTuple", [](vtkFloatArray* a) { a->SetTuple3(5, 1.0, 2.0, 3.0); } },
+    { "SetComponent", [](vtkFloatArray* a) { a->SetComponent(5, 1, -1.0); } },
+    { "InsertNextValue", [](vtkFloatArray* a) { a->InsertNextValue(-1.0f); } },
+    { "InsertComponent", [](vtkFloatArray* a) { a->InsertComponent(4, 1, -1.0); } },
+    { "FillValue", [](vtkFloatArray* a) { a->FillValue(-1.0f); } },
+    { "FillComponent", [](vtkFloatArray* a) { a->FillComponent(1, -1.0); } },
+    { "WritePointer", [](vtkFloatArray* a) { a->WritePointer(0, 3)[1] = -1.0f; } },
+    { "Resize", [](vtkFloatArray* a) { a->Resize(3 * NumberOfTuples); } },
+    { "SetNumberOfTuples", [](vtkFloatArray* a) { a->SetNumberOfTuples(2 * NumberOfTuples); } },
+    { "Initialize", [](vtkFloatArray* a) { a->Initialize(); } },
+    { "SetArray",
+      [](vtkFloatArray* a)
+      { a->SetArray(new float[3], 3, 0, vtkAbstractArray::VTK_DATA_ARRAY_DELETE); } },
+    { "DeepCopy",
+      [](vtkFloatArray* a)
+      {
+        vtkNew<vtkIntArray> ints;
+        ints->SetNumberOfComponents(3);
+        ints->SetNumberOfTuples(NumberOfTuples);
+        ints->Fill(-1);
+        a->DeepCopy(ints);
+      } },
+  };
+  for (const auto& modification : modifications)
+  {
+    if (!TestModification(modification.first, modification.second))
+    {
+      res = EXIT_FAILURE;
+    }
+  }
+
+  // the copy keeps its values and its modification
+  source = MakeSource();
+  vtkNew<vtkFloatArray> cow;
+  cow->CopyOnWriteOn();
+  cow->ShallowCopy(source);
+  cow->Resize(2 * NumberOfTuples);
+  cow->InsertNextTuple3(-1.0, -2.0, -3.0);
+  for (vtkIdType i = 0; i < source->GetNumberOfValues(); ++i)
+  {
+    if (cow->GetValue(i) != static_cast<float>(i))
+    {
+      std::cerr << "The copy lost its value at index " << i << std::endl;
+      res = EXIT_FAILURE;
+      break;
+    }
+  }
+  if (cow->GetNumberOfTuples() != NumberOfTuples + 1 ||
+    cow->GetTypedComponent(NumberOfTuples, 2) != -3.0f)
+  {
+    std::cerr << "The copy lost its modification" << std::endl;
+    res = EXIT_FAILURE;
+  }
+
+  // CopyOnWrite is inherited by the shallow copies, which protects the first array too
+  source = MakeSource();
+  source->CopyOnWriteOn();
+  vtkNew<vtkFloatArray> inherited;
+  inherited->ShallowCopy(source);
+  inherited->SetValue(0, -1.0f);
+  source->SetValue(1, -1.0f);
+  if (!inherited->GetCopyOnWrite() || source->GetValue(0) != 0.0f ||
+    inherited->GetValue(1) != 1.0f)
+  {
+    std::cerr << "CopyOnWrite is not inherited by ShallowCopy" << std::endl;
+    res = EXIT_FAILURE;
+  }
+
+  return res;
+}
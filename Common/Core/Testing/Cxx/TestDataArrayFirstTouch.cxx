@@ -0,0 +1,94 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Checks the parallel first touch policy of vtkAOSDataArrayTemplate and vtkSOADataArrayTemplate.
+// Its timings are in Utilities/Benchmarks.
+
+#include "vtkAOSDataArrayTemplate.h"
+#include "vtkDataArray.h"
+#include "vtkNew.h"
+#include "vtkSOADataArrayTemplate.h"
+
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+template <typename ArrayT>
+bool CheckZeros(ArrayT* array, vtkIdType begin)
+{
+  for (vtkIdType tupleId = begin; tupleId < array->GetNumberOfTuples(); ++tupleId)
+  {
+    for (int comp = 0; comp < array->GetNumberOfComponents(); ++comp)
+    {
+      if (array->GetTypedComponent(tupleId, comp) != 0)
+      {
+        std::cerr << array->GetClassName() << ": value of tuple " << tupleId << " and component "
+                  << comp << " is not zero" << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+template <typename ArrayT>
+bool TestArray()
+{
+  vtkNew<ArrayT> array;
+  array->SetNumberOfComponents(3);
+  array->SetNumberOfTuples(10000);
+  if (!CheckZeros(array.Get(), 0))
+  {
+    return false;
+  }
+  for (vtkIdType tupleId = 0; tupleId < 10000; ++tupleId)
+  {
+    array->SetTuple3(tupleId, tupleId, 2 * tupleId, 3 * tupleId);
+  }
+  array->Resize(25000);
+  array->SetNumberOfTuples(25000);
+  for (vtkIdType tupleId = 0; tupleId < 10000; ++tupleId)
+  {
+    for (int comp = 0; comp < 3; ++comp)
+    {
+      if (array->GetTypedComponent(tupleId, comp) != (comp + 1) * tupleId)
+      {
+        std::cerr << array->GetClassName() << ": value of tuple " << tupleId
+                  << " and component " << comp << " was lost by Resize" << std::endl;
+        return false;
+      }
+    }
+  }
+  return CheckZeros(array.Get(), 10000);
+}
+}
+
+int TestDataArrayFirstTouch(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  int res = EXIT_SUCCESS;
+  const bool firstTouch = vtkDataArray::GetParallelFirstTouch();
+  const vtkIdType threshold = vtkDataArray::GetFirstTouchThreshold();
+
+  vtkDataArray::SetParallelFirstTouch(true);
+  vtkDataArray::SetFirstTouchThreshold(1024);
+  if (!TestArray<vtkAOSDataArrayTemplate<double>>() ||
+    !TestArray<vtkAOSDataArrayTemplate<int>>() || !TestArray<vtkSOADataArrayTemplate<float>>())
+  {
+    res = EXIT_FAILURE;
+  }
+  // GetVoidPointer switches vtkSOADataArrayTemplate to an AOS storage
+  vtkNew<vtkSOADataArrayTemplate<double>> aosStorage;
+  aosStorage->SetNumberOfComponents(2);
+  aosStorage->SetNumberOfTuples(10);
+  aosStorage->GetVoidPointer(0);
+  aosStorage->Resize(5000);
+  aosStorage->SetNumberOfTuples(5000);
+  if (!CheckZeros(aosStorage.Get(), 10))
+  {
+    res = EXIT_FAILURE;
+  }
+
+  vtkDataArray::SetParallelFirstTouch(firstTouch);
+  vtkDataArray::SetFirstTouchThreshold(threshold);
+  return res;
+}
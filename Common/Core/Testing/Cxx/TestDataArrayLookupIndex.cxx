@@ -0,0 +1,179 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Checks the value lookups of vtkGenericDataArray against a brute force search: with several
+// threads, after appending values without calling DataChanged, with NaN values, and with the
+// batched LookupValues.
+
+#include "vtkDoubleArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkSMPTools.h"
+#include "vtkStringArray.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace
+{
+template <typename ArrayT>
+std::vector<vtkIdType> FindAll(ArrayT* array, typename ArrayT::ValueType value)
+{
+  std::vector<vtkIdType> ids;
+  for (vtkIdType i = 0; i < array->GetNumberOfValues(); ++i)
+  {
+    const auto arrayValue = array->GetValue(i);
+    if (arrayValue == value || (std::isnan(static_cast<double>(value)) &&
+                                 std::isnan(static_cast<double>(arrayValue))))
+    {
+      ids.push_back(i);
+    }
+  }
+  return ids;
+}
+
+template <typename ArrayT>
+bool CheckLookup(ArrayT* array, typename ArrayT::ValueType value)
+{
+  const std::vector<vtkIdType> expected = FindAll(array, value);
+  vtkNew<vtkIdList> ids;
+  array->LookupTypedValue(value, ids);
+  if (std::vector<vtkIdType>(ids->begin(), ids->end()) != expected)
+  {
+    std::cerr << "Found " << ids->GetNumberOfIds() << " indices of " << value << " instead of "
+              << expected.size() << std::endl;
+    return false;
+  }
+  const vtkIdType first = expected.empty() ? -1 : expected.front();
+  if (array->LookupTypedValue(value) != first)
+  {
+    std::cerr << "Found " << value << " at " << array->LookupTypedValue(value) << " instead of "
+              << first << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestDataArrayLookupIndex(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  int res = EXIT_SUCCESS;
+
+  // global ids with repeated values
+  const vtkIdType numberOfValues = 100000;
+  vtkNew<vtkIdTypeArray> globalIds;
+  globalIds->SetNumberOfValues(numberOfValues);
+  for (vtkIdType i = 0; i < numberOfValues; ++i)
+  {
+    globalIds->SetValue(i, (i * 7919) % (numberOfValues / 2));
+  }
+  vtkSMPTools::LocalScope(vtkSMPTools::Config{ 4 },
+    [&]()
+    {
+      for (vtkIdType value : { 0, 1, 12345, 49999, 50000, -1 })
+      {
+        if (!CheckLookup<vtkIdTypeArray>(globalIds, value))
+        {
+          res = EXIT_FAILURE;
+        }
+      }
+    });
+
+  // appended values are found without calling DataChanged
+  for (vtkIdType i = 0; i < 1000; ++i)
+  {
+    globalIds->InsertNextValue(numberOfValues - i);
+  }
+  for (vtkIdType value : { 0, 12345, 50000, 99500, 100000, 100001 })
+  {
+    if (!CheckLookup<vtkIdTypeArray>(globalIds, value))
+    {
+      std::cerr << "Wrong lookup after appending values" << std::endl;
+      res = EXIT_FAILURE;
+    }
+  }
+
+  // shrinking the array rebuilds the index
+  globalIds->SetNumberOfValues(numberOfValues / 2);
+  if (!CheckLookup<vtkIdTypeArray>(globalIds, 100000) ||
+    !CheckLookup<vtkIdTypeArray>(globalIds, 12345))
+  {
+    std::cerr << "Wrong lookup after shrinking the array" << std::endl;
+    res = EXIT_FAILURE;
+  }
+
+  // NaN values, also appended after the index is built
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  vtkNew<vtkDoubleArray> scalars;
+  for (vtkIdType i = 0; i < 1000; ++i)
+  {
+    scalars->InsertNextValue(i % 10 == 3 ? nan : static_cast<double>(i % 100));
+  }
+  if (!CheckLookup<vtkDoubleArray>(scalars, nan) || !CheckLookup<vtkDoubleArray>(scalars, 42.0))
+  {
+    res = EXIT_FAILURE;
+  }
+  scalars->InsertNextValue(nan);
+  scalars->InsertNextValue(42.0);
+  scalars->InsertNextValue(-1.0);
+  if (!CheckLookup<vtkDoubleArray>(scalars, nan) || !CheckLookup<vtkDoubleArray>(scalars, 42.0) ||
+    !CheckLookup<vtkDoubleArray>(scalars, -1.0))
+  {
+    std::cerr << "Wrong lookup after appending NaN values" << std::endl;
+    res = EXIT_FAILURE;
+  }
+
+  // batched lookups, with values of the same type and of other types
+  vtkNew<vtkIntArray> intValues;
+  vtkNew<vtkStringArray> stringValues;
+  vtkNew<vtkDoubleArray> doubleValues;
+  for (int value : { 42, 3, 1000, 0, 42 })
+  {
+    intValues->InsertNextValue(value);
+    stringValues->InsertNextValue(std::to_string(value));
+    doubleValues->InsertNextValue(value);
+  }
+  doubleValues->InsertNextValue(nan);
+  stringValues->InsertNextValue("not a number");
+  vtkNew<vtkIdList> ids;
+  vtkSMPTools::LocalScope(vtkSMPTools::Config{ 4 },
+    [&]()
+    {
+      for (vtkAbstractArray* values :
+        { static_cast<vtkAbstractArray*>(intValues), static_cast<vtkAbstractArray*>(stringValues),
+          static_cast<vtkAbstractArray*>(doubleValues) })
+      {
+        scalars->LookupValues(values, ids);
+        if (ids->GetNumberOfIds() != values->GetNumberOfValues())
+        {
+          std::cerr << "Got " << ids->GetNumberOfIds() << " ids for the batched lookup of "
+                    << values->GetNumberOfValues() << " " << values->GetClassName() << " values"
+                    << std::endl;
+          res = EXIT_FAILURE;
+          continue;
+        }
+        for (vtkIdType i = 0; i < values->GetNumberOfValues(); ++i)
+        {
+          const vtkIdType expected = scalars->LookupValue(values->GetVariantValue(i));
+          if (ids->GetId(i) != expected)
+          {
+            std::cerr << "Batched lookup of value " << i << " of a " << values->GetClassName()
+                      << " gave " << ids->GetId(i) << " instead of " << expected << std::endl;
+            res = EXIT_FAILURE;
+          }
+        }
+      }
+    });
+  if (ids->GetId(0) != 42 || ids->GetId(3) != 0 || ids->GetId(5) != 3)
+  {
+    std::cerr << "Wrong batched lookup of double values" << std::endl;
+    res = EXIT_FAILURE;
+  }
+
+  return res;
+}
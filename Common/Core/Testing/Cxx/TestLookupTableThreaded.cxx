@@ -4,6 +4,10 @@
 #include "vtkLookupTable.h"
 #include "vtkMultiThreader.h"
 #include "vtkNew.h"
+#include "vtkVariant.h"
+
+#include <cmath>
+#include <vector>
 
 namespace
 {
@@ -32,6 +36,37 @@ VTK_THREAD_RETURN_TYPE ThreadedMethod(void*)
   return VTK_THREAD_RETURN_VALUE;
 }
 
+// Maps a large array in one call, which is done in parallel chunks, and
+// compares the result with the mapping of every value on its own.
+bool TestParallelMapping(vtkLookupTable* table, int outputFormat)
+{
+  const int numberOfValues = 100000;
+  std::vector<double> input(2 * numberOfValues);
+  for (int i = 0; i < numberOfValues; ++i)
+  {
+    input[2 * i] = (i % 7 == 0) ? std::nan("") : (i % 1500) - 100.0;
+  }
+  std::vector<unsigned char> output(outputFormat * numberOfValues);
+  table->MapScalarsThroughTable2(
+    input.data(), output.data(), VTK_DOUBLE, numberOfValues, 2, outputFormat);
+
+  unsigned char expected[4];
+  for (int i = 0; i < numberOfValues; ++i)
+  {
+    table->MapScalarsThroughTable2(&input[2 * i], expected, VTK_DOUBLE, 1, 2, outputFormat);
+    for (int c = 0; c < outputFormat; ++c)
+    {
+      if (output[outputFormat * i + c] != expected[c])
+      {
+        std::cerr << "Mismatch for value " << i << " with output format " << outputFormat
+                  << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
 } // end anonymous namespace
 
 int TestLookupTableThreaded(int, char*[])
@@ -46,5 +81,30 @@ int TestLookupTableThreaded(int, char*[])
 
   lut->Delete();
 
-  return EXIT_SUCCESS;
+  vtkNew<vtkLookupTable> table;
+  table->SetNumberOfTableValues(256);
+  table->SetTableRange(1, 1000);
+  table->SetUseBelowRangeColor(true);
+  table->Build();
+  bool success = true;
+  for (int scale : { VTK_SCALE_LINEAR, VTK_SCALE_LOG10 })
+  {
+    table->SetScale(scale);
+    for (int outputFormat : { VTK_LUMINANCE, VTK_LUMINANCE_ALPHA, VTK_RGB, VTK_RGBA })
+    {
+      table->SetAlpha(1.0);
+      success &= TestParallelMapping(table, outputFormat);
+      table->SetAlpha(0.5);
+      success &= TestParallelMapping(table, outputFormat);
+    }
+  }
+  table->SetAlpha(1.0);
+  table->IndexedLookupOn();
+  for (int i = 0; i < 10; ++i)
+  {
+    table->SetAnnotation(vtkVariant(10.0 * i), "annotation");
+  }
+  success &= TestParallelMapping(table, VTK_RGBA);
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
 }
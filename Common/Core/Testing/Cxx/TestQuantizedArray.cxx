@@ -0,0 +1,159 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Checks that vtkQuantizedArray gives back the values it was built from up to half a
+// quantization step, and that it can be used through vtkArrayDispatch.
+
+#include "vtkQuantizedArray.h"
+
+#include "vtkArrayDispatch.h"
+#include "vtkDataArrayRange.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkIntArray.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+
+namespace
+{
+template <typename ValueType>
+vtkSmartPointer<vtkQuantizedArray<ValueType>> Quantize(vtkDataArray* array)
+{
+  auto quantized = vtkSmartPointer<vtkQuantizedArray<ValueType>>::New();
+  quantized->SetBackend(std::make_shared<vtkQuantizedImplicitBackend<ValueType>>(array));
+  quantized->SetNumberOfComponents(array->GetNumberOfComponents());
+  quantized->SetNumberOfTuples(array->GetNumberOfTuples());
+  return quantized;
+}
+
+template <typename ValueType>
+bool CheckValues(vtkDataArray* expected, vtkQuantizedArray<ValueType>* quantized)
+{
+  for (vtkIdType tupleId = 0; tupleId < expected->GetNumberOfTuples(); ++tupleId)
+  {
+    for (int comp = 0; comp < expected->GetNumberOfComponents(); ++comp)
+    {
+      // half a step, with some slack for the rounding of the values to ValueType
+      const double tolerance = 0.5 * quantized->GetBackend()->GetScale(comp) * (1.0 + 1e-6) +
+        1e-6 * std::abs(quantized->GetBackend()->GetShift(comp));
+      const double error = std::abs(
+        quantized->GetTypedComponent(tupleId, comp) - expected->GetComponent(tupleId, comp));
+      if (!(error <= tolerance))
+      {
+        std::cerr << "Wrong value " << quantized->GetTypedComponent(tupleId, comp) << " for tuple "
+                  << tupleId << " and component " << comp << ", expected "
+                  << expected->GetComponent(tupleId, comp) << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+struct MaxWorker
+{
+  template <typename ArrayT>
+  void operator()(ArrayT* array, double& max)
+  {
+    max = std::numeric_limits<double>::lowest();
+    for (const auto value : vtk::DataArrayValueRange(array))
+    {
+      max = std::max(max, static_cast<double>(value));
+    }
+  }
+};
+}
+
+int TestQuantizedArray(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  int res = EXIT_SUCCESS;
+
+  // unit normals and a constant component
+  const vtkIdType numberOfTuples = 100000;
+  vtkNew<vtkFloatArray> normals;
+  normals->SetNumberOfComponents(4);
+  normals->SetNumberOfTuples(numberOfTuples);
+  for (vtkIdType i = 0; i < numberOfTuples; ++i)
+  {
+    const double theta = 1e-3 * static_cast<double>(i);
+    const double phi = 0.37 * static_cast<double>(i);
+    normals->SetTuple4(i, std::sin(theta) * std::cos(phi), std::sin(theta) * std::sin(phi),
+      std::cos(theta), 3.0);
+  }
+  auto quantizedNormals = Quantize<float>(normals);
+  if (!CheckValues(normals, quantizedNormals.Get()))
+  {
+    std::cerr << "vtkQuantizedArray<float> does not match its input" << std::endl;
+    res = EXIT_FAILURE;
+  }
+  if (quantizedNormals->GetBackend()->GetScale(3) != 0.0 ||
+    quantizedNormals->GetTypedComponent(42, 3) != 3.0f)
+  {
+    std::cerr << "A constant component should be represented exactly" << std::endl;
+    res = EXIT_FAILURE;
+  }
+  if (2 * quantizedNormals->GetActualMemorySize() > normals->GetActualMemorySize() + 2)
+  {
+    std::cerr << "vtkQuantizedArray<float> uses " << quantizedNormals->GetActualMemorySize()
+              << " KiB for an input of " << normals->GetActualMemorySize() << " KiB" << std::endl;
+    res = EXIT_FAILURE;
+  }
+
+  // a large double range and integers
+  vtkNew<vtkDoubleArray> scalars;
+  vtkNew<vtkIntArray> ids;
+  scalars->SetNumberOfValues(numberOfTuples);
+  ids->SetNumberOfValues(numberOfTuples);
+  for (vtkIdType i = 0; i < numberOfTuples; ++i)
+  {
+    scalars->SetValue(i, 1e6 + 1e3 * std::sin(1e-2 * static_cast<double>(i)));
+    ids->SetValue(i, static_cast<int>(i % 1000) - 500);
+  }
+  auto quantizedIds = Quantize<int>(ids);
+  if (!CheckValues(scalars, Quantize<double>(scalars).Get()) ||
+    !CheckValues(ids, quantizedIds.Get()))
+  {
+    std::cerr << "vtkQuantizedArray does not match its input" << std::endl;
+    res = EXIT_FAILURE;
+  }
+  for (vtkIdType i = 0; i < numberOfTuples; ++i)
+  {
+    // 1000 integers fit in the 65536 codes
+    if (quantizedIds->GetValue(i) != ids->GetValue(i))
+    {
+      std::cerr << "Wrong integer value at index " << i << std::endl;
+      res = EXIT_FAILURE;
+      break;
+    }
+  }
+
+  // non finite values
+  vtkNew<vtkDoubleArray> special;
+  special->SetNumberOfValues(4);
+  special->SetValue(0, -1.0);
+  special->SetValue(1, std::numeric_limits<double>::quiet_NaN());
+  special->SetValue(2, std::numeric_limits<double>::infinity());
+  special->SetValue(3, 1.0);
+  auto quantizedSpecial = Quantize<double>(special);
+  if (quantizedSpecial->GetValue(0) != -1.0 || quantizedSpecial->GetValue(1) != -1.0 ||
+    quantizedSpecial->GetValue(2) != 1.0 || quantizedSpecial->GetValue(3) != 1.0)
+  {
+    std::cerr << "Wrong handling of non finite values" << std::endl;
+    res = EXIT_FAILURE;
+  }
+
+  // the quantized array feeds vtkArrayDispatch based code like any other array
+  using Dispatcher =
+    vtkArrayDispatch::DispatchByArray<vtkTypeList::Create<vtkQuantizedArray<float>>>;
+  MaxWorker worker;
+  double max = 0.0;
+  if (!Dispatcher::Execute(quantizedNormals, worker, max) || max != 3.0)
+  {
+    std::cerr << "Dispatch failed, got a maximum of " << max << std::endl;
+    res = EXIT_FAILURE;
+  }
+
+  return res;
+}
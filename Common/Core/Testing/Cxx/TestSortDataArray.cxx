@@ -12,6 +12,7 @@
 
 #include <locale> // C++ locale
 #include <sstream>
+#include <vector>
 
 // #define ARRAY_SIZE (2*1024*1024)
 #define ARRAY_SIZE 2048
@@ -278,6 +279,41 @@ int TestSortDataArray(int, char*[])
   }
   cout << "String array consistency check finished\n" << endl;
 
+  // Real keys, sorted from scratch then again after a perturbation
+  const vtkIdType numRealKeys = 300000;
+  std::vector<double> depths(numRealKeys);
+  std::vector<double> depthOfId(numRealKeys);
+  std::vector<vtkIdType> depthIds(numRealKeys);
+  for (vtkIdType j = 0; j < numRealKeys; ++j)
+  {
+    depths[j] = depthOfId[j] = (j % 11 == 0) ? 1.0 : vtkMath::Random(-1000.0, 1000.0);
+    depthIds[j] = j;
+  }
+  for (bool nearlySorted : { false, true })
+  {
+    cout << "Sorting real keys" << (nearlySorted ? " (nearly sorted)" : "") << endl;
+    timer->StartTimer();
+    vtkSortDataArray::SortRealKeys(depths.data(), depthIds.data(), numRealKeys, nearlySorted);
+    timer->StopTimer();
+    cout << "Time to sort real keys: " << timer->GetElapsedTime() << " sec" << endl;
+    for (vtkIdType j = 0; j < numRealKeys; ++j)
+    {
+      if (depths[j] != depthOfId[depthIds[j]] || (j > 0 && depths[j] < depths[j - 1]))
+      {
+        cout << "Real keys sorted incorrectly!" << endl;
+        retVal = 1;
+        break;
+      }
+    }
+    // move the keys a little, as a small camera motion would do
+    for (vtkIdType j = 0; j < numRealKeys; ++j)
+    {
+      depths[j] += 0.001 * (j % 7);
+      depthOfId[depthIds[j]] = depths[j];
+    }
+  }
+  cout << "Real keys consistency check finished\n" << endl;
+
   timer->Delete();
   keys->Delete();
   ids->Delete();
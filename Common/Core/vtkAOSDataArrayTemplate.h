@@ -87,6 +87,10 @@ public:
   void SetValue(vtkIdType valueIdx, ValueType value)
     VTK_EXPECTS(0 <= valueIdx && valueIdx < GetNumberOfValues())
   {
+    if (!this->DetachSharedBuffer())
+    {
+      return;
+    }
     this->Buffer->GetBuffer()[valueIdx] = value;
   }
 
@@ -111,6 +115,10 @@ public:
     VTK_EXPECTS(0 <= tupleIdx && tupleIdx < GetNumberOfTuples())
   {
     const vtkIdType valueIdx = tupleIdx * this->NumberOfComponents;
+    if (!this->DetachSharedBuffer())
+    {
+      return;
+    }
     std::copy(tuple, tuple + this->NumberOfComponents, this->Buffer->GetBuffer() + valueIdx);
   }
   ///@}
@@ -129,6 +137,10 @@ public:
     VTK_EXPECTS(0 <= tupleIdx && tupleIdx < GetNumberOfTuples()) override
   {
     const vtkIdType valueIdx = tupleIdx * this->NumberOfComponents;
+    if (!this->DetachSharedBuffer())
+    {
+      return;
+    }
     for (vtkIdType ii = 0; ii < this->NumberOfComponents; ++ii)
     {
       this->Buffer->GetBuffer()[valueIdx + ii] = static_cast<ValueType>(tuple[ii]);
@@ -149,6 +161,10 @@ public:
     VTK_EXPECTS(0 <= tupleIdx && tupleIdx < GetNumberOfTuples()) override
   {
     const vtkIdType valueIdx = tupleIdx * this->NumberOfComponents;
+    if (!this->DetachSharedBuffer())
+    {
+      return;
+    }
     for (vtkIdType ii = 0; ii < this->NumberOfComponents; ++ii)
     {
       this->Buffer->GetBuffer()[valueIdx + ii] = static_cast<ValueType>(tuple[ii]);
@@ -210,6 +226,8 @@ public:
    * Use of this method is discouraged, as newer arrays require a deep-copy of
    * the array data in order to return a suitable pointer. See vtkArrayDispatch
    * for a safer alternative for fast data access.
+   * These methods do not copy a buffer shared with CopyOnWrite on, use WritePointer to get
+   * a pointer to modify the values.
    */
   ValueType* GetPointer(vtkIdType valueIdx);
   void* GetVoidPointer(vtkIdType valueIdx) override;
@@ -309,6 +327,36 @@ public:
   bool HasStandardMemoryLayout() const override { return true; }
   void ShallowCopy(vtkDataArray* other) override;
 
+  // Overridden to release a shared buffer instead of copying it:
+  void DeepCopy(vtkDataArray* other) override;
+  // MSVC doesn't like 'using' here (error C2487). Just forward instead:
+  // using Superclass::DeepCopy;
+  void DeepCopy(vtkAbstractArray* other) override { this->Superclass::DeepCopy(other); }
+
+  ///@{
+  /**
+   * Copy-on-write mode of the buffer shared by ShallowCopy. When on, the first modification of
+   * the values through the API of the array (SetValue, SetTypedTuple, FillValue, WritePointer,
+   * Resize, ...) gives the array its own copy of the buffer if the buffer is still shared with
+   * other arrays, so the arrays sharing it are not modified. Filters can then shallow copy the
+   * arrays of their input and modify a few values instead of deep copying them.
+   *
+   * GetPointer, GetVoidPointer and the value ranges do not copy the buffer: use WritePointer to
+   * get a pointer to write to. The copy is not thread safe, the first modification of a shared
+   * buffer must not happen concurrently, e.g. call WritePointer before a vtkSMPTools loop.
+   *
+   * The mode is off by default. ShallowCopy turns it on when it is on for the copied array.
+   */
+  vtkSetMacro(CopyOnWrite, bool);
+  vtkGetMacro(CopyOnWrite, bool);
+  vtkBooleanMacro(CopyOnWrite, bool);
+  ///@}
+
+  /**
+   * Return true if the buffer of this array is shared with other arrays.
+   */
+  bool HasSharedBuffer() const { return this->Buffer->GetReferenceCount() > 1; }
+
   // Reimplemented for efficiency:
   void InsertTuples(
     vtkIdType dstStart, vtkIdType n, vtkIdType srcStart, vtkAbstractArray* source) override;
@@ -340,7 +388,31 @@ protected:
    */
   bool ReallocateTuples(vtkIdType numTuples);
 
+  /**
+   * Zero-initialize the values in [beginValue, endValue) with a vtkSMPTools loop over the tuples
+   * when vtkDataArray::GetParallelFirstTouch() is on.
+   */
+  void FirstTouch(vtkIdType beginValue, vtkIdType endValue);
+
+  /**
+   * Give this array its own copy of its buffer when it is shared and CopyOnWrite is on. Must be
+   * called before modifying the values, which must not be modified if it returns false, i.e. if
+   * the copy could not be allocated.
+   */
+  bool DetachSharedBuffer()
+  {
+    return !this->CopyOnWrite || !this->HasSharedBuffer() ||
+      this->CopySharedBuffer(this->Buffer->GetSize(), this->MaxId + 1);
+  }
+
+  /**
+   * Replace the buffer by a new buffer of @a size values, holding a copy of the first
+   * @a numValues values of the current buffer.
+   */
+  bool CopySharedBuffer(vtkIdType size, vtkIdType numValues);
+
   vtkBuffer<ValueType>* Buffer;
+  bool CopyOnWrite = false;
 
 private:
   vtkAOSDataArrayTemplate(const vtkAOSDataArrayTemplate&) = delete;
@@ -12,6 +12,9 @@
 #include "vtkAOSDataArrayTemplate.h"
 
 #include "vtkArrayIteratorTemplate.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
 
 //-----------------------------------------------------------------------------
 VTK_ABI_NAMESPACE_BEGIN
@@ -60,6 +63,11 @@ template <class ValueTypeT>
 void vtkAOSDataArrayTemplate<ValueTypeT>::SetArray(
   ValueType* array, vtkIdType size, int save, int deleteMethod)
 {
+  if (this->CopyOnWrite && this->HasSharedBuffer())
+  {
+    // the arrays sharing the buffer keep their values
+    this->CopySharedBuffer(0, 0);
+  }
 
   this->Buffer->SetBuffer(array, size);
 
@@ -121,6 +129,10 @@ void vtkAOSDataArrayTemplate<ValueTypeT>::SetTuple(vtkIdType tupleIdx, const flo
   // While std::copy is the obvious choice here, it kills performance on MSVC
   // debugging builds as their STL calls are poorly optimized. Just use a for
   // loop instead.
+  if (!this->DetachSharedBuffer())
+  {
+    return;
+  }
   ValueTypeT* data = this->Buffer->GetBuffer() + tupleIdx * this->NumberOfComponents;
   for (int i = 0; i < this->NumberOfComponents; ++i)
   {
@@ -133,6 +145,10 @@ template <class ValueTypeT>
 void vtkAOSDataArrayTemplate<ValueTypeT>::SetTuple(vtkIdType tupleIdx, const double* tuple)
 {
   // See note in SetTuple about std::copy vs for loops on MSVC.
+  if (!this->DetachSharedBuffer())
+  {
+    return;
+  }
   ValueTypeT* data = this->Buffer->GetBuffer() + tupleIdx * this->NumberOfComponents;
   for (int i = 0; i < this->NumberOfComponents; ++i)
   {
@@ -148,6 +164,10 @@ void vtkAOSDataArrayTemplate<ValueTypeT>::InsertTuple(vtkIdType tupleIdx, const
   {
     // See note in SetTuple about std::copy vs for loops on MSVC.
     const vtkIdType valueIdx = tupleIdx * this->NumberOfComponents;
+    if (!this->DetachSharedBuffer())
+    {
+      return;
+    }
     ValueTypeT* data = this->Buffer->GetBuffer() + valueIdx;
     for (int i = 0; i < this->NumberOfComponents; ++i)
     {
@@ -165,6 +185,10 @@ void vtkAOSDataArrayTemplate<ValueTypeT>::InsertTuple(vtkIdType tupleIdx, const
   {
     // See note in SetTuple about std::copy vs for loops on MSVC.
     const vtkIdType valueIdx = tupleIdx * this->NumberOfComponents;
+    if (!this->DetachSharedBuffer())
+    {
+      return;
+    }
     ValueTypeT* data = this->Buffer->GetBuffer() + valueIdx;
     for (int i = 0; i < this->NumberOfComponents; ++i)
     {
@@ -188,6 +212,10 @@ void vtkAOSDataArrayTemplate<ValueTypeT>::InsertComponent(
     }
   }
 
+  if (!this->DetachSharedBuffer())
+  {
+    return;
+  }
   this->Buffer->GetBuffer()[newMaxId] = static_cast<ValueTypeT>(value);
   this->MaxId = std::max(newMaxId, this->MaxId);
 }
@@ -207,6 +235,10 @@ vtkIdType vtkAOSDataArrayTemplate<ValueTypeT>::InsertNextTuple(const float* tupl
   }
 
   // See note in SetTuple about std::copy vs for loops on MSVC.
+  if (!this->DetachSharedBuffer())
+  {
+    return -1;
+  }
   ValueTypeT* data = this->Buffer->GetBuffer() + this->MaxId + 1;
   for (int i = 0; i < this->NumberOfComponents; ++i)
   {
@@ -231,6 +263,10 @@ vtkIdType vtkAOSDataArrayTemplate<ValueTypeT>::InsertNextTuple(const double* tup
   }
 
   // See note in SetTuple about std::copy vs for loops on MSVC.
+  if (!this->DetachSharedBuffer())
+  {
+    return -1;
+  }
   ValueTypeT* data = this->Buffer->GetBuffer() + this->MaxId + 1;
   for (int i = 0; i < this->NumberOfComponents; ++i)
   {
@@ -293,6 +329,7 @@ void vtkAOSDataArrayTemplate<ValueTypeT>::ShallowCopy(vtkDataArray* other)
       this->Buffer = o->Buffer;
       this->Buffer->Register(nullptr);
     }
+    this->CopyOnWrite = this->CopyOnWrite || o->CopyOnWrite;
     this->DataChanged();
   }
   else
@@ -301,6 +338,20 @@ void vtkAOSDataArrayTemplate<ValueTypeT>::ShallowCopy(vtkDataArray* other)
   }
 }
 
+//-----------------------------------------------------------------------------
+template <class ValueTypeT>
+void vtkAOSDataArrayTemplate<ValueTypeT>::DeepCopy(vtkDataArray* other)
+{
+  if (other != this && this->CopyOnWrite && this->HasSharedBuffer())
+  {
+    // all the values are replaced, so the shared buffer is released instead of being copied
+    this->CopySharedBuffer(0, 0);
+    this->Size = 0;
+    this->MaxId = -1;
+  }
+  this->Superclass::DeepCopy(other);
+}
+
 //-----------------------------------------------------------------------------
 template <class ValueTypeT>
 void vtkAOSDataArrayTemplate<ValueTypeT>::InsertTuples(
@@ -351,6 +402,10 @@ void vtkAOSDataArrayTemplate<ValueTypeT>::InsertTuples(
     }
   }
 
+  if (!this->DetachSharedBuffer())
+  {
+    return;
+  }
   this->MaxId = std::max(this->MaxId, newSize - 1);
 
   ValueType* srcBegin = other->GetPointer(srcStart * numComps);
@@ -379,6 +434,10 @@ template <class ValueTypeT>
 void vtkAOSDataArrayTemplate<ValueTypeT>::FillValue(ValueType value)
 {
   std::ptrdiff_t offset = this->MaxId + 1;
+  if (!this->DetachSharedBuffer())
+  {
+    return;
+  }
   std::fill(this->Buffer->GetBuffer(), this->Buffer->GetBuffer() + offset, value);
 }
 
@@ -404,6 +463,12 @@ vtkAOSDataArrayTemplate<ValueTypeT>::WritePointer(vtkIdType valueIdx, vtkIdType
     this->MaxId = (newSize - 1);
   }
 
+  // Only the values in use before extending them are copied.
+  if (!this->DetachSharedBuffer())
+  {
+    return nullptr;
+  }
+
   // For extending the in-use ids but not the size:
   this->MaxId = std::max(this->MaxId, newSize - 1);
 
@@ -438,9 +503,15 @@ template <class ValueTypeT>
 bool vtkAOSDataArrayTemplate<ValueTypeT>::AllocateTuples(vtkIdType numTuples)
 {
   vtkIdType numValues = numTuples * this->GetNumberOfComponents();
+  if (this->CopyOnWrite && this->HasSharedBuffer())
+  {
+    // old data is not preserved, the arrays sharing the buffer keep it
+    this->CopySharedBuffer(0, 0);
+  }
   if (this->Buffer->Allocate(numValues))
   {
     this->Size = this->Buffer->GetSize();
+    this->FirstTouch(0, this->Size);
     return true;
   }
   return false;
@@ -450,13 +521,67 @@ bool vtkAOSDataArrayTemplate<ValueTypeT>::AllocateTuples(vtkIdType numTuples)
 template <class ValueTypeT>
 bool vtkAOSDataArrayTemplate<ValueTypeT>::ReallocateTuples(vtkIdType numTuples)
 {
-  if (this->Buffer->Reallocate(numTuples * this->GetNumberOfComponents()))
+  const vtkIdType oldSize = this->Buffer->GetSize();
+  const vtkIdType numValues = numTuples * this->GetNumberOfComponents();
+  if (this->CopyOnWrite && this->HasSharedBuffer())
+  {
+    // the copy of the shared buffer is the reallocation
+    if (!this->CopySharedBuffer(numValues, this->MaxId + 1))
+    {
+      return false;
+    }
+    this->Size = this->Buffer->GetSize();
+    this->FirstTouch(std::min(this->MaxId + 1, this->Size), this->Size);
+    return true;
+  }
+  if (this->Buffer->Reallocate(numValues))
   {
     this->Size = this->Buffer->GetSize();
+    this->FirstTouch(oldSize, this->Size);
     return true;
   }
   return false;
 }
 
+//-----------------------------------------------------------------------------
+template <class ValueTypeT>
+void vtkAOSDataArrayTemplate<ValueTypeT>::FirstTouch(vtkIdType beginValue, vtkIdType endValue)
+{
+  if (!vtkDataArray::GetParallelFirstTouch() ||
+    (endValue - beginValue) * static_cast<vtkIdType>(sizeof(ValueType)) <
+      vtkDataArray::GetFirstTouchThreshold())
+  {
+    return;
+  }
+  // the values are partitioned by tuples, like in the loops of the filters over points or cells
+  ValueType* data = this->Buffer->GetBuffer();
+  const vtkIdType numComps = this->GetNumberOfComponents();
+  vtkSMPTools::For(beginValue / numComps, (endValue + numComps - 1) / numComps,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      std::fill(data + std::max(begin * numComps, beginValue),
+        data + std::min(end * numComps, endValue), ValueType());
+    });
+}
+
+//-----------------------------------------------------------------------------
+template <class ValueTypeT>
+bool vtkAOSDataArrayTemplate<ValueTypeT>::CopySharedBuffer(vtkIdType size, vtkIdType numValues)
+{
+  vtkBuffer<ValueType>* buffer = vtkBuffer<ValueType>::New();
+  if (!buffer->Allocate(size))
+  {
+    vtkErrorMacro("Unable to allocate " << size << " elements of size " << sizeof(ValueType)
+                                        << " bytes to copy a shared buffer.");
+    buffer->Delete();
+    return false;
+  }
+  const ValueType* values = this->Buffer->GetBuffer();
+  std::copy(values, values + std::min(numValues, size), buffer->GetBuffer());
+  this->Buffer->Delete();
+  this->Buffer = buffer;
+  return true;
+}
+
 VTK_ABI_NAMESPACE_END
 #endif // header guard
@@ -520,6 +520,17 @@ vtkVariant vtkAbstractArrayGetVariantValue(T* arr, vtkIdType index)
   return vtkVariant(arr[index]);
 }
 
+//------------------------------------------------------------------------------
+void vtkAbstractArray::LookupValues(vtkAbstractArray* values, vtkIdList* valueIds)
+{
+  const vtkIdType numValues = values->GetNumberOfValues();
+  valueIds->SetNumberOfIds(numValues);
+  for (vtkIdType i = 0; i < numValues; ++i)
+  {
+    valueIds->SetId(i, this->LookupValue(values->GetVariantValue(i)));
+  }
+}
+
 //------------------------------------------------------------------------------
 vtkVariant vtkAbstractArray::GetVariantValue(vtkIdType valueIdx)
 {
@@ -466,6 +466,13 @@ public:
   virtual void LookupValue(vtkVariant value, vtkIdList* valueIds) = 0;
   ///@}
 
+  /**
+   * Return in valueIds the index of the first occurrence of each value of values, or -1 for the
+   * values that are not found, as LookupValue(vtkVariant) would. valueIds gets as many ids as
+   * values has values. Subclasses may run the lookups in parallel.
+   */
+  virtual void LookupValues(vtkAbstractArray* values, vtkIdList* valueIds);
+
   /**
    * Retrieve value from the array as a variant.
    */
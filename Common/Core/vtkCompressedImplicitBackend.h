@@ -0,0 +1,113 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#ifndef vtkCompressedImplicitBackend_h
+#define vtkCompressedImplicitBackend_h
+
+/**
+ * \class vtkCompressedImplicitBackend
+ *
+ * A backend for the `vtkImplicitArray` framework keeping the values of a given data array
+ * compressed in memory.
+ *
+ * The values are split in blocks of `BlockSize` values which are compressed independently with a
+ * lossless scheme suited to scientific data: each value is xor-ed with the same component of the
+ * previous tuple, the bytes of the result are regrouped by significance and the byte planes are
+ * run length encoded. Smooth fields, piecewise constant fields and integer ids compress well
+ * since the most significant byte planes then mostly contain zeros.
+ *
+ * A small cache of decompressed blocks avoids decompressing a block for every value read. The
+ * cache is split in shards protected by their own mutex so that the array can be read from
+ * several threads, e.g. by filters using `vtkSMPTools`. Reading a value is still much slower than
+ * reading from a `vtkAOSDataArrayTemplate`: this backend trades access time for memory, for
+ * instance to keep many time steps of a field in memory.
+ *
+ * The compressed values are a copy of the values of the given array at construction time, which
+ * can be released afterwards.
+ *
+ * An example of potential usage in a `vtkImplicitArray`:
+ * ```
+ * vtkNew<vtkDoubleArray> baseArray;
+ * baseArray->SetNumberOfComponents(3);
+ * baseArray->SetNumberOfTuples(100000);
+ * ...
+ *
+ * vtkNew<vtkImplicitArray<vtkCompressedImplicitBackend<double>>> compressed; // More compact with
+ *                                                                           // `vtkCompressedArray`
+ * compressed->SetBackend(std::make_shared<vtkCompressedImplicitBackend<double>>(baseArray));
+ * compressed->SetNumberOfComponents(3);
+ * compressed->SetNumberOfTuples(100000);
+ * CHECK(compressed->GetComponent(42, 1) == baseArray->GetComponent(42, 1));
+ * ```
+ *
+ * @sa
+ * vtkImplicitArray, vtkCompressedArray
+ */
+
+#include "vtkCommonCoreModule.h"
+
+#include "vtkType.h"
+
+#include <memory>
+
+VTK_ABI_NAMESPACE_BEGIN
+class vtkDataArray;
+template <typename ValueType>
+class VTKCOMMONCORE_EXPORT vtkCompressedImplicitBackend final
+{
+public:
+  /**
+   * Constructor
+   * @param array array whose values are compressed
+   * @param blockSize number of values per compressed block, rounded up to a multiple of the
+   * number of components of the array
+   * @param numberOfCachedBlocks number of decompressed blocks kept in memory
+   */
+  vtkCompressedImplicitBackend(
+    vtkDataArray* array, vtkIdType blockSize = 4096, int numberOfCachedBlocks = 16);
+  ~vtkCompressedImplicitBackend();
+
+  /**
+   * Indexing operation for the compressed array respecting the backend expectations of
+   * `vtkImplicitArray`
+   */
+  ValueType operator()(vtkIdType idx) const;
+
+  /**
+   * Returns the smallest integer memory size in KiB needed to store the compressed values and
+   * the blocks currently in the cache.
+   * Used to implement GetActualMemorySize on `vtkCompressedImplicitBackend`.
+   */
+  unsigned long getMemorySize() const;
+
+private:
+  struct Internals;
+  std::unique_ptr<Internals> Internal;
+};
+VTK_ABI_NAMESPACE_END
+
+#endif // vtkCompressedImplicitBackend_h
+
+#if defined(VTK_COMPRESSED_BACKEND_INSTANTIATING)
+
+#define VTK_INSTANTIATE_COMPRESSED_BACKEND(ValueType)                                              \
+  VTK_ABI_NAMESPACE_BEGIN                                                                          \
+  template class VTKCOMMONCORE_EXPORT vtkCompressedImplicitBackend<ValueType>;                     \
+  VTK_ABI_NAMESPACE_END
+
+#elif defined(VTK_USE_EXTERN_TEMPLATE)
+
+#ifndef VTK_COMPRESSED_BACKEND_TEMPLATE_EXTERN
+#define VTK_COMPRESSED_BACKEND_TEMPLATE_EXTERN
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable : 4910) // extern and dllexport incompatible
+#endif
+VTK_ABI_NAMESPACE_BEGIN
+vtkExternTemplateMacro(extern template class VTKCOMMONCORE_EXPORT vtkCompressedImplicitBackend);
+VTK_ABI_NAMESPACE_END
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+#endif // VTK_COMPRESSED_BACKEND_TEMPLATE_EXTERN
+
+#endif
@@ -0,0 +1,357 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkCompressedImplicitBackend.h"
+
+#include "vtkArrayDispatch.h"
+#include "vtkDataArray.h"
+#include "vtkDataArrayRange.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace vtkCompressedImplicitBackendDetail
+{
+VTK_ABI_NAMESPACE_BEGIN
+//-----------------------------------------------------------------------
+// Unsigned integer with the size of a value, used to manipulate its bits.
+template <std::size_t Size>
+struct BitsOf;
+template <>
+struct BitsOf<1>
+{
+  using type = std::uint8_t;
+};
+template <>
+struct BitsOf<2>
+{
+  using type = std::uint16_t;
+};
+template <>
+struct BitsOf<4>
+{
+  using type = std::uint32_t;
+};
+template <>
+struct BitsOf<8>
+{
+  using type = std::uint64_t;
+};
+
+//-----------------------------------------------------------------------
+// Run length encoding of a byte stream: a control byte c < 128 is followed by c + 1 literal
+// bytes, a control byte c >= 128 by a single byte repeated c - 125 times.
+constexpr std::size_t MinimumRun = 3;
+constexpr std::size_t MaximumRun = 130;
+constexpr std::size_t MaximumLiterals = 128;
+
+inline void EncodeRuns(
+  const unsigned char* bytes, std::size_t size, std::vector<unsigned char>& out)
+{
+  std::size_t literalsBegin = 0;
+  auto flushLiterals = [&](std::size_t end)
+  {
+    while (literalsBegin < end)
+    {
+      const std::size_t count = std::min(end - literalsBegin, MaximumLiterals);
+      out.push_back(static_cast<unsigned char>(count - 1));
+      out.insert(out.end(), bytes + literalsBegin, bytes + literalsBegin + count);
+      literalsBegin += count;
+    }
+  };
+
+  std::size_t i = 0;
+  while (i < size)
+  {
+    std::size_t run = 1;
+    while (i + run < size && run < MaximumRun && bytes[i + run] == bytes[i])
+    {
+      ++run;
+    }
+    if (run >= MinimumRun)
+    {
+      flushLiterals(i);
+      out.push_back(static_cast<unsigned char>(run + 125));
+      out.push_back(bytes[i]);
+      literalsBegin = i + run;
+    }
+    i += run;
+  }
+  flushLiterals(size);
+}
+
+inline void DecodeRuns(const unsigned char* in, unsigned char* out, std::size_t size)
+{
+  std::size_t pos = 0;
+  while (pos < size)
+  {
+    const unsigned char control = *in++;
+    if (control < 128)
+    {
+      const std::size_t count = control + 1;
+      std::memcpy(out + pos, in, count);
+      in += count;
+      pos += count;
+    }
+    else
+    {
+      const std::size_t count = control - 125;
+      std::memset(out + pos, *in++, count);
+      pos += count;
+    }
+  }
+}
+
+//-----------------------------------------------------------------------
+// A block is stored as the byte planes of the xor of each value with the same component of the
+// previous tuple, the least significant plane first. Within a plane the bytes are sorted by
+// component so that a constant component gives long runs, and the planes are run length encoded
+// together.
+template <typename ValueType>
+void EncodeBlock(const ValueType* values, std::size_t numberOfValues, std::size_t stride,
+  std::vector<unsigned char>& planes, std::vector<unsigned char>& out)
+{
+  using Bits = typename BitsOf<sizeof(ValueType)>::type;
+  constexpr std::size_t numberOfPlanes = sizeof(ValueType);
+  planes.resize(numberOfValues * numberOfPlanes);
+  std::size_t pos = 0;
+  for (std::size_t component = 0; component < stride; ++component)
+  {
+    for (std::size_t i = component; i < numberOfValues; i += stride, ++pos)
+    {
+      Bits delta;
+      std::memcpy(&delta, values + i, sizeof(ValueType));
+      if (i >= stride)
+      {
+        Bits previous;
+        std::memcpy(&previous, values + i - stride, sizeof(ValueType));
+        delta ^= previous;
+      }
+      for (std::size_t plane = 0; plane < numberOfPlanes; ++plane)
+      {
+        planes[plane * numberOfValues + pos] = static_cast<unsigned char>(delta >> (8 * plane));
+      }
+    }
+  }
+  EncodeRuns(planes.data(), planes.size(), out);
+}
+
+template <typename ValueType>
+void DecodeBlock(const unsigned char* in, std::size_t numberOfValues, std::size_t stride,
+  std::vector<unsigned char>& planes, ValueType* values)
+{
+  using Bits = typename BitsOf<sizeof(ValueType)>::type;
+  constexpr std::size_t numberOfPlanes = sizeof(ValueType);
+  planes.resize(numberOfValues * numberOfPlanes);
+  DecodeRuns(in, planes.data(), planes.size());
+  std::size_t pos = 0;
+  for (std::size_t component = 0; component < stride; ++component)
+  {
+    for (std::size_t i = component; i < numberOfValues; i += stride, ++pos)
+    {
+      Bits bits = 0;
+      for (std::size_t plane = 0; plane < numberOfPlanes; ++plane)
+      {
+        bits |= static_cast<Bits>(static_cast<Bits>(planes[plane * numberOfValues + pos])
+          << (8 * plane));
+      }
+      if (i >= stride)
+      {
+        Bits previous;
+        std::memcpy(&previous, values + i - stride, sizeof(ValueType));
+        bits ^= previous;
+      }
+      std::memcpy(values + i, &bits, sizeof(ValueType));
+    }
+  }
+}
+
+//-----------------------------------------------------------------------
+template <typename ValueType>
+struct CompressWorker
+{
+  template <typename ArrayT>
+  void operator()(
+    ArrayT* array, vtkIdType blockSize, std::vector<std::vector<unsigned char>>& blocks)
+  {
+    const vtkIdType numberOfValues = array->GetNumberOfValues();
+    const std::size_t stride = static_cast<std::size_t>(array->GetNumberOfComponents());
+    vtkSMPTools::For(0, static_cast<vtkIdType>(blocks.size()),
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        const auto values = vtk::DataArrayValueRange(array);
+        std::vector<ValueType> buffer(blockSize);
+        std::vector<unsigned char> planes;
+        for (vtkIdType blockId = begin; blockId < end; ++blockId)
+        {
+          const vtkIdType first = blockId * blockSize;
+          const vtkIdType size = std::min(blockSize, numberOfValues - first);
+          std::transform(values.begin() + first, values.begin() + first + size, buffer.begin(),
+            [](auto value) { return static_cast<ValueType>(value); });
+          EncodeBlock(
+            buffer.data(), static_cast<std::size_t>(size), stride, planes, blocks[blockId]);
+        }
+      });
+  }
+};
+VTK_ABI_NAMESPACE_END
+} // namespace vtkCompressedImplicitBackendDetail
+
+VTK_ABI_NAMESPACE_BEGIN
+//-----------------------------------------------------------------------
+template <typename ValueType>
+struct vtkCompressedImplicitBackend<ValueType>::Internals
+{
+  // The cache is split in shards so that threads reading different blocks do not wait for each
+  // other. Block i is cached in shard i % NumberOfShards.
+  static constexpr std::size_t NumberOfShards = 8;
+
+  struct CachedBlock
+  {
+    vtkIdType Id = -1;
+    unsigned long long LastUse = 0;
+    std::vector<ValueType> Values;
+  };
+
+  struct Shard
+  {
+    std::mutex Mutex;
+    std::vector<CachedBlock> Blocks;
+    std::vector<unsigned char> Planes;
+    unsigned long long Clock = 0;
+  };
+
+  // The blocks hold whole tuples, so that each value is xor-ed with the same component of the
+  // previous tuple.
+  static vtkIdType GetTupleAlignedBlockSize(vtkDataArray* array, vtkIdType blockSize)
+  {
+    const vtkIdType numberOfComponents = array ? std::max(array->GetNumberOfComponents(), 1) : 1;
+    blockSize = std::max<vtkIdType>(blockSize, 1);
+    return (blockSize + numberOfComponents - 1) / numberOfComponents * numberOfComponents;
+  }
+
+  Internals(vtkDataArray* array, vtkIdType blockSize, int numberOfCachedBlocks)
+    : BlockSize(GetTupleAlignedBlockSize(array, blockSize))
+    , ShardCapacity(
+        (static_cast<std::size_t>(std::max(numberOfCachedBlocks, 1)) + NumberOfShards - 1) /
+        NumberOfShards)
+  {
+    this->Offsets.push_back(0);
+    if (!array)
+    {
+      vtkErrorWithObjectMacro(nullptr, "Cannot compress a nullptr array");
+      return;
+    }
+    this->NumberOfValues = array->GetNumberOfValues();
+    this->Stride = static_cast<std::size_t>(array->GetNumberOfComponents());
+    std::vector<std::vector<unsigned char>> blocks(
+      (this->NumberOfValues + this->BlockSize - 1) / this->BlockSize);
+    vtkCompressedImplicitBackendDetail::CompressWorker<ValueType> worker;
+    if (!vtkArrayDispatch::Dispatch::Execute(array, worker, this->BlockSize, blocks))
+    {
+      worker(array, this->BlockSize, blocks);
+    }
+
+    std::size_t size = 0;
+    for (const auto& block : blocks)
+    {
+      size += block.size();
+      this->Offsets.push_back(size);
+    }
+    this->Data.reserve(size);
+    for (const auto& block : blocks)
+    {
+      this->Data.insert(this->Data.end(), block.begin(), block.end());
+    }
+  }
+
+  ValueType GetValue(vtkIdType idx)
+  {
+    const vtkIdType blockId = idx / this->BlockSize;
+    Shard& shard = this->Shards[static_cast<std::size_t>(blockId) % NumberOfShards];
+    std::lock_guard<std::mutex> lock(shard.Mutex);
+    auto block = std::find_if(shard.Blocks.begin(), shard.Blocks.end(),
+      [blockId](const CachedBlock& cached) { return cached.Id == blockId; });
+    if (block == shard.Blocks.end())
+    {
+      if (shard.Blocks.size() < this->ShardCapacity)
+      {
+        block = shard.Blocks.emplace(shard.Blocks.end());
+      }
+      else
+      {
+        // evict the least recently used block of the shard
+        block = std::min_element(shard.Blocks.begin(), shard.Blocks.end(),
+          [](const CachedBlock& a, const CachedBlock& b) { return a.LastUse < b.LastUse; });
+      }
+      const vtkIdType first = blockId * this->BlockSize;
+      const std::size_t size =
+        static_cast<std::size_t>(std::min(this->BlockSize, this->NumberOfValues - first));
+      block->Values.resize(size);
+      vtkCompressedImplicitBackendDetail::DecodeBlock(
+        this->Data.data() + this->Offsets[blockId], size, this->Stride, shard.Planes,
+        block->Values.data());
+      block->Id = blockId;
+    }
+    block->LastUse = ++shard.Clock;
+    return block->Values[idx - blockId * this->BlockSize];
+  }
+
+  std::size_t GetCacheSize()
+  {
+    std::size_t size = 0;
+    for (Shard& shard : this->Shards)
+    {
+      std::lock_guard<std::mutex> lock(shard.Mutex);
+      for (const CachedBlock& block : shard.Blocks)
+      {
+        size += block.Values.capacity() * sizeof(ValueType);
+      }
+      size += shard.Planes.capacity();
+    }
+    return size;
+  }
+
+  const vtkIdType BlockSize;
+  const std::size_t ShardCapacity;
+  vtkIdType NumberOfValues = 0;
+  std::size_t Stride = 1;
+  std::vector<unsigned char> Data;
+  std::vector<std::size_t> Offsets;
+  std::array<Shard, NumberOfShards> Shards;
+};
+
+//-----------------------------------------------------------------------
+template <typename ValueType>
+vtkCompressedImplicitBackend<ValueType>::vtkCompressedImplicitBackend(
+  vtkDataArray* array, vtkIdType blockSize, int numberOfCachedBlocks)
+  : Internal(std::unique_ptr<Internals>(new Internals(array, blockSize, numberOfCachedBlocks)))
+{
+}
+
+//-----------------------------------------------------------------------
+template <typename ValueType>
+vtkCompressedImplicitBackend<ValueType>::~vtkCompressedImplicitBackend() = default;
+
+//-----------------------------------------------------------------------
+template <typename ValueType>
+ValueType vtkCompressedImplicitBackend<ValueType>::operator()(vtkIdType idx) const
+{
+  return this->Internal->GetValue(idx);
+}
+
+//-----------------------------------------------------------------------
+template <typename ValueType>
+unsigned long vtkCompressedImplicitBackend<ValueType>::getMemorySize() const
+{
+  const std::size_t bytes = this->Internal->Data.size() +
+    this->Internal->Offsets.size() * sizeof(std::size_t) + this->Internal->GetCacheSize();
+  return static_cast<unsigned long>(std::ceil(bytes / 1024.0));
+}
+VTK_ABI_NAMESPACE_END
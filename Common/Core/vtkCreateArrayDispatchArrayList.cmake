@@ -19,9 +19,14 @@
 # - VTK_DISPATCH_AFFINE_ARRAYS (default: OFF)
 #   Include vtkAffineArray<ValueType> for the basic types supported
 #   by VTK.
+# - VTK_DISPATCH_COMPRESSED_ARRAYS (default: OFF)
+#   Include vtkCompressedArray<ValueType> for the basic types supported
+#   by VTK.
 # - VTK_DISPATCH_CONSTANT_ARRAYS (default: OFF)
 #   Include vtkConstantArray<ValueType> for the basic types supported
 #   by VTK.
+# - VTK_DISPATCH_QUANTIZED_ARRAYS (default: OFF)
+#   Include vtkQuantizedArray<ValueType> for float and double.
 # - VTK_DISPATCH_STD_FUNCTION_ARRAYS (default: OFF)
 #   Include vtkStdFunctionArray<ValueType> for the basic types supported
 #   by VTK.
@@ -176,9 +181,17 @@ endmacro()
 _vtkCreateArrayDispatchImplicit(VTK_DISPATCH_AFFINE_ARRAYS "vtkAffineArray"
   "${vtk_numeric_types}")
 
+_vtkCreateArrayDispatchImplicit(VTK_DISPATCH_COMPRESSED_ARRAYS "vtkCompressedArray"
+  "${vtk_numeric_types}")
+
 _vtkCreateArrayDispatchImplicit(VTK_DISPATCH_CONSTANT_ARRAYS "vtkConstantArray"
   "${vtk_numeric_types}")
 
+# quantization is meant for floating point values
+set(vtkArrayDispatchImplicit_quantized_types "float;double")
+_vtkCreateArrayDispatchImplicit(VTK_DISPATCH_QUANTIZED_ARRAYS "vtkQuantizedArray"
+  "${vtkArrayDispatchImplicit_quantized_types}")
+
 _vtkCreateArrayDispatchImplicit(VTK_DISPATCH_STD_FUNCTION_ARRAYS "vtkStdFunctionArray"
   "${vtk_numeric_types}")
 
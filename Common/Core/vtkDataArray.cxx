@@ -34,10 +34,13 @@
 #include "vtkUnsignedShortArray.h"
 
 #include <algorithm> // for min(), max()
+#include <atomic>
 #include <vector>
 
 namespace
 {
+std::atomic<bool> ParallelFirstTouch(false);
+std::atomic<vtkIdType> FirstTouchThreshold(1 << 20);
 
 template <typename InfoType, typename KeyType>
 bool hasValidKey(InfoType info, KeyType key, double range[2])
@@ -688,6 +691,30 @@ vtkDataArray* vtkDataArray::CreateDataArray(int dataType)
   return da;
 }
 
+//------------------------------------------------------------------------------
+void vtkDataArray::SetParallelFirstTouch(bool firstTouch)
+{
+  ParallelFirstTouch = firstTouch;
+}
+
+//------------------------------------------------------------------------------
+bool vtkDataArray::GetParallelFirstTouch()
+{
+  return ParallelFirstTouch;
+}
+
+//------------------------------------------------------------------------------
+void vtkDataArray::SetFirstTouchThreshold(vtkIdType bytes)
+{
+  FirstTouchThreshold = bytes;
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkDataArray::GetFirstTouchThreshold()
+{
+  return FirstTouchThreshold;
+}
+
 //------------------------------------------------------------------------------
 void vtkDataArray::FillComponent(int compIdx, double value)
 {
@@ -518,6 +518,22 @@ public:
   VTK_NEWINSTANCE
   static vtkDataArray* CreateDataArray(int dataType);
 
+  ///@{
+  /**
+   * Memory placement policy of the arrays storing their values in contiguous buffers
+   * (vtkAOSDataArrayTemplate and vtkSOADataArrayTemplate). When on, the values added when
+   * allocating or growing an array of at least FirstTouchThreshold bytes are zero-initialized
+   * with a vtkSMPTools::For loop over the tuples. On NUMA systems the pages are then placed on the
+   * memory of the threads that will process the same tuples in the subsequent vtkSMPTools loops,
+   * instead of all being placed on the memory of the thread that allocated the array.
+   * ParallelFirstTouch is off by default, FirstTouchThreshold is 1 MiB.
+   */
+  static void SetParallelFirstTouch(bool firstTouch);
+  static bool GetParallelFirstTouch();
+  static void SetFirstTouchThreshold(vtkIdType bytes);
+  static vtkIdType GetFirstTouchThreshold();
+  ///@}
+
   /**
    * This key is used to hold tight bounds on the range of
    * one component over all tuples of the array.
@@ -11,6 +11,7 @@
 
 #include "vtkDataArrayPrivate.txx"
 #include "vtkOStreamWrapper.h"
+#include "vtkSMPTools.h"
 
 namespace vtkDataArrayPrivate
 {
@@ -18,3 +19,21 @@ VTK_ABI_NAMESPACE_BEGIN
 VTK_INSTANTIATE_VALUERANGE_ARRAYTYPE(vtkDataArray, double)
 VTK_ABI_NAMESPACE_END
 } // namespace vtkDataArrayPrivate
+
+// Parallel loops of vtkGenericDataArrayLookupHelper.
+namespace vtkGenericDataArrayLookupHelper_detail
+{
+VTK_ABI_NAMESPACE_BEGIN
+void ParallelFor(vtkIdType first, vtkIdType last, vtkIdType grain,
+  const std::function<void(vtkIdType, vtkIdType)>& functor)
+{
+  vtkSMPTools::For(
+    first, last, grain, [&](vtkIdType begin, vtkIdType end) { functor(begin, end); });
+}
+
+int GetEstimatedNumberOfThreads()
+{
+  return vtkSMPTools::GetEstimatedNumberOfThreads();
+}
+VTK_ABI_NAMESPACE_END
+} // namespace vtkGenericDataArrayLookupHelper_detail
@@ -321,6 +321,12 @@ public:
   virtual vtkIdType LookupTypedValue(ValueType value);
   void LookupValue(vtkVariant value, vtkIdList* valueIds) override;
   virtual void LookupTypedValue(ValueType value, vtkIdList* valueIds);
+  void LookupValues(vtkAbstractArray* values, vtkIdList* valueIds) override;
+  /**
+   * Set valueIds[i] to the index of the first occurrence of values[i], -1 if it is not found,
+   * for the numValues values. The lookups are run in parallel with vtkSMPTools.
+   */
+  void LookupTypedValues(const ValueType* values, vtkIdType numValues, vtkIdType* valueIds);
   void ClearLookup() override;
   void DataChanged() override;
   void FillComponent(int compIdx, double value) override;
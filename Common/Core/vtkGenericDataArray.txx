@@ -9,6 +9,9 @@
 #include "vtkMath.h"
 #include "vtkVariantCast.h"
 
+#include <cstddef>
+#include <vector>
+
 //-----------------------------------------------------------------------------
 VTK_ABI_NAMESPACE_BEGIN
 template <class DerivedT, class ValueTypeT>
@@ -307,6 +310,51 @@ void vtkGenericDataArray<DerivedT, ValueTypeT>::LookupTypedValue(ValueType value
   this->Lookup.LookupValue(value, ids);
 }
 
+//-----------------------------------------------------------------------------
+template <class DerivedT, class ValueTypeT>
+void vtkGenericDataArray<DerivedT, ValueTypeT>::LookupValues(
+  vtkAbstractArray* values, vtkIdList* ids)
+{
+  const vtkIdType numValues = values->GetNumberOfValues();
+  ids->SetNumberOfIds(numValues);
+  if (values->GetDataType() == this->GetDataType() && values->HasStandardMemoryLayout())
+  {
+    this->LookupTypedValues(
+      static_cast<const ValueType*>(values->GetVoidPointer(0)), numValues, ids->GetPointer(0));
+    return;
+  }
+
+  // the values that cannot be converted to ValueType are not found
+  std::vector<ValueType> typedValues(static_cast<std::size_t>(numValues));
+  std::vector<char> valid(static_cast<std::size_t>(numValues));
+  vtkGenericDataArrayLookupHelper_detail::ParallelFor(0, numValues, 0,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        bool isValid = true;
+        typedValues[i] = vtkVariantCast<ValueType>(values->GetVariantValue(i), &isValid);
+        valid[i] = isValid;
+      }
+    });
+  this->LookupTypedValues(typedValues.data(), numValues, ids->GetPointer(0));
+  for (vtkIdType i = 0; i < numValues; ++i)
+  {
+    if (!valid[i])
+    {
+      ids->SetId(i, -1);
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+template <class DerivedT, class ValueTypeT>
+void vtkGenericDataArray<DerivedT, ValueTypeT>::LookupTypedValues(
+  const ValueType* values, vtkIdType numValues, vtkIdType* ids)
+{
+  this->Lookup.LookupValues(values, numValues, ids);
+}
+
 //-----------------------------------------------------------------------------
 template <class DerivedT, class ValueTypeT>
 void vtkGenericDataArray<DerivedT, ValueTypeT>::ClearLookup()
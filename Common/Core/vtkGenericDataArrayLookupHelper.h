@@ -5,16 +5,21 @@
  * @brief   internal class used by
  * vtkGenericDataArray to support LookupValue.
  *
+ * The index is built in parallel on the first lookup, and the values appended to the
+ * array afterwards are merged into it on the next lookup instead of rebuilding it.
  */
 
 #ifndef vtkGenericDataArrayLookupHelper_h
 #define vtkGenericDataArrayLookupHelper_h
 
+#include "vtkCommonCoreModule.h" // For export macro
 #include "vtkIdList.h"
+
 #include <algorithm>
 #include <cmath>
+#include <cstddef>
+#include <functional>
 #include <limits>
-#include <unordered_map>
 #include <vector>
 
 namespace vtkGenericDataArrayLookupHelper_detail
@@ -41,6 +46,51 @@ bool isnan(T x)
   // Select the correct partially specialized type.
   return has_NaN<T, std::numeric_limits<T>::has_quiet_NaN>::isnan(x);
 }
+
+// vtkSMPTools::For and vtkSMPTools::GetEstimatedNumberOfThreads, compiled in
+// vtkGenericDataArray.cxx so that the array headers do not depend on vtkSMPTools.
+VTKCOMMONCORE_EXPORT void ParallelFor(vtkIdType first, vtkIdType last, vtkIdType grain,
+  const std::function<void(vtkIdType, vtkIdType)>& functor);
+VTKCOMMONCORE_EXPORT int GetEstimatedNumberOfThreads();
+
+// Sort each of the chunks of [begin, end) in parallel, then merge them pairwise, the merges of
+// each round running in parallel.
+template <typename Iterator, typename Compare>
+void ParallelSort(Iterator begin, Iterator end, Compare comp)
+{
+  const vtkIdType size = static_cast<vtkIdType>(end - begin);
+  const vtkIdType minChunkSize = 16384;
+  const vtkIdType numChunks =
+    std::min(static_cast<vtkIdType>(GetEstimatedNumberOfThreads()), size / minChunkSize);
+  if (numChunks < 2)
+  {
+    std::sort(begin, end, comp);
+    return;
+  }
+  auto chunkBegin = [&](vtkIdType chunk) { return begin + size * chunk / numChunks; };
+  ParallelFor(0, numChunks, 1,
+    [&](vtkIdType chunk, vtkIdType endChunk)
+    {
+      for (; chunk < endChunk; ++chunk)
+      {
+        std::sort(chunkBegin(chunk), chunkBegin(chunk + 1), comp);
+      }
+    });
+  for (vtkIdType width = 1; width < numChunks; width *= 2)
+  {
+    ParallelFor(0, (numChunks + 2 * width - 1) / (2 * width), 1,
+      [&](vtkIdType pair, vtkIdType endPair)
+      {
+        for (; pair < endPair; ++pair)
+        {
+          const vtkIdType first = 2 * width * pair;
+          const vtkIdType middle = std::min(first + width, numChunks);
+          const vtkIdType last = std::min(first + 2 * width, numChunks);
+          std::inplace_merge(chunkBegin(first), chunkBegin(middle), chunkBegin(last), comp);
+        }
+      });
+  }
+}
 VTK_ABI_NAMESPACE_END
 } // namespace detail
 
@@ -68,27 +118,44 @@ public:
   vtkIdType LookupValue(ValueType elem)
   {
     this->UpdateLookup();
-    auto indices = FindIndexVec(elem);
-    if (indices == nullptr)
-    {
-      return -1;
-    }
-    return indices->front();
+    return this->FindFirstIndex(elem);
   }
 
   void LookupValue(ValueType elem, vtkIdList* ids)
   {
     ids->Reset();
     this->UpdateLookup();
-    auto indices = FindIndexVec(elem);
-    if (indices)
+    if (vtkGenericDataArrayLookupHelper_detail::isnan(elem))
     {
-      ids->Allocate(static_cast<vtkIdType>(indices->size()));
-      for (auto index : *indices)
+      ids->Allocate(static_cast<vtkIdType>(this->NanIndices.size()));
+      for (auto index : this->NanIndices)
       {
         ids->InsertNextId(index);
       }
+      return;
     }
+    auto first = std::lower_bound(
+      this->ValueIndex.begin(), this->ValueIndex.end(), elem, LowerThanValue{});
+    auto last = std::upper_bound(first, this->ValueIndex.end(), elem, GreaterThanValue{});
+    ids->SetNumberOfIds(static_cast<vtkIdType>(last - first));
+    std::transform(first, last, ids->begin(), [](const Entry& entry) { return entry.Index; });
+  }
+
+  /**
+   * Look up the index of the first occurrence of each of the numValues values, -1 when a value
+   * is not found. The lookups are run in parallel once the index is up to date.
+   */
+  void LookupValues(const ValueType* values, vtkIdType numValues, vtkIdType* indices)
+  {
+    this->UpdateLookup();
+    vtkGenericDataArrayLookupHelper_detail::ParallelFor(0, numValues, 0,
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        for (vtkIdType i = begin; i < end; ++i)
+        {
+          indices[i] = this->FindFirstIndex(values[i]);
+        }
+      });
   }
 
   ///@{
@@ -97,8 +164,9 @@ public:
    */
   void ClearLookup()
   {
-    this->ValueMap.clear();
-    this->NanIndices.clear();
+    std::vector<Entry>().swap(this->ValueIndex);
+    std::vector<vtkIdType>().swap(this->NanIndices);
+    this->NumberOfIndexedValues = 0;
   }
   ///@}
 
@@ -106,47 +174,114 @@ private:
   vtkGenericDataArrayLookupHelper(const vtkGenericDataArrayLookupHelper&) = delete;
   void operator=(const vtkGenericDataArrayLookupHelper&) = delete;
 
+  // The index is the list of the (value, index) pairs of the array sorted by value, then by
+  // index, so that the indices of a value are contiguous and increasing. NaN values, which do not
+  // compare equal to themselves, are listed apart in NanIndices.
+  struct Entry
+  {
+    ValueType Value;
+    vtkIdType Index;
+  };
+
+  struct LowerThanValue
+  {
+    bool operator()(const Entry& entry, ValueType value) const { return entry.Value < value; }
+  };
+
+  struct GreaterThanValue
+  {
+    bool operator()(ValueType value, const Entry& entry) const { return value < entry.Value; }
+  };
+
+  // Orders the NaN values last.
+  struct EntryLess
+  {
+    bool operator()(const Entry& a, const Entry& b) const
+    {
+      const bool aIsNan = vtkGenericDataArrayLookupHelper_detail::isnan(a.Value);
+      const bool bIsNan = vtkGenericDataArrayLookupHelper_detail::isnan(b.Value);
+      if (aIsNan || bIsNan)
+      {
+        return aIsNan == bIsNan ? a.Index < b.Index : bIsNan;
+      }
+      return a.Value < b.Value || (!(b.Value < a.Value) && a.Index < b.Index);
+    }
+  };
+
+  // Builds the index on the first lookup. The values appended since the last lookup, which is
+  // the case when the array was only grown with the Insert methods, are indexed and merged into
+  // the existing index. DataChanged() has to be called for any other modification.
   void UpdateLookup()
   {
-    if (!this->AssociatedArray || (this->AssociatedArray->GetNumberOfTuples() < 1) ||
-      (!this->ValueMap.empty() || !this->NanIndices.empty()))
+    if (!this->AssociatedArray)
     {
       return;
     }
-
-    vtkIdType num = this->AssociatedArray->GetNumberOfValues();
-    this->ValueMap.reserve(num);
-    for (vtkIdType i = 0; i < num; ++i)
+    const vtkIdType num = this->AssociatedArray->GetNumberOfValues();
+    if (num < this->NumberOfIndexedValues)
+    {
+      this->ClearLookup();
+    }
+    if (num == this->NumberOfIndexedValues)
     {
-      auto value = this->AssociatedArray->GetValue(i);
-      if (vtkGenericDataArrayLookupHelper_detail::isnan(value))
+      return;
+    }
+
+    const vtkIdType offset = this->NumberOfIndexedValues;
+    std::vector<Entry> entries(static_cast<std::size_t>(num - offset));
+    ArrayTypeT* array = this->AssociatedArray;
+    vtkGenericDataArrayLookupHelper_detail::ParallelFor(offset, num, 0,
+      [&](vtkIdType begin, vtkIdType end)
       {
-        NanIndices.push_back(i);
-      }
-      this->ValueMap[value].push_back(i);
+        for (vtkIdType i = begin; i < end; ++i)
+        {
+          entries[i - offset] = Entry{ array->GetValue(i), i };
+        }
+      });
+    vtkGenericDataArrayLookupHelper_detail::ParallelSort(
+      entries.begin(), entries.end(), EntryLess{});
+
+    // the NaN values are at the end, with increasing indices
+    auto nanBegin = std::partition_point(entries.begin(), entries.end(),
+      [](const Entry& entry)
+      { return !vtkGenericDataArrayLookupHelper_detail::isnan(entry.Value); });
+    for (auto it = nanBegin; it != entries.end(); ++it)
+    {
+      this->NanIndices.push_back(it->Index);
     }
-  }
+    entries.erase(nanBegin, entries.end());
 
-  // Return a pointer to the relevant vector of indices if specified value was
-  // found in the array.
-  std::vector<vtkIdType>* FindIndexVec(ValueType value)
-  {
-    std::vector<vtkIdType>* indices{ nullptr };
-    if (vtkGenericDataArrayLookupHelper_detail::isnan(value) && !this->NanIndices.empty())
+    if (this->ValueIndex.empty())
+    {
+      this->ValueIndex.swap(entries);
+    }
+    else
     {
-      indices = &this->NanIndices;
+      // the appended indices are greater than the indexed ones, so they stay after them
+      const auto middle = static_cast<std::ptrdiff_t>(this->ValueIndex.size());
+      this->ValueIndex.insert(this->ValueIndex.end(), entries.begin(), entries.end());
+      std::inplace_merge(this->ValueIndex.begin(), this->ValueIndex.begin() + middle,
+        this->ValueIndex.end(), EntryLess{});
     }
-    const auto& pos = this->ValueMap.find(value);
-    if (pos != this->ValueMap.end())
+    this->NumberOfIndexedValues = num;
+  }
+
+  // Return the smallest index of the value in the array, -1 if it is not found.
+  vtkIdType FindFirstIndex(ValueType value) const
+  {
+    if (vtkGenericDataArrayLookupHelper_detail::isnan(value))
     {
-      indices = &pos->second;
+      return this->NanIndices.empty() ? -1 : this->NanIndices.front();
     }
-    return indices;
+    auto it =
+      std::lower_bound(this->ValueIndex.begin(), this->ValueIndex.end(), value, LowerThanValue{});
+    return it != this->ValueIndex.end() && !(value < it->Value) ? it->Index : -1;
   }
 
   ArrayTypeT* AssociatedArray{ nullptr };
-  std::unordered_map<ValueType, std::vector<vtkIdType>> ValueMap;
+  std::vector<Entry> ValueIndex;
   std::vector<vtkIdType> NanIndices;
+  vtkIdType NumberOfIndexedValues{ 0 };
 };
 
 VTK_ABI_NAMESPACE_END
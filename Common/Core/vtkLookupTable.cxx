@@ -7,6 +7,7 @@
 #include "vtkMath.h"
 #include "vtkMathConfigure.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
 #include "vtkStringArray.h"
 #include "vtkVariantArray.h"
 
@@ -1180,6 +1181,21 @@ void vtkLookupTableIndexedMapData(vtkLookupTable* self, const T* input, unsigned
   } // alpha blending
 }
 
+//------------------------------------------------------------------------------
+// Every value is mapped independently, so chunks of values are mapped in
+// parallel with the serial kernels above, which keeps the output identical.
+// The output format is also the number of output components.
+template <class T, class Kernel>
+void vtkLookupTableMapInParallel(
+  T* input, unsigned char* output, int length, int inIncr, int outFormat, Kernel&& kernel)
+{
+  vtkSMPTools::For(0, length, 10000,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      kernel(input + begin * inIncr, output + begin * outFormat, static_cast<int>(end - begin));
+    });
+}
+
 } // end anonymous namespace
 
 VTK_ABI_NAMESPACE_BEGIN
@@ -1189,6 +1205,9 @@ void vtkLookupTable::MapScalarsThroughTable2(void* input, unsigned char* output,
 {
   if (this->IndexedLookup)
   {
+    auto indexedMap = [&](const auto* in, unsigned char* out, int length)
+    { vtkLookupTableIndexedMapData(this, in, out, length, inputIncrement, outputFormat); };
+
     switch (inputDataType)
     {
       case VTK_BIT:
@@ -1202,19 +1221,19 @@ void vtkLookupTable::MapScalarsThroughTable2(void* input, unsigned char* output,
         {
           newInput->SetValue(i, bitArray->GetValue(id));
         }
-        vtkLookupTableIndexedMapData(
-          this, newInput->GetPointer(0), output, numberOfValues, inputIncrement, outputFormat);
+        vtkLookupTableMapInParallel(newInput->GetPointer(0), output, numberOfValues,
+          inputIncrement, outputFormat, indexedMap);
         newInput->Delete();
         bitArray->Delete();
       }
       break;
 
-        vtkTemplateMacro(vtkLookupTableIndexedMapData(
-          this, static_cast<VTK_TT*>(input), output, numberOfValues, inputIncrement, outputFormat));
+        vtkTemplateMacro(vtkLookupTableMapInParallel(static_cast<VTK_TT*>(input), output,
+          numberOfValues, inputIncrement, outputFormat, indexedMap));
 
       case VTK_STRING:
-        vtkLookupTableIndexedMapData(this, static_cast<vtkStdString*>(input), output,
-          numberOfValues, inputIncrement, outputFormat);
+        vtkLookupTableMapInParallel(static_cast<vtkStdString*>(input), output, numberOfValues,
+          inputIncrement, outputFormat, indexedMap);
         break;
 
       default:
@@ -1227,6 +1246,13 @@ void vtkLookupTable::MapScalarsThroughTable2(void* input, unsigned char* output,
     TableParameters p;
     p.NumColors = this->GetNumberOfColors();
 
+    // vtkLookupTableMapData() updates the parameters, each chunk uses its own
+    auto map = [&](auto* in, unsigned char* out, int length)
+    {
+      TableParameters chunkParameters = p;
+      vtkLookupTableMapData(this, in, out, length, inputIncrement, outputFormat, chunkParameters);
+    };
+
     switch (inputDataType)
     {
       case VTK_BIT:
@@ -1240,15 +1266,15 @@ void vtkLookupTable::MapScalarsThroughTable2(void* input, unsigned char* output,
         {
           newInput->SetValue(i, bitArray->GetValue(id));
         }
-        vtkLookupTableMapData(
-          this, newInput->GetPointer(0), output, numberOfValues, inputIncrement, outputFormat, p);
+        vtkLookupTableMapInParallel(
+          newInput->GetPointer(0), output, numberOfValues, inputIncrement, outputFormat, map);
         newInput->Delete();
         bitArray->Delete();
       }
       break;
 
-        vtkTemplateMacro(vtkLookupTableMapData(this, static_cast<VTK_TT*>(input), output,
-          numberOfValues, inputIncrement, outputFormat, p));
+        vtkTemplateMacro(vtkLookupTableMapInParallel(static_cast<VTK_TT*>(input), output,
+          numberOfValues, inputIncrement, outputFormat, map));
       default:
         vtkErrorMacro(<< "MapScalarsThroughTable2: Unknown input ScalarType");
         return;
@@ -0,0 +1,116 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#ifndef vtkQuantizedImplicitBackend_h
+#define vtkQuantizedImplicitBackend_h
+
+/**
+ * \class vtkQuantizedImplicitBackend
+ *
+ * A backend for the `vtkImplicitArray` framework storing the values of a given data array as
+ * 16 bit integer codes, with a shift and a scale per component:
+ * value = Shift[component] + Scale[component] * code.
+ *
+ * The shift and the scale of a component map the finite range of the component on the 65536
+ * codes, so the values are read back with an error of at most half a quantization step, i.e.
+ * `GetScale(component) / 2`. It halves the memory used by float arrays and quarters the memory
+ * used by double arrays, which is well suited to normals, scalars used for coloring or other
+ * fields that are only visualized. Non finite values are not represented: NaNs are read back as
+ * the minimum of the component, infinities as its extrema. The rendering code reads the
+ * dequantized values like those of any other array, so the buffers it uploads to the GPU are
+ * not smaller.
+ *
+ * The codes are computed from the values of the given array at construction time, which can be
+ * released afterwards.
+ *
+ * An example of potential usage in a `vtkImplicitArray`:
+ * ```
+ * vtkNew<vtkFloatArray> normals;
+ * normals->SetNumberOfComponents(3);
+ * normals->SetNumberOfTuples(100000);
+ * ...
+ *
+ * vtkNew<vtkImplicitArray<vtkQuantizedImplicitBackend<float>>> quantized; // More compact with
+ *                                                                        // `vtkQuantizedArray`
+ * quantized->SetBackend(std::make_shared<vtkQuantizedImplicitBackend<float>>(normals));
+ * quantized->SetNumberOfComponents(3);
+ * quantized->SetNumberOfTuples(100000);
+ * CHECK(std::abs(quantized->GetComponent(42, 1) - normals->GetComponent(42, 1)) <=
+ *   quantized->GetBackend()->GetScale(1) / 2);
+ * ```
+ *
+ * @sa
+ * vtkImplicitArray, vtkQuantizedArray, vtkScaledSOADataArrayTemplate
+ */
+
+#include "vtkCommonCoreModule.h"
+
+#include "vtkType.h"
+
+#include <memory>
+
+VTK_ABI_NAMESPACE_BEGIN
+class vtkDataArray;
+template <typename ValueType>
+class VTKCOMMONCORE_EXPORT vtkQuantizedImplicitBackend final
+{
+public:
+  /**
+   * Constructor
+   * @param array array whose values are quantized
+   */
+  vtkQuantizedImplicitBackend(vtkDataArray* array);
+  ~vtkQuantizedImplicitBackend();
+
+  /**
+   * Indexing operation for the quantized array respecting the backend expectations of
+   * `vtkImplicitArray`
+   */
+  ValueType operator()(vtkIdType idx) const;
+
+  /**
+   * Returns the smallest integer memory size in KiB needed to store the array.
+   * Used to implement GetActualMemorySize on `vtkQuantizedImplicitBackend`.
+   */
+  unsigned long getMemorySize() const;
+
+  ///@{
+  /**
+   * The value of the code 0 and the difference between the values of two consecutive codes for
+   * the given component.
+   */
+  double GetShift(int component) const;
+  double GetScale(int component) const;
+  ///@}
+
+private:
+  struct Internals;
+  std::unique_ptr<Internals> Internal;
+};
+VTK_ABI_NAMESPACE_END
+
+#endif // vtkQuantizedImplicitBackend_h
+
+#if defined(VTK_QUANTIZED_BACKEND_INSTANTIATING)
+
+#define VTK_INSTANTIATE_QUANTIZED_BACKEND(ValueType)                                               \
+  VTK_ABI_NAMESPACE_BEGIN                                                                          \
+  template class VTKCOMMONCORE_EXPORT vtkQuantizedImplicitBackend<ValueType>;                      \
+  VTK_ABI_NAMESPACE_END
+
+#elif defined(VTK_USE_EXTERN_TEMPLATE)
+
+#ifndef VTK_QUANTIZED_BACKEND_TEMPLATE_EXTERN
+#define VTK_QUANTIZED_BACKEND_TEMPLATE_EXTERN
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable : 4910) // extern and dllexport incompatible
+#endif
+VTK_ABI_NAMESPACE_BEGIN
+vtkExternTemplateMacro(extern template class VTKCOMMONCORE_EXPORT vtkQuantizedImplicitBackend);
+VTK_ABI_NAMESPACE_END
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+#endif // VTK_QUANTIZED_BACKEND_TEMPLATE_EXTERN
+
+#endif
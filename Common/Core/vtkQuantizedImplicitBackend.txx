@@ -0,0 +1,143 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkQuantizedImplicitBackend.h"
+
+#include "vtkArrayDispatch.h"
+#include "vtkDataArray.h"
+#include "vtkDataArrayRange.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace vtkQuantizedImplicitBackendDetail
+{
+VTK_ABI_NAMESPACE_BEGIN
+using CodeType = unsigned short;
+constexpr double MaximumCode = std::numeric_limits<CodeType>::max();
+
+//-----------------------------------------------------------------------
+struct QuantizeWorker
+{
+  template <typename ArrayT>
+  void operator()(ArrayT* array, const std::vector<double>& shift,
+    const std::vector<double>& inverseScale, std::vector<CodeType>& codes)
+  {
+    const int numComps = array->GetNumberOfComponents();
+    vtkSMPTools::For(0, array->GetNumberOfTuples(),
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        CodeType* code = codes.data() + begin * numComps;
+        for (const auto tuple : vtk::DataArrayTupleRange(array, begin, end))
+        {
+          for (int comp = 0; comp < numComps; ++comp, ++code)
+          {
+            const double q =
+              (static_cast<double>(tuple[comp]) - shift[comp]) * inverseScale[comp] + 0.5;
+            // comparisons with NaN are false, so NaNs get the code 0
+            *code = q > 0.0 ? static_cast<CodeType>(std::min(q, MaximumCode)) : 0;
+          }
+        }
+      });
+  }
+};
+VTK_ABI_NAMESPACE_END
+} // namespace vtkQuantizedImplicitBackendDetail
+
+VTK_ABI_NAMESPACE_BEGIN
+//-----------------------------------------------------------------------
+template <typename ValueType>
+struct vtkQuantizedImplicitBackend<ValueType>::Internals
+{
+  Internals(vtkDataArray* array)
+  {
+    if (!array)
+    {
+      vtkErrorWithObjectMacro(nullptr, "Cannot quantize a nullptr array");
+      return;
+    }
+    this->NumberOfComponents = array->GetNumberOfComponents();
+    this->Shift.resize(this->NumberOfComponents, 0.0);
+    this->Scale.resize(this->NumberOfComponents, 0.0);
+    std::vector<double> inverseScale(this->NumberOfComponents, 0.0);
+    for (int comp = 0; comp < this->NumberOfComponents; ++comp)
+    {
+      double range[2];
+      array->GetFiniteRange(range, comp);
+      if (range[0] > range[1])
+      {
+        // no finite value in this component
+        continue;
+      }
+      this->Shift[comp] = range[0];
+      this->Scale[comp] = (range[1] - range[0]) / vtkQuantizedImplicitBackendDetail::MaximumCode;
+      inverseScale[comp] = this->Scale[comp] > 0.0 ? 1.0 / this->Scale[comp] : 0.0;
+    }
+
+    this->Codes.resize(array->GetNumberOfValues());
+    vtkQuantizedImplicitBackendDetail::QuantizeWorker worker;
+    if (!vtkArrayDispatch::Dispatch::Execute(array, worker, this->Shift, inverseScale, this->Codes))
+    {
+      worker(array, this->Shift, inverseScale, this->Codes);
+    }
+  }
+
+  int NumberOfComponents = 1;
+  std::vector<double> Shift;
+  std::vector<double> Scale;
+  std::vector<vtkQuantizedImplicitBackendDetail::CodeType> Codes;
+};
+
+//-----------------------------------------------------------------------
+template <typename ValueType>
+vtkQuantizedImplicitBackend<ValueType>::vtkQuantizedImplicitBackend(vtkDataArray* array)
+  : Internal(std::unique_ptr<Internals>(new Internals(array)))
+{
+}
+
+//-----------------------------------------------------------------------
+template <typename ValueType>
+vtkQuantizedImplicitBackend<ValueType>::~vtkQuantizedImplicitBackend() = default;
+
+//-----------------------------------------------------------------------
+template <typename ValueType>
+ValueType vtkQuantizedImplicitBackend<ValueType>::operator()(vtkIdType idx) const
+{
+  const int comp = static_cast<int>(idx % this->Internal->NumberOfComponents);
+  double value =
+    this->Internal->Shift[comp] + this->Internal->Scale[comp] * this->Internal->Codes[idx];
+  if (std::is_integral<ValueType>::value)
+  {
+    value = std::floor(value + 0.5);
+  }
+  return static_cast<ValueType>(value);
+}
+
+//-----------------------------------------------------------------------
+template <typename ValueType>
+unsigned long vtkQuantizedImplicitBackend<ValueType>::getMemorySize() const
+{
+  const std::size_t bytes =
+    this->Internal->Codes.size() * sizeof(vtkQuantizedImplicitBackendDetail::CodeType) +
+    2 * this->Internal->NumberOfComponents * sizeof(double);
+  return static_cast<unsigned long>(std::ceil(bytes / 1024.0));
+}
+
+//-----------------------------------------------------------------------
+template <typename ValueType>
+double vtkQuantizedImplicitBackend<ValueType>::GetShift(int component) const
+{
+  return this->Internal->Shift[component];
+}
+
+//-----------------------------------------------------------------------
+template <typename ValueType>
+double vtkQuantizedImplicitBackend<ValueType>::GetScale(int component) const
+{
+  return this->Internal->Scale[component];
+}
+VTK_ABI_NAMESPACE_END
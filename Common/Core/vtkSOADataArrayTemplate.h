@@ -250,6 +250,13 @@ protected:
    */
   bool ReallocateTuples(vtkIdType numTuples);
 
+  /**
+   * Zero-initialize the values in [begin, end) of the buffers with a vtkSMPTools loop over the
+   * tuples when vtkDataArray::GetParallelFirstTouch() is on. The indices are tuple indices with the
+   * SOA storage and value indices with the AOS storage.
+   */
+  void FirstTouch(vtkIdType begin, vtkIdType end);
+
   std::vector<vtkBuffer<ValueType>*> Data;
   vtkBuffer<ValueType>* AoSData;
 
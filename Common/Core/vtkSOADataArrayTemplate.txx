@@ -14,7 +14,9 @@
 
 #include "vtkArrayIteratorTemplate.h"
 #include "vtkBuffer.h"
+#include "vtkSMPTools.h"
 
+#include <algorithm>
 #include <array>
 #include <cassert>
 
@@ -355,6 +357,7 @@ bool vtkSOADataArrayTemplate<ValueType>::AllocateTuples(vtkIdType numTuples)
         return false;
       }
     }
+    this->FirstTouch(0, numTuples);
   }
   else
   {
@@ -362,6 +365,7 @@ bool vtkSOADataArrayTemplate<ValueType>::AllocateTuples(vtkIdType numTuples)
     {
       return false;
     }
+    this->FirstTouch(0, this->AoSData->GetSize());
   }
   return true;
 }
@@ -372,6 +376,7 @@ bool vtkSOADataArrayTemplate<ValueType>::ReallocateTuples(vtkIdType numTuples)
 {
   if (this->StorageType == StorageTypeEnum::SOA)
   {
+    const vtkIdType oldNumTuples = this->Data.empty() ? 0 : this->Data[0]->GetSize();
     for (size_t cc = 0, max = this->Data.size(); cc < max; ++cc)
     {
       if (!this->Data[cc]->Reallocate(numTuples))
@@ -379,17 +384,61 @@ bool vtkSOADataArrayTemplate<ValueType>::ReallocateTuples(vtkIdType numTuples)
         return false;
       }
     }
+    this->FirstTouch(oldNumTuples, numTuples);
   }
   else
   {
+    const vtkIdType oldSize = this->AoSData->GetSize();
     if (!this->AoSData->Reallocate(numTuples * this->GetNumberOfComponents()))
     {
       return false;
     }
+    this->FirstTouch(oldSize, this->AoSData->GetSize());
   }
   return true;
 }
 
+//-----------------------------------------------------------------------------
+template <class ValueType>
+void vtkSOADataArrayTemplate<ValueType>::FirstTouch(vtkIdType begin, vtkIdType end)
+{
+  const vtkIdType numComps = this->GetNumberOfComponents();
+  const bool soa = this->StorageType == StorageTypeEnum::SOA;
+  if (!vtkDataArray::GetParallelFirstTouch() ||
+    (end - begin) * static_cast<vtkIdType>(sizeof(ValueType)) * (soa ? numComps : 1) <
+      vtkDataArray::GetFirstTouchThreshold())
+  {
+    return;
+  }
+  // the values are partitioned by tuples, like in the loops of the filters over points or cells
+  if (soa)
+  {
+    std::vector<ValueType*> buffers;
+    for (vtkBuffer<ValueType>* buffer : this->Data)
+    {
+      buffers.push_back(buffer->GetBuffer());
+    }
+    vtkSMPTools::For(begin, end,
+      [&](vtkIdType beginTuple, vtkIdType endTuple)
+      {
+        for (ValueType* buffer : buffers)
+        {
+          std::fill(buffer + beginTuple, buffer + endTuple, ValueType());
+        }
+      });
+  }
+  else
+  {
+    ValueType* data = this->AoSData->GetBuffer();
+    vtkSMPTools::For(begin / numComps, (end + numComps - 1) / numComps,
+      [&](vtkIdType beginTuple, vtkIdType endTuple)
+      {
+        std::fill(data + std::max(beginTuple * numComps, begin),
+          data + std::min(endTuple * numComps, end), ValueType());
+      });
+  }
+}
+
 //-----------------------------------------------------------------------------
 template <class ValueType>
 void* vtkSOADataArrayTemplate<ValueType>::GetVoidPointer(vtkIdType valueIdx)
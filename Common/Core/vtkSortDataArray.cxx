@@ -13,7 +13,12 @@
 #include "vtkStringArray.h"
 #include "vtkVariant.h"
 #include "vtkVariantArray.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
 #include <functional> //std::greater
+#include <vector>
 
 //------------------------------------------------------------------------------
 
@@ -441,6 +446,219 @@ void vtkSortDataArray::SortArrayByComponent(vtkAbstractArray* arr, int k, int di
   delete[] idx;
 }
 
+VTK_ABI_NAMESPACE_END
+
+namespace
+{
+// Keys sorted by a single task.
+constexpr vtkIdType RADIX_BLOCK_SIZE = 65536;
+constexpr int RADIX_BUCKETS = 256;
+
+//------------------------------------------------------------------------------
+// Maps a floating point value to an unsigned integer with the same order:
+// negative values have all their bits flipped, positive ones their sign bit.
+template <typename BitsT, typename RealT>
+BitsT RealToOrderedBits(RealT value)
+{
+  static_assert(sizeof(BitsT) == sizeof(RealT), "Mismatched key sizes");
+  constexpr BitsT signBit = BitsT(1) << (sizeof(BitsT) * 8 - 1);
+  if (value == 0)
+  {
+    value = 0; // -0 and +0 compare equal
+  }
+  BitsT bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return (bits & signBit) ? static_cast<BitsT>(~bits) : static_cast<BitsT>(bits | signBit);
+}
+
+template <typename RealT, typename BitsT>
+RealT OrderedBitsToReal(BitsT bits)
+{
+  constexpr BitsT signBit = BitsT(1) << (sizeof(BitsT) * 8 - 1);
+  bits = (bits & signBit) ? static_cast<BitsT>(bits ^ signBit) : static_cast<BitsT>(~bits);
+  RealT value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+//------------------------------------------------------------------------------
+// Least significant digit radix sort, one byte per pass. Every pass counts
+// the digits of fixed blocks of keys in parallel, then scatters the blocks in
+// parallel at offsets that keep the sort stable.
+template <typename RealT, typename BitsT>
+void RadixSortRealKeys(RealT* keys, vtkIdType* ids, vtkIdType numKeys)
+{
+  std::vector<BitsT> bits(numKeys);
+  std::vector<BitsT> sortedBits(numKeys);
+  std::vector<vtkIdType> sortedIds(numKeys);
+  vtkSMPTools::For(0, numKeys,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        bits[i] = RealToOrderedBits<BitsT>(keys[i]);
+      }
+    });
+
+  const vtkIdType numBlocks = (numKeys + RADIX_BLOCK_SIZE - 1) / RADIX_BLOCK_SIZE;
+  std::vector<vtkIdType> offsets(numBlocks * RADIX_BUCKETS);
+  BitsT* srcBits = bits.data();
+  BitsT* dstBits = sortedBits.data();
+  vtkIdType* srcIds = ids;
+  vtkIdType* dstIds = sortedIds.data();
+
+  for (unsigned int shift = 0; shift < sizeof(BitsT) * 8; shift += 8)
+  {
+    std::fill(offsets.begin(), offsets.end(), 0);
+    vtkSMPTools::For(0, numBlocks,
+      [&](vtkIdType firstBlock, vtkIdType lastBlock)
+      {
+        for (vtkIdType block = firstBlock; block < lastBlock; ++block)
+        {
+          vtkIdType* counts = offsets.data() + block * RADIX_BUCKETS;
+          const vtkIdType end = std::min(numKeys, (block + 1) * RADIX_BLOCK_SIZE);
+          for (vtkIdType i = block * RADIX_BLOCK_SIZE; i < end; ++i)
+          {
+            counts[(srcBits[i] >> shift) & 0xff]++;
+          }
+        }
+      });
+
+    // turn the counts into the position of every digit of every block
+    vtkIdType position = 0;
+    bool singleDigit = false;
+    for (int digit = 0; digit < RADIX_BUCKETS; ++digit)
+    {
+      const vtkIdType digitStart = position;
+      for (vtkIdType block = 0; block < numBlocks; ++block)
+      {
+        const vtkIdType count = offsets[block * RADIX_BUCKETS + digit];
+        offsets[block * RADIX_BUCKETS + digit] = position;
+        position += count;
+      }
+      singleDigit |= (position - digitStart == numKeys);
+    }
+    if (singleDigit)
+    {
+      // all keys share this digit, the pass would not move anything
+      continue;
+    }
+
+    vtkSMPTools::For(0, numBlocks,
+      [&](vtkIdType firstBlock, vtkIdType lastBlock)
+      {
+        for (vtkIdType block = firstBlock; block < lastBlock; ++block)
+        {
+          vtkIdType* positions = offsets.data() + block * RADIX_BUCKETS;
+          const vtkIdType end = std::min(numKeys, (block + 1) * RADIX_BLOCK_SIZE);
+          for (vtkIdType i = block * RADIX_BLOCK_SIZE; i < end; ++i)
+          {
+            const vtkIdType dst = positions[(srcBits[i] >> shift) & 0xff]++;
+            dstBits[dst] = srcBits[i];
+            dstIds[dst] = srcIds[i];
+          }
+        }
+      });
+    std::swap(srcBits, dstBits);
+    std::swap(srcIds, dstIds);
+  }
+
+  vtkSMPTools::For(0, numKeys,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        keys[i] = OrderedBitsToReal<RealT>(srcBits[i]);
+      }
+      if (srcIds != ids)
+      {
+        std::copy(srcIds + begin, srcIds + end, ids + begin);
+      }
+    });
+}
+
+//------------------------------------------------------------------------------
+// Stable insertion sort of [begin, end) giving up after maxMoves moves, in
+// which case the keys are left partially sorted.
+template <typename RealT>
+bool InsertionSortRealKeys(
+  RealT* keys, vtkIdType* ids, vtkIdType begin, vtkIdType end, vtkIdType maxMoves)
+{
+  vtkIdType moves = 0;
+  for (vtkIdType i = begin + 1; i < end; ++i)
+  {
+    const RealT key = keys[i];
+    const vtkIdType id = ids[i];
+    vtkIdType j = i;
+    for (; j > begin && key < keys[j - 1]; --j)
+    {
+      keys[j] = keys[j - 1];
+      ids[j] = ids[j - 1];
+      ++moves;
+    }
+    keys[j] = key;
+    ids[j] = id;
+    if (moves > maxMoves)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+template <typename RealT, typename BitsT>
+void SortRealKeysImpl(RealT* keys, vtkIdType* ids, vtkIdType numKeys, bool nearlySorted)
+{
+  if (numKeys < 2)
+  {
+    return;
+  }
+
+  if (nearlySorted)
+  {
+    // Sort the blocks in parallel, then the whole array, which only moves
+    // the keys crossing block boundaries when the keys were nearly sorted.
+    const vtkIdType numBlocks = (numKeys + RADIX_BLOCK_SIZE - 1) / RADIX_BLOCK_SIZE;
+    std::atomic<bool> sorted(true);
+    vtkSMPTools::For(0, numBlocks,
+      [&](vtkIdType firstBlock, vtkIdType lastBlock)
+      {
+        for (vtkIdType block = firstBlock; block < lastBlock && sorted; ++block)
+        {
+          const vtkIdType begin = block * RADIX_BLOCK_SIZE;
+          const vtkIdType end = std::min(numKeys, begin + RADIX_BLOCK_SIZE);
+          if (!InsertionSortRealKeys(keys, ids, begin, end, 4 * (end - begin)))
+          {
+            sorted = false;
+          }
+        }
+      });
+    if (sorted && InsertionSortRealKeys(keys, ids, 0, numKeys, numKeys))
+    {
+      return;
+    }
+  }
+
+  RadixSortRealKeys<RealT, BitsT>(keys, ids, numKeys);
+}
+} // anonymous namespace
+
+VTK_ABI_NAMESPACE_BEGIN
+//------------------------------------------------------------------------------
+void vtkSortDataArray::SortRealKeys(
+  float* keys, vtkIdType* ids, vtkIdType numKeys, bool nearlySorted)
+{
+  SortRealKeysImpl<float, vtkTypeUInt32>(keys, ids, numKeys, nearlySorted);
+}
+
+//------------------------------------------------------------------------------
+void vtkSortDataArray::SortRealKeys(
+  double* keys, vtkIdType* ids, vtkIdType numKeys, bool nearlySorted)
+{
+  SortRealKeysImpl<double, vtkTypeUInt64>(keys, ids, numKeys, nearlySorted);
+}
+
 //------------------------------------------------------------------------------
 void vtkSortDataArray::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -129,6 +129,23 @@ public:
    */
   static void SortArrayByComponent(vtkAbstractArray* arr, int k, int dir);
 
+  ///@{
+  /**
+   * Sorts numKeys floating point keys in ascending order and applies the
+   * same permutation to ids. This is a stable, parallel radix sort on the
+   * bit patterns of the keys, meant for large arrays of depths or distances
+   * as used for visibility sorting. When nearlySorted is true the keys are
+   * expected to be close to their final order, e.g. depths computed in the
+   * order of the previous frame after a small camera motion, and an
+   * insertion sort is tried first, falling back to the radix sort when too
+   * many keys are out of order. NaN keys are not supported.
+   */
+  static void SortRealKeys(
+    float* keys, vtkIdType* ids, vtkIdType numKeys, bool nearlySorted = false);
+  static void SortRealKeys(
+    double* keys, vtkIdType* ids, vtkIdType numKeys, bool nearlySorted = false);
+  ///@}
+
   ///@{
   /**
    * The following are general functions which can be used to produce an
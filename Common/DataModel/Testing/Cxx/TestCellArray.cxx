@@ -14,6 +14,7 @@
 #include "vtkNew.h"
 #include "vtkPolyData.h"
 #include "vtkQuad.h"
+#include "vtkSMPTools.h"
 #include "vtkSetGet.h"
 #include "vtkSmartPointer.h"
 #include "vtkTypeInt32Array.h"
@@ -409,6 +410,138 @@ void TestSetData(vtkSmartPointer<vtkCellArray> cellArray)
   TestSetDataImpl<vtkLongLongArray>(cellArray, false);
 }
 
+// Checks the cell arrays of quads set from a connectivity array only, with
+// implicit offsets.
+void ValidateFixedSizeCellArray(vtkCellArray* cellArray, vtkIdType numCells)
+{
+  TEST_ASSERT(cellArray->GetNumberOfCells() == numCells);
+  TEST_ASSERT(cellArray->GetNumberOfOffsets() == numCells + 1);
+  TEST_ASSERT(cellArray->GetOffset(numCells) == 4 * numCells);
+  TEST_ASSERT(cellArray->IsHomogeneous() == 4);
+  TEST_ASSERT(cellArray->GetMaxCellSize() == 4);
+
+  vtkIdType cellId = 0;
+  vtkIdType npts;
+  const vtkIdType* pts;
+  auto it = vtk::TakeSmartPointer(cellArray->NewIterator());
+  for (it->GoToFirstCell(); !it->IsDoneWithTraversal(); it->GoToNextCell(), ++cellId)
+  {
+    it->GetCurrentCell(npts, pts);
+    TEST_ASSERT(npts == 4);
+    TEST_ASSERT(cellArray->GetCellSize(cellId) == 4);
+    TEST_ASSERT(cellArray->GetOffset(cellId) == 4 * cellId);
+    for (vtkIdType i = 0; i < npts; ++i)
+    {
+      TEST_ASSERT(pts[i] == 4 * cellId + i);
+      TEST_ASSERT(cellArray->GetCellPointAtId(cellId, i) == 4 * cellId + i);
+    }
+  }
+  TEST_ASSERT(cellId == numCells);
+}
+
+void TestSetDataFixedSize(vtkSmartPointer<vtkCellArray> cellArray)
+{
+  vtkLogScopeFunction(INFO);
+
+  const vtkIdType numCells = 100;
+  vtkSmartPointer<vtkDataArray> conn =
+    vtk::TakeSmartPointer(cellArray->GetConnectivityArray()->NewInstance());
+  conn->SetNumberOfTuples(4 * numCells);
+  for (vtkIdType i = 0; i < 4 * numCells; ++i)
+  {
+    conn->SetComponent(i, 0, static_cast<double>(i));
+  }
+
+  TEST_ASSERT(cellArray->SetData(4, conn));
+  TEST_ASSERT(cellArray->IsStorageFixedSize());
+  TEST_ASSERT(cellArray->GetConnectivityArray()->GetVoidPointer(0) == conn->GetVoidPointer(0));
+  ValidateFixedSizeCellArray(cellArray, numCells);
+  // reading the cells does not create the offsets array
+  TEST_ASSERT(cellArray->IsStorageFixedSize());
+
+  // the copies and the conversions keep the offsets implicit
+  vtkNew<vtkCellArray> deepCopy;
+  deepCopy->DeepCopy(cellArray);
+  TEST_ASSERT(deepCopy->IsStorageFixedSize());
+  ValidateFixedSizeCellArray(deepCopy, numCells);
+  vtkNew<vtkCellArray> shallowCopy;
+  shallowCopy->ShallowCopy(cellArray);
+  TEST_ASSERT(shallowCopy->IsStorageFixedSize());
+  TEST_ASSERT(shallowCopy->GetConnectivityArray() == cellArray->GetConnectivityArray());
+  ValidateFixedSizeCellArray(shallowCopy, numCells);
+  TEST_ASSERT(deepCopy->ConvertTo32BitStorage() && deepCopy->IsStorageFixedSize());
+  TEST_ASSERT(!deepCopy->IsStorage64Bit());
+  TEST_ASSERT(deepCopy->ConvertTo64BitStorage() && deepCopy->IsStorageFixedSize());
+  TEST_ASSERT(deepCopy->IsStorage64Bit());
+  ValidateFixedSizeCellArray(deepCopy, numCells);
+
+  // as do the functors reading the cells through the accessors of the visit
+  // state, the appends and the memory size
+  const bool validCells = cellArray->Visit(
+    [&](auto& state)
+    {
+      bool valid = state.GetNumberOfCells() == numCells;
+      for (vtkIdType cellId = 0; cellId < state.GetNumberOfCells(); ++cellId)
+      {
+        const auto cellRange = state.GetCellRange(cellId);
+        valid = valid && state.GetCellSize(cellId) == 4 &&
+          state.GetBeginOffset(cellId) == 4 * cellId && cellRange.size() == 4 &&
+          cellRange[0] == 4 * cellId;
+      }
+      return valid;
+    });
+  TEST_ASSERT(validCells);
+  vtkNew<vtkCellArray> appended;
+  appended->Append(cellArray, 4 * numCells);
+  appended->Append(cellArray, 4 * numCells);
+  TEST_ASSERT(appended->GetNumberOfCells() == 2 * numCells);
+  TEST_ASSERT(appended->GetOffset(2 * numCells) == 8 * numCells);
+  TEST_ASSERT(appended->GetCellPointAtId(numCells + 1, 0) == 4 * numCells + 4);
+  TEST_ASSERT(appended->IsValid());
+  TEST_ASSERT(cellArray->GetActualMemorySize() > 0);
+  TEST_ASSERT(cellArray->IsStorageFixedSize());
+
+  // the offsets requested by several visitors at once are generated once
+  vtkNew<vtkCellArray> sharedCopy;
+  sharedCopy->DeepCopy(cellArray);
+  std::vector<vtkIdType> lastOffsets(8, 0);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(lastOffsets.size()),
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        lastOffsets[i] = sharedCopy->Visit([&](auto& state)
+          { return static_cast<vtkIdType>(state.GetOffsets()->GetValue(numCells)); });
+      }
+    });
+  TEST_ASSERT(!sharedCopy->IsStorageFixedSize());
+  TEST_ASSERT(std::count(lastOffsets.begin(), lastOffsets.end(), 4 * numCells) == 8);
+  ValidateFixedSizeCellArray(sharedCopy, numCells);
+
+  // the offsets array is created when requested
+  vtkDataArray* offsets = cellArray->GetOffsetsArray();
+  TEST_ASSERT(!cellArray->IsStorageFixedSize());
+  TEST_ASSERT(offsets->GetNumberOfTuples() == numCells + 1);
+  for (vtkIdType cellId = 0; cellId <= numCells; ++cellId)
+  {
+    TEST_ASSERT(offsets->GetComponent(cellId, 0) == 4 * cellId);
+  }
+  ValidateFixedSizeCellArray(cellArray, numCells);
+  TEST_ASSERT(cellArray->IsValid());
+
+  // or when the cells are modified
+  deepCopy->InsertNextCell({ 0, 1, 2 });
+  TEST_ASSERT(!deepCopy->IsStorageFixedSize());
+  TEST_ASSERT(deepCopy->GetNumberOfCells() == numCells + 1);
+  TEST_ASSERT(deepCopy->GetCellSize(numCells) == 3);
+  TEST_ASSERT(deepCopy->IsHomogeneous() == -1);
+
+  deepCopy->Reset();
+  TEST_ASSERT(!deepCopy->IsStorageFixedSize());
+  TEST_ASSERT(deepCopy->GetNumberOfCells() == 0);
+  TEST_ASSERT(deepCopy->IsValid());
+}
+
 struct TestIsStorage64BitImpl
 {
   template <typename CellStateT>
@@ -1378,6 +1511,7 @@ void RunTests(bool use64BitStorage)
   TestGetNumberOfConnectivityIds(NewCellArray(use64BitStorage));
   TestNewIterator(NewCellArray(use64BitStorage));
   TestSetData(NewCellArray(use64BitStorage));
+  TestSetDataFixedSize(NewCellArray(use64BitStorage));
   TestIsStorage64Bit(NewCellArray(use64BitStorage));
   TestUse32BitStorage(NewCellArray(use64BitStorage));
   TestUse64BitStorage(NewCellArray(use64BitStorage));
@@ -0,0 +1,197 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Checks that a vtkKdTree built with several threads has the same regions as a vtkKdTree built
+// serially, and that the batched queries of vtkKdTreePointLocator match the single queries.
+
+#include "vtkDoubleArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkKdTree.h"
+#include "vtkKdTreePointLocator.h"
+#include "vtkMath.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+vtkSmartPointer<vtkKdTree> BuildKdTree(vtkPoints* points, int numberOfThreads)
+{
+  auto kdTree = vtkSmartPointer<vtkKdTree>::New();
+  vtkSMPTools::LocalScope(vtkSMPTools::Config{ numberOfThreads },
+    [&]() { kdTree->BuildLocatorFromPoints(points); });
+  return kdTree;
+}
+
+std::vector<vtkIdType> GetSortedPointsInRegion(vtkKdTree* kdTree, int regionId)
+{
+  auto array = vtkSmartPointer<vtkIdTypeArray>::Take(kdTree->GetPointsInRegion(regionId));
+  std::vector<vtkIdType> ids(
+    array->GetPointer(0), array->GetPointer(0) + array->GetNumberOfValues());
+  std::sort(ids.begin(), ids.end());
+  return ids;
+}
+
+bool CompareKdTrees(vtkKdTree* serial, vtkKdTree* parallel)
+{
+  if (serial->GetNumberOfRegions() != parallel->GetNumberOfRegions())
+  {
+    std::cerr << "Got " << parallel->GetNumberOfRegions() << " regions instead of "
+              << serial->GetNumberOfRegions() << std::endl;
+    return false;
+  }
+  for (int regionId = 0; regionId < serial->GetNumberOfRegions(); ++regionId)
+  {
+    double bounds[6], parallelBounds[6], dataBounds[6], parallelDataBounds[6];
+    serial->GetRegionBounds(regionId, bounds);
+    parallel->GetRegionBounds(regionId, parallelBounds);
+    serial->GetRegionDataBounds(regionId, dataBounds);
+    parallel->GetRegionDataBounds(regionId, parallelDataBounds);
+    if (!std::equal(bounds, bounds + 6, parallelBounds) ||
+      !std::equal(dataBounds, dataBounds + 6, parallelDataBounds))
+    {
+      std::cerr << "Wrong bounds for region " << regionId << std::endl;
+      return false;
+    }
+    if (GetSortedPointsInRegion(serial, regionId) != GetSortedPointsInRegion(parallel, regionId))
+    {
+      std::cerr << "Wrong points in region " << regionId << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool CheckBatchQueries(vtkKdTreePointLocator* locator, vtkPoints* points, vtkDataArray* queries)
+{
+  const vtkIdType numQueries = queries->GetNumberOfTuples();
+  vtkNew<vtkIdTypeArray> closestIds, offsets, ids;
+  vtkNew<vtkIdList> result;
+  double x[3];
+
+  locator->FindClosestPointBatch(queries, closestIds);
+  for (vtkIdType i = 0; i < numQueries; ++i)
+  {
+    queries->GetTuple(i, x);
+    if (closestIds->GetValue(i) != locator->FindClosestPoint(x))
+    {
+      std::cerr << "Wrong closest point for query " << i << std::endl;
+      return false;
+    }
+  }
+
+  const int N = 8;
+  locator->FindClosestNPointsBatch(N, queries, offsets, ids);
+  for (vtkIdType i = 0; i < numQueries; ++i)
+  {
+    queries->GetTuple(i, x);
+    locator->FindClosestNPoints(N, x, result);
+    const vtkIdType* first = ids->GetPointer(offsets->GetValue(i));
+    if (offsets->GetValue(i + 1) - offsets->GetValue(i) != N ||
+      !std::equal(result->begin(), result->end(), first))
+    {
+      std::cerr << "Wrong closest " << N << " points for query " << i << std::endl;
+      return false;
+    }
+  }
+
+  const double R = 0.02;
+  locator->FindPointsWithinRadiusBatch(R, queries, offsets, ids);
+  for (vtkIdType i = 0; i < numQueries; ++i)
+  {
+    queries->GetTuple(i, x);
+    locator->FindPointsWithinRadius(R, x, result);
+    const vtkIdType* first = ids->GetPointer(offsets->GetValue(i));
+    const vtkIdType* last = ids->GetPointer(offsets->GetValue(i + 1));
+    if (!std::equal(result->begin(), result->end(), first, last))
+    {
+      std::cerr << "Wrong points within radius for query " << i << std::endl;
+      return false;
+    }
+    if (i % 100 == 0)
+    {
+      // against a brute force search
+      vtkIdType count = 0;
+      for (vtkIdType ptId = 0; ptId < points->GetNumberOfPoints(); ++ptId)
+      {
+        count += vtkMath::Distance2BetweenPoints(x, points->GetPoint(ptId)) <= R * R;
+      }
+      if (count != last - first)
+      {
+        std::cerr << "Found " << last - first << " points within radius for query " << i
+                  << " instead of " << count << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
+
+int TestKdTreeParallelBuild(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  int res = EXIT_SUCCESS;
+
+  // random points, half of them on a few planes so that the medians are repeated
+  const vtkIdType numberOfPoints = 200000;
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(42);
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToFloat();
+  points->SetNumberOfPoints(numberOfPoints);
+  for (vtkIdType i = 0; i < numberOfPoints; ++i)
+  {
+    double x[3];
+    for (int comp = 0; comp < 3; ++comp)
+    {
+      x[comp] = random->GetNextValue();
+    }
+    if (i % 2 == 0)
+    {
+      x[0] = std::floor(16.0 * x[0]) / 16.0;
+    }
+    points->SetPoint(i, x);
+  }
+
+  auto serial = BuildKdTree(points, 1);
+  auto parallel = BuildKdTree(points, 4);
+  if (!CompareKdTrees(serial, parallel))
+  {
+    std::cerr << "The k-d trees built with 1 and 4 threads differ" << std::endl;
+    res = EXIT_FAILURE;
+  }
+
+  // batched queries, the query points being partly outside of the point cloud
+  vtkNew<vtkPolyData> polyData;
+  polyData->SetPoints(points);
+  vtkNew<vtkKdTreePointLocator> locator;
+  locator->SetDataSet(polyData);
+  vtkNew<vtkDoubleArray> queries;
+  queries->SetNumberOfComponents(3);
+  queries->SetNumberOfTuples(1000);
+  for (vtkIdType i = 0; i < queries->GetNumberOfTuples(); ++i)
+  {
+    for (int comp = 0; comp < 3; ++comp)
+    {
+      queries->SetComponent(i, comp, 1.2 * random->GetNextValue() - 0.1);
+    }
+  }
+  vtkSMPTools::LocalScope(vtkSMPTools::Config{ 4 },
+    [&]()
+    {
+      if (!CheckBatchQueries(locator, points, queries))
+      {
+        std::cerr << "The batched queries of vtkKdTreePointLocator are wrong" << std::endl;
+        res = EXIT_FAILURE;
+      }
+    });
+
+  return res;
+}
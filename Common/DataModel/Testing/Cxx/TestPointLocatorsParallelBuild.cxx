@@ -0,0 +1,214 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Checks that vtkPointLocator and vtkOctreePointLocator built with several threads match the
+// locators built serially, and that the batched queries match the single queries, whether they
+// run in parallel or serially as for vtkIncrementalOctreePointLocator.
+
+#include "vtkDoubleArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkIncrementalOctreePointLocator.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkOctreePointLocator.h"
+#include "vtkPointLocator.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkStaticPointLocator.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+template <typename LocatorT>
+vtkSmartPointer<LocatorT> BuildLocator(vtkPolyData* polyData, int numberOfThreads)
+{
+  auto locator = vtkSmartPointer<LocatorT>::New();
+  locator->SetDataSet(polyData);
+  vtkSMPTools::LocalScope(
+    vtkSMPTools::Config{ numberOfThreads }, [&]() { locator->BuildLocator(); });
+  return locator;
+}
+
+bool CompareOctrees(vtkOctreePointLocator* serial, vtkOctreePointLocator* parallel)
+{
+  if (serial->GetNumberOfLeafNodes() != parallel->GetNumberOfLeafNodes() ||
+    serial->GetLevel() != parallel->GetLevel())
+  {
+    std::cerr << "Got " << parallel->GetNumberOfLeafNodes() << " leaf nodes and "
+              << parallel->GetLevel() << " levels instead of " << serial->GetNumberOfLeafNodes()
+              << " and " << serial->GetLevel() << std::endl;
+    return false;
+  }
+  for (int leafNodeId = 0; leafNodeId < serial->GetNumberOfLeafNodes(); ++leafNodeId)
+  {
+    auto ids = vtkSmartPointer<vtkIdTypeArray>::Take(serial->GetPointsInRegion(leafNodeId));
+    auto parallelIds =
+      vtkSmartPointer<vtkIdTypeArray>::Take(parallel->GetPointsInRegion(leafNodeId));
+    if (ids->GetNumberOfValues() != parallelIds->GetNumberOfValues() ||
+      !std::equal(ids->GetPointer(0), ids->GetPointer(0) + ids->GetNumberOfValues(),
+        parallelIds->GetPointer(0)))
+    {
+      std::cerr << "Wrong points in leaf node " << leafNodeId << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+// The ids found in a radius are listed in the order of the buckets or octants, so the locators
+// built serially and in parallel must give them in the same order.
+bool CompareQueries(vtkAbstractPointLocator* serial, vtkAbstractPointLocator* parallel,
+  vtkDataArray* queries, double R)
+{
+  vtkNew<vtkIdList> ids, parallelIds;
+  double x[3];
+  for (vtkIdType i = 0; i < queries->GetNumberOfTuples(); ++i)
+  {
+    queries->GetTuple(i, x);
+    serial->FindPointsWithinRadius(R, x, ids);
+    parallel->FindPointsWithinRadius(R, x, parallelIds);
+    if (ids->GetNumberOfIds() != parallelIds->GetNumberOfIds() ||
+      !std::equal(ids->begin(), ids->end(), parallelIds->begin()) ||
+      serial->FindClosestPoint(x) != parallel->FindClosestPoint(x))
+    {
+      std::cerr << "Different results for query " << i << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool CheckBatchQueries(vtkAbstractPointLocator* locator, vtkDataArray* queries, double R)
+{
+  const vtkIdType numQueries = queries->GetNumberOfTuples();
+  vtkNew<vtkIdTypeArray> closestIds, offsets, ids;
+  vtkNew<vtkIdList> result;
+  double x[3];
+
+  locator->FindClosestPointBatch(queries, closestIds);
+  for (vtkIdType i = 0; i < numQueries; ++i)
+  {
+    queries->GetTuple(i, x);
+    if (closestIds->GetValue(i) != locator->FindClosestPoint(x))
+    {
+      std::cerr << "Wrong closest point for query " << i << std::endl;
+      return false;
+    }
+  }
+
+  const int N = 5;
+  locator->FindClosestNPointsBatch(N, queries, offsets, ids);
+  for (vtkIdType i = 0; i < numQueries; ++i)
+  {
+    queries->GetTuple(i, x);
+    locator->FindClosestNPoints(N, x, result);
+    if (offsets->GetValue(i + 1) - offsets->GetValue(i) != result->GetNumberOfIds() ||
+      !std::equal(result->begin(), result->end(), ids->GetPointer(offsets->GetValue(i))))
+    {
+      std::cerr << "Wrong closest " << N << " points for query " << i << std::endl;
+      return false;
+    }
+  }
+
+  locator->FindPointsWithinRadiusBatch(R, queries, offsets, ids);
+  for (vtkIdType i = 0; i < numQueries; ++i)
+  {
+    queries->GetTuple(i, x);
+    locator->FindPointsWithinRadius(R, x, result);
+    if (offsets->GetValue(i + 1) - offsets->GetValue(i) != result->GetNumberOfIds() ||
+      !std::equal(result->begin(), result->end(), ids->GetPointer(offsets->GetValue(i))))
+    {
+      std::cerr << "Wrong points within radius for query " << i << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestPointLocatorsParallelBuild(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  int res = EXIT_SUCCESS;
+
+  // random points, denser around the origin so that the octree is unbalanced
+  const vtkIdType numberOfPoints = 200000;
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(7);
+  vtkNew<vtkPoints> points;
+  points->SetNumberOfPoints(numberOfPoints);
+  for (vtkIdType i = 0; i < numberOfPoints; ++i)
+  {
+    double x[3];
+    for (int comp = 0; comp < 3; ++comp)
+    {
+      x[comp] = random->GetNextValue();
+      x[comp] = i % 2 ? x[comp] * x[comp] * x[comp] : x[comp];
+    }
+    points->SetPoint(i, x);
+  }
+  vtkNew<vtkPolyData> polyData;
+  polyData->SetPoints(points);
+
+  vtkNew<vtkDoubleArray> queries;
+  queries->SetNumberOfComponents(3);
+  queries->SetNumberOfTuples(500);
+  for (vtkIdType i = 0; i < queries->GetNumberOfTuples(); ++i)
+  {
+    for (int comp = 0; comp < 3; ++comp)
+    {
+      queries->SetComponent(i, comp, 1.2 * random->GetNextValue() - 0.1);
+    }
+  }
+  const double R = 0.03;
+
+  auto pointLocator = BuildLocator<vtkPointLocator>(polyData, 1);
+  auto parallelPointLocator = BuildLocator<vtkPointLocator>(polyData, 4);
+  if (!CompareQueries(pointLocator, parallelPointLocator, queries, R))
+  {
+    std::cerr << "The vtkPointLocator built with 1 and 4 threads differ" << std::endl;
+    res = EXIT_FAILURE;
+  }
+
+  auto octree = BuildLocator<vtkOctreePointLocator>(polyData, 1);
+  auto parallelOctree = BuildLocator<vtkOctreePointLocator>(polyData, 4);
+  if (!CompareOctrees(octree, parallelOctree) ||
+    !CompareQueries(octree, parallelOctree, queries, R))
+  {
+    std::cerr << "The vtkOctreePointLocator built with 1 and 4 threads differ" << std::endl;
+    res = EXIT_FAILURE;
+  }
+
+  vtkSMPTools::LocalScope(vtkSMPTools::Config{ 4 },
+    [&]()
+    {
+      if (!CheckBatchQueries(parallelPointLocator, queries, R))
+      {
+        std::cerr << "The batched queries of vtkPointLocator are wrong" << std::endl;
+        res = EXIT_FAILURE;
+      }
+      if (!CheckBatchQueries(parallelOctree, queries, R))
+      {
+        std::cerr << "The batched queries of vtkOctreePointLocator are wrong" << std::endl;
+        res = EXIT_FAILURE;
+      }
+      auto staticLocator = BuildLocator<vtkStaticPointLocator>(polyData, 4);
+      if (!CheckBatchQueries(staticLocator, queries, R))
+      {
+        std::cerr << "The batched queries of vtkStaticPointLocator are wrong" << std::endl;
+        res = EXIT_FAILURE;
+      }
+      auto incrementalOctree = BuildLocator<vtkIncrementalOctreePointLocator>(polyData, 4);
+      if (!CheckBatchQueries(incrementalOctree, queries, R))
+      {
+        std::cerr << "The batched queries of vtkIncrementalOctreePointLocator are wrong"
+                  << std::endl;
+        res = EXIT_FAILURE;
+      }
+    });
+
+  return res;
+}
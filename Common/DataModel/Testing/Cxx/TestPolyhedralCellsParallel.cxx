@@ -0,0 +1,253 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Checks the threaded conversions of the polyhedron face streams of vtkUnstructuredGrid, the
+// cells and face streams given by GetCell() from several threads, and vtkCellLinks built with
+// several threads.
+
+// VTK_DEPRECATED_IN_9_4_0()
+#define VTK_DEPRECATION_LEVEL 0
+
+#include "vtkCellArray.h"
+#include "vtkCellLinks.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+const int Resolution = 16;
+
+// Point ids of the hexahedron (i, j, k) of the grid, in the VTK_HEXAHEDRON order.
+void GetHexahedron(int i, int j, int k, vtkIdType pts[8])
+{
+  auto id = [](int x, int y, int z) -> vtkIdType
+  { return x + (Resolution + 1) * (y + (Resolution + 1) * z); };
+  pts[0] = id(i, j, k);
+  pts[1] = id(i + 1, j, k);
+  pts[2] = id(i + 1, j + 1, k);
+  pts[3] = id(i, j + 1, k);
+  pts[4] = id(i, j, k + 1);
+  pts[5] = id(i + 1, j, k + 1);
+  pts[6] = id(i + 1, j + 1, k + 1);
+  pts[7] = id(i, j + 1, k + 1);
+}
+
+// Face stream [numFace0Pts, id1, id2, id3, id4, numFace1Pts, ...] of the hexahedron.
+std::vector<vtkIdType> GetFaces(const vtkIdType pts[8])
+{
+  const int faces[6][4] = { { 0, 3, 2, 1 }, { 4, 5, 6, 7 }, { 0, 1, 5, 4 }, { 1, 2, 6, 5 },
+    { 2, 3, 7, 6 }, { 3, 0, 4, 7 } };
+  std::vector<vtkIdType> stream;
+  for (const auto& face : faces)
+  {
+    stream.push_back(4);
+    for (int vertex : face)
+    {
+      stream.push_back(pts[vertex]);
+    }
+  }
+  return stream;
+}
+
+bool SameIds(vtkIdList* ids, vtkIdList* expected)
+{
+  return ids->GetNumberOfIds() == expected->GetNumberOfIds() &&
+    std::equal(ids->begin(), ids->end(), expected->begin());
+}
+
+// Compare the cells of a grid with the reference one.
+bool CompareGrids(vtkUnstructuredGrid* grid, vtkUnstructuredGrid* reference)
+{
+  if (grid->GetNumberOfCells() != reference->GetNumberOfCells())
+  {
+    std::cerr << "Got " << grid->GetNumberOfCells() << " cells instead of "
+              << reference->GetNumberOfCells() << std::endl;
+    return false;
+  }
+  vtkNew<vtkIdList> ids, expected;
+  for (vtkIdType cellId = 0; cellId < reference->GetNumberOfCells(); ++cellId)
+  {
+    grid->GetCellPoints(cellId, ids);
+    reference->GetCellPoints(cellId, expected);
+    if (grid->GetCellType(cellId) != reference->GetCellType(cellId) || !SameIds(ids, expected))
+    {
+      std::cerr << "Wrong points for cell " << cellId << std::endl;
+      return false;
+    }
+    grid->GetFaceStream(cellId, ids);
+    reference->GetFaceStream(cellId, expected);
+    if (!SameIds(ids, expected))
+    {
+      std::cerr << "Wrong face stream for cell " << cellId << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+// Get the cells from several threads, their center must be inside them.
+bool CheckParallelGetCell(vtkUnstructuredGrid* grid)
+{
+  vtkSMPThreadLocalObject<vtkGenericCell> tlCell;
+  std::atomic<vtkIdType> numberOfErrors(0);
+  vtkSMPTools::For(0, grid->GetNumberOfCells(),
+    [&](vtkIdType cellId, vtkIdType endCellId)
+    {
+      vtkGenericCell* cell = tlCell.Local();
+      std::vector<double> weights;
+      for (; cellId < endCellId; ++cellId)
+      {
+        grid->GetCell(cellId, cell);
+        double bounds[6], center[3], closest[3], pcoords[3], dist2;
+        int subId;
+        cell->GetBounds(bounds);
+        for (int comp = 0; comp < 3; ++comp)
+        {
+          center[comp] = 0.5 * (bounds[2 * comp] + bounds[2 * comp + 1]);
+        }
+        weights.resize(cell->GetNumberOfPoints());
+        if (cell->GetNumberOfPoints() != 8 || cell->GetNumberOfFaces() != 6 ||
+          cell->EvaluatePosition(center, closest, subId, pcoords, dist2, weights.data()) != 1)
+        {
+          ++numberOfErrors;
+        }
+      }
+    });
+  if (numberOfErrors > 0)
+  {
+    std::cerr << numberOfErrors << " cells are wrong when got from several threads" << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestPolyhedralCellsParallel(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  int res = EXIT_SUCCESS;
+
+  vtkNew<vtkPoints> points;
+  for (int k = 0; k <= Resolution; ++k)
+  {
+    for (int j = 0; j <= Resolution; ++j)
+    {
+      for (int i = 0; i <= Resolution; ++i)
+      {
+        points->InsertNextPoint(i, j, k);
+      }
+    }
+  }
+
+  // Every third cell is a hexahedron, the others are the same hexahedra given as polyhedra.
+  // The reference grid inserts the cells one by one, the cell array of the other one stores the
+  // face streams of the polyhedra.
+  vtkNew<vtkUnstructuredGrid> reference;
+  reference->SetPoints(points);
+  reference->AllocateExact(Resolution * Resolution * Resolution, 8);
+  vtkNew<vtkUnsignedCharArray> types;
+  vtkNew<vtkCellArray> cells;
+  for (int k = 0; k < Resolution; ++k)
+  {
+    for (int j = 0; j < Resolution; ++j)
+    {
+      for (int i = 0; i < Resolution; ++i)
+      {
+        vtkIdType pts[8];
+        GetHexahedron(i, j, k, pts);
+        if (reference->GetNumberOfCells() % 3 == 0)
+        {
+          reference->InsertNextCell(VTK_HEXAHEDRON, 8, pts);
+          types->InsertNextValue(VTK_HEXAHEDRON);
+          cells->InsertNextCell(8, pts);
+          continue;
+        }
+        std::vector<vtkIdType> stream = GetFaces(pts);
+        std::sort(pts, pts + 8);
+        reference->InsertNextCell(VTK_POLYHEDRON, 8, pts, 6, stream.data());
+        stream.insert(stream.begin(), 6);
+        types->InsertNextValue(VTK_POLYHEDRON);
+        cells->InsertNextCell(static_cast<vtkIdType>(stream.size()), stream.data());
+      }
+    }
+  }
+
+  vtkSMPTools::LocalScope(vtkSMPTools::Config{ 4 },
+    [&]()
+    {
+      // polyhedra given by their face streams
+      vtkNew<vtkUnstructuredGrid> grid;
+      grid->SetPoints(points);
+      grid->SetCells(types, cells);
+      if (!CompareGrids(grid, reference))
+      {
+        std::cerr << "Wrong cells set from face streams" << std::endl;
+        res = EXIT_FAILURE;
+      }
+
+      // legacy face locations, -1 for the cells which are not polyhedra
+      vtkIdTypeArray* faces = reference->GetFaces();
+      vtkIdTypeArray* faceLocations = reference->GetFaceLocations();
+      if (!faces || !faceLocations ||
+        faceLocations->GetNumberOfValues() != reference->GetNumberOfCells() ||
+        faceLocations->GetValue(0) != -1 || faceLocations->GetValue(1) != 0 ||
+        faceLocations->GetValue(2) != 31 || faceLocations->GetValue(3) != -1 ||
+        faceLocations->GetValue(4) != 62 ||
+        faces->GetNumberOfValues() != 31 * (2 * reference->GetNumberOfCells() / 3))
+      {
+        std::cerr << "Wrong legacy faces" << std::endl;
+        res = EXIT_FAILURE;
+      }
+      else
+      {
+        vtkNew<vtkUnstructuredGrid> legacyGrid;
+        legacyGrid->SetPoints(points);
+        legacyGrid->SetCells(types, grid->GetCells(), faceLocations, faces);
+        if (!CompareGrids(legacyGrid, reference))
+        {
+          std::cerr << "Wrong cells set from legacy faces" << std::endl;
+          res = EXIT_FAILURE;
+        }
+      }
+
+      if (!CheckParallelGetCell(grid))
+      {
+        res = EXIT_FAILURE;
+      }
+
+      // editable grids use vtkCellLinks, the other ones vtkStaticCellLinks
+      grid->BuildLinks();
+      reference->EditableOn();
+      reference->BuildLinks();
+      if (!vtkCellLinks::SafeDownCast(reference->GetLinks()))
+      {
+        std::cerr << "The editable grid does not use vtkCellLinks" << std::endl;
+        res = EXIT_FAILURE;
+      }
+      vtkNew<vtkIdList> cellIds, expected;
+      for (vtkIdType ptId = 0; ptId < points->GetNumberOfPoints(); ++ptId)
+      {
+        reference->GetPointCells(ptId, cellIds);
+        grid->GetPointCells(ptId, expected);
+        if (!SameIds(cellIds, expected))
+        {
+          std::cerr << "Wrong cells using point " << ptId << std::endl;
+          res = EXIT_FAILURE;
+          break;
+        }
+      }
+    });
+
+  return res;
+}
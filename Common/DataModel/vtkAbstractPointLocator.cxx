@@ -2,11 +2,102 @@
 // SPDX-License-Identifier: BSD-3-Clause
 #include "vtkAbstractPointLocator.h"
 
+#include "vtkDataArray.h"
 #include "vtkDataSet.h"
 #include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <vector>
 
-//------------------------------------------------------------------------------
 VTK_ABI_NAMESPACE_BEGIN
+namespace
+{
+//------------------------------------------------------------------------------
+// Run functor(begin, end) over [0, n) with vtkSMPTools if parallel, else in the calling thread.
+template <typename FunctorT>
+void ForQueries(bool parallel, vtkIdType n, FunctorT&& functor)
+{
+  if (parallel)
+  {
+    vtkSMPTools::For(0, n, functor);
+  }
+  else
+  {
+    functor(0, n);
+  }
+}
+
+//------------------------------------------------------------------------------
+// Run query for each point of queryPoints and gather the ids found in the compressed sparse row
+// arrays offsets and ids. query(x, list) fills list with the ids found for x.
+template <typename QueryT>
+void RunBatchQueries(vtkDataArray* queryPoints, vtkIdTypeArray* offsets, vtkIdTypeArray* ids,
+  bool parallel, QueryT&& query)
+{
+  const vtkIdType numQueries = queryPoints->GetNumberOfTuples();
+
+  // the ids found for the query i are stored in Results[i] from Begins[i] by the thread which
+  // ran the query
+  vtkSMPThreadLocalObject<vtkIdList> tlList;
+  vtkSMPThreadLocal<std::vector<vtkIdType>> tlResults;
+  std::vector<std::vector<vtkIdType>*> results(numQueries);
+  std::vector<vtkIdType> begins(numQueries);
+  offsets->SetNumberOfComponents(1);
+  offsets->SetNumberOfValues(numQueries + 1);
+  vtkIdType* offset = offsets->GetPointer(0);
+  ForQueries(parallel, numQueries,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      vtkIdList* list = tlList.Local();
+      std::vector<vtkIdType>& localResults = tlResults.Local();
+      double x[3];
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        queryPoints->GetTuple(i, x);
+        query(x, list);
+        results[i] = &localResults;
+        begins[i] = static_cast<vtkIdType>(localResults.size());
+        offset[i + 1] = list->GetNumberOfIds();
+        localResults.insert(localResults.end(), list->begin(), list->end());
+      }
+    });
+
+  offset[0] = 0;
+  for (vtkIdType i = 0; i < numQueries; ++i)
+  {
+    offset[i + 1] += offset[i];
+  }
+  ids->SetNumberOfComponents(1);
+  ids->SetNumberOfValues(offset[numQueries]);
+  vtkIdType* id = ids->GetPointer(0);
+  ForQueries(parallel, numQueries,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        const vtkIdType* first = results[i]->data() + begins[i];
+        std::copy(first, first + offset[i + 1] - offset[i], id + offset[i]);
+      }
+    });
+}
+
+//------------------------------------------------------------------------------
+bool CheckQueryPoints(vtkAbstractPointLocator* self, vtkDataArray* queryPoints)
+{
+  if (!queryPoints || queryPoints->GetNumberOfComponents() != 3)
+  {
+    vtkErrorWithObjectMacro(self, "The query points must be given by an array with 3 components");
+    return false;
+  }
+  return true;
+}
+}
+
+//------------------------------------------------------------------------------
 vtkAbstractPointLocator::vtkAbstractPointLocator()
 {
   for (int i = 0; i < 6; i++)
@@ -53,6 +144,79 @@ void vtkAbstractPointLocator::FindPointsWithinRadius(
   this->FindPointsWithinRadius(R, p, result);
 }
 
+//------------------------------------------------------------------------------
+void vtkAbstractPointLocator::FindClosestPointBatch(vtkDataArray* queryPoints, vtkIdTypeArray* ids)
+{
+  this->FindClosestPointBatch(queryPoints, ids, false);
+}
+
+//------------------------------------------------------------------------------
+void vtkAbstractPointLocator::FindClosestNPointsBatch(
+  int N, vtkDataArray* queryPoints, vtkIdTypeArray* offsets, vtkIdTypeArray* ids)
+{
+  this->FindClosestNPointsBatch(N, queryPoints, offsets, ids, false);
+}
+
+//------------------------------------------------------------------------------
+void vtkAbstractPointLocator::FindPointsWithinRadiusBatch(
+  double R, vtkDataArray* queryPoints, vtkIdTypeArray* offsets, vtkIdTypeArray* ids)
+{
+  this->FindPointsWithinRadiusBatch(R, queryPoints, offsets, ids, false);
+}
+
+//------------------------------------------------------------------------------
+void vtkAbstractPointLocator::FindClosestPointBatch(
+  vtkDataArray* queryPoints, vtkIdTypeArray* ids, bool parallel)
+{
+  if (!CheckQueryPoints(this, queryPoints))
+  {
+    return;
+  }
+  this->BuildLocator();
+
+  ids->SetNumberOfComponents(1);
+  ids->SetNumberOfValues(queryPoints->GetNumberOfTuples());
+  vtkIdType* id = ids->GetPointer(0);
+  ForQueries(parallel, queryPoints->GetNumberOfTuples(),
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      double x[3];
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        queryPoints->GetTuple(i, x);
+        id[i] = this->FindClosestPoint(x);
+      }
+    });
+}
+
+//------------------------------------------------------------------------------
+void vtkAbstractPointLocator::FindClosestNPointsBatch(
+  int N, vtkDataArray* queryPoints, vtkIdTypeArray* offsets, vtkIdTypeArray* ids, bool parallel)
+{
+  if (!CheckQueryPoints(this, queryPoints))
+  {
+    return;
+  }
+  this->BuildLocator();
+
+  RunBatchQueries(queryPoints, offsets, ids, parallel,
+    [&](const double x[3], vtkIdList* result) { this->FindClosestNPoints(N, x, result); });
+}
+
+//------------------------------------------------------------------------------
+void vtkAbstractPointLocator::FindPointsWithinRadiusBatch(
+  double R, vtkDataArray* queryPoints, vtkIdTypeArray* offsets, vtkIdTypeArray* ids, bool parallel)
+{
+  if (!CheckQueryPoints(this, queryPoints))
+  {
+    return;
+  }
+  this->BuildLocator();
+
+  RunBatchQueries(queryPoints, offsets, ids, parallel,
+    [&](const double x[3], vtkIdList* result) { this->FindPointsWithinRadius(R, x, result); });
+}
+
 //------------------------------------------------------------------------------
 void vtkAbstractPointLocator::GetBounds(double* bnds)
 {
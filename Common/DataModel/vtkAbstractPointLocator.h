@@ -22,7 +22,9 @@
 #include "vtkLocator.h"
 
 VTK_ABI_NAMESPACE_BEGIN
+class vtkDataArray;
 class vtkIdList;
+class vtkIdTypeArray;
 
 class VTKCOMMONDATAMODEL_EXPORT vtkAbstractPointLocator : public vtkLocator
 {
@@ -78,6 +80,25 @@ public:
   void FindPointsWithinRadius(double R, double x, double y, double z, vtkIdList* result);
   ///@}
 
+  ///@{
+  /**
+   * Batched versions of FindClosestPoint(), FindClosestNPoints() and FindPointsWithinRadius()
+   * for all the points of queryPoints, which must have 3 components. The locator is built first,
+   * then the queries are run one after the other. Subclasses whose single query methods are
+   * thread safe once built override these methods to run the queries in parallel with
+   * vtkSMPTools, see the protected overloads.
+   * FindClosestPointBatch() returns the id of the closest point of each query point in ids. The
+   * other methods return their results in a compressed sparse row layout: offsets gets one more
+   * value than there are query points, and the ids found for the query point i are
+   * ids[offsets[i]] to ids[offsets[i + 1] - 1], in the order of the single query methods.
+   */
+  virtual void FindClosestPointBatch(vtkDataArray* queryPoints, vtkIdTypeArray* ids);
+  virtual void FindClosestNPointsBatch(
+    int N, vtkDataArray* queryPoints, vtkIdTypeArray* offsets, vtkIdTypeArray* ids);
+  virtual void FindPointsWithinRadiusBatch(
+    double R, vtkDataArray* queryPoints, vtkIdTypeArray* offsets, vtkIdTypeArray* ids);
+  ///@}
+
   ///@{
   /**
    * Provide an accessor to the bounds. Valid after the locator is built.
@@ -98,6 +119,19 @@ protected:
   vtkAbstractPointLocator();
   ~vtkAbstractPointLocator() override;
 
+  ///@{
+  /**
+   * Implementations of the batched queries, which run the single queries with vtkSMPTools if
+   * parallel is true. Only call them with parallel set to true from subclasses whose single query
+   * methods are thread safe once the locator is built.
+   */
+  void FindClosestPointBatch(vtkDataArray* queryPoints, vtkIdTypeArray* ids, bool parallel);
+  void FindClosestNPointsBatch(int N, vtkDataArray* queryPoints, vtkIdTypeArray* offsets,
+    vtkIdTypeArray* ids, bool parallel);
+  void FindPointsWithinRadiusBatch(double R, vtkDataArray* queryPoints, vtkIdTypeArray* offsets,
+    vtkIdTypeArray* ids, bool parallel);
+  ///@}
+
   double Bounds[6];          // bounds of points
   vtkIdType NumberOfBuckets; // total size of locator
 
@@ -219,8 +219,8 @@ struct CanConvert
 
     // offsets are sorted, so just check the last value, but we have to compute
     // the full range of the connectivity array.
-    auto* off = state.GetOffsets();
-    if (off->GetNumberOfValues() > 0 && !this->CheckValue(off->GetValue(off->GetMaxId())))
+    const vtkIdType numCells = state.GetNumberOfCells();
+    if (numCells >= 0 && !this->CheckValue(state.GetBeginOffset(numCells)))
     {
       return false;
     }
@@ -373,35 +373,12 @@ struct FindMaxCell // SMP functor
   }
 };
 
-struct GetActualMemorySizeImpl
-{
-  template <typename CellStateT>
-  unsigned long operator()(CellStateT& cells) const
-  {
-    return (
-      cells.GetOffsets()->GetActualMemorySize() + cells.GetConnectivity()->GetActualMemorySize());
-  }
-};
-
-struct PrintSelfImpl
-{
-  template <typename CellStateT>
-  void operator()(CellStateT& cells, ostream& os, vtkIndent indent) const
-  {
-    os << indent << "Offsets:\n";
-    cells.GetOffsets()->PrintSelf(os, indent.GetNextIndent());
-    os << indent << "Connectivity:\n";
-    cells.GetConnectivity()->PrintSelf(os, indent.GetNextIndent());
-  }
-};
-
 struct GetLegacyDataSizeImpl
 {
   template <typename CellStateT>
   vtkIdType operator()(CellStateT& cells) const
   {
-    return (
-      (cells.GetOffsets()->GetNumberOfValues() - 1) + cells.GetConnectivity()->GetNumberOfValues());
+    return cells.GetNumberOfCells() + cells.GetConnectivity()->GetNumberOfValues();
   }
 };
 
@@ -483,16 +460,36 @@ struct AppendImpl
   template <typename SrcCellStateT, typename DstCellStateT>
   void operator()(SrcCellStateT& src, DstCellStateT& dst, vtkIdType pointOffsets) const
   {
-    this->AppendArrayWithOffset(
-      src.GetOffsets(), dst.GetOffsets(), dst.GetConnectivity()->GetNumberOfValues(), true);
-    this->AppendArrayWithOffset(src.GetConnectivity(), dst.GetConnectivity(), pointOffsets, false);
+    this->AppendOffsets(src, dst);
+    this->AppendArrayWithOffset(src.GetConnectivity(), dst.GetConnectivity(), pointOffsets);
+  }
+
+  // The offsets of src are read with the accessors, so that appending a fixed size storage does
+  // not expand its offsets.
+  template <typename SrcCellStateT, typename DstCellStateT>
+  void AppendOffsets(SrcCellStateT& src, DstCellStateT& dst) const
+  {
+    using DstValueType = typename DstCellStateT::ValueType;
+    auto* dstOffsets = dst.GetOffsets();
+    const vtkIdType numCells = src.GetNumberOfCells();
+    const vtkIdType dstBegin = dstOffsets->GetNumberOfValues();
+    const vtkIdType connOffset = dst.GetConnectivity()->GetNumberOfValues();
+
+    // This extends the allocation of dst to ensure we have enough space
+    // allocated:
+    dstOffsets->InsertValue(dstBegin + numCells - 1, 0);
+
+    DstValueType* out = dstOffsets->GetPointer(dstBegin);
+    for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+    {
+      out[cellId] = static_cast<DstValueType>(connOffset + src.GetEndOffset(cellId));
+    }
   }
 
   // Assumes both arrays are 1 component. src's data is appended to dst with
   // offset added to each value.
   template <typename SrcArrayT, typename DstArrayT>
-  void AppendArrayWithOffset(
-    SrcArrayT* srcArray, DstArrayT* dstArray, vtkIdType offset, bool skipFirst) const
+  void AppendArrayWithOffset(SrcArrayT* srcArray, DstArrayT* dstArray, vtkIdType offset) const
   {
     VTK_ASSUME(srcArray->GetNumberOfComponents() == 1);
     VTK_ASSUME(dstArray->GetNumberOfComponents() == 1);
@@ -500,8 +497,7 @@ struct AppendImpl
     using SrcValueType = vtk::GetAPIType<SrcArrayT>;
     using DstValueType = vtk::GetAPIType<DstArrayT>;
 
-    const vtkIdType srcSize =
-      skipFirst ? srcArray->GetNumberOfValues() - 1 : srcArray->GetNumberOfValues();
+    const vtkIdType srcSize = srcArray->GetNumberOfValues();
     const vtkIdType dstBegin = dstArray->GetNumberOfValues();
     const vtkIdType dstEnd = dstBegin + srcSize;
 
@@ -509,7 +505,7 @@ struct AppendImpl
     // allocated:
     dstArray->InsertValue(dstEnd - 1, 0);
 
-    const auto srcRange = vtk::DataArrayValueRange<1>(srcArray, skipFirst ? 1 : 0);
+    const auto srcRange = vtk::DataArrayValueRange<1>(srcArray);
     auto dstRange = vtk::DataArrayValueRange<1>(dstArray, dstBegin, dstEnd);
     assert(srcRange.size() == dstRange.size());
 
@@ -684,6 +680,8 @@ void vtkCellArray::DeepCopy(vtkAbstractCellArray* ca)
     return;
   }
 
+  // the implicit offsets of a fixed size storage are kept implicit
+  const vtkIdType fixedCellSize = other->GetFixedCellSize();
   if (other->Storage.Is64Bit())
   {
     this->Storage.Use64BitStorage();
@@ -691,6 +689,7 @@ void vtkCellArray::DeepCopy(vtkAbstractCellArray* ca)
     auto& dstStorage = this->Storage.GetArrays64();
     dstStorage.Offsets->DeepCopy(srcStorage.Offsets);
     dstStorage.Connectivity->DeepCopy(srcStorage.Connectivity);
+    dstStorage.FixedCellSize = fixedCellSize;
     this->Modified();
   }
   else
@@ -700,6 +699,7 @@ void vtkCellArray::DeepCopy(vtkAbstractCellArray* ca)
     auto& dstStorage = this->Storage.GetArrays32();
     dstStorage.Offsets->DeepCopy(srcStorage.Offsets);
     dstStorage.Connectivity->DeepCopy(srcStorage.Connectivity);
+    dstStorage.FixedCellSize = fixedCellSize;
     this->Modified();
   }
 }
@@ -717,15 +717,29 @@ void vtkCellArray::ShallowCopy(vtkAbstractCellArray* ca)
     return;
   }
 
+  const vtkIdType fixedCellSize = other->GetFixedCellSize();
   if (other->Storage.Is64Bit())
   {
     auto& srcStorage = other->Storage.GetArrays64();
-    this->SetData(srcStorage.GetOffsets(), srcStorage.GetConnectivity());
+    this->SetData(srcStorage.Offsets.Get(), srcStorage.Connectivity.Get());
   }
   else
   {
     auto& srcStorage = other->Storage.GetArrays32();
-    this->SetData(srcStorage.GetOffsets(), srcStorage.GetConnectivity());
+    this->SetData(srcStorage.Offsets.Get(), srcStorage.Connectivity.Get());
+  }
+
+  if (fixedCellSize > 0)
+  {
+    // keep the offsets implicit, each copy expands its own offsets array
+    this->Visit(
+      [fixedCellSize](auto& state)
+      {
+        using ArrayType = typename std::decay_t<decltype(state)>::ArrayType;
+        state.Offsets = vtkSmartPointer<ArrayType>::New();
+        state.Offsets->InsertNextValue(0);
+        state.FixedCellSize = fixedCellSize;
+      });
   }
 }
 
@@ -741,7 +755,13 @@ void vtkCellArray::Append(vtkCellArray* src, vtkIdType pointOffset)
 //------------------------------------------------------------------------------
 void vtkCellArray::Initialize()
 {
-  this->Visit(InitializeImpl{});
+  // InitializeImpl resets the offsets, no need to expand the implicit ones
+  this->Visit(
+    [](auto& state)
+    {
+      state.FixedCellSize = 0;
+      InitializeImpl{}(state);
+    });
 
   this->LegacyData->Initialize();
 }
@@ -771,6 +791,7 @@ void vtkCellArray::SetData(vtkTypeInt32Array* offsets, vtkTypeInt32Array* connec
   // vtkArrayDownCast to ensure this works when ArrayType32 is vtkIdTypeArray.
   storage.Offsets = vtkArrayDownCast<ArrayType32>(offsets);
   storage.Connectivity = vtkArrayDownCast<ArrayType32>(connectivity);
+  storage.FixedCellSize = 0;
   this->Modified();
 }
 
@@ -790,6 +811,7 @@ void vtkCellArray::SetData(vtkTypeInt64Array* offsets, vtkTypeInt64Array* connec
   // vtkArrayDownCast to ensure this works when ArrayType64 is vtkIdTypeArray.
   storage.Offsets = vtkArrayDownCast<ArrayType64>(offsets);
   storage.Connectivity = vtkArrayDownCast<ArrayType64>(connectivity);
+  storage.FixedCellSize = 0;
   this->Modified();
 }
 
@@ -900,22 +922,6 @@ struct SetDataGenericImpl
   }
 };
 
-struct GenerateOffsetsImpl
-{
-  vtkIdType CellSize;
-  vtkIdType ConnectivityArraySize;
-
-  template <typename ArrayT>
-  void operator()(ArrayT* offsets)
-  {
-    for (vtkIdType cc = 0, max = (offsets->GetNumberOfTuples() - 1); cc < max; ++cc)
-    {
-      offsets->SetTypedComponent(cc, 0, cc * this->CellSize);
-    }
-    offsets->SetTypedComponent(offsets->GetNumberOfTuples() - 1, 0, this->ConnectivityArraySize);
-  }
-};
-
 } // end anon namespace
 
 VTK_ABI_NAMESPACE_BEGIN
@@ -957,21 +963,20 @@ bool vtkCellArray::SetData(vtkIdType cellSize, vtkDataArray* connectivity)
     return false;
   }
 
+  // Only the first offset is stored, the others are computed from the cell
+  // size until the offsets array is needed.
   vtkSmartPointer<vtkDataArray> offsets;
   offsets.TakeReference(connectivity->NewInstance());
-  offsets->SetNumberOfTuples(1 + connectivity->GetNumberOfTuples() / cellSize);
-
-  GenerateOffsetsImpl worker{ cellSize, connectivity->GetNumberOfTuples() };
-  using SupportedArrays = vtkCellArray::InputArrayList;
-  using Dispatch = vtkArrayDispatch::DispatchByArray<SupportedArrays>;
-  if (!Dispatch::Execute(offsets, worker))
+  offsets->SetNumberOfComponents(1);
+  offsets->SetNumberOfTuples(1);
+  offsets->SetComponent(0, 0, 0.0);
+  if (!this->SetData(offsets, connectivity))
   {
-    vtkErrorMacro("Invalid array types passed to SetData: "
-      << "connectivity=" << connectivity->GetClassName());
     return false;
   }
 
-  return this->SetData(offsets, connectivity);
+  this->Visit([cellSize](auto& state) { state.FixedCellSize = cellSize; });
+  return true;
 }
 
 //------------------------------------------------------------------------------
@@ -1039,6 +1044,13 @@ bool vtkCellArray::ConvertTo32BitStorage()
   {
     return true;
   }
+  if (this->IsStorageFixedSize())
+  {
+    // only the connectivity is converted, the offsets stay implicit
+    vtkNew<ArrayType32> conn;
+    conn->DeepCopy(this->GetConnectivityArray());
+    return this->SetData(this->GetFixedCellSize(), conn);
+  }
   vtkNew<ArrayType32> offsets;
   vtkNew<ArrayType32> conn;
   if (!this->Visit(ExtractAndInitialize{}, offsets.Get(), conn.Get()))
@@ -1057,6 +1069,13 @@ bool vtkCellArray::ConvertTo64BitStorage()
   {
     return true;
   }
+  if (this->IsStorageFixedSize())
+  {
+    // only the connectivity is converted, the offsets stay implicit
+    vtkNew<ArrayType64> conn;
+    conn->DeepCopy(this->GetConnectivityArray());
+    return this->SetData(this->GetFixedCellSize(), conn);
+  }
   vtkNew<ArrayType64> offsets;
   vtkNew<ArrayType64> conn;
   if (!this->Visit(ExtractAndInitialize{}, offsets.Get(), conn.Get()))
@@ -1107,6 +1126,10 @@ bool vtkCellArray::ResizeExact(vtkIdType numCells, vtkIdType connectivitySize)
 int vtkCellArray::GetMaxCellSize()
 {
   const vtkIdType numCells = this->GetNumberOfCells();
+  if (this->IsStorageFixedSize())
+  {
+    return numCells > 0 ? static_cast<int>(this->GetFixedCellSize()) : 0;
+  }
   // We use THRESHOLD to test if the data size is small enough
   // to execute the functor serially. This is faster.
   // and also potentially avoids nested multithreading which creates race conditions.
@@ -1119,7 +1142,13 @@ int vtkCellArray::GetMaxCellSize()
 //------------------------------------------------------------------------------
 unsigned long vtkCellArray::GetActualMemorySize() const
 {
-  return this->Visit(GetActualMemorySizeImpl{});
+  // the stored arrays, without expanding the implicit offsets
+  return this->Visit(
+    [](auto& state) -> unsigned long
+    {
+      return state.Offsets->GetActualMemorySize() +
+        state.Connectivity->GetActualMemorySize();
+    });
 }
 
 //------------------------------------------------------------------------------
@@ -1128,9 +1157,16 @@ void vtkCellArray::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os, indent);
 
   os << indent << "StorageIs64Bit: " << this->Storage.Is64Bit() << "\n";
+  os << indent << "FixedCellSize: " << this->GetFixedCellSize() << "\n";
 
-  PrintSelfImpl functor;
-  this->Visit(functor, os, indent);
+  this->Visit(
+    [&](auto& state)
+    {
+      os << indent << "Offsets:\n";
+      state.Offsets->PrintSelf(os, indent.GetNextIndent());
+      os << indent << "Connectivity:\n";
+      state.Connectivity->PrintSelf(os, indent.GetNextIndent());
+    });
 }
 
 //------------------------------------------------------------------------------
@@ -1241,6 +1277,10 @@ bool vtkCellArray::IsValid()
 //------------------------------------------------------------------------------
 vtkIdType vtkCellArray::IsHomogeneous()
 {
+  if (this->IsStorageFixedSize())
+  {
+    return this->GetNumberOfCells() > 0 ? this->GetFixedCellSize() : 0;
+  }
   return this->Visit(IsHomogeneousImpl{});
 }
 VTK_ABI_NAMESPACE_END
@@ -136,8 +136,10 @@
 #include "vtkTypeInt64Array.h"       // Needed for inline methods
 #include "vtkTypeList.h"             // Needed for ArrayList definition
 
+#include <atomic>           // for std::atomic
 #include <cassert>          // for assert
 #include <initializer_list> // for API
+#include <mutex>            // for std::mutex
 #include <type_traits>      // for std::is_same
 #include <utility>          // for std::forward
 
@@ -305,11 +307,11 @@ public:
   {
     if (this->Storage.Is64Bit())
     {
-      return this->Storage.GetArrays64().Offsets->GetNumberOfValues() - 1;
+      return this->Storage.GetArrays64().GetNumberOfCells();
     }
     else
     {
-      return this->Storage.GetArrays32().Offsets->GetNumberOfValues() - 1;
+      return this->Storage.GetArrays32().GetNumberOfCells();
     }
   }
 
@@ -319,6 +321,10 @@ public:
    */
   vtkIdType GetNumberOfOffsets() const override
   {
+    if (this->IsStorageFixedSize())
+    {
+      return this->GetNumberOfCells() + 1;
+    }
     if (this->Storage.Is64Bit())
     {
       return this->Storage.GetArrays64().Offsets->GetNumberOfValues();
@@ -336,11 +342,11 @@ public:
   {
     if (this->Storage.Is64Bit())
     {
-      return this->Storage.GetArrays64().Offsets->GetValue(cellId);
+      return this->Storage.GetArrays64().GetBeginOffset(cellId);
     }
     else
     {
-      return this->Storage.GetArrays32().Offsets->GetValue(cellId);
+      return this->Storage.GetArrays32().GetBeginOffset(cellId);
     }
   }
 
@@ -349,6 +355,7 @@ public:
    */
   void SetOffset(vtkIdType cellId, vtkIdType offset)
   {
+    this->MakeOffsetsExplicit();
     if (this->Storage.Is64Bit())
     {
       this->Storage.GetArrays64().Offsets->SetValue(cellId, offset);
@@ -418,8 +425,11 @@ public:
   bool SetData(vtkDataArray* offsets, vtkDataArray* connectivity);
 
   /**
-   * Sets the internal arrays to the supported connectivity array with an
-   * offsets array automatically generated given the fixed cells size.
+   * Sets the internal arrays to the supported connectivity array of cells
+   * that all have `cellSize` points. The offsets are implicit: no offsets
+   * array is stored until one is requested, by GetOffsetsArray(),
+   * VisitState::GetOffsets() or a method that modifies the cells. See
+   * IsStorageFixedSize().
    *
    * This is a convenience method, and may fail if the following conditions
    * are not met:
@@ -438,6 +448,15 @@ public:
    */
   bool IsStorage64Bit() const { return this->Storage.Is64Bit(); }
 
+  /**
+   * @return True if all the cells have the same size and the offsets are
+   * implicit, i.e. only the connectivity array is stored. This is the case
+   * after SetData(cellSize, connectivity) until the explicit offsets are
+   * needed. The cell accessors (GetCellAtId(), GetCellSize(), the
+   * vtkCellArrayIterator, ...) do not need the explicit offsets.
+   */
+  bool IsStorageFixedSize() const { return this->GetFixedCellSize() > 0; }
+
   /**
    * @return True if the internal storage can be shared as a
    * pointer to vtkIdType, i.e., the type and organization of internal
@@ -511,6 +530,7 @@ public:
    */
   vtkDataArray* GetOffsetsArray()
   {
+    this->MakeOffsetsExplicit();
     if (this->Storage.Is64Bit())
     {
       return this->GetOffsetsArray64();
@@ -520,8 +540,16 @@ public:
       return this->GetOffsetsArray32();
     }
   }
-  ArrayType32* GetOffsetsArray32() { return this->Storage.GetArrays32().Offsets; }
-  ArrayType64* GetOffsetsArray64() { return this->Storage.GetArrays64().Offsets; }
+  ArrayType32* GetOffsetsArray32()
+  {
+    this->MakeOffsetsExplicit();
+    return this->Storage.GetArrays32().Offsets;
+  }
+  ArrayType64* GetOffsetsArray64()
+  {
+    this->MakeOffsetsExplicit();
+    return this->Storage.GetArrays64().Offsets;
+  }
   /**@}*/
 
   /**
@@ -832,8 +860,24 @@ public:
     static constexpr bool ValueTypeIsSameAsIdType = std::is_integral<ValueType>::value &&
       std::is_signed<ValueType>::value && (sizeof(ValueType) == sizeof(vtkIdType));
 
-    ArrayType* GetOffsets() { return this->Offsets; }
-    const ArrayType* GetOffsets() const { return this->Offsets; }
+    ///@{
+    /**
+     * The offsets array. When the offsets are implicit, see
+     * vtkCellArray::IsStorageFixedSize(), it is generated on the first call:
+     * the functors that only need the offsets of some cells should use the
+     * accessors below, which keep them implicit.
+     */
+    ArrayType* GetOffsets()
+    {
+      this->ExpandOffsets();
+      return this->Offsets;
+    }
+    const ArrayType* GetOffsets() const
+    {
+      this->ExpandOffsets();
+      return this->Offsets;
+    }
+    ///@}
 
     ArrayType* GetConnectivity() { return this->Connectivity; }
     const ArrayType* GetConnectivity() const { return this->Connectivity; }
@@ -862,6 +906,12 @@ public:
       }
     }
     ~VisitState() = default;
+
+    // Generate the Offsets array of implicit offsets. This is done at most
+    // once, even when the offsets of a const cell array are requested from
+    // several threads.
+    void ExpandOffsets() const;
+
     void* operator new(size_t nSize)
     {
       void* r;
@@ -892,6 +942,11 @@ public:
     vtkSmartPointer<ArrayType> Connectivity;
     vtkSmartPointer<ArrayType> Offsets;
 
+    // Size of all the cells when the offsets are implicit, 0 when the offsets
+    // are stored in the Offsets array, which then only holds the first offset.
+    mutable std::atomic<vtkIdType> FixedCellSize{ 0 };
+    mutable std::mutex OffsetsMutex;
+
   private:
     VisitState(const VisitState&) = delete;
     VisitState& operator=(const VisitState&) = delete;
@@ -936,6 +991,10 @@ public:
    * instantiated for the current storage type of the cell array. See that
    * class for usage details.
    *
+   * The offsets of a fixed size storage (see IsStorageFixedSize) stay
+   * implicit as long as the functor reads them with the accessors of the
+   * state, GetCellRange(), GetBeginOffset(), ..., rather than GetOffsets().
+   *
    * The functor may also:
    * - Return a value from `operator()`
    * - Pass additional arguments to `operator()`
@@ -1354,6 +1413,32 @@ protected:
     bool IsInMemkind = false;
   };
 
+  // Size of all the cells when the offsets are implicit, 0 otherwise.
+  vtkIdType GetFixedCellSize() const
+  {
+    if (this->Storage.Is64Bit())
+    {
+      return this->Storage.GetArrays64().FixedCellSize.load(std::memory_order_acquire);
+    }
+    else
+    {
+      return this->Storage.GetArrays32().FixedCellSize.load(std::memory_order_acquire);
+    }
+  }
+
+  // Generate the offsets array of a fixed size storage.
+  void MakeOffsetsExplicit() const
+  {
+    if (this->Storage.Is64Bit())
+    {
+      this->Storage.GetArrays64().ExpandOffsets();
+    }
+    else
+    {
+      this->Storage.GetArrays32().ExpandOffsets();
+    }
+  }
+
   Storage Storage;
   vtkIdType TraversalCellId{ 0 };
 
@@ -1366,28 +1451,73 @@ private:
   void operator=(const vtkCellArray&) = delete;
 };
 
+template <typename ArrayT>
+void vtkCellArray::VisitState<ArrayT>::ExpandOffsets() const
+{
+  if (this->FixedCellSize.load(std::memory_order_acquire) <= 0)
+  {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(this->OffsetsMutex);
+  const vtkIdType cellSize = this->FixedCellSize.load(std::memory_order_acquire);
+  if (cellSize <= 0)
+  {
+    return; // expanded by another thread
+  }
+  // The accessors do not use the Offsets array until FixedCellSize is reset,
+  // so it can be filled while other threads read the cells.
+  const vtkIdType numCells = this->Connectivity->GetNumberOfValues() / cellSize;
+  this->Offsets->SetNumberOfValues(numCells + 1);
+  for (vtkIdType cellId = 0; cellId <= numCells; ++cellId)
+  {
+    this->Offsets->SetValue(cellId, static_cast<ValueType>(cellId * cellSize));
+  }
+  this->FixedCellSize.store(0, std::memory_order_release);
+}
+
 template <typename ArrayT>
 vtkIdType vtkCellArray::VisitState<ArrayT>::GetNumberOfCells() const
 {
+  const vtkIdType cellSize = this->FixedCellSize.load(std::memory_order_acquire);
+  if (cellSize > 0)
+  {
+    return this->Connectivity->GetNumberOfValues() / cellSize;
+  }
   return this->Offsets->GetNumberOfValues() - 1;
 }
 
 template <typename ArrayT>
 vtkIdType vtkCellArray::VisitState<ArrayT>::GetBeginOffset(vtkIdType cellId) const
 {
+  const vtkIdType cellSize = this->FixedCellSize.load(std::memory_order_acquire);
+  if (cellSize > 0)
+  {
+    return cellId * cellSize;
+  }
   return static_cast<vtkIdType>(this->Offsets->GetValue(cellId));
 }
 
 template <typename ArrayT>
 vtkIdType vtkCellArray::VisitState<ArrayT>::GetEndOffset(vtkIdType cellId) const
 {
+  const vtkIdType cellSize = this->FixedCellSize.load(std::memory_order_acquire);
+  if (cellSize > 0)
+  {
+    return (cellId + 1) * cellSize;
+  }
   return static_cast<vtkIdType>(this->Offsets->GetValue(cellId + 1));
 }
 
 template <typename ArrayT>
 vtkIdType vtkCellArray::VisitState<ArrayT>::GetCellSize(vtkIdType cellId) const
 {
-  return this->GetEndOffset(cellId) - this->GetBeginOffset(cellId);
+  const vtkIdType cellSize = this->FixedCellSize.load(std::memory_order_acquire);
+  if (cellSize > 0)
+  {
+    return cellSize;
+  }
+  return static_cast<vtkIdType>(this->Offsets->GetValue(cellId + 1)) -
+    static_cast<vtkIdType>(this->Offsets->GetValue(cellId));
 }
 
 template <typename ArrayT>
@@ -1661,6 +1791,7 @@ inline vtkIdType vtkCellArray::InsertNextCell(int npts)
 //----------------------------------------------------------------------------
 inline void vtkCellArray::InsertCellPoint(vtkIdType id)
 {
+  this->MakeOffsetsExplicit();
   if (this->Storage.Is64Bit())
   {
     using ValueType = typename ArrayType64::ValueType;
@@ -1697,6 +1828,11 @@ inline vtkIdType vtkCellArray::InsertNextCell(vtkCell* cell)
 //----------------------------------------------------------------------------
 inline void vtkCellArray::Reset()
 {
+  if (this->IsStorageFixedSize())
+  {
+    // the Offsets array only holds the first offset
+    this->Visit([](auto& state) { state.FixedCellSize = 0; });
+  }
   this->Visit(vtkCellArray_detail::ResetImpl{});
 }
 
@@ -5,11 +5,16 @@
 #include "vtkCellArray.h"
 #include "vtkDataSet.h"
 #include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocalObject.h"
 #include "vtkSMPTools.h"
 
-#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <memory>
 
 VTK_ABI_NAMESPACE_BEGIN
 //------------------------------------------------------------------------------
@@ -142,8 +147,6 @@ void vtkCellLinks::BuildLinks()
   }
   vtkIdType numPts = this->NumberOfPoints = this->DataSet->GetNumberOfPoints();
   vtkIdType numCells = this->NumberOfCells = this->DataSet->GetNumberOfCells();
-  int j;
-  vtkIdType cellId;
 
   if (this->Array == nullptr)
   {
@@ -155,35 +158,82 @@ void vtkCellLinks::BuildLinks()
     this->Allocate(numPts);
   }
 
-  // Use fast path if polydata
-  vtkIdType npts;
-  const vtkIdType* pts;
-  vtkNew<vtkIdList> tempIds;
-
-  // traverse data to determine number of uses of each point
-  for (cellId = 0; cellId < numCells; cellId++)
+  // GetCellPoints() is thread safe once it has been called from a single
+  // thread (vtkPolyData builds its cells then).
+  if (numCells > 0)
   {
-    this->DataSet->GetCellPoints(cellId, npts, pts, tempIds);
-    for (j = 0; j < npts; j++)
-    {
-      this->IncrementLinkCount(pts[j]);
-    }
+    vtkIdType npts;
+    const vtkIdType* pts;
+    vtkNew<vtkIdList> tempIds;
+    this->DataSet->GetCellPoints(0, npts, pts, tempIds);
   }
 
-  // fill out lists with number of references to cells
-  std::vector<vtkIdType> linkLoc(numPts, 0);
+  // traverse data to determine number of uses of each point
+  std::unique_ptr<std::atomic<vtkIdType>[]> counts(new std::atomic<vtkIdType>[numPts]());
+  vtkSMPThreadLocalObject<vtkIdList> tlTempIds;
+  vtkSMPTools::For(0, numCells,
+    [&](vtkIdType cellId, vtkIdType endCellId)
+    {
+      vtkIdType cellSize;
+      const vtkIdType* cellPts;
+      vtkIdList* tempIds = tlTempIds.Local();
+      for (; cellId < endCellId; ++cellId)
+      {
+        this->DataSet->GetCellPoints(cellId, cellSize, cellPts, tempIds);
+        for (vtkIdType j = 0; j < cellSize; ++j)
+        {
+          counts[cellPts[j]].fetch_add(1, std::memory_order_relaxed);
+        }
+      }
+    });
 
   // now allocate storage for the links
+  vtkSMPTools::For(0, numPts,
+    [&](vtkIdType ptId, vtkIdType endPtId)
+    {
+      for (; ptId < endPtId; ++ptId)
+      {
+        this->Array[ptId].ncells = counts[ptId].load(std::memory_order_relaxed);
+      }
+    });
   this->AllocateLinks(numPts);
-  // fill out lists with cell ids
-  for (cellId = 0; cellId < numCells; cellId++)
-  {
-    this->DataSet->GetCellPoints(cellId, npts, pts, tempIds);
-    for (j = 0; j < npts; j++)
+
+  // fill out lists with cell ids. Each use of a point takes the next free
+  // position of its list by decrementing its count.
+  vtkSMPTools::For(0, numCells,
+    [&](vtkIdType cellId, vtkIdType endCellId)
     {
-      this->InsertCellReference(pts[j], (linkLoc[pts[j]])++, cellId);
-    }
-  }
+      vtkIdType cellSize;
+      const vtkIdType* cellPts;
+      vtkIdList* tempIds = tlTempIds.Local();
+      for (; cellId < endCellId; ++cellId)
+      {
+        this->DataSet->GetCellPoints(cellId, cellSize, cellPts, tempIds);
+        for (vtkIdType j = 0; j < cellSize; ++j)
+        {
+          const vtkIdType ptId = cellPts[j];
+          const vtkIdType pos =
+            this->Array[ptId].ncells - counts[ptId].fetch_sub(1, std::memory_order_relaxed);
+          this->Array[ptId].cells[pos] = cellId;
+        }
+      }
+    });
+
+  // the threads insert the cells in any order, sort the lists to get the
+  // cell ids in increasing order like a serial traversal
+  vtkSMPTools::For(0, numPts,
+    [&](vtkIdType ptId, vtkIdType endPtId)
+    {
+      for (; ptId < endPtId; ++ptId)
+      {
+        vtkIdType* cells = this->Array[ptId].cells;
+        const vtkIdType ncells = this->Array[ptId].ncells;
+        if (!std::is_sorted(cells, cells + ncells))
+        {
+          std::sort(cells, cells + ncells);
+        }
+      }
+    });
   this->MaxId = numPts - 1;
   this->BuildTime.Modified();
 }
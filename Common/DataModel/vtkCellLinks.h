@@ -59,7 +59,8 @@ public:
   ///@}
 
   /**
-   * Build the link list array from the input dataset.
+   * Build the link list array from the input dataset. The cells are traversed
+   * with vtkSMPTools, the cell ids of each list are in increasing order.
    */
   void BuildLinks() override;
 
@@ -23,15 +23,20 @@
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
 #include "vtkRectilinearGrid.h"
+#include "vtkSMPTools.h"
 #include "vtkTimerLog.h"
 #include "vtkUniformGrid.h"
 #include "vtkUnsignedCharArray.h"
 
 #include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
 #include <list>
 #include <map>
 #include <queue>
 #include <set>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 namespace
@@ -172,6 +177,264 @@ private:
 };
 }
 
+// helpers for the parallel build of the k-d tree, see vtkKdTree::DivideRegions()
+namespace
+{
+// Regions with fewer points are divided with the serial DivideRegion
+constexpr int ParallelSplitMinimumNumberOfPoints = 1 << 15;
+// Number of points per chunk of the data parallel passes
+constexpr int ChunkSize = 1 << 14;
+
+int GetNumberOfChunks(int npoints)
+{
+  return (npoints + ChunkSize - 1) / ChunkSize;
+}
+
+//------------------------------------------------------------------------------
+// Return the value of rank K of the dim coordinates of the points, i.e. the value Select_
+// moves to index K. The value is bracketed between two values of a regular sample of the
+// coordinates, then selected among the coordinates within the bracket.
+float SelectValue(const float* c1, int npoints, int dim, int K)
+{
+  const int sampleSize = std::min(npoints, ChunkSize);
+  std::vector<float> sample(sampleSize);
+  for (int i = 0; i < sampleSize; ++i)
+  {
+    const vtkIdType pointId = static_cast<vtkIdType>(i) * npoints / sampleSize;
+    sample[i] = c1[3 * pointId + dim];
+  }
+  std::sort(sample.begin(), sample.end());
+  const int rank = static_cast<int>(static_cast<vtkIdType>(K) * sampleSize / npoints);
+  const int margin = 4 * static_cast<int>(std::sqrt(static_cast<double>(sampleSize))) + 1;
+  float low = sample[std::max(rank - margin, 0)];
+  float high = sample[std::min(rank + margin, sampleSize - 1)];
+
+  const int numChunks = GetNumberOfChunks(npoints);
+  std::vector<int> numBelow(numChunks), numInside(numChunks);
+  while (true)
+  {
+    vtkSMPTools::For(0, numChunks,
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        for (vtkIdType chunk = begin; chunk < end; ++chunk)
+        {
+          const float* x = c1 + 3 * chunk * ChunkSize + dim;
+          const float* last = c1 + 3 * std::min<vtkIdType>((chunk + 1) * ChunkSize, npoints) + dim;
+          int below = 0, inside = 0;
+          for (; x < last; x += 3)
+          {
+            below += *x < low;
+            inside += *x >= low && *x <= high;
+          }
+          numBelow[chunk] = below;
+          numInside[chunk] = inside;
+        }
+      });
+    vtkIdType below = 0, inside = 0;
+    for (int chunk = 0; chunk < numChunks; ++chunk)
+    {
+      below += numBelow[chunk];
+      inside += numInside[chunk];
+    }
+    if (K < below || K >= below + inside)
+    {
+      if (low == -std::numeric_limits<float>::infinity() &&
+        high == std::numeric_limits<float>::infinity())
+      {
+        // NaN coordinates, which are not ordered
+        return high;
+      }
+      // the sample missed the value, bracket all the coordinates
+      low = -std::numeric_limits<float>::infinity();
+      high = std::numeric_limits<float>::infinity();
+      continue;
+    }
+    if (low == high)
+    {
+      return low;
+    }
+
+    // gather the coordinates within the bracket and select among them
+    std::vector<int> offsets(numChunks + 1, 0);
+    for (int chunk = 0; chunk < numChunks; ++chunk)
+    {
+      offsets[chunk + 1] = offsets[chunk] + numInside[chunk];
+    }
+    std::vector<float> values(inside);
+    vtkSMPTools::For(0, numChunks,
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        for (vtkIdType chunk = begin; chunk < end; ++chunk)
+        {
+          const float* x = c1 + 3 * chunk * ChunkSize + dim;
+          const float* last = c1 + 3 * std::min<vtkIdType>((chunk + 1) * ChunkSize, npoints) + dim;
+          float* value = values.data() + offsets[chunk];
+          for (; x < last; x += 3)
+          {
+            if (*x >= low && *x <= high)
+            {
+              *value++ = *x;
+            }
+          }
+        }
+      });
+    auto kth = values.begin() + (K - below);
+    std::nth_element(values.begin(), kth, values.end());
+    return *kth;
+  }
+}
+
+//------------------------------------------------------------------------------
+// Move the points whose dim coordinate is lower than value before the other points, keeping
+// their order, through the scratch buffers. Return the number of points moved to the left, 0 if
+// the points were not moved because none is lower than value. The bounds of the left and right
+// points are returned too.
+int Partition(float* c1, int* ids, int npoints, int dim, float value, float* scratchPoints,
+  int* scratchIds, float leftBounds[6], float rightBounds[6])
+{
+  const int numChunks = GetNumberOfChunks(npoints);
+  std::vector<int> numLeft(numChunks);
+  std::vector<std::array<float, 12>> chunkBounds(numChunks);
+  vtkSMPTools::For(0, numChunks,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType chunk = begin; chunk < end; ++chunk)
+      {
+        const float* x = c1 + 3 * chunk * ChunkSize;
+        const float* last = c1 + 3 * std::min<vtkIdType>((chunk + 1) * ChunkSize, npoints);
+        std::array<float, 12> bounds;
+        for (int i = 0; i < 12; i += 2)
+        {
+          bounds[i] = VTK_FLOAT_MAX;
+          bounds[i + 1] = -VTK_FLOAT_MAX;
+        }
+        int left = 0;
+        for (; x < last; x += 3)
+        {
+          const int side = x[dim] < value ? 0 : 6;
+          left += side == 0;
+          for (int i = 0; i < 3; ++i)
+          {
+            bounds[side + 2 * i] = std::min(bounds[side + 2 * i], x[i]);
+            bounds[side + 2 * i + 1] = std::max(bounds[side + 2 * i + 1], x[i]);
+          }
+        }
+        numLeft[chunk] = left;
+        chunkBounds[chunk] = bounds;
+      }
+    });
+
+  std::vector<int> leftOffsets(numChunks + 1, 0);
+  for (int i = 0; i < 6; i += 2)
+  {
+    leftBounds[i] = rightBounds[i] = VTK_FLOAT_MAX;
+    leftBounds[i + 1] = rightBounds[i + 1] = -VTK_FLOAT_MAX;
+  }
+  for (int chunk = 0; chunk < numChunks; ++chunk)
+  {
+    leftOffsets[chunk + 1] = leftOffsets[chunk] + numLeft[chunk];
+    for (int i = 0; i < 6; i += 2)
+    {
+      leftBounds[i] = std::min(leftBounds[i], chunkBounds[chunk][i]);
+      leftBounds[i + 1] = std::max(leftBounds[i + 1], chunkBounds[chunk][i + 1]);
+      rightBounds[i] = std::min(rightBounds[i], chunkBounds[chunk][i + 6]);
+      rightBounds[i + 1] = std::max(rightBounds[i + 1], chunkBounds[chunk][i + 7]);
+    }
+  }
+  const int nleft = leftOffsets[numChunks];
+  if (nleft == 0)
+  {
+    return 0;
+  }
+
+  vtkSMPTools::For(0, numChunks,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType chunk = begin; chunk < end; ++chunk)
+      {
+        const vtkIdType first = chunk * ChunkSize;
+        const vtkIdType last = std::min<vtkIdType>(first + ChunkSize, npoints);
+        vtkIdType left = leftOffsets[chunk];
+        vtkIdType right = nleft + first - leftOffsets[chunk];
+        for (vtkIdType i = first; i < last; ++i)
+        {
+          vtkIdType& to = c1[3 * i + dim] < value ? left : right;
+          std::copy(c1 + 3 * i, c1 + 3 * i + 3, scratchPoints + 3 * to);
+          if (ids)
+          {
+            scratchIds[to] = ids[i];
+          }
+          ++to;
+        }
+      }
+    });
+  vtkSMPTools::For(0, numChunks,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      const vtkIdType first = begin * ChunkSize;
+      const vtkIdType last = std::min<vtkIdType>(end * ChunkSize, npoints);
+      std::copy(scratchPoints + 3 * first, scratchPoints + 3 * last, c1 + 3 * first);
+      if (ids)
+      {
+        std::copy(scratchIds + first, scratchIds + last, ids + first);
+      }
+    });
+  return nleft;
+}
+
+//------------------------------------------------------------------------------
+// Same as vtkKdTree::AddNewRegions, with the data bounds of the new regions already known.
+void AddNewRegionsWithDataBounds(vtkKdNode* kd, int midpt, int dim, double coord,
+  const float leftBounds[6], const float rightBounds[6])
+{
+  vtkKdNode* left = vtkKdNode::New();
+  vtkKdNode* right = vtkKdNode::New();
+
+  kd->AddChildNodes(left, right);
+
+  double bounds[6];
+  kd->GetBounds(bounds);
+  bounds[2 * dim + 1] = coord;
+  left->SetBounds(bounds);
+  kd->GetBounds(bounds);
+  bounds[2 * dim] = coord;
+  right->SetBounds(bounds);
+
+  left->SetNumberOfPoints(midpt);
+  right->SetNumberOfPoints(kd->GetNumberOfPoints() - midpt);
+
+  left->SetDataBounds(leftBounds[0], leftBounds[1], leftBounds[2], leftBounds[3], leftBounds[4],
+    leftBounds[5]);
+  right->SetDataBounds(rightBounds[0], rightBounds[1], rightBounds[2], rightBounds[3],
+    rightBounds[4], rightBounds[5]);
+}
+
+//------------------------------------------------------------------------------
+// Same traversal as vtkBSPIntersections::IntersectsSphere2 with
+// ComputeIntersectionsUsingDataBounds on, without changing the state of the calculator so that
+// concurrent queries are safe.
+int FindRegionsIntersectingSphere(
+  vtkKdNode* node, int* ids, int len, double x, double y, double z, double r2)
+{
+  if (!node->IntersectsSphere2(x, y, z, r2, 1))
+  {
+    return 0;
+  }
+  if (node->GetLeft() == nullptr)
+  {
+    ids[0] = node->GetID();
+    return 1;
+  }
+  int nnodes = FindRegionsIntersectingSphere(node->GetLeft(), ids, len, x, y, z, r2);
+  if (len - nnodes > 0)
+  {
+    nnodes +=
+      FindRegionsIntersectingSphere(node->GetRight(), ids + nnodes, len - nnodes, x, y, z, r2);
+  }
+  return nnodes;
+}
+}
+
 //------------------------------------------------------------------------------
 vtkStandardNewMacro(vtkKdTree);
 
@@ -912,7 +1175,7 @@ void vtkKdTree::BuildLocatorInternal()
 
     this->ProgressOffset += this->ProgressScale;
     this->ProgressScale = 0.7;
-    this->DivideRegion(kd, ptarray, nullptr, 0);
+    this->DivideRegions(kd, ptarray, nullptr);
 
     TIMERDONE("Build tree");
 
@@ -1255,22 +1518,13 @@ int vtkKdTree::DivideTest(int size, int level)
 }
 
 //------------------------------------------------------------------------------
-int vtkKdTree::DivideRegion(vtkKdNode* kd, float* c1, int* ids, int level)
+void vtkKdTree::SelectCutDirections(vtkKdNode* kd, int dims[3])
 {
-  int ok = this->DivideTest(kd->GetNumberOfPoints(), level);
-
-  if (!ok)
-  {
-    return 0;
-  }
-
   int maxdim = this->SelectCutDirection(kd);
 
-  kd->SetDim(maxdim);
-
-  int dim1 = maxdim; // best cut direction
-  int dim2 = -1;     // other valid cut directions
-  int dim3 = -1;
+  dims[0] = maxdim; // best cut direction
+  dims[1] = -1;     // other valid cut directions
+  dims[2] = -1;
 
   int otherDirections = this->ValidDirections ^ (1 << maxdim);
 
@@ -1282,33 +1536,49 @@ int vtkKdTree::DivideRegion(vtkKdNode* kd, float* c1, int* ids, int level)
 
     if (x)
     {
-      dim2 = vtkKdTree::XDIM;
+      dims[1] = vtkKdTree::XDIM;
 
       if (y)
       {
-        dim3 = vtkKdTree::YDIM;
+        dims[2] = vtkKdTree::YDIM;
       }
       else if (z)
       {
-        dim3 = vtkKdTree::ZDIM;
+        dims[2] = vtkKdTree::ZDIM;
       }
     }
     else if (y)
     {
-      dim2 = vtkKdTree::YDIM;
+      dims[1] = vtkKdTree::YDIM;
 
       if (z)
       {
-        dim3 = vtkKdTree::ZDIM;
+        dims[2] = vtkKdTree::ZDIM;
       }
     }
     else if (z)
     {
-      dim2 = vtkKdTree::ZDIM;
+      dims[1] = vtkKdTree::ZDIM;
     }
   }
+}
 
-  this->DoMedianFind(kd, c1, ids, dim1, dim2, dim3);
+//------------------------------------------------------------------------------
+int vtkKdTree::DivideRegion(vtkKdNode* kd, float* c1, int* ids, int level)
+{
+  int ok = this->DivideTest(kd->GetNumberOfPoints(), level);
+
+  if (!ok)
+  {
+    return 0;
+  }
+
+  int dims[3];
+  this->SelectCutDirections(kd, dims);
+
+  kd->SetDim(dims[0]);
+
+  this->DoMedianFind(kd, c1, ids, dims[0], dims[1], dims[2]);
 
   if (kd->GetLeft() == nullptr)
   {
@@ -1327,6 +1597,89 @@ int vtkKdTree::DivideRegion(vtkKdNode* kd, float* c1, int* ids, int level)
   return 0;
 }
 
+//------------------------------------------------------------------------------
+void vtkKdTree::DivideRegions(vtkKdNode* kd, float* c1, int* ids)
+{
+  const int numThreads = vtkSMPTools::GetEstimatedNumberOfThreads();
+  if (numThreads < 2 || kd->GetNumberOfPoints() < ParallelSplitMinimumNumberOfPoints)
+  {
+    this->DivideRegion(kd, c1, ids, 0);
+    return;
+  }
+
+  // Regions with more points than subtreeSize are split one level at a time with data parallel
+  // passes. The points of a region are moved to the left region when their coordinate is lower
+  // than the median value, as Select does. The smaller regions are then divided with the serial
+  // DivideRegion, one subtree per task.
+  const int subtreeSize =
+    std::max(ParallelSplitMinimumNumberOfPoints, kd->GetNumberOfPoints() / (8 * numThreads));
+
+  struct Region
+  {
+    vtkKdNode* Node;
+    float* Points;
+    int* Ids;
+    int Level;
+  };
+  std::vector<Region> regions{ { kd, c1, ids, 0 } };
+  std::vector<Region> subtrees;
+  std::vector<float> scratchPoints(3 * static_cast<size_t>(kd->GetNumberOfPoints()));
+  std::vector<int> scratchIds(ids ? kd->GetNumberOfPoints() : 0);
+  while (!regions.empty())
+  {
+    std::vector<Region> nextRegions;
+    for (const Region& region : regions)
+    {
+      vtkKdNode* node = region.Node;
+      const int npoints = node->GetNumberOfPoints();
+      if (npoints < subtreeSize)
+      {
+        subtrees.push_back(region);
+        continue;
+      }
+      if (!this->DivideTest(npoints, region.Level))
+      {
+        continue;
+      }
+
+      int dims[3];
+      this->SelectCutDirections(node, dims);
+      node->SetDim(dims[0]);
+      for (int i = 0; i < 3 && dims[i] >= 0; ++i)
+      {
+        const float value = SelectValue(region.Points, npoints, dims[i], npoints / 2);
+        float leftBounds[6], rightBounds[6];
+        const int midpt = Partition(region.Points, region.Ids, npoints, dims[i], value,
+          scratchPoints.data(), scratchIds.data(), leftBounds, rightBounds);
+        if (midpt == 0)
+        {
+          continue; // all the points have the median value in this direction
+        }
+
+        node->SetDim(dims[i]);
+        const double coord =
+          (static_cast<double>(value) + static_cast<double>(leftBounds[2 * dims[i] + 1])) / 2.0;
+        AddNewRegionsWithDataBounds(node, midpt, dims[i], coord, leftBounds, rightBounds);
+        nextRegions.push_back({ node->GetLeft(), region.Points, region.Ids, region.Level + 1 });
+        nextRegions.push_back({ node->GetRight(), region.Points + 3 * static_cast<size_t>(midpt),
+          region.Ids ? region.Ids + midpt : nullptr, region.Level + 1 });
+        break;
+      }
+    }
+    regions.swap(nextRegions);
+  }
+
+  vtkSMPTools::For(0, static_cast<vtkIdType>(subtrees.size()), 1,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        const Region& region = subtrees[i];
+        this->DivideRegion(region.Node, region.Points, region.Ids, region.Level);
+      }
+    });
+}
+
 //------------------------------------------------------------------------------
 // Rearrange the point array.  Try dim1 first.  If there's a problem
 // go to dim2, then dim3.
@@ -1850,30 +2203,40 @@ void vtkKdTree::BuildLocatorFromPoints(vtkPoints** ptArrays, int numPtArrays)
       // Hopefully point arrays are usually floats.  This conversion will
       // really slow things down.
 
-      for (vtkIdType ii = 0; ii < npoints; ii++)
-      {
-        double* pt = ptArrays[i]->GetPoint(ii);
-
-        points[ptId++] = static_cast<float>(pt[0]);
-        points[ptId++] = static_cast<float>(pt[1]);
-        points[ptId++] = static_cast<float>(pt[2]);
-      }
+      vtkPoints* pts = ptArrays[i];
+      float* converted = points + ptId;
+      vtkSMPTools::For(0, npoints,
+        [&](vtkIdType begin, vtkIdType end)
+        {
+          double pt[3];
+          for (vtkIdType ii = begin; ii < end; ii++)
+          {
+            pts->GetPoint(ii, pt);
+            converted[3 * ii] = static_cast<float>(pt[0]);
+            converted[3 * ii + 1] = static_cast<float>(pt[1]);
+            converted[3 * ii + 2] = static_cast<float>(pt[2]);
+          }
+        });
+      ptId += nvals;
     }
   }
 
-  for (ptId = 0; ptId < totalNumPoints; ptId++)
-  {
-    // Select_ dominates DivideRegion algorithm, operating on
-    // ints is much fast than operating on long longs
-
-    ptIds[ptId] = ptId;
-  }
+  // Select_ dominates DivideRegion algorithm, operating on
+  // ints is much fast than operating on long longs
+  vtkSMPTools::For(0, totalNumPoints,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType id = begin; id < end; id++)
+      {
+        ptIds[id] = static_cast<int>(id);
+      }
+    });
 
   TIMERDONE("Set up to build k-d tree");
 
   TIMER("Build tree");
 
-  this->DivideRegion(kd, points, ptIds, 0);
+  this->DivideRegions(kd, points, ptIds);
 
   this->SetActualLevel();
   this->BuildRegionList();
@@ -2381,12 +2744,9 @@ int vtkKdTree::FindClosestPointInSphere(
   }
   int* regionIds = new int[this->NumberOfRegions];
 
-  this->BSPCalculator->ComputeIntersectionsUsingDataBoundsOn();
-
-  int nRegions = this->BSPCalculator->IntersectsSphere2(
-    regionIds, this->NumberOfRegions, x, y, z, radius * radius);
-
-  this->BSPCalculator->ComputeIntersectionsUsingDataBoundsOff();
+  // the state of BSPCalculator is not modified, so that queries can run concurrently
+  int nRegions = FindRegionsIntersectingSphere(
+    this->Top, regionIds, this->NumberOfRegions, x, y, z, radius * radius);
 
   double minDistance2 = 4 * this->MaxWidth * this->MaxWidth;
   int localCloseId = -1;
@@ -34,6 +34,13 @@
  *     tolerance, or you can use FindPoint and FindClosestPoint to
  *     locate points in the original set that the tree was built from.
  *
+ *     The k-d tree is built in parallel with vtkSMPTools for large point
+ *     sets: the largest regions are split with data parallel passes over
+ *     their points and the smaller regions are divided concurrently. This
+ *     needs a temporary buffer of 16 bytes per point. The regions are the
+ *     same as with a serial build, the order of the points within a region
+ *     may differ.
+ *
  * @sa
  *      vtkLocator vtkCellLocator vtkPKdTree
  */
@@ -511,6 +518,8 @@ public:
    * Given a position x and a radius r, return the id of the point
    * closest to the point in that radius.
    * dist2 returns the squared distance to the point.
+   * This method is thread safe if BuildLocator() is directly or
+   * indirectly called from a single thread first.
    */
   vtkIdType FindClosestPointWithinRadius(double radius, const double x[3], double& dist2);
 
@@ -768,6 +777,18 @@ protected:
 
   int DivideRegion(vtkKdNode* kd, float* c1, int* ids, int nlevels);
 
+  /**
+   * Divide the top region kd like DivideRegion. The largest regions are split with data parallel
+   * passes over their points and the smaller regions are divided concurrently, with
+   * vtkSMPTools. The regions get the same points as with DivideRegion, possibly in another order.
+   */
+  void DivideRegions(vtkKdNode* kd, float* c1, int* ids);
+
+  /**
+   * Get the cut directions to try in order to divide kd, -1 after the last valid direction.
+   */
+  void SelectCutDirections(vtkKdNode* kd, int dims[3]);
+
   void DoMedianFind(vtkKdNode* kd, float* c1, int* ids, int d1, int d2, int d3);
 
   void SelfRegister(vtkKdNode* kd);
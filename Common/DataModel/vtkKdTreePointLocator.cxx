@@ -121,6 +121,26 @@ void vtkKdTreePointLocator::GenerateRepresentation(int level, vtkPolyData* pd)
   this->KdTree->GenerateRepresentation(level, pd);
 }
 
+//------------------------------------------------------------------------------
+void vtkKdTreePointLocator::FindClosestPointBatch(vtkDataArray* queryPoints, vtkIdTypeArray* ids)
+{
+  this->Superclass::FindClosestPointBatch(queryPoints, ids, true);
+}
+
+//------------------------------------------------------------------------------
+void vtkKdTreePointLocator::FindClosestNPointsBatch(
+  int N, vtkDataArray* queryPoints, vtkIdTypeArray* offsets, vtkIdTypeArray* ids)
+{
+  this->Superclass::FindClosestNPointsBatch(N, queryPoints, offsets, ids, true);
+}
+
+//------------------------------------------------------------------------------
+void vtkKdTreePointLocator::FindPointsWithinRadiusBatch(
+  double R, vtkDataArray* queryPoints, vtkIdTypeArray* offsets, vtkIdTypeArray* ids)
+{
+  this->Superclass::FindPointsWithinRadiusBatch(R, queryPoints, offsets, ids, true);
+}
+
 //------------------------------------------------------------------------------
 void vtkKdTreePointLocator::PrintSelf(ostream& os, vtkIndent indent)
 {
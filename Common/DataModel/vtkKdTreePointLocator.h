@@ -18,7 +18,9 @@
 #include "vtkCommonDataModelModule.h" // For export macro
 
 VTK_ABI_NAMESPACE_BEGIN
+class vtkDataArray;
 class vtkIdList;
+class vtkIdTypeArray;
 class vtkKdTree;
 
 class VTKCOMMONDATAMODEL_EXPORT vtkKdTreePointLocator : public vtkAbstractPointLocator
@@ -40,6 +42,8 @@ public:
    * Given a position x and a radius r, return the id of the point
    * closest to the point in that radius.
    * dist2 returns the squared distance to the point.
+   * This method is thread safe if BuildLocator() is directly or
+   * indirectly called from a single thread first.
    */
   vtkIdType FindClosestPointWithinRadius(double radius, const double x[3], double& dist2) override;
 
@@ -61,6 +65,18 @@ public:
    */
   void FindPointsWithinRadius(double R, const double x[3], vtkIdList* result) override;
 
+  ///@{
+  /**
+   * Batched queries of vtkAbstractPointLocator, run in parallel with
+   * vtkSMPTools once the k-d tree is built.
+   */
+  void FindClosestPointBatch(vtkDataArray* queryPoints, vtkIdTypeArray* ids) override;
+  void FindClosestNPointsBatch(
+    int N, vtkDataArray* queryPoints, vtkIdTypeArray* offsets, vtkIdTypeArray* ids) override;
+  void FindPointsWithinRadiusBatch(
+    double R, vtkDataArray* queryPoints, vtkIdTypeArray* offsets, vtkIdTypeArray* ids) override;
+  ///@}
+
   ///@{
   /**
    * See vtkLocator interface documentation.
@@ -14,7 +14,10 @@
 #include "vtkOctreePointLocatorNode.h"
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 
+#include <algorithm>
+#include <array>
 #include <list>
 #include <map>
 #include <queue>
@@ -24,6 +27,9 @@
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkOctreePointLocator);
 
+// Below this number of points the octants are divided serially
+static const int VTK_PARALLEL_DIVISION_SIZE = 1 << 15;
+
 // helper class for ordering the points in
 // vtkOctreePointLocator::FindClosestNPoints()
 namespace
@@ -226,14 +232,21 @@ int vtkOctreePointLocator::DivideTest(int size, int level)
 
 //------------------------------------------------------------------------------
 void vtkOctreePointLocator::DivideRegion(vtkOctreePointLocatorNode* node, int* ordering, int level)
+{
+  this->DivideRegion(node, ordering, level, this->Level);
+}
+
+//------------------------------------------------------------------------------
+void vtkOctreePointLocator::DivideRegion(
+  vtkOctreePointLocatorNode* node, int* ordering, int level, int& maxLevel)
 {
   if (!this->DivideTest(node->GetNumberOfPoints(), level))
   {
     return;
   }
-  if (level >= this->Level)
+  if (level >= maxLevel)
   {
-    this->Level = level + 1;
+    maxLevel = level + 1;
   }
 
   node->CreateChildNodes();
@@ -243,9 +256,11 @@ void vtkOctreePointLocator::DivideRegion(vtkOctreePointLocatorNode* node, int* o
   std::vector<int> points[7];
   int i;
   int subOctantNumberOfPoints[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+  double pt[3];
   for (i = 0; i < numberOfPoints; i++)
   {
-    int index = node->GetSubOctantIndex(ds->GetPoint(ordering[i]), 0);
+    ds->GetPoint(ordering[i], pt);
+    int index = node->GetSubOctantIndex(pt, 0);
     if (index)
     {
       points[index - 1].push_back(ordering[i]);
@@ -270,11 +285,142 @@ void vtkOctreePointLocator::DivideRegion(vtkOctreePointLocatorNode* node, int* o
   for (i = 0; i < 8; i++)
   {
     node->GetChild(i)->SetNumberOfPoints(subOctantNumberOfPoints[i]);
-    this->DivideRegion(node->GetChild(i), ordering + counter, level + 1);
+    this->DivideRegion(node->GetChild(i), ordering + counter, level + 1, maxLevel);
     counter += subOctantNumberOfPoints[i];
   }
 }
 
+//------------------------------------------------------------------------------
+void vtkOctreePointLocator::DivideRegions(vtkOctreePointLocatorNode* node, int* ordering)
+{
+  const int numThreads = vtkSMPTools::GetEstimatedNumberOfThreads();
+  if (numThreads < 2 || node->GetNumberOfPoints() < VTK_PARALLEL_DIVISION_SIZE)
+  {
+    this->DivideRegion(node, ordering, 0);
+    return;
+  }
+
+  // Octants with more points than subtreeSize are divided one level at a time with data parallel
+  // passes, which keep the order of the points within each sub-octant as DivideRegion does. The
+  // smaller octants are then divided with the serial DivideRegion, one subtree per task.
+  const int subtreeSize =
+    std::max(VTK_PARALLEL_DIVISION_SIZE, node->GetNumberOfPoints() / (8 * numThreads));
+  const int chunkSize = VTK_PARALLEL_DIVISION_SIZE / 2;
+  vtkDataSet* ds = this->GetDataSet();
+
+  struct Octant
+  {
+    vtkOctreePointLocatorNode* Node;
+    int* Ordering;
+    int Level;
+  };
+  std::vector<Octant> octants{ { node, ordering, 0 } };
+  std::vector<Octant> subtrees;
+  std::vector<int> scratch(node->GetNumberOfPoints());
+  std::vector<unsigned char> subOctants(node->GetNumberOfPoints());
+  while (!octants.empty())
+  {
+    std::vector<Octant> nextOctants;
+    for (const Octant& octant : octants)
+    {
+      const int numberOfPoints = octant.Node->GetNumberOfPoints();
+      if (numberOfPoints < subtreeSize)
+      {
+        subtrees.push_back(octant);
+        continue;
+      }
+      if (!this->DivideTest(numberOfPoints, octant.Level))
+      {
+        continue;
+      }
+      if (octant.Level >= this->Level)
+      {
+        this->Level = octant.Level + 1;
+      }
+      octant.Node->CreateChildNodes();
+
+      // count the points of each sub-octant per chunk of points
+      const int numChunks = (numberOfPoints + chunkSize - 1) / chunkSize;
+      std::vector<std::array<int, 8>> counts(numChunks);
+      vtkSMPTools::For(0, numChunks,
+        [&](vtkIdType begin, vtkIdType end)
+        {
+          double pt[3];
+          for (vtkIdType chunk = begin; chunk < end; ++chunk)
+          {
+            std::array<int, 8>& count = counts[chunk];
+            count.fill(0);
+            const int last = std::min(numberOfPoints, static_cast<int>(chunk + 1) * chunkSize);
+            for (int i = static_cast<int>(chunk) * chunkSize; i < last; ++i)
+            {
+              ds->GetPoint(octant.Ordering[i], pt);
+              subOctants[i] = static_cast<unsigned char>(octant.Node->GetSubOctantIndex(pt, 0));
+              ++count[subOctants[i]];
+            }
+          }
+        });
+
+      // turn the counts into the positions of the points of each chunk in the sub-octants
+      std::array<int, 8> subOctantNumberOfPoints;
+      subOctantNumberOfPoints.fill(0);
+      for (int chunk = 0; chunk < numChunks; ++chunk)
+      {
+        for (int i = 0; i < 8; ++i)
+        {
+          const int count = counts[chunk][i];
+          counts[chunk][i] = subOctantNumberOfPoints[i];
+          subOctantNumberOfPoints[i] += count;
+        }
+      }
+      int counter = 0;
+      for (int i = 0; i < 8; ++i)
+      {
+        for (int chunk = 0; chunk < numChunks; ++chunk)
+        {
+          counts[chunk][i] += counter;
+        }
+        octant.Node->GetChild(i)->SetNumberOfPoints(subOctantNumberOfPoints[i]);
+        nextOctants.push_back(
+          { octant.Node->GetChild(i), octant.Ordering + counter, octant.Level + 1 });
+        counter += subOctantNumberOfPoints[i];
+      }
+
+      vtkSMPTools::For(0, numChunks,
+        [&](vtkIdType begin, vtkIdType end)
+        {
+          for (vtkIdType chunk = begin; chunk < end; ++chunk)
+          {
+            std::array<int, 8>& position = counts[chunk];
+            const int last = std::min(numberOfPoints, static_cast<int>(chunk + 1) * chunkSize);
+            for (int i = static_cast<int>(chunk) * chunkSize; i < last; ++i)
+            {
+              scratch[position[subOctants[i]]++] = octant.Ordering[i];
+            }
+          }
+        });
+      vtkSMPTools::For(0, numberOfPoints,
+        [&](vtkIdType begin, vtkIdType end)
+        { std::copy(scratch.begin() + begin, scratch.begin() + end, octant.Ordering + begin); });
+    }
+    octants.swap(nextOctants);
+  }
+
+  std::vector<int> maxLevels(subtrees.size(), 0);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(subtrees.size()), 1,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        const Octant& octant = subtrees[i];
+        this->DivideRegion(octant.Node, octant.Ordering, octant.Level, maxLevels[i]);
+      }
+    });
+  for (int maxLevel : maxLevels)
+  {
+    this->Level = std::max(this->Level, maxLevel);
+  }
+}
+
 //------------------------------------------------------------------------------
 void vtkOctreePointLocator::BuildLocator()
 {
@@ -395,23 +541,32 @@ void vtkOctreePointLocator::BuildLocatorInternal()
     return;
   }
 
-  for (i = 0; i < numPoints; i++)
-  {
-    this->LocatorIds[i] = i;
-  }
-  this->DivideRegion(node, this->LocatorIds, 0);
+  vtkSMPTools::For(0, numPoints,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType id = begin; id < end; id++)
+      {
+        this->LocatorIds[id] = static_cast<int>(id);
+      }
+    });
+  this->DivideRegions(node, this->LocatorIds);
   // TODO: may want to directly check if there exists a point array that
   // is of type float and directly copy that instead of dealing with
   // all of the casts
   vtkDataSet* ds = this->GetDataSet();
-  for (i = 0; i < numPoints; i++)
-  {
-    double* pt = ds->GetPoint(this->LocatorIds[i]);
+  vtkSMPTools::For(0, numPoints,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      double pt[3];
+      for (vtkIdType id = begin; id < end; id++)
+      {
+        ds->GetPoint(this->LocatorIds[id], pt);
 
-    this->LocatorPoints[i * 3] = static_cast<float>(pt[0]);
-    this->LocatorPoints[i * 3 + 1] = static_cast<float>(pt[1]);
-    this->LocatorPoints[i * 3 + 2] = static_cast<float>(pt[2]);
-  }
+        this->LocatorPoints[id * 3] = static_cast<float>(pt[0]);
+        this->LocatorPoints[id * 3 + 1] = static_cast<float>(pt[1]);
+        this->LocatorPoints[id * 3 + 2] = static_cast<float>(pt[2]);
+      }
+    });
 
   int nextLeafNodeId = 0;
   int nextMinId = 0;
@@ -1270,6 +1425,26 @@ void vtkOctreePointLocator::AddAllPointsInRegion(vtkOctreePointLocatorNode* node
   }
 }
 
+//------------------------------------------------------------------------------
+void vtkOctreePointLocator::FindClosestPointBatch(vtkDataArray* queryPoints, vtkIdTypeArray* ids)
+{
+  this->Superclass::FindClosestPointBatch(queryPoints, ids, true);
+}
+
+//------------------------------------------------------------------------------
+void vtkOctreePointLocator::FindClosestNPointsBatch(
+  int N, vtkDataArray* queryPoints, vtkIdTypeArray* offsets, vtkIdTypeArray* ids)
+{
+  this->Superclass::FindClosestNPointsBatch(N, queryPoints, offsets, ids, true);
+}
+
+//------------------------------------------------------------------------------
+void vtkOctreePointLocator::FindPointsWithinRadiusBatch(
+  double R, vtkDataArray* queryPoints, vtkIdTypeArray* offsets, vtkIdTypeArray* ids)
+{
+  this->Superclass::FindPointsWithinRadiusBatch(R, queryPoints, offsets, ids, true);
+}
+
 //------------------------------------------------------------------------------
 void vtkOctreePointLocator::PrintSelf(ostream& os, vtkIndent indent)
 {
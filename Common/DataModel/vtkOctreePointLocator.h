@@ -15,6 +15,11 @@
  * This class can also generate a PolyData representation of
  * the boundaries of the spatial regions in the decomposition.
  *
+ * The octree is built in parallel with vtkSMPTools for large data sets,
+ * with the same octants as a serial build. Once built, the point queries
+ * are thread safe, and the batched queries of vtkAbstractPointLocator run
+ * them for many points in parallel.
+ *
  * @sa
  * vtkLocator vtkPointLocator vtkOctreePointLocatorNode
  */
@@ -27,6 +32,7 @@
 
 VTK_ABI_NAMESPACE_BEGIN
 class vtkCellArray;
+class vtkDataArray;
 class vtkIdTypeArray;
 class vtkOctreePointLocatorNode;
 class vtkPoints;
@@ -116,6 +122,8 @@ public:
   /**
    * Return the Id of the point that is closest to the given point.
    * Set the square of the distance between the two points.
+   * These methods are thread safe if BuildLocator() is directly or
+   * indirectly called from a single thread first.
    */
   vtkIdType FindClosestPoint(const double x[3]) override;
   vtkIdType FindClosestPoint(double x, double y, double z, double& dist2);
@@ -125,6 +133,8 @@ public:
    * Given a position x and a radius r, return the id of the point
    * closest to the point in that radius.
    * dist2 returns the squared distance to the point.
+   * This method is thread safe if BuildLocator() is directly or
+   * indirectly called from a single thread first.
    */
   vtkIdType FindClosestPointWithinRadius(double radius, const double x[3], double& dist2) override;
 
@@ -141,9 +151,23 @@ public:
   /**
    * Find all points within a specified radius of position x.
    * The result is not sorted in any specific manner.
+   * This method is thread safe if BuildLocator() is directly or
+   * indirectly called from a single thread first.
    */
   void FindPointsWithinRadius(double radius, const double x[3], vtkIdList* result) override;
 
+  ///@{
+  /**
+   * Batched queries of vtkAbstractPointLocator, run in parallel with
+   * vtkSMPTools over the query points.
+   */
+  void FindClosestPointBatch(vtkDataArray* queryPoints, vtkIdTypeArray* ids) override;
+  void FindClosestNPointsBatch(
+    int N, vtkDataArray* queryPoints, vtkIdTypeArray* offsets, vtkIdTypeArray* ids) override;
+  void FindPointsWithinRadiusBatch(
+    double R, vtkDataArray* queryPoints, vtkIdTypeArray* offsets, vtkIdTypeArray* ids) override;
+  ///@}
+
   /**
    * Find the closest N points to a position. This returns the closest
    * N points to a position. A faster method could be created that returned
@@ -221,6 +245,19 @@ protected:
 
   void DivideRegion(vtkOctreePointLocatorNode* node, int* ordering, int level);
 
+  /**
+   * Same as DivideRegion, the depth of the divided octants being reported in maxLevel instead
+   * of Level so that disjoint octants can be divided concurrently.
+   */
+  void DivideRegion(vtkOctreePointLocatorNode* node, int* ordering, int level, int& maxLevel);
+
+  /**
+   * Divide the root octant like DivideRegion. The octants with the most points are divided with
+   * data parallel passes over their points and the smaller octants are divided concurrently,
+   * with vtkSMPTools. The octants get the same points, in the same order, as with DivideRegion.
+   */
+  void DivideRegions(vtkOctreePointLocatorNode* node, int* ordering);
+
   int DivideTest(int size, int level);
 
   void AddPolys(vtkOctreePointLocatorNode* node, vtkPoints* pts, vtkCellArray* polys);
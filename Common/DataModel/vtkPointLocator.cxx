@@ -9,13 +9,17 @@
 #include "vtkMath.h"
 #include "vtkObjectFactory.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 
 #include <algorithm> //std::sort
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkPointLocator);
 
 static const int VTK_INITIAL_SIZE = 1000;
+// Below this number of points the buckets are filled serially
+static const vtkIdType VTK_PARALLEL_BUILD_SIZE = 10000;
 
 //------------------------------------------------------------------------------
 // Utility class to store an array of ijk values
@@ -843,6 +847,23 @@ void vtkPointLocator::ForceBuildLocator()
   this->BuildLocatorInternal();
 }
 
+//------------------------------------------------------------------------------
+namespace
+{
+// The point ids sorted by bucket, to fill the buckets in parallel
+struct BucketTuple
+{
+  vtkIdType PtId;
+  vtkIdType Bucket;
+
+  // the ids are increasing in each bucket, as with the serial insertion
+  bool operator<(const BucketTuple& tuple) const
+  {
+    return this->Bucket < tuple.Bucket || (this->Bucket == tuple.Bucket && this->PtId < tuple.PtId);
+  }
+};
+}
+
 //------------------------------------------------------------------------------
 //  Method to form subdivision of space based on the points provided and
 //  subject to the constraints of levels and NumberOfPointsPerBucket.
@@ -915,18 +936,64 @@ void vtkPointLocator::BuildLocatorInternal()
   //  Insert each point into the appropriate bucket.  Make sure point
   //  falls within bucket.
   //
-  for (vtkIdType i = 0; i < numPts; ++i)
+  if (numPts >= VTK_PARALLEL_BUILD_SIZE && vtkSMPTools::GetEstimatedNumberOfThreads() > 1)
   {
-    this->DataSet->GetPoint(i, x);
-    idx = this->GetBucketIndex(x);
-    bucket = this->HashTable[idx];
-    if (!bucket)
+    // Sort the points by bucket, then fill each bucket from its run of points. The buckets get
+    // the same lists as with the serial insertion.
+    std::vector<BucketTuple> tuples(numPts);
+    vtkSMPTools::For(0, numPts,
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        double pt[3];
+        for (vtkIdType ptId = begin; ptId < end; ++ptId)
+        {
+          this->DataSet->GetPoint(ptId, pt);
+          tuples[ptId].PtId = ptId;
+          tuples[ptId].Bucket = this->GetBucketIndex(pt);
+        }
+      });
+    vtkSMPTools::Sort(tuples.begin(), tuples.end());
+    vtkSMPTools::For(0, numPts,
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        // a run of points is processed by the range where it starts
+        for (vtkIdType first = begin; first < end; ++first)
+        {
+          if (first > 0 && tuples[first].Bucket == tuples[first - 1].Bucket)
+          {
+            continue;
+          }
+          vtkIdType last = first + 1;
+          while (last < numPts && tuples[last].Bucket == tuples[first].Bucket)
+          {
+            ++last;
+          }
+          vtkIdList* ids = vtkIdList::New();
+          ids->SetNumberOfIds(last - first);
+          for (vtkIdType i = first; i < last; ++i)
+          {
+            ids->SetId(i - first, tuples[i].PtId);
+          }
+          this->HashTable[tuples[first].Bucket] = ids;
+          first = last - 1;
+        }
+      });
+  }
+  else
+  {
+    for (vtkIdType i = 0; i < numPts; ++i)
     {
-      bucket = vtkIdList::New();
-      bucket->Allocate(this->NumberOfPointsPerBucket, this->NumberOfPointsPerBucket / 3);
-      this->HashTable[idx] = bucket;
+      this->DataSet->GetPoint(i, x);
+      idx = this->GetBucketIndex(x);
+      bucket = this->HashTable[idx];
+      if (!bucket)
+      {
+        bucket = vtkIdList::New();
+        bucket->Allocate(this->NumberOfPointsPerBucket, this->NumberOfPointsPerBucket / 3);
+        this->HashTable[idx] = bucket;
+      }
+      bucket->InsertNextId(i);
     }
-    bucket->InsertNextId(i);
   }
 
   // Okay we're done update mtime
@@ -1711,6 +1778,26 @@ double vtkPointLocator::Distance2ToBounds(const double x[3], const double bounds
   return distance;
 }
 
+//------------------------------------------------------------------------------
+void vtkPointLocator::FindClosestPointBatch(vtkDataArray* queryPoints, vtkIdTypeArray* ids)
+{
+  this->Superclass::FindClosestPointBatch(queryPoints, ids, true);
+}
+
+//------------------------------------------------------------------------------
+void vtkPointLocator::FindClosestNPointsBatch(
+  int N, vtkDataArray* queryPoints, vtkIdTypeArray* offsets, vtkIdTypeArray* ids)
+{
+  this->Superclass::FindClosestNPointsBatch(N, queryPoints, offsets, ids, true);
+}
+
+//------------------------------------------------------------------------------
+void vtkPointLocator::FindPointsWithinRadiusBatch(
+  double R, vtkDataArray* queryPoints, vtkIdTypeArray* offsets, vtkIdTypeArray* ids)
+{
+  this->Superclass::FindPointsWithinRadiusBatch(R, queryPoints, offsets, ids, true);
+}
+
 //------------------------------------------------------------------------------
 void vtkPointLocator::PrintSelf(ostream& os, vtkIndent indent)
 {
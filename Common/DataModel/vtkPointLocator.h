@@ -26,6 +26,9 @@
  * vtkStaticCellLocator is threaded and is typically much faster for
  * a large number of points (on the order of 3-5x faster). For small numbers
  * of points, vtkPointLocator is just as fast as vtkStaticPointLocator.
+ * BuildLocator() fills the buckets of large data sets in parallel too, and
+ * the batched queries of vtkAbstractPointLocator run the thread safe point
+ * queries for many points in parallel.
  *
  * @sa
  * vtkCellPicker vtkPointPicker vtkStaticPointLocator
@@ -39,7 +42,9 @@
 
 VTK_ABI_NAMESPACE_BEGIN
 class vtkCellArray;
+class vtkDataArray;
 class vtkIdList;
+class vtkIdTypeArray;
 class vtkNeighborPoints;
 class vtkPoints;
 
@@ -206,6 +211,18 @@ public:
    */
   void FindPointsWithinRadius(double R, const double x[3], vtkIdList* result) override;
 
+  ///@{
+  /**
+   * Batched queries of vtkAbstractPointLocator. The point queries being thread
+   * safe once the buckets are built, they run in parallel with vtkSMPTools.
+   */
+  void FindClosestPointBatch(vtkDataArray* queryPoints, vtkIdTypeArray* ids) override;
+  void FindClosestNPointsBatch(
+    int N, vtkDataArray* queryPoints, vtkIdTypeArray* offsets, vtkIdTypeArray* ids) override;
+  void FindPointsWithinRadiusBatch(
+    double R, vtkDataArray* queryPoints, vtkIdTypeArray* offsets, vtkIdTypeArray* ids) override;
+  ///@}
+
   /**
    * Given a position x, return the list of points in the bucket that
    * contains the point. It is possible that nullptr is returned. The user
@@ -195,7 +195,6 @@ struct BuildLinks
     using ValueType = typename CellStateT::ValueType;
 
     const auto cellConnectivity = vtk::DataArrayValueRange<1>(state.GetConnectivity());
-    const auto cellOffsets = vtk::DataArrayValueRange<1>(state.GetOffsets());
     // Now build the links. The summation from the prefix sum indicates where
     // the cells are to be inserted. Each time a cell is inserted, the offset
     // is decremented. In the end, the offset array is also constructed as it
@@ -205,7 +204,9 @@ struct BuildLinks
     TIds offset;
     for (vtkIdType cellId = beginCellId; cellId < endCellId; ++cellId)
     {
-      for (ptIdOffset = cellOffsets[cellId]; ptIdOffset < cellOffsets[cellId + 1]; ++ptIdOffset)
+      const ValueType endOffset = static_cast<ValueType>(state.GetEndOffset(cellId));
+      for (ptIdOffset = static_cast<ValueType>(state.GetBeginOffset(cellId)); ptIdOffset < endOffset;
+           ++ptIdOffset)
       {
         ptId = static_cast<size_t>(cellConnectivity[ptIdOffset]);
         // memory_order_relaxed is safe here, since we're not using the atomics for synchronization.
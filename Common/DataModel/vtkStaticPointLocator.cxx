@@ -2365,6 +2365,26 @@ void vtkStaticPointLocator::MergePointsWithData(vtkDataArray* data, vtkIdType* p
   }
 }
 
+//------------------------------------------------------------------------------
+void vtkStaticPointLocator::FindClosestPointBatch(vtkDataArray* queryPoints, vtkIdTypeArray* ids)
+{
+  this->Superclass::FindClosestPointBatch(queryPoints, ids, true);
+}
+
+//------------------------------------------------------------------------------
+void vtkStaticPointLocator::FindClosestNPointsBatch(
+  int N, vtkDataArray* queryPoints, vtkIdTypeArray* offsets, vtkIdTypeArray* ids)
+{
+  this->Superclass::FindClosestNPointsBatch(N, queryPoints, offsets, ids, true);
+}
+
+//------------------------------------------------------------------------------
+void vtkStaticPointLocator::FindPointsWithinRadiusBatch(
+  double R, vtkDataArray* queryPoints, vtkIdTypeArray* offsets, vtkIdTypeArray* ids)
+{
+  this->Superclass::FindPointsWithinRadiusBatch(R, queryPoints, offsets, ids, true);
+}
+
 //------------------------------------------------------------------------------
 void vtkStaticPointLocator::PrintSelf(ostream& os, vtkIndent indent)
 {
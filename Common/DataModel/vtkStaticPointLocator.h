@@ -50,6 +50,7 @@
 
 VTK_ABI_NAMESPACE_BEGIN
 class vtkIdList;
+class vtkIdTypeArray;
 struct vtkBucketList;
 class vtkDataArray;
 
@@ -139,6 +140,18 @@ public:
    */
   void FindPointsWithinRadius(double R, const double x[3], vtkIdList* result) override;
 
+  ///@{
+  /**
+   * Batched queries of vtkAbstractPointLocator. They run the thread safe
+   * point queries above in parallel with vtkSMPTools.
+   */
+  void FindClosestPointBatch(vtkDataArray* queryPoints, vtkIdTypeArray* ids) override;
+  void FindClosestNPointsBatch(
+    int N, vtkDataArray* queryPoints, vtkIdTypeArray* offsets, vtkIdTypeArray* ids) override;
+  void FindPointsWithinRadiusBatch(
+    double R, vtkDataArray* queryPoints, vtkIdTypeArray* offsets, vtkIdTypeArray* ids) override;
+  ///@}
+
   /**
    * Intersect the points contained in the locator with the line defined by
    * (a0,a1). Return the point within the tolerance tol that is closest to a0
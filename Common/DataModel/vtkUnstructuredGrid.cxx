@@ -22,12 +22,15 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyhedron.h"
+#include "vtkSMPTools.h"
 #include "vtkStaticCellLinks.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGridCellIterator.h"
 
 #include <algorithm>
+#include <numeric>
 #include <set>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkUnstructuredGrid);
@@ -788,64 +791,79 @@ void vtkUnstructuredGrid::GetPolyhedronFaces(vtkIdType cellId, vtkCellArray* fac
 // Supporting functions for CopyPolyhedronToFaceStream()
 namespace
 {
-template <typename FaceIdType>
-struct InsertFaceStreamVisitor
+// Dispatch a functor with the storage of both the face locations and the faces.
+template <typename Functor, typename... Args>
+void VisitPolyhedronFaces(
+  vtkCellArray* faceLocations, vtkCellArray* faces, Functor&& functor, Args&&... args)
 {
-  // Insert full cell
-  template <typename CellStateT>
-  vtkIdType operator()(CellStateT& state, const vtkIdType NumberOfFaces,
-    const FaceIdType* cellFaces, vtkIdTypeArray* faceStream)
-  {
-    vtkIdType loc = 0;
-
-    faceStream->InsertNextValue(NumberOfFaces);
-    loc++;
-    for (vtkIdType faceNum = 0; faceNum < NumberOfFaces; ++faceNum)
+  faceLocations->Visit(
+    [&](auto& locationState)
     {
-      const vtkIdType beginOffset = state.GetBeginOffset(cellFaces[faceNum]);
-      const vtkIdType endOffset = state.GetEndOffset(cellFaces[faceNum]);
-      const vtkIdType NumberOfPoints = endOffset - beginOffset;
-      const auto cellPoints = state.GetConnectivity()->GetPointer(beginOffset);
+      faces->Visit([&](auto& faceState) { functor(locationState, faceState, args...); });
+    });
+}
 
-      faceStream->InsertNextValue(NumberOfPoints);
-      for (vtkIdType ptIdx = 0; ptIdx < NumberOfPoints; ++ptIdx)
+// The face stream of a cell is [nCellFaces, nFace0Pts, i, j, k, nFace1Pts, ...],
+// the cells without faces have an empty stream and a -1 location. The streams
+// are sized in parallel, their locations are summed, then each thread fills its
+// cells.
+struct FaceStreamSizesWorker
+{
+  template <typename LocationStateT, typename FaceStateT>
+  void operator()(LocationStateT& locationState, FaceStateT& faceState, vtkIdType* sizes)
+  {
+    const auto cellFaces = locationState.GetConnectivity()->GetPointer(0);
+    vtkSMPTools::For(0, locationState.GetNumberOfCells(),
+      [&](vtkIdType cellId, vtkIdType endCellId)
       {
-        faceStream->InsertNextValue(static_cast<vtkIdType>(cellPoints[ptIdx]));
-      }
-      loc += NumberOfPoints + 1;
-    }
-    return loc;
+        for (; cellId < endCellId; ++cellId)
+        {
+          const vtkIdType beginOffset = locationState.GetBeginOffset(cellId);
+          const vtkIdType endOffset = locationState.GetEndOffset(cellId);
+          vtkIdType size = beginOffset == endOffset ? 0 : 1 + endOffset - beginOffset;
+          for (vtkIdType loc = beginOffset; loc < endOffset; ++loc)
+          {
+            size += faceState.GetCellSize(static_cast<vtkIdType>(cellFaces[loc]));
+          }
+          sizes[cellId + 1] = size;
+        }
+      });
   }
 };
 
-struct InsertPolyLocationVisitor
+struct FaceStreamFillWorker
 {
-  // Insert full cell
-  template <typename CellStateT>
-  void operator()(CellStateT& state, vtkCellArray* faceArray, vtkIdTypeArray* faceStream,
-    vtkIdTypeArray* faceLocation)
+  template <typename LocationStateT, typename FaceStateT>
+  void operator()(LocationStateT& locationState, FaceStateT& faceState, const vtkIdType* locations,
+    vtkIdType* faceLocation, vtkIdType* faceStream)
   {
-
-    using ValueType = typename CellStateT::ValueType;
-    using TInsertFaceStream = InsertFaceStreamVisitor<ValueType>;
-
-    const vtkIdType numCells = state.GetNumberOfCells();
-    vtkIdType loc = 0;
-
-    for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
-    {
-      const vtkIdType beginOffset = state.GetBeginOffset(cellId);
-      const vtkIdType endOffset = state.GetEndOffset(cellId);
-      const vtkIdType NumberOfFaces = endOffset - beginOffset;
-      if (NumberOfFaces == 0)
+    const auto cellFaces = locationState.GetConnectivity()->GetPointer(0);
+    const auto facePoints = faceState.GetConnectivity()->GetPointer(0);
+    vtkSMPTools::For(0, locationState.GetNumberOfCells(),
+      [&](vtkIdType cellId, vtkIdType endCellId)
       {
-        faceLocation->InsertNextValue(-1);
-        return;
-      }
-      faceLocation->InsertNextValue(loc);
-      const auto cellFaces = state.GetConnectivity()->GetPointer(beginOffset);
-      loc += faceArray->Visit(TInsertFaceStream{}, NumberOfFaces, cellFaces, faceStream);
-    }
+        for (; cellId < endCellId; ++cellId)
+        {
+          const vtkIdType beginOffset = locationState.GetBeginOffset(cellId);
+          const vtkIdType endOffset = locationState.GetEndOffset(cellId);
+          if (beginOffset == endOffset)
+          {
+            faceLocation[cellId] = -1;
+            continue;
+          }
+          faceLocation[cellId] = locations[cellId];
+          vtkIdType* stream = faceStream + locations[cellId];
+          *stream++ = endOffset - beginOffset;
+          for (vtkIdType loc = beginOffset; loc < endOffset; ++loc)
+          {
+            const vtkIdType faceId = static_cast<vtkIdType>(cellFaces[loc]);
+            const vtkIdType beginPoint = faceState.GetBeginOffset(faceId);
+            const vtkIdType endPoint = faceState.GetEndOffset(faceId);
+            *stream++ = endPoint - beginPoint;
+            stream = std::copy(facePoints + beginPoint, facePoints + endPoint, stream);
+          }
+        }
+      });
   }
 };
 }
@@ -868,24 +886,23 @@ int vtkUnstructuredGrid::CopyPolyhedronToFaceStream(vtkCellArray* faceArray,
   {
     faceLocationTmp = faceLocation;
   }
-  vtkIdType SizeCount = 0;
-  vtkIdType NumberOfFaces = 0;
-  // Estimate Size needed for the face stream
-  for (vtkIdType cellId = 0; cellId < faceLocationArray->GetNumberOfCells(); ++cellId)
-  {
-    NumberOfFaces = faceLocationArray->GetCellSize(cellId);
-    if (NumberOfFaces != 0)
-    {
-      SizeCount += NumberOfFaces + 1;
-    }
-  }
-  SizeCount += faceArray->GetConnectivityArray()->GetNumberOfValues();
-  faceStream->Allocate(SizeCount);
+  const vtkIdType numCells = faceLocationArray->GetNumberOfCells();
+
+  // Size the stream of each cell, a face can be listed by several cells
+  std::vector<vtkIdType> locations(numCells + 1, 0);
+  VisitPolyhedronFaces(faceLocationArray, faceArray, FaceStreamSizesWorker{}, locations.data());
+  std::partial_sum(locations.begin(), locations.end(), locations.begin());
+
   // faceLocation is exactly the size of NumberOfCells.
-  faceLocationTmp->Allocate(faceLocationArray->GetNumberOfCells());
+  faceStream->SetNumberOfValues(locations[numCells]);
+  faceLocationTmp->SetNumberOfValues(numCells);
 
   // Fill the arrays
-  faceLocationArray->Visit(InsertPolyLocationVisitor{}, faceArray, faceStream, faceLocationTmp);
+  VisitPolyhedronFaces(faceLocationArray, faceArray, FaceStreamFillWorker{}, locations.data(),
+    faceLocationTmp->GetPointer(0), faceStream->GetPointer(0));
+  // GetFaces() and GetFaceLocations() compare this time with the faces one
+  faceStream->Modified();
+  faceLocationTmp->Modified();
 
   return 1;
 }
@@ -995,11 +1012,190 @@ void vtkUnstructuredGrid::SetCells(int* types, vtkCellArray* cells)
   this->SetCells(cellTypes, cells);
 }
 
+//------------------------------------------------------------------------------
+// Supporting functions for SetCells() with polyhedron face streams
+namespace
+{
+// Convert the face streams [nCellFaces, nFace0Pts, i, j, k, nFace1Pts, ...] of
+// the polyhedra into the face locations and faces cell arrays. Like
+// CopyPolyhedronToFaceStream(), the cells are sized in parallel, then each
+// thread fills its cells. getFaceStream(cellId) returns the stream of a
+// polyhedron and nullptr for the other cells.
+template <typename GetFaceStreamT>
+void FaceStreamsToCellArrays(vtkIdType numCells, GetFaceStreamT&& getFaceStream,
+  vtkCellArray* faceLocations, vtkCellArray* faces)
+{
+  // Count the faces and the face points of each cell
+  vtkNew<vtkIdTypeArray> locationOffsets;
+  locationOffsets->SetNumberOfValues(numCells + 1);
+  vtkIdType* firstFaceIds = locationOffsets->GetPointer(0);
+  std::vector<vtkIdType> firstPoints(numCells + 1);
+  firstFaceIds[0] = firstPoints[0] = 0;
+  vtkSMPTools::For(0, numCells,
+    [&](vtkIdType cellId, vtkIdType endCellId)
+    {
+      for (; cellId < endCellId; ++cellId)
+      {
+        vtkIdType numFaces = 0;
+        vtkIdType numPoints = 0;
+        if (const auto stream = getFaceStream(cellId))
+        {
+          numFaces = std::max<vtkIdType>(static_cast<vtkIdType>(stream[0]), 0);
+          auto face = stream + 1;
+          for (vtkIdType faceNum = 0; faceNum < numFaces; ++faceNum)
+          {
+            const vtkIdType npts = static_cast<vtkIdType>(*face);
+            numPoints += npts;
+            face += npts + 1;
+          }
+        }
+        firstFaceIds[cellId + 1] = numFaces;
+        firstPoints[cellId + 1] = numPoints;
+      }
+    });
+  std::partial_sum(firstFaceIds, firstFaceIds + numCells + 1, firstFaceIds);
+  std::partial_sum(firstPoints.begin(), firstPoints.end(), firstPoints.begin());
+  const vtkIdType numFaces = firstFaceIds[numCells];
+
+  // The faces are numbered in the order of the cells
+  vtkNew<vtkIdTypeArray> locationConnectivity;
+  locationConnectivity->SetNumberOfValues(numFaces);
+  vtkNew<vtkIdTypeArray> faceOffsets;
+  faceOffsets->SetNumberOfValues(numFaces + 1);
+  vtkNew<vtkIdTypeArray> faceConnectivity;
+  faceConnectivity->SetNumberOfValues(firstPoints[numCells]);
+  vtkIdType* faceIds = locationConnectivity->GetPointer(0);
+  vtkIdType* offsets = faceOffsets->GetPointer(0);
+  vtkIdType* points = faceConnectivity->GetPointer(0);
+  offsets[numFaces] = firstPoints[numCells];
+  vtkSMPTools::For(0, numCells,
+    [&](vtkIdType cellId, vtkIdType endCellId)
+    {
+      for (; cellId < endCellId; ++cellId)
+      {
+        const auto stream = getFaceStream(cellId);
+        if (!stream)
+        {
+          continue;
+        }
+        auto face = stream + 1;
+        vtkIdType offset = firstPoints[cellId];
+        for (vtkIdType faceId = firstFaceIds[cellId]; faceId < firstFaceIds[cellId + 1]; ++faceId)
+        {
+          const vtkIdType npts = static_cast<vtkIdType>(*face++);
+          faceIds[faceId] = faceId;
+          offsets[faceId] = offset;
+          std::copy(face, face + npts, points + offset);
+          offset += npts;
+          face += npts;
+        }
+      }
+    });
+
+  faceLocations->SetData(locationOffsets, locationConnectivity);
+  faces->SetData(faceOffsets, faceConnectivity);
+}
+
+// Gather the sorted unique point ids of a polyhedron face stream, which is the
+// order used by DecomposeAPolyhedronCell().
+template <typename ValueType>
+void GetPolyhedronPointIds(const ValueType* stream, std::vector<vtkIdType>& pointIds)
+{
+  pointIds.clear();
+  const vtkIdType numFaces = std::max<vtkIdType>(static_cast<vtkIdType>(stream[0]), 0);
+  auto face = stream + 1;
+  for (vtkIdType faceNum = 0; faceNum < numFaces; ++faceNum)
+  {
+    const vtkIdType npts = static_cast<vtkIdType>(*face++);
+    pointIds.insert(pointIds.end(), face, face + npts);
+    face += npts;
+  }
+  std::sort(pointIds.begin(), pointIds.end());
+  pointIds.erase(std::unique(pointIds.begin(), pointIds.end()), pointIds.end());
+}
+
+// Split a cell array holding the face streams of its polyhedra into the cell
+// connectivity, the face locations and the faces.
+struct DecomposePolyhedraWorker
+{
+  template <typename CellStateT>
+  void operator()(CellStateT& state, const unsigned char* types, vtkCellArray* newCells,
+    vtkCellArray* faceLocations, vtkCellArray* faces)
+  {
+    using ValueType = typename CellStateT::ValueType;
+    const vtkIdType numCells = state.GetNumberOfCells();
+    const ValueType* connectivity = state.GetConnectivity()->GetPointer(0);
+    auto getFaceStream = [&](vtkIdType cellId) -> const ValueType*
+    {
+      const vtkIdType beginOffset = state.GetBeginOffset(cellId);
+      return types[cellId] == VTK_POLYHEDRON && state.GetEndOffset(cellId) > beginOffset
+        ? connectivity + beginOffset
+        : nullptr;
+    };
+    FaceStreamsToCellArrays(numCells, getFaceStream, faceLocations, faces);
+
+    // The polyhedra keep the unique ids of their face points
+    vtkNew<vtkIdTypeArray> cellOffsets;
+    cellOffsets->SetNumberOfValues(numCells + 1);
+    vtkIdType* offsets = cellOffsets->GetPointer(0);
+    offsets[0] = 0;
+    vtkSMPTools::For(0, numCells,
+      [&](vtkIdType cellId, vtkIdType endCellId)
+      {
+        std::vector<vtkIdType> pointIds;
+        for (; cellId < endCellId; ++cellId)
+        {
+          if (types[cellId] == VTK_POLYHEDRON)
+          {
+            const auto stream = getFaceStream(cellId);
+            pointIds.clear();
+            if (stream)
+            {
+              GetPolyhedronPointIds(stream, pointIds);
+            }
+            offsets[cellId + 1] = static_cast<vtkIdType>(pointIds.size());
+          }
+          else
+          {
+            offsets[cellId + 1] = state.GetCellSize(cellId);
+          }
+        }
+      });
+    std::partial_sum(offsets, offsets + numCells + 1, offsets);
+
+    vtkNew<vtkIdTypeArray> cellConnectivity;
+    cellConnectivity->SetNumberOfValues(offsets[numCells]);
+    vtkIdType* points = cellConnectivity->GetPointer(0);
+    vtkSMPTools::For(0, numCells,
+      [&](vtkIdType cellId, vtkIdType endCellId)
+      {
+        std::vector<vtkIdType> pointIds;
+        for (; cellId < endCellId; ++cellId)
+        {
+          if (types[cellId] == VTK_POLYHEDRON)
+          {
+            if (const auto stream = getFaceStream(cellId))
+            {
+              GetPolyhedronPointIds(stream, pointIds);
+              std::copy(pointIds.begin(), pointIds.end(), points + offsets[cellId]);
+            }
+          }
+          else
+          {
+            std::copy(connectivity + state.GetBeginOffset(cellId),
+              connectivity + state.GetEndOffset(cellId), points + offsets[cellId]);
+          }
+        }
+      });
+    newCells->SetData(cellOffsets, cellConnectivity);
+  }
+};
+}
+
 //------------------------------------------------------------------------------
 void vtkUnstructuredGrid::SetCells(vtkUnsignedCharArray* cellTypes, vtkCellArray* cells)
 {
   // check if cells contain any polyhedron cell
-  const vtkIdType ncells = cells->GetNumberOfCells();
   const auto typeRange = vtk::DataArrayValueRange<1>(cellTypes);
   const bool containPolyhedron =
     std::find(typeRange.cbegin(), typeRange.cend(), VTK_POLYHEDRON) != typeRange.cend();
@@ -1015,36 +1211,10 @@ void vtkUnstructuredGrid::SetCells(vtkUnsignedCharArray* cellTypes, vtkCellArray
   // We need to convert it into new cell connectivities of standard format,
   // update cellLocations as well as create faces and facelocations.
   vtkNew<vtkCellArray> newCells;
-  newCells->AllocateExact(ncells, cells->GetNumberOfConnectivityIds());
-
   vtkNew<vtkCellArray> faces;
-  faces->AllocateExact(ncells, cells->GetNumberOfConnectivityIds());
-
   vtkNew<vtkCellArray> faceLocations;
-  faceLocations->AllocateExact(ncells, 4 * ncells);
-
-  auto cellIter = vtkSmartPointer<vtkCellArrayIterator>::Take(cells->NewIterator());
-
-  for (cellIter->GoToFirstCell(); !cellIter->IsDoneWithTraversal(); cellIter->GoToNextCell())
-  {
-    vtkIdType npts;
-    const vtkIdType* pts;
-    cellIter->GetCurrentCell(npts, pts);
-    const vtkIdType cellId = cellIter->GetCurrentCellId();
-
-    if (cellTypes->GetValue(cellId) != VTK_POLYHEDRON)
-    {
-      newCells->InsertNextCell(npts, pts);
-      faceLocations->InsertNextCell(0);
-    }
-    else
-    {
-      vtkIdType realnpts;
-      vtkIdType nfaces;
-      vtkUnstructuredGrid::DecomposeAPolyhedronCell(
-        pts, realnpts, nfaces, newCells, faces, faceLocations);
-    }
-  }
+  cells->Visit(
+    DecomposePolyhedraWorker{}, cellTypes->GetPointer(0), newCells, faceLocations, faces);
 
   this->SetPolyhedralCells(cellTypes, newCells, faceLocations, faces);
 }
@@ -1061,38 +1231,17 @@ void vtkUnstructuredGrid::SetCells(vtkUnsignedCharArray* cellTypes, vtkCellArray
   this->FaceLocations = nullptr;
   if (faceLocations != nullptr && faces != nullptr)
   {
-    vtkIdType prepareSize = faceLocations->GetSize();
-    vtkIdType faceId = 0;
+    const unsigned char* types = cellTypes->GetPointer(0);
+    const vtkIdType* locations = faceLocations->GetPointer(0);
+    const vtkIdType* stream = faces->GetPointer(0);
+    auto getFaceStream = [types, locations, stream](vtkIdType cellId) -> const vtkIdType*
+    {
+      return types[cellId] == VTK_POLYHEDRON ? stream + locations[cellId] : nullptr;
+    };
 
     vtkNew<vtkCellArray> newFaces;
-    newFaces->AllocateExact(prepareSize, faces->GetSize());
-
     vtkNew<vtkCellArray> newFaceLocations;
-    newFaceLocations->AllocateExact(prepareSize, 4 * prepareSize);
-
-    auto cellIter = vtkSmartPointer<vtkCellArrayIterator>::Take(cells->NewIterator());
-    for (cellIter->GoToFirstCell(); !cellIter->IsDoneWithTraversal(); cellIter->GoToNextCell())
-    {
-      const vtkIdType cellId = cellIter->GetCurrentCellId();
-      if (cellTypes->GetValue(cellId) != VTK_POLYHEDRON)
-      {
-        newFaceLocations->InsertNextCell(0);
-      }
-      else
-      {
-        const vtkIdType loc = faceLocations->GetValue(cellId);
-        vtkIdType* facePtr = faces->GetPointer(loc);
-        vtkIdType nfaces = *facePtr++;
-        vtkIdType len = 0;
-        newFaceLocations->InsertNextCell(nfaces);
-        for (vtkIdType i = 0; i < nfaces; ++i)
-        {
-          len += *(facePtr + len);
-          newFaceLocations->InsertCellPoint(faceId++);
-        }
-        newFaces->AppendLegacyFormat(facePtr, len, 0);
-      }
-    }
+    FaceStreamsToCellArrays(cells->GetNumberOfCells(), getFaceStream, newFaceLocations, newFaces);
     this->Faces = newFaces;
     this->FaceLocations = newFaceLocations;
   }
@@ -0,0 +1,140 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Glyphs enough points to be processed by several threads and checks that the
+// glyphs are output in the order of the input points, with their point and cell
+// data.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDoubleArray.h"
+#include "vtkGlyph3D.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+constexpr vtkIdType NumberOfPoints = 20000;
+
+// A source with a vertex and two triangles, so that the glyph cells are split
+// between the verts and the polys of the output.
+void CreateSource(vtkPolyData* source)
+{
+  vtkNew<vtkPoints> points;
+  points->InsertNextPoint(0.0, 0.0, 0.0);
+  points->InsertNextPoint(1.0, 0.0, 0.0);
+  points->InsertNextPoint(0.0, 1.0, 0.0);
+  points->InsertNextPoint(0.0, 0.0, 1.0);
+  source->SetPoints(points);
+  source->AllocateEstimate(3, 3);
+  vtkIdType vertex = 3;
+  vtkIdType triangles[2][3] = { { 0, 1, 2 }, { 0, 2, 3 } };
+  source->InsertNextCell(VTK_TRIANGLE, 3, triangles[0]);
+  source->InsertNextCell(VTK_VERTEX, 1, &vertex);
+  source->InsertNextCell(VTK_TRIANGLE, 3, triangles[1]);
+}
+
+void CreateInput(vtkPolyData* input)
+{
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("Scalars");
+  vtkNew<vtkDoubleArray> values;
+  values->SetName("Values");
+  for (vtkIdType i = 0; i < NumberOfPoints; ++i)
+  {
+    points->InsertNextPoint(i % 100, i / 100, 0.0);
+    scalars->InsertNextValue(1.0 + (i % 7) * 0.1);
+    values->InsertNextValue(static_cast<double>(i));
+  }
+  input->SetPoints(points);
+  input->GetPointData()->SetScalars(scalars);
+  input->GetPointData()->AddArray(values);
+}
+}
+
+int TestGlyph3DParallel(int, char*[])
+{
+  vtkNew<vtkPolyData> source;
+  CreateSource(source);
+  vtkNew<vtkPolyData> input;
+  CreateInput(input);
+
+  vtkNew<vtkGlyph3D> glyph3D;
+  glyph3D->SetSourceData(source);
+  glyph3D->SetInputData(input);
+  glyph3D->OrientOff();
+  glyph3D->SetScaleModeToScaleByScalar();
+  glyph3D->SetScaleFactor(0.5);
+  glyph3D->GeneratePointIdsOn();
+  glyph3D->FillCellDataOn();
+  glyph3D->Update();
+
+  vtkPolyData* output = glyph3D->GetOutput();
+  const vtkIdType numSourcePts = source->GetNumberOfPoints();
+  if (output->GetNumberOfPoints() != NumberOfPoints * numSourcePts ||
+    output->GetNumberOfVerts() != NumberOfPoints || output->GetNumberOfPolys() != 2 * NumberOfPoints)
+  {
+    std::cerr << "Unexpected output size: " << output->GetNumberOfPoints() << " points, "
+              << output->GetNumberOfVerts() << " verts, " << output->GetNumberOfPolys()
+              << " polys." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkIdTypeArray* pointIds =
+    vtkIdTypeArray::SafeDownCast(output->GetPointData()->GetArray("InputPointIds"));
+  vtkDataArray* pointValues = output->GetPointData()->GetArray("Values");
+  if (!pointIds || !pointValues)
+  {
+    std::cerr << "Missing output point data." << std::endl;
+    return EXIT_FAILURE;
+  }
+  for (vtkIdType ptId = 0; ptId < output->GetNumberOfPoints(); ++ptId)
+  {
+    const vtkIdType inPtId = ptId / numSourcePts;
+    double expected[3], sourcePoint[3], x[3];
+    input->GetPoint(inPtId, expected);
+    source->GetPoint(ptId % numSourcePts, sourcePoint);
+    const double scale = 0.5 * input->GetPointData()->GetScalars()->GetTuple1(inPtId);
+    for (int i = 0; i < 3; ++i)
+    {
+      expected[i] += scale * sourcePoint[i];
+    }
+    output->GetPoint(ptId, x);
+    if (pointIds->GetValue(ptId) != inPtId || pointValues->GetTuple1(ptId) != inPtId ||
+      vtkMath::Distance2BetweenPoints(x, expected) > 1e-8)
+    {
+      std::cerr << "Incorrect glyph point " << ptId << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // the cell data of every cell comes from the input point of its points
+  vtkDataArray* cellValues = output->GetCellData()->GetArray("Values");
+  if (!cellValues || cellValues->GetNumberOfTuples() != output->GetNumberOfCells())
+  {
+    std::cerr << "Missing output cell data." << std::endl;
+    return EXIT_FAILURE;
+  }
+  vtkNew<vtkIdList> cellPoints;
+  for (vtkIdType cellId = 0; cellId < output->GetNumberOfCells(); ++cellId)
+  {
+    output->GetCellPoints(cellId, cellPoints);
+    for (vtkIdType i = 0; i < cellPoints->GetNumberOfIds(); ++i)
+    {
+      if (pointIds->GetValue(cellPoints->GetId(i)) != cellValues->GetTuple1(cellId))
+      {
+        std::cerr << "Incorrect cell data for cell " << cellId << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,295 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Checks that vtkSpatialReorder permutes the points, the cells and their attributes consistently
+// and improves the locality of a shuffled data set. Its effect on the downstream filters is timed
+// in Utilities/Benchmarks.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkContour3DLinearGrid.h"
+#include "vtkConvertToPolyhedra.h"
+#include "vtkDataSetTriangleFilter.h"
+#include "vtkFloatArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkRTAnalyticSource.h"
+#include "vtkSpatialReorder.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace
+{
+// Calls f on each point id of a polyhedron face stream, skipping the numbers of faces and points.
+template <typename FunctorT>
+void ForEachFacePointId(vtkIdList* faceStream, FunctorT&& f)
+{
+  vtkIdType nextFace = 1;
+  for (vtkIdType i = 1; i < faceStream->GetNumberOfIds(); ++i)
+  {
+    if (i == nextFace)
+    {
+      nextFace += faceStream->GetId(i) + 1;
+    }
+    else
+    {
+      f(*faceStream->GetPointer(i));
+    }
+  }
+}
+
+// Returns a copy of the grid with its points and cells in a random order.
+vtkSmartPointer<vtkUnstructuredGrid> Shuffle(vtkUnstructuredGrid* input)
+{
+  const vtkIdType numPts = input->GetNumberOfPoints();
+  const vtkIdType numCells = input->GetNumberOfCells();
+  std::mt19937 generator(5489);
+  vtkNew<vtkIdList> pointOrder, cellOrder, ids;
+  pointOrder->SetNumberOfIds(numPts);
+  cellOrder->SetNumberOfIds(numCells);
+  std::iota(pointOrder->begin(), pointOrder->end(), 0);
+  std::iota(cellOrder->begin(), cellOrder->end(), 0);
+  std::shuffle(pointOrder->begin(), pointOrder->end(), generator);
+  std::shuffle(cellOrder->begin(), cellOrder->end(), generator);
+  std::vector<vtkIdType> pointMap(numPts);
+  for (vtkIdType i = 0; i < numPts; ++i)
+  {
+    pointMap[pointOrder->GetId(i)] = i;
+  }
+
+  auto output = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  vtkNew<vtkPoints> points;
+  points->SetDataType(input->GetPoints()->GetDataType());
+  points->SetNumberOfPoints(numPts);
+  input->GetPoints()->GetData()->GetTuples(pointOrder, points->GetData());
+  output->SetPoints(points);
+  output->Allocate(numCells);
+  for (vtkIdType i = 0; i < numCells; ++i)
+  {
+    const vtkIdType inCellId = cellOrder->GetId(i);
+    const int cellType = input->GetCellType(inCellId);
+    if (cellType == VTK_POLYHEDRON)
+    {
+      input->GetFaceStream(inCellId, ids);
+      ForEachFacePointId(ids, [&](vtkIdType& ptId) { ptId = pointMap[ptId]; });
+    }
+    else
+    {
+      input->GetCellPoints(inCellId, ids);
+      for (vtkIdType& ptId : *ids)
+      {
+        ptId = pointMap[ptId];
+      }
+    }
+    output->InsertNextCell(cellType, ids);
+  }
+
+  vtkNew<vtkIdList> identity;
+  identity->SetNumberOfIds(std::max(numPts, numCells));
+  std::iota(identity->begin(), identity->end(), 0);
+  identity->SetNumberOfIds(numPts);
+  output->GetPointData()->CopyAllocate(input->GetPointData(), numPts);
+  output->GetPointData()->CopyData(input->GetPointData(), pointOrder, identity);
+  identity->SetNumberOfIds(numCells);
+  output->GetCellData()->CopyAllocate(input->GetCellData(), numCells);
+  output->GetCellData()->CopyData(input->GetCellData(), cellOrder, identity);
+  return output;
+}
+
+// Adds a cell data array holding the cell ids.
+void AddCellIds(vtkDataSet* dataSet)
+{
+  vtkNew<vtkIdTypeArray> cellIds;
+  cellIds->SetName("InputCellId");
+  cellIds->SetNumberOfValues(dataSet->GetNumberOfCells());
+  std::iota(cellIds->GetPointer(0), cellIds->GetPointer(0) + dataSet->GetNumberOfCells(), 0);
+  dataSet->GetCellData()->AddArray(cellIds);
+}
+
+// Returns the ids of the points of the cell, or of its faces for a polyhedron.
+void GetCellStream(vtkDataSet* dataSet, vtkIdType cellId, vtkIdList* ids)
+{
+  auto grid = vtkUnstructuredGrid::SafeDownCast(dataSet);
+  if (grid && grid->GetCellType(cellId) == VTK_POLYHEDRON)
+  {
+    grid->GetFaceStream(cellId, ids);
+    vtkIdType numIds = 0;
+    ForEachFacePointId(ids, [&](vtkIdType ptId) { ids->SetId(numIds++, ptId); });
+    ids->SetNumberOfIds(numIds);
+  }
+  else
+  {
+    dataSet->GetCellPoints(cellId, ids);
+  }
+}
+
+bool CheckReordered(vtkDataSet* input, vtkDataSet* output)
+{
+  if (input->GetNumberOfPoints() != output->GetNumberOfPoints() ||
+    input->GetNumberOfCells() != output->GetNumberOfCells())
+  {
+    std::cerr << "Got " << output->GetNumberOfPoints() << " points and "
+              << output->GetNumberOfCells() << " cells instead of " << input->GetNumberOfPoints()
+              << " and " << input->GetNumberOfCells() << std::endl;
+    return false;
+  }
+  auto originalPointIds =
+    vtkIdTypeArray::SafeDownCast(output->GetPointData()->GetArray("vtkOriginalPointIds"));
+  auto originalCellIds =
+    vtkIdTypeArray::SafeDownCast(output->GetCellData()->GetArray("vtkOriginalCellIds"));
+  auto scalars = input->GetPointData()->GetScalars();
+  auto outScalars = output->GetPointData()->GetScalars();
+  auto cellIds = output->GetCellData()->GetArray("InputCellId");
+  if (!originalPointIds || !originalCellIds || !outScalars || !cellIds)
+  {
+    std::cerr << "Missing output arrays" << std::endl;
+    return false;
+  }
+
+  for (vtkIdType ptId = 0; ptId < output->GetNumberOfPoints(); ++ptId)
+  {
+    const vtkIdType inPtId = originalPointIds->GetValue(ptId);
+    double x[3], inX[3];
+    output->GetPoint(ptId, x);
+    input->GetPoint(inPtId, inX);
+    if (!std::equal(x, x + 3, inX) || outScalars->GetTuple1(ptId) != scalars->GetTuple1(inPtId))
+    {
+      std::cerr << "Output point " << ptId << " does not match input point " << inPtId
+                << std::endl;
+      return false;
+    }
+  }
+
+  vtkNew<vtkIdList> ids, inIds;
+  for (vtkIdType cellId = 0; cellId < output->GetNumberOfCells(); ++cellId)
+  {
+    const vtkIdType inCellId = originalCellIds->GetValue(cellId);
+    GetCellStream(output, cellId, ids);
+    GetCellStream(input, inCellId, inIds);
+    for (vtkIdType i = 0; i < ids->GetNumberOfIds(); ++i)
+    {
+      ids->SetId(i, originalPointIds->GetValue(ids->GetId(i)));
+    }
+    if (output->GetCellType(cellId) != input->GetCellType(inCellId) ||
+      ids->GetNumberOfIds() != inIds->GetNumberOfIds() ||
+      !std::equal(ids->begin(), ids->end(), inIds->begin()) ||
+      cellIds->GetTuple1(cellId) != static_cast<double>(inCellId))
+    {
+      std::cerr << "Output cell " << cellId << " does not match input cell " << inCellId
+                << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+// Average difference between the largest and the smallest point id of the cells.
+double AveragePointIdSpan(vtkDataSet* dataSet)
+{
+  vtkNew<vtkIdList> ids;
+  double span = 0.0;
+  for (vtkIdType cellId = 0; cellId < dataSet->GetNumberOfCells(); ++cellId)
+  {
+    dataSet->GetCellPoints(cellId, ids);
+    const auto range = std::minmax_element(ids->begin(), ids->end());
+    span += static_cast<double>(*range.second - *range.first);
+  }
+  return span / dataSet->GetNumberOfCells();
+}
+
+vtkSmartPointer<vtkDataSet> Reorder(vtkDataSet* input, int curveType)
+{
+  vtkNew<vtkSpatialReorder> reorder;
+  reorder->SetInputData(input);
+  reorder->SetCurveType(curveType);
+  reorder->GenerateOriginalIdsOn();
+  reorder->Update();
+  return reorder->GetOutput();
+}
+}
+
+int TestSpatialReorder(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  int res = EXIT_SUCCESS;
+
+  vtkNew<vtkRTAnalyticSource> wavelet;
+  wavelet->SetWholeExtent(-20, 20, -20, 20, -20, 20);
+  vtkNew<vtkDataSetTriangleFilter> tetrahedralize;
+  tetrahedralize->SetInputConnection(wavelet->GetOutputPort());
+  tetrahedralize->Update();
+  auto shuffled = Shuffle(tetrahedralize->GetOutput());
+  AddCellIds(shuffled);
+
+  const double shuffledSpan = AveragePointIdSpan(shuffled);
+  for (int curveType : { vtkSpatialReorder::HILBERT, vtkSpatialReorder::MORTON })
+  {
+    auto reordered = Reorder(shuffled, curveType);
+    if (!CheckReordered(shuffled, reordered))
+    {
+      std::cerr << "Wrong reordering of an unstructured grid with curve " << curveType
+                << std::endl;
+      res = EXIT_FAILURE;
+    }
+    const double span = AveragePointIdSpan(reordered);
+    if (!(span < 0.1 * shuffledSpan))
+    {
+      std::cerr << "The average point id span of the cells is " << span << " after reordering "
+                << "with curve " << curveType << " and " << shuffledSpan << " before" << std::endl;
+      res = EXIT_FAILURE;
+    }
+  }
+
+  // a polydata with vertices and triangles
+  vtkNew<vtkContour3DLinearGrid> contour;
+  contour->SetInputData(shuffled);
+  contour->SetValue(0, 160.0);
+  contour->Update();
+  vtkNew<vtkPolyData> surface;
+  surface->ShallowCopy(contour->GetOutput());
+  vtkNew<vtkCellArray> verts;
+  for (vtkIdType ptId = 0; ptId < surface->GetNumberOfPoints(); ptId += 100)
+  {
+    verts->InsertNextCell(1, &ptId);
+  }
+  surface->SetVerts(verts);
+  vtkNew<vtkFloatArray> scalars;
+  scalars->SetNumberOfValues(surface->GetNumberOfPoints());
+  for (vtkIdType ptId = 0; ptId < surface->GetNumberOfPoints(); ++ptId)
+  {
+    scalars->SetValue(ptId, static_cast<float>(ptId));
+  }
+  surface->GetPointData()->SetScalars(scalars);
+  AddCellIds(surface);
+  if (!CheckReordered(surface, Reorder(surface, vtkSpatialReorder::HILBERT)))
+  {
+    std::cerr << "Wrong reordering of a polydata" << std::endl;
+    res = EXIT_FAILURE;
+  }
+
+  // polyhedra
+  vtkNew<vtkRTAnalyticSource> smallWavelet;
+  smallWavelet->SetWholeExtent(-4, 4, -4, 4, -4, 4);
+  vtkNew<vtkDataSetTriangleFilter> smallTetrahedralize;
+  smallTetrahedralize->SetInputConnection(smallWavelet->GetOutputPort());
+  vtkNew<vtkConvertToPolyhedra> toPolyhedra;
+  toPolyhedra->SetInputConnection(smallTetrahedralize->GetOutputPort());
+  toPolyhedra->Update();
+  auto polyhedra = Shuffle(toPolyhedra->GetOutput());
+  AddCellIds(polyhedra);
+  if (!CheckReordered(polyhedra, Reorder(polyhedra, vtkSpatialReorder::HILBERT)))
+  {
+    std::cerr << "Wrong reordering of polyhedra" << std::endl;
+    res = EXIT_FAILURE;
+  }
+
+  return res;
+}
@@ -117,15 +117,17 @@ struct AppendCellArray
     vtkIdType pointOffset)
   {
     using ValueType = typename CellStateT::ValueType;
-    auto inputOffsets = state.GetOffsets();
     auto inputConnectivity = state.GetConnectivity();
-    auto numberOfCells = inputOffsets->GetNumberOfValues() - 1;
+    const vtkIdType numberOfCells = state.GetNumberOfCells();
     auto numberOfConnectivityIds = inputConnectivity->GetNumberOfValues();
 
-    // Copy the offsets and transform them using the cellConnectivityOffset
-    std::transform(inputOffsets->GetPointer(0), inputOffsets->GetPointer(numberOfCells),
-      outputOffsets->GetPointer(cellOffset),
-      [&](ValueType offset) { return static_cast<ValueType>(offset + cellConnectivityOffset); });
+    // Copy the offsets and transform them using the cellConnectivityOffset. The accessor keeps
+    // the offsets of fixed size cells implicit in the input.
+    vtkIdType* outOffsets = outputOffsets->GetPointer(cellOffset);
+    for (vtkIdType cellId = 0; cellId < numberOfCells; ++cellId)
+    {
+      outOffsets[cellId] = state.GetBeginOffset(cellId) + cellConnectivityOffset;
+    }
     // Copy the connectivity and transform them using the pointOffset
     std::transform(inputConnectivity->GetPointer(0),
       inputConnectivity->GetPointer(numberOfConnectivityIds),
@@ -2,10 +2,10 @@
 // SPDX-License-Identifier: BSD-3-Clause
 #include "vtkGlyph3D.h"
 
-#include "vtkCell.h"
+#include "vtkArrayListTemplate.h"
+#include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkFloatArray.h"
-#include "vtkIdList.h"
 #include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
@@ -14,6 +14,7 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTransform.h"
@@ -21,7 +22,134 @@
 #include "vtkUniformGrid.h"
 #include "vtkUnsignedCharArray.h"
 
+#include <algorithm>
+#include <vector>
+
 VTK_ABI_NAMESPACE_BEGIN
+namespace
+{
+// Cells of one of the cell arrays of a glyph source, i.e. verts, lines, polys
+// or strips.
+struct GlyphCells
+{
+  std::vector<vtkIdType> Offsets{ 0 };
+  std::vector<vtkIdType> Connectivity;
+};
+
+// Geometry of a glyph source, extracted once to be shared by the threads.
+struct GlyphSource
+{
+  bool Valid = false;
+  vtkIdType NumberOfPoints = 0;
+  // points after the source transform
+  std::vector<double> Points;
+  std::vector<double> Normals;
+  GlyphCells Cells[4];
+
+  void Initialize(vtkPolyData* source, vtkTransform* sourceTransform, bool withNormals)
+  {
+    this->Valid = source != nullptr;
+    if (!source || !source->GetPoints())
+    {
+      return;
+    }
+    vtkNew<vtkPoints> points;
+    points->SetDataTypeToDouble();
+    if (sourceTransform)
+    {
+      sourceTransform->TransformPoints(source->GetPoints(), points);
+    }
+    else
+    {
+      points->DeepCopy(source->GetPoints());
+    }
+    this->NumberOfPoints = points->GetNumberOfPoints();
+    this->Points.resize(3 * this->NumberOfPoints);
+    for (vtkIdType i = 0; i < this->NumberOfPoints; ++i)
+    {
+      points->GetPoint(i, &this->Points[3 * i]);
+    }
+    vtkDataArray* normals = source->GetPointData()->GetNormals();
+    if (withNormals && normals)
+    {
+      this->Normals.resize(3 * this->NumberOfPoints);
+      for (vtkIdType i = 0; i < this->NumberOfPoints; ++i)
+      {
+        normals->GetTuple(i, &this->Normals[3 * i]);
+      }
+    }
+
+    vtkCellArray* cellArrays[4] = { source->GetVerts(), source->GetLines(), source->GetPolys(),
+      source->GetStrips() };
+    for (int c = 0; c < 4; ++c)
+    {
+      GlyphCells& cells = this->Cells[c];
+      vtkIdType npts;
+      const vtkIdType* pts;
+      for (cellArrays[c]->InitTraversal(); cellArrays[c]->GetNextCell(npts, pts);)
+      {
+        cells.Connectivity.insert(cells.Connectivity.end(), pts, pts + npts);
+        cells.Offsets.push_back(static_cast<vtkIdType>(cells.Connectivity.size()));
+      }
+    }
+  }
+};
+
+// Output sizes of glyphs, used for the offsets of the chunks of input points
+// in the output.
+struct GlyphChunk
+{
+  vtkIdType NumberOfPoints = 0;
+  vtkIdType NumberOfCells[4] = { 0, 0, 0, 0 };
+  vtkIdType ConnectivitySize[4] = { 0, 0, 0, 0 };
+
+  void Add(const GlyphSource& source)
+  {
+    this->NumberOfPoints += source.NumberOfPoints;
+    for (int c = 0; c < 4; ++c)
+    {
+      this->NumberOfCells[c] += static_cast<vtkIdType>(source.Cells[c].Offsets.size()) - 1;
+      this->ConnectivitySize[c] += static_cast<vtkIdType>(source.Cells[c].Connectivity.size());
+    }
+  }
+
+  void Add(const GlyphChunk& other)
+  {
+    this->NumberOfPoints += other.NumberOfPoints;
+    for (int c = 0; c < 4; ++c)
+    {
+      this->NumberOfCells[c] += other.NumberOfCells[c];
+      this->ConnectivitySize[c] += other.ConnectivitySize[c];
+    }
+  }
+};
+
+// Glyph of an input point.
+struct GlyphPoint
+{
+  // index of the source, -1 when the point is not glyphed
+  int Source;
+  double Position[3];
+  double Vector[3];
+  double VectorMagnitude;
+  double Scale[3];
+};
+
+// Same rotation as vtkTransform::RotateWXYZ(180, axis).
+void HalfTurn(const double axis[3], double rotation[3][3])
+{
+  double n[3] = { axis[0], axis[1], axis[2] };
+  vtkMath::Normalize(n);
+  for (int i = 0; i < 3; ++i)
+  {
+    for (int j = 0; j < 3; ++j)
+    {
+      rotation[i][j] = 2.0 * n[i] * n[j] - (i == j ? 1.0 : 0.0);
+    }
+  }
+}
+}
+
 vtkStandardNewMacro(vtkGlyph3D);
 vtkCxxSetObjectMacro(vtkGlyph3D, SourceTransform, vtkTransform);
 
@@ -125,40 +253,24 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
   vtkPointData* pd;
   vtkDataArray* inCScalars; // Scalars for Coloring
   unsigned char* inGhostLevels = nullptr;
-  vtkDataArray *inNormals, *sourceNormals = nullptr;
+  vtkDataArray* inNormals;
   vtkDataArray* sourceTCoords = nullptr;
-  vtkIdType numPts, numSourcePts, numSourceCells, inPtId, i;
-  vtkPoints* sourcePts = nullptr;
-  vtkSmartPointer<vtkPoints> transformedSourcePts = vtkSmartPointer<vtkPoints>::New();
+  vtkIdType numPts;
   vtkPoints* newPts;
   vtkDataArray* newScalars = nullptr;
   vtkDataArray* newVectors = nullptr;
   vtkDataArray* newNormals = nullptr;
   vtkDataArray* newTCoords = nullptr;
-  double x[3], v[3], vNew[3], s = 0.0, vMag = 0.0, value, tc[3];
-  vtkTransform* trans = vtkTransform::New();
-  vtkNew<vtkIdList> pointIdList;
-  vtkIdList* cellPts;
-  int npts;
-  vtkIdList* pts;
-  vtkIdType ptIncr, cellIncr, cellId;
   int haveVectors, haveNormals, haveTCoords = 0;
-  double scalex, scaley, scalez, den;
+  double den;
   vtkPointData* outputPD = output->GetPointData();
   vtkCellData* outputCD = output->GetCellData();
   int numberOfSources = this->GetNumberOfInputConnections(1);
   vtkIdTypeArray* pointIds = nullptr;
   vtkSmartPointer<vtkPolyData> source = this->GetSource(0, sourceVector);
-  vtkNew<vtkIdList> srcPointIdList;
-  vtkNew<vtkIdList> dstPointIdList;
-  vtkNew<vtkIdList> srcCellIdList;
-  vtkNew<vtkIdList> dstCellIdList;
 
   vtkDebugMacro(<< "Generating glyphs");
 
-  pts = vtkIdList::New();
-  pts->Allocate(VTK_CELL_SIZE);
-
   pd = input->GetPointData();
   inNormals = this->GetInputArrayToProcess(2, input);
   inCScalars = this->GetInputArrayToProcess(3, input);
@@ -185,8 +297,6 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
   if (numPts < 1)
   {
     vtkDebugMacro(<< "No points to glyph!");
-    pts->Delete();
-    trans->Delete();
     return true;
   }
 
@@ -208,6 +318,17 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
     haveVectors = 0;
   }
 
+  vtkDataArray* array3D = nullptr;
+  if (haveVectors && this->VectorMode != VTK_FOLLOW_CAMERA_DIRECTION)
+  {
+    array3D = this->VectorMode == VTK_USE_NORMAL ? inNormals : inVectors;
+    if (array3D->GetNumberOfComponents() > 3)
+    {
+      vtkErrorMacro(<< "vtkDataArray " << array3D->GetName() << " has more than 3 components.\n");
+      return false;
+    }
+  }
+
   if ((this->IndexMode == VTK_INDEXING_BY_SCALAR && !inSScalars) ||
     (this->IndexMode == VTK_INDEXING_BY_VECTOR &&
       ((!inVectors && this->VectorMode == VTK_USE_VECTOR) ||
@@ -216,8 +337,6 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
     if (source == nullptr)
     {
       vtkErrorMacro(<< "Indexing on but don't have data to index with");
-      pts->Delete();
-      trans->Delete();
       return true;
     }
     else
@@ -249,70 +368,193 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
     source = defaultSource;
   }
 
+  // The geometry of the sources is extracted once and shared by the threads.
+  std::vector<GlyphSource> sources;
   if (this->IndexMode != VTK_INDEXING_OFF)
   {
     pd = nullptr;
     haveNormals = 1;
-    for (numSourcePts = numSourceCells = i = 0; i < numberOfSources; i++)
+    sources.resize(numberOfSources);
+    for (int i = 0; i < numberOfSources; i++)
     {
       source = this->GetSource(i, sourceVector);
       if (source != nullptr)
       {
-        if (source->GetNumberOfPoints() > numSourcePts)
-        {
-          numSourcePts = source->GetNumberOfPoints();
-        }
-        if (source->GetNumberOfCells() > numSourceCells)
-        {
-          numSourceCells = source->GetNumberOfCells();
-        }
-        if (!(sourceNormals = source->GetPointData()->GetNormals()))
+        if (!source->GetPointData()->GetNormals())
         {
           haveNormals = 0;
         }
       }
     }
+    for (int i = 0; i < numberOfSources; i++)
+    {
+      sources[i].Initialize(this->GetSource(i, sourceVector), this->SourceTransform, haveNormals);
+    }
   }
   else
   {
-    sourcePts = source->GetPoints();
-    numSourcePts = sourcePts->GetNumberOfPoints();
-    numSourceCells = source->GetNumberOfCells();
+    haveNormals = source->GetPointData()->GetNormals() ? 1 : 0;
+    sourceTCoords = source->GetPointData()->GetTCoords();
+    haveTCoords = sourceTCoords ? 1 : 0;
+    sources.resize(1);
+    sources[0].Initialize(source, this->SourceTransform, haveNormals);
+
+    pd = input->GetPointData();
+  }
 
-    sourceNormals = source->GetPointData()->GetNormals();
-    if (sourceNormals)
+  // makes the next GetPoint() calls thread safe
+  double firstPoint[3];
+  input->GetPoint(0, firstPoint);
+
+  // Whether an input point is glyphed at all.
+  auto isPointVisible = [&](vtkIdType inPtId)
+  {
+    // Check ghost points.
+    // If we are processing a piece, we do not want to duplicate glyphs on the borders.
+    if (inGhostLevels &&
+      inGhostLevels[inPtId] &
+        (vtkDataSetAttributes::DUPLICATEPOINT | vtkDataSetAttributes::HIDDENPOINT))
     {
-      haveNormals = 1;
+      return false;
     }
-    else
+    if (inputUG && !inputUG->IsPointVisible(inPtId))
     {
-      haveNormals = 0;
+      // input is a vtkUniformGrid and the current point is blanked. Don't glyph
+      // it.
+      return false;
     }
+    return this->IsPointVisible(input, inPtId) != 0;
+  };
 
-    sourceTCoords = source->GetPointData()->GetTCoords();
-    if (sourceTCoords)
+  // Evaluates the glyph of a visible input point. Source is -1 when the point
+  // is not glyphed.
+  auto evaluatePoint = [&](vtkIdType inPtId, GlyphPoint& glyph)
+  {
+    glyph.Source = -1;
+    double* scale = glyph.Scale;
+    scale[0] = scale[1] = scale[2] = 1.0;
+    double s = 0.0;
+    double* v = glyph.Vector;
+    v[0] = v[1] = v[2] = 0.0;
+    glyph.VectorMagnitude = 0.0;
+    input->GetPoint(inPtId, glyph.Position);
+
+    // Get the scalar and vector data
+    if (inSScalars)
     {
-      haveTCoords = 1;
+      s = inSScalars->GetComponent(inPtId, 0);
+      if (this->ScaleMode == VTK_SCALE_BY_SCALAR || this->ScaleMode == VTK_DATA_SCALING_OFF)
+      {
+        scale[0] = scale[1] = scale[2] = s;
+      }
     }
-    else
+
+    if (haveVectors)
     {
-      haveTCoords = 0;
+      if (this->VectorMode == VTK_FOLLOW_CAMERA_DIRECTION)
+      {
+        // glyph normal direction in world coordinate system
+        vtkMath::Subtract(this->FollowedCameraPosition, glyph.Position, v);
+        vtkMath::Normalize(v);
+        glyph.VectorMagnitude = 1.0;
+      }
+      else
+      {
+        array3D->GetTuple(inPtId, v);
+        glyph.VectorMagnitude = vtkMath::Norm(v);
+        if (this->ScaleMode == VTK_SCALE_BY_VECTORCOMPONENTS)
+        {
+          scale[0] = v[0];
+          scale[1] = v[1];
+          scale[2] = v[2];
+        }
+        else if (this->ScaleMode == VTK_SCALE_BY_VECTOR)
+        {
+          scale[0] = scale[1] = scale[2] = glyph.VectorMagnitude;
+        }
+      }
     }
 
-    // Prepare to copy output.
-    pd = input->GetPointData();
-    outputPD->CopyAllocate(pd, numPts * numSourcePts);
-    if (this->FillCellData)
+    // Clamp data scale if enabled
+    if (this->Clamping)
     {
-      outputCD->CopyGlobalIdsOn();
-      outputCD->CopyAllocate(pd, numPts * numSourceCells);
+      for (int i = 0; i < 3; i++)
+      {
+        scale[i] = (scale[i] < this->Range[0]
+            ? this->Range[0]
+            : (scale[i] > this->Range[1] ? this->Range[1] : scale[i]));
+        scale[i] = (scale[i] - this->Range[0]) / den;
+      }
+    }
+
+    // Compute index into table of glyphs
+    int index = 0;
+    if (this->IndexMode != VTK_INDEXING_OFF)
+    {
+      double value = this->IndexMode == VTK_INDEXING_BY_SCALAR ? s : glyph.VectorMagnitude;
+      index = static_cast<int>((value - this->Range[0]) * numberOfSources / den);
+      index = (index < 0 ? 0 : (index >= numberOfSources ? (numberOfSources - 1) : index));
+    }
+
+    // Make sure we're not indexing into empty glyph
+    if (index >= 0 && index < static_cast<int>(sources.size()) && sources[index].Valid)
+    {
+      glyph.Source = index;
     }
+  };
+
+  // The input points are processed by chunks. The output size of every chunk
+  // is computed first, then the chunks fill their part of the output in
+  // parallel, in the order of the input points. The source of every point,
+  // -1 when it is not glyphed, is kept from the first pass so that the second
+  // one fills exactly the output allocated for it.
+  const vtkIdType chunkSize = 1024;
+  const vtkIdType numChunks = (numPts + chunkSize - 1) / chunkSize;
+  std::vector<GlyphChunk> chunks(numChunks + 1);
+  std::vector<int> pointSources(numPts);
+  vtkSMPTools::For(0, numChunks,
+    [&](vtkIdType firstChunk, vtkIdType lastChunk)
+    {
+      GlyphPoint glyph;
+      for (vtkIdType chunk = firstChunk; chunk < lastChunk; ++chunk)
+      {
+        GlyphChunk& sizes = chunks[chunk];
+        const vtkIdType lastPtId = std::min(numPts, (chunk + 1) * chunkSize);
+        for (vtkIdType inPtId = chunk * chunkSize; inPtId < lastPtId; inPtId++)
+        {
+          pointSources[inPtId] = -1;
+          if (!isPointVisible(inPtId))
+          {
+            continue;
+          }
+          evaluatePoint(inPtId, glyph);
+          pointSources[inPtId] = glyph.Source;
+          if (glyph.Source >= 0)
+          {
+            sizes.Add(sources[glyph.Source]);
+          }
+        }
+      }
+    });
+
+  // exclusive scan of the chunk sizes, the last one is the output size
+  GlyphChunk total;
+  for (GlyphChunk& chunk : chunks)
+  {
+    GlyphChunk sizes = chunk;
+    chunk = total;
+    total.Add(sizes);
   }
 
-  srcPointIdList->SetNumberOfIds(numSourcePts);
-  dstPointIdList->SetNumberOfIds(numSourcePts);
-  srcCellIdList->SetNumberOfIds(numSourceCells);
-  dstCellIdList->SetNumberOfIds(numSourceCells);
+  vtkIdType numNewPts = total.NumberOfPoints;
+  vtkIdType numNewCells = 0;
+  vtkIdType cellTypeOffsets[4];
+  for (int c = 0; c < 4; ++c)
+  {
+    // the output cell ids: verts, then lines, polys and strips
+    cellTypeOffsets[c] = numNewCells;
+    numNewCells += total.NumberOfCells[c];
+  }
 
   newPts = vtkPoints::New();
 
@@ -329,13 +571,28 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
   {
     newPts->SetDataType(VTK_DOUBLE);
   }
+  newPts->SetNumberOfPoints(numNewPts);
+
+  // Prepare to copy output.
+  ArrayList pointArrays;
+  ArrayList cellArrays;
+  if (pd)
+  {
+    outputPD->CopyAllocate(pd, numNewPts);
+    pointArrays.AddArrays(numNewPts, pd, outputPD, 0.0, false);
+    if (this->FillCellData)
+    {
+      outputCD->CopyGlobalIdsOn();
+      outputCD->CopyAllocate(pd, numNewCells);
+      cellArrays.AddArrays(numNewCells, pd, outputCD, 0.0, false);
+    }
+  }
 
-  newPts->Allocate(numPts * numSourcePts);
   if (this->GeneratePointIds)
   {
     pointIds = vtkIdTypeArray::New();
     pointIds->SetName(this->PointIdsName);
-    pointIds->Allocate(numPts * numSourcePts);
+    pointIds->SetNumberOfValues(numNewPts);
     outputPD->AddArray(pointIds);
     pointIds->Delete();
   }
@@ -343,13 +600,13 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
   {
     newScalars = inCScalars->NewInstance();
     newScalars->SetNumberOfComponents(inCScalars->GetNumberOfComponents());
-    newScalars->Allocate(inCScalars->GetNumberOfComponents() * numPts * numSourcePts);
+    newScalars->SetNumberOfTuples(numNewPts);
     newScalars->SetName(inCScalars->GetName());
   }
   else if ((this->ColorMode == VTK_COLOR_BY_SCALE) && inSScalars)
   {
     newScalars = vtkFloatArray::New();
-    newScalars->Allocate(numPts * numSourcePts);
+    newScalars->SetNumberOfTuples(numNewPts);
     newScalars->SetName("GlyphScale");
     if (this->ScaleMode == VTK_SCALE_BY_SCALAR)
     {
@@ -359,21 +616,21 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
   else if ((this->ColorMode == VTK_COLOR_BY_VECTOR) && haveVectors)
   {
     newScalars = vtkFloatArray::New();
-    newScalars->Allocate(numPts * numSourcePts);
+    newScalars->SetNumberOfTuples(numNewPts);
     newScalars->SetName("VectorMagnitude");
   }
   if (haveVectors)
   {
     newVectors = vtkFloatArray::New();
     newVectors->SetNumberOfComponents(3);
-    newVectors->Allocate(3 * numPts * numSourcePts);
+    newVectors->SetNumberOfTuples(numNewPts);
     newVectors->SetName("GlyphVector");
   }
   if (haveNormals)
   {
     newNormals = vtkFloatArray::New();
     newNormals->SetNumberOfComponents(3);
-    newNormals->Allocate(3 * numPts * numSourcePts);
+    newNormals->SetNumberOfTuples(numNewPts);
     newNormals->SetName("Normals");
   }
   if (haveTCoords)
@@ -381,339 +638,255 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
     newTCoords = vtkFloatArray::New();
     int numComps = sourceTCoords->GetNumberOfComponents();
     newTCoords->SetNumberOfComponents(numComps);
-    newTCoords->Allocate(numComps * numPts * numSourcePts);
+    newTCoords->SetNumberOfTuples(numNewPts);
     newTCoords->SetName("TCoords");
   }
 
-  // Setting up for calls to PolyData::InsertNextCell()
-  output->AllocateEstimate(numPts * numSourceCells, 3);
-
-  transformedSourcePts->SetDataTypeToDouble();
-  transformedSourcePts->Allocate(numSourcePts);
+  vtkNew<vtkIdTypeArray> newOffsets[4];
+  vtkNew<vtkIdTypeArray> newConnectivity[4];
+  for (int c = 0; c < 4; ++c)
+  {
+    newOffsets[c]->SetNumberOfValues(total.NumberOfCells[c] + 1);
+    newOffsets[c]->SetValue(total.NumberOfCells[c], total.ConnectivitySize[c]);
+    newConnectivity[c]->SetNumberOfValues(total.ConnectivitySize[c]);
+  }
 
   // Traverse all Input points, transforming Source points and copying
   // point attributes.
   //
-  ptIncr = 0;
-  cellIncr = 0;
-  for (inPtId = 0; inPtId < numPts; inPtId++)
-  {
-    scalex = scaley = scalez = 1.0;
-    if (!(inPtId % 10000))
+  vtkSMPTools::For(0, numChunks,
+    [&](vtkIdType firstChunk, vtkIdType lastChunk)
     {
-      this->UpdateProgress(static_cast<double>(inPtId) / numPts);
-      if (this->CheckAbort())
+      GlyphPoint glyph;
+      std::vector<double> tc(haveTCoords ? sourceTCoords->GetNumberOfComponents() : 0);
+      bool isFirst = vtkSMPTools::GetSingleThread();
+      for (vtkIdType chunk = firstChunk; chunk < lastChunk; ++chunk)
       {
-        break;
-      }
-    }
-
-    // Get the scalar and vector data
-    if (inSScalars)
-    {
-      s = inSScalars->GetComponent(inPtId, 0);
-      if (this->ScaleMode == VTK_SCALE_BY_SCALAR || this->ScaleMode == VTK_DATA_SCALING_OFF)
-      {
-        scalex = scaley = scalez = s;
-      }
-    }
+        if (isFirst)
+        {
+          this->UpdateProgress(static_cast<double>(chunk) / numChunks);
+          this->CheckAbort();
+        }
+        if (this->GetAbortOutput())
+        {
+          break;
+        }
 
-    if (haveVectors)
-    {
-      if (this->VectorMode == VTK_FOLLOW_CAMERA_DIRECTION)
-      {
-        vMag = 1.0; // v will be set later
-      }
-      else
-      {
-        vtkDataArray* array3D = this->VectorMode == VTK_USE_NORMAL ? inNormals : inVectors;
-        if (array3D->GetNumberOfComponents() > 3)
+        GlyphChunk offsets = chunks[chunk];
+        const vtkIdType lastPtId = std::min(numPts, (chunk + 1) * chunkSize);
+        for (vtkIdType inPtId = chunk * chunkSize; inPtId < lastPtId; inPtId++)
         {
-          vtkErrorMacro(<< "vtkDataArray " << array3D->GetName()
-                        << " has more than 3 components.\n");
-          pts->Delete();
-          trans->Delete();
-          if (newPts)
+          if (pointSources[inPtId] < 0)
           {
-            newPts->Delete();
+            continue;
           }
-          if (newVectors)
+          evaluatePoint(inPtId, glyph);
+          const GlyphSource& glyphSource = sources[pointSources[inPtId]];
+          const vtkIdType ptIncr = offsets.NumberOfPoints;
+          const vtkIdType numSourcePts = glyphSource.NumberOfPoints;
+          double* v = glyph.Vector;
+          double* scale = glyph.Scale;
+
+          // Copy all topology (transformation independent)
+          for (int c = 0; c < 4; ++c)
           {
-            newVectors->Delete();
+            const GlyphCells& cells = glyphSource.Cells[c];
+            const vtkIdType numCells = static_cast<vtkIdType>(cells.Offsets.size()) - 1;
+            vtkIdType* outOffsets = newOffsets[c]->GetPointer(offsets.NumberOfCells[c]);
+            for (vtkIdType i = 0; i < numCells; i++)
+            {
+              outOffsets[i] = offsets.ConnectivitySize[c] + cells.Offsets[i];
+            }
+            vtkIdType* outConnectivity =
+              newConnectivity[c]->GetPointer(offsets.ConnectivitySize[c]);
+            for (size_t i = 0; i < cells.Connectivity.size(); i++)
+            {
+              outConnectivity[i] = cells.Connectivity[i] + ptIncr;
+            }
           }
-          return false;
-        }
-
-        v[0] = 0;
-        v[1] = 0;
-        v[2] = 0;
-        array3D->GetTuple(inPtId, v);
-        vMag = vtkMath::Norm(v);
-        if (this->ScaleMode == VTK_SCALE_BY_VECTORCOMPONENTS)
-        {
-          scalex = v[0];
-          scaley = v[1];
-          scalez = v[2];
-        }
-        else if (this->ScaleMode == VTK_SCALE_BY_VECTOR)
-        {
-          scalex = scaley = scalez = vMag;
-        }
-      }
-    }
-
-    // Clamp data scale if enabled
-    if (this->Clamping)
-    {
-      scalex = (scalex < this->Range[0] ? this->Range[0]
-                                        : (scalex > this->Range[1] ? this->Range[1] : scalex));
-      scalex = (scalex - this->Range[0]) / den;
-      scaley = (scaley < this->Range[0] ? this->Range[0]
-                                        : (scaley > this->Range[1] ? this->Range[1] : scaley));
-      scaley = (scaley - this->Range[0]) / den;
-      scalez = (scalez < this->Range[0] ? this->Range[0]
-                                        : (scalez > this->Range[1] ? this->Range[1] : scalez));
-      scalez = (scalez - this->Range[0]) / den;
-    }
-
-    // Compute index into table of glyphs
-    if (this->IndexMode != VTK_INDEXING_OFF)
-    {
-      if (this->IndexMode == VTK_INDEXING_BY_SCALAR)
-      {
-        value = s;
-      }
-      else
-      {
-        value = vMag;
-      }
 
-      int index = static_cast<int>((value - this->Range[0]) * numberOfSources / den);
-      index = (index < 0 ? 0 : (index >= numberOfSources ? (numberOfSources - 1) : index));
-
-      source = this->GetSource(index, sourceVector);
-      if (source != nullptr)
-      {
-        sourcePts = source->GetPoints();
-        sourceNormals = source->GetPointData()->GetNormals();
-        numSourcePts = sourcePts->GetNumberOfPoints();
-        numSourceCells = source->GetNumberOfCells();
-      }
-    }
-
-    // Make sure we're not indexing into empty glyph
-    if (source == nullptr)
-    {
-      continue;
-    }
-
-    // Check ghost points.
-    // If we are processing a piece, we do not want to duplicate glyphs on the borders.
-    if (inGhostLevels &&
-      inGhostLevels[inPtId] &
-        (vtkDataSetAttributes::DUPLICATEPOINT | vtkDataSetAttributes::HIDDENPOINT))
-    {
-      continue;
-    }
-
-    if (inputUG && !inputUG->IsPointVisible(inPtId))
-    {
-      // input is a vtkUniformGrid and the current point is blanked. Don't glyph
-      // it.
-      continue;
-    }
-
-    if (!this->IsPointVisible(input, inPtId))
-    {
-      continue;
-    }
-
-    // Now begin copying/transforming glyph
-    trans->Identity();
-
-    // Copy all topology (transformation independent)
-    for (cellId = 0; cellId < numSourceCells; cellId++)
-    {
-      source->GetCellPoints(cellId, pointIdList);
-      cellPts = pointIdList;
-      npts = cellPts->GetNumberOfIds();
-      for (pts->Reset(), i = 0; i < npts; i++)
-      {
-        pts->InsertId(i, cellPts->GetId(i) + ptIncr);
-      }
-      output->InsertNextCell(source->GetCellType(cellId), pts);
-    }
+          // Now begin copying/transforming glyph: translate Source to Input
+          // point, orient it, then scale it
+          double rotation[3][3] = { { 1.0, 0.0, 0.0 }, { 0.0, 1.0, 0.0 }, { 0.0, 0.0, 1.0 } };
+          if (haveVectors)
+          {
+            // Copy Input vector
+            for (vtkIdType i = 0; i < numSourcePts; i++)
+            {
+              newVectors->SetTuple(i + ptIncr, v);
+            }
+            if (this->Orient)
+            {
+              if (this->VectorMode == VTK_FOLLOW_CAMERA_DIRECTION)
+              {
+                double glyphRight_World[3]; // glyph right direction in World coordinate system
+                vtkMath::Cross(this->FollowedCameraViewUp, v, glyphRight_World);
+                // glyph up direction in World coordinate system
+                // (approximately the same as this->FollowedCameraViewUp, but slightly adjusted
+                // to be orthogonal to the normal direction)
+                double glyphUp_World[3];
+                vtkMath::Cross(v, glyphRight_World, glyphUp_World);
+                for (int i = 0; i < 3; i++)
+                {
+                  rotation[i][0] = glyphRight_World[i];
+                  rotation[i][1] = glyphUp_World[i];
+                  rotation[i][2] = v[i];
+                }
+              }
+              else if (glyph.VectorMagnitude > 0.0)
+              {
+                // if there is no y or z component
+                if (v[1] == 0.0 && v[2] == 0.0)
+                {
+                  if (v[0] < 0) // just flip x if we need to
+                  {
+                    const double yAxis[3] = { 0.0, 1.0, 0.0 };
+                    HalfTurn(yAxis, rotation);
+                  }
+                }
+                else
+                {
+                  double vNew[3];
+                  vNew[0] = (v[0] + glyph.VectorMagnitude) / 2.0;
+                  vNew[1] = v[1] / 2.0;
+                  vNew[2] = v[2] / 2.0;
+                  HalfTurn(vNew, rotation);
+                }
+              }
+            }
+          }
 
-    // translate Source to Input point
-    input->GetPoint(inPtId, x);
-    trans->Translate(x[0], x[1], x[2]);
+          if (haveTCoords)
+          {
+            for (vtkIdType i = 0; i < numSourcePts; i++)
+            {
+              sourceTCoords->GetTuple(i, tc.data());
+              newTCoords->SetTuple(i + ptIncr, tc.data());
+            }
+          }
 
-    if (haveVectors)
-    {
-      // Copy Input vector
-      for (i = 0; i < numSourcePts; i++)
-      {
-        newVectors->InsertTuple(i + ptIncr, v);
-      }
-      if (this->Orient)
-      {
-        if (this->VectorMode == VTK_FOLLOW_CAMERA_DIRECTION)
-        {
-          // v = glyphNormal_World (glyph normal direction in World coordinate system)
-          v[0] = this->FollowedCameraPosition[0] - x[0];
-          v[1] = this->FollowedCameraPosition[1] - x[1];
-          v[2] = this->FollowedCameraPosition[2] - x[2];
-          vtkMath::Normalize(v);
-          double glyphRight_World[3]; // glyph right direction in World coordinate system
-          vtkMath::Cross(this->FollowedCameraViewUp, v, glyphRight_World);
-          // glyph up direction in World coordinate system
-          // (approximately the same as this->FollowedCameraViewUp, but slightly adjusted to be
-          // orthogonal to the normal direction)
-          double glyphUp_World[3];
-          vtkMath::Cross(v, glyphRight_World, glyphUp_World);
-          double glyphToWorld[16] = { glyphRight_World[0], glyphUp_World[0], v[0], 0.0,
-            glyphRight_World[1], glyphUp_World[1], v[1], 0.0, glyphRight_World[2], glyphUp_World[2],
-            v[2], 0.0, 0.0, 0.0, 0.0, 1.0 };
-          trans->Concatenate(glyphToWorld);
-        }
-        else if (vMag > 0.0)
-        {
-          // if there is no y or z component
-          if (v[1] == 0.0 && v[2] == 0.0)
+          // determine scale factor from scalars if appropriate
+          // Copy scalar value
+          if (inSScalars && (this->ColorMode == VTK_COLOR_BY_SCALE))
           {
-            if (v[0] < 0) // just flip x if we need to
+            for (vtkIdType i = 0; i < numSourcePts; i++)
             {
-              trans->RotateWXYZ(180.0, 0, 1, 0);
+              newScalars->SetTuple(i + ptIncr, scale); // = scaley = scalez
             }
           }
-          else
+          else if (inCScalars && (this->ColorMode == VTK_COLOR_BY_SCALAR))
           {
-            vNew[0] = (v[0] + vMag) / 2.0;
-            vNew[1] = v[1] / 2.0;
-            vNew[2] = v[2] / 2.0;
-            trans->RotateWXYZ(180.0, vNew[0], vNew[1], vNew[2]);
+            for (vtkIdType i = 0; i < numSourcePts; i++)
+            {
+              newScalars->SetTuple(ptIncr + i, inPtId, inCScalars);
+            }
+          }
+          if (haveVectors && this->ColorMode == VTK_COLOR_BY_VECTOR)
+          {
+            for (vtkIdType i = 0; i < numSourcePts; i++)
+            {
+              newScalars->SetTuple(i + ptIncr, &glyph.VectorMagnitude);
+            }
           }
-        }
-      }
-    }
-
-    if (haveTCoords)
-    {
-      for (i = 0; i < numSourcePts; i++)
-      {
-        sourceTCoords->GetTuple(i, tc);
-        newTCoords->InsertTuple(i + ptIncr, tc);
-      }
-    }
 
-    // determine scale factor from scalars if appropriate
-    // Copy scalar value
-    if (inSScalars && (this->ColorMode == VTK_COLOR_BY_SCALE))
-    {
-      for (i = 0; i < numSourcePts; i++)
-      {
-        newScalars->InsertTuple(i + ptIncr, &scalex); // = scaley = scalez
-      }
-    }
-    else if (inCScalars && (this->ColorMode == VTK_COLOR_BY_SCALAR))
-    {
-      for (i = 0; i < numSourcePts; i++)
-      {
-        outputPD->CopyTuple(inCScalars, newScalars, inPtId, ptIncr + i);
-      }
-    }
-    if (haveVectors && this->ColorMode == VTK_COLOR_BY_VECTOR)
-    {
-      for (i = 0; i < numSourcePts; i++)
-      {
-        newScalars->InsertTuple(i + ptIncr, &vMag);
-      }
-    }
+          // scale data if appropriate
+          if (this->Scaling)
+          {
+            for (int j = 0; j < 3; j++)
+            {
+              scale[j] = this->ScaleMode == VTK_DATA_SCALING_OFF ? this->ScaleFactor
+                                                                 : scale[j] * this->ScaleFactor;
+              if (scale[j] == 0.0)
+              {
+                scale[j] = 1.0e-10;
+              }
+              for (int i = 0; i < 3; i++)
+              {
+                rotation[i][j] *= scale[j];
+              }
+            }
+          }
 
-    // scale data if appropriate
-    if (this->Scaling)
-    {
-      if (this->ScaleMode == VTK_DATA_SCALING_OFF)
-      {
-        scalex = scaley = scalez = this->ScaleFactor;
-      }
-      else
-      {
-        scalex *= this->ScaleFactor;
-        scaley *= this->ScaleFactor;
-        scalez *= this->ScaleFactor;
-      }
+          // multiply points and normals by resulting matrix
+          vtkDataArray* outPoints = newPts->GetData();
+          for (vtkIdType i = 0; i < numSourcePts; i++)
+          {
+            double p[3];
+            vtkMath::Multiply3x3(rotation, &glyphSource.Points[3 * i], p);
+            vtkMath::Add(p, glyph.Position, p);
+            outPoints->SetTuple(ptIncr + i, p);
+          }
 
-      if (scalex == 0.0)
-      {
-        scalex = 1.0e-10;
-      }
-      if (scaley == 0.0)
-      {
-        scaley = 1.0e-10;
-      }
-      if (scalez == 0.0)
-      {
-        scalez = 1.0e-10;
-      }
-      trans->Scale(scalex, scaley, scalez);
-    }
+          if (haveNormals)
+          {
+            // to transform the normals, multiply by the transposed inverse matrix
+            double inverse[3][3];
+            double normalMatrix[3][3];
+            vtkMath::Invert3x3(rotation, inverse);
+            vtkMath::Transpose3x3(inverse, normalMatrix);
+            for (vtkIdType i = 0; i < numSourcePts; i++)
+            {
+              double n[3];
+              vtkMath::Multiply3x3(normalMatrix, &glyphSource.Normals[3 * i], n);
+              vtkMath::Normalize(n);
+              newNormals->SetTuple(ptIncr + i, n);
+            }
+          }
 
-    // multiply points and normals by resulting matrix
-    if (this->SourceTransform)
-    {
-      transformedSourcePts->Reset();
-      this->SourceTransform->TransformPoints(sourcePts, transformedSourcePts);
-      trans->TransformPoints(transformedSourcePts, newPts);
-    }
-    else
-    {
-      trans->TransformPoints(sourcePts, newPts);
-    }
+          // Copy point data from source (if possible)
+          if (pd)
+          {
+            for (vtkIdType i = 0; i < numSourcePts; ++i)
+            {
+              pointArrays.Copy(inPtId, ptIncr + i);
+            }
+            if (this->FillCellData)
+            {
+              for (int c = 0; c < 4; ++c)
+              {
+                const vtkIdType numCells =
+                  static_cast<vtkIdType>(glyphSource.Cells[c].Offsets.size()) - 1;
+                const vtkIdType cellIncr = cellTypeOffsets[c] + offsets.NumberOfCells[c];
+                for (vtkIdType i = 0; i < numCells; ++i)
+                {
+                  cellArrays.Copy(inPtId, cellIncr + i);
+                }
+              }
+            }
+          }
 
-    if (haveNormals)
-    {
-      trans->TransformNormals(sourceNormals, newNormals);
-    }
+          // If point ids are to be generated, do it here
+          if (this->GeneratePointIds)
+          {
+            for (vtkIdType i = 0; i < numSourcePts; i++)
+            {
+              pointIds->SetValue(ptIncr + i, inPtId);
+            }
+          }
 
-    // Copy point data from source (if possible)
-    if (pd)
-    {
-      for (i = 0; i < numSourcePts; ++i)
-      {
-        srcPointIdList->SetId(i, inPtId);
-        dstPointIdList->SetId(i, ptIncr + i);
-      }
-      outputPD->CopyData(pd, srcPointIdList, dstPointIdList);
-      if (this->FillCellData)
-      {
-        for (i = 0; i < numSourceCells; ++i)
-        {
-          srcCellIdList->SetId(i, inPtId);
-          dstCellIdList->SetId(i, cellIncr + i);
+          offsets.Add(glyphSource);
         }
-        outputCD->CopyData(pd, srcCellIdList, dstCellIdList);
-      }
-    }
-
-    // If point ids are to be generated, do it here
-    if (this->GeneratePointIds)
-    {
-      for (i = 0; i < numSourcePts; i++)
-      {
-        pointIds->InsertNextValue(inPtId);
       }
-    }
-
-    ptIncr += numSourcePts;
-    cellIncr += numSourceCells;
-  }
+    });
 
   // Update ourselves and release memory
   //
   output->SetPoints(newPts);
   newPts->Delete();
 
+  vtkNew<vtkCellArray> newCells[4];
+  for (int c = 0; c < 4; ++c)
+  {
+    if (total.NumberOfCells[c] > 0)
+    {
+      newCells[c]->SetData(newOffsets[c], newConnectivity[c]);
+    }
+  }
+  output->SetVerts(total.NumberOfCells[0] > 0 ? newCells[0].Get() : nullptr);
+  output->SetLines(total.NumberOfCells[1] > 0 ? newCells[1].Get() : nullptr);
+  output->SetPolys(total.NumberOfCells[2] > 0 ? newCells[2].Get() : nullptr);
+  output->SetStrips(total.NumberOfCells[3] > 0 ? newCells[3].Get() : nullptr);
+
   if (newScalars)
   {
     int idx = outputPD->AddArray(newScalars);
@@ -739,13 +912,8 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
     newTCoords->Delete();
   }
 
-  output->Squeeze();
-  trans->Delete();
-  pts->Delete();
-
   return true;
 }
-
 //------------------------------------------------------------------------------
 // Specify a source object at a specified table location.
 void vtkGlyph3D::SetSourceConnection(int id, vtkAlgorithmOutput* algOutput)
@@ -61,6 +61,12 @@
  * vtkAlgorithm. The first array is scalars, the next vectors, the next
  * normals and finally color scalars.
  *
+ * @warning
+ * This class has been threaded with vtkSMPTools. The output size of chunks of
+ * input points is computed first, then the chunks are glyphed in parallel.
+ * Using TBB or other non-sequential type (set in the CMake variable
+ * VTK_SMP_IMPLEMENTATION_TYPE) may improve performance significantly.
+ *
  * @sa
  * vtkTensorGlyph
  */
@@ -293,6 +299,8 @@ public:
   /**
    * This can be overwritten by subclass to return 0 when a point is
    * blanked. Default implementation is to always return 1;
+   * It is called once per point, concurrently from several threads, and must
+   * be thread safe.
    */
   virtual int IsPointVisible(vtkDataSet*, vtkIdType) { return 1; }
 
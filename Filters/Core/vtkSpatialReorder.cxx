@@ -0,0 +1,468 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkSpatialReorder.h"
+
+#include "vtkArrayListTemplate.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkIdTypeArray.h"
+#include "vtkInformation.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+VTK_ABI_NAMESPACE_BEGIN
+namespace
+{
+// Number of bits of the quantized coordinates, so that the keys of the three axes fit in 64 bits.
+constexpr int CurveBits = 21;
+
+// Inserts two zero bits between each of the lowest 21 bits of x.
+uint64_t SpreadBits(uint64_t x)
+{
+  x &= 0x1fffff;
+  x = (x | x << 32) & 0x1f00000000ffffULL;
+  x = (x | x << 16) & 0x1f0000ff0000ffULL;
+  x = (x | x << 8) & 0x100f00f00f00f00fULL;
+  x = (x | x << 4) & 0x10c30c30c30c30c3ULL;
+  x = (x | x << 2) & 0x1249249249249249ULL;
+  return x;
+}
+
+uint64_t MortonKey(const uint32_t q[3])
+{
+  return (SpreadBits(q[0]) << 2) | (SpreadBits(q[1]) << 1) | SpreadBits(q[2]);
+}
+
+// Transforms the coordinates as in J. Skilling, "Programming the Hilbert curve" (2004), after
+// which the interleaved bits are the index along the Hilbert curve.
+uint64_t HilbertKey(const uint32_t q[3])
+{
+  uint32_t x[3] = { q[0], q[1], q[2] };
+  const uint32_t m = 1u << (CurveBits - 1);
+  for (uint32_t bit = m; bit > 1; bit >>= 1)
+  {
+    const uint32_t lowerBits = bit - 1;
+    for (int i = 0; i < 3; ++i)
+    {
+      if (x[i] & bit)
+      {
+        x[0] ^= lowerBits;
+      }
+      else
+      {
+        const uint32_t swapped = (x[0] ^ x[i]) & lowerBits;
+        x[0] ^= swapped;
+        x[i] ^= swapped;
+      }
+    }
+  }
+  x[1] ^= x[0];
+  x[2] ^= x[1];
+  uint32_t gray = 0;
+  for (uint32_t bit = m; bit > 1; bit >>= 1)
+  {
+    if (x[2] & bit)
+    {
+      gray ^= bit - 1;
+    }
+  }
+  for (int i = 0; i < 3; ++i)
+  {
+    x[i] ^= gray;
+  }
+  return MortonKey(x);
+}
+
+// Quantizes positions in the bounding box of the data set and returns their key along the curve.
+// The same scale is used on the three axes so that the curve keeps its locality.
+class CurveKey
+{
+public:
+  CurveKey(const double bounds[6], int curveType)
+    : CurveType(curveType)
+  {
+    double length = 0.0;
+    for (int i = 0; i < 3; ++i)
+    {
+      this->Origin[i] = bounds[2 * i];
+      length = std::max(length, bounds[2 * i + 1] - bounds[2 * i]);
+    }
+    this->Scale = length > 0.0 ? MaxCoordinate / length : 0.0;
+  }
+
+  uint64_t operator()(const double x[3]) const
+  {
+    uint32_t q[3];
+    for (int i = 0; i < 3; ++i)
+    {
+      const double t = (x[i] - this->Origin[i]) * this->Scale;
+      q[i] = t > 0.0 ? static_cast<uint32_t>(std::min(t, MaxCoordinate)) : 0;
+    }
+    return this->CurveType == vtkSpatialReorder::HILBERT ? HilbertKey(q) : MortonKey(q);
+  }
+
+private:
+  static constexpr double MaxCoordinate = static_cast<double>((1u << CurveBits) - 1);
+
+  double Origin[3];
+  double Scale;
+  int CurveType;
+};
+
+using KeyedId = std::pair<uint64_t, vtkIdType>;
+
+// Sorts the keyed ids, the ids breaking the ties so that the order does not depend on the number
+// of threads, and fills order with the sorted ids.
+void SortKeys(std::vector<KeyedId>& keys, vtkIdType* order)
+{
+  vtkSMPTools::Sort(keys.begin(), keys.end());
+  vtkSMPTools::For(0, static_cast<vtkIdType>(keys.size()),
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        order[i] = keys[i].second;
+      }
+    });
+}
+
+// Computes the key of the center of the points of each cell.
+struct ComputeCellKeys
+{
+  template <typename CellStateT>
+  void operator()(CellStateT& state, vtkPoints* points, const CurveKey& curveKey, KeyedId* keys)
+  {
+    vtkSMPTools::For(0, state.GetNumberOfCells(),
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        double x[3];
+        for (vtkIdType cellId = begin; cellId < end; ++cellId)
+        {
+          double center[3] = { 0.0, 0.0, 0.0 };
+          const vtkIdType npts = state.GetCellSize(cellId);
+          for (const vtkIdType ptId : state.GetCellRange(cellId))
+          {
+            points->GetPoint(ptId, x);
+            center[0] += x[0];
+            center[1] += x[1];
+            center[2] += x[2];
+          }
+          for (int i = 0; npts > 0 && i < 3; ++i)
+          {
+            center[i] /= npts;
+          }
+          keys[cellId] = KeyedId(curveKey(center), cellId);
+        }
+      });
+  }
+};
+
+// Copies the cells in the given order, or in the same order when cellOrder is nullptr, and maps
+// the ids of the connectivity through valueMap unless it is nullptr. The storage type is kept.
+struct PermuteCellArray
+{
+  template <typename CellStateT>
+  void operator()(CellStateT& state, vtkCellArray* output, const vtkIdType* cellOrder,
+    const vtkIdType* valueMap)
+  {
+    using ArrayType = typename CellStateT::ArrayType;
+    using ValueType = typename CellStateT::ValueType;
+    const vtkIdType numCells = state.GetNumberOfCells();
+    const ValueType* inConnectivity = state.GetConnectivity()->GetPointer(0);
+
+    vtkNew<ArrayType> offsets;
+    offsets->SetNumberOfValues(numCells + 1);
+    ValueType* outOffsets = offsets->GetPointer(0);
+    outOffsets[0] = 0;
+    vtkSMPTools::For(0, numCells,
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        for (vtkIdType cellId = begin; cellId < end; ++cellId)
+        {
+          const vtkIdType inCellId = cellOrder ? cellOrder[cellId] : cellId;
+          outOffsets[cellId + 1] = static_cast<ValueType>(state.GetCellSize(inCellId));
+        }
+      });
+    std::partial_sum(outOffsets + 1, outOffsets + numCells + 1, outOffsets + 1);
+
+    vtkNew<ArrayType> connectivity;
+    connectivity->SetNumberOfValues(outOffsets[numCells]);
+    ValueType* outConnectivity = connectivity->GetPointer(0);
+    vtkSMPTools::For(0, numCells,
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        for (vtkIdType cellId = begin; cellId < end; ++cellId)
+        {
+          const vtkIdType inCellId = cellOrder ? cellOrder[cellId] : cellId;
+          const ValueType* first = inConnectivity + state.GetBeginOffset(inCellId);
+          const ValueType* last = inConnectivity + state.GetEndOffset(inCellId);
+          ValueType* result = outConnectivity + outOffsets[cellId];
+          if (valueMap)
+          {
+            std::transform(first, last, result,
+              [valueMap](ValueType id) { return static_cast<ValueType>(valueMap[id]); });
+          }
+          else
+          {
+            std::copy(first, last, result);
+          }
+        }
+      });
+
+    output->SetData(offsets, connectivity);
+  }
+};
+
+// Fills order with the ids of the cells sorted along the curve.
+void SortCells(vtkCellArray* cells, vtkPoints* points, const CurveKey& curveKey, vtkIdType* order)
+{
+  std::vector<KeyedId> keys(static_cast<std::size_t>(cells->GetNumberOfCells()));
+  cells->Visit(ComputeCellKeys{}, points, curveKey, keys.data());
+  SortKeys(keys, order);
+}
+
+// Copies the attributes in the given order, along with the extra array if any.
+void PermuteAttributes(vtkDataSetAttributes* input, vtkDataSetAttributes* output,
+  const std::vector<vtkIdType>& order, vtkDataArray* extraInput = nullptr,
+  vtkSmartPointer<vtkDataArray>* extraOutput = nullptr)
+{
+  const vtkIdType numTuples = static_cast<vtkIdType>(order.size());
+  output->CopyAllOn();
+  output->CopyAllocate(input, numTuples);
+  ArrayList arrays;
+  arrays.AddArrays(numTuples, input, output, 0.0, /*promote=*/false);
+  if (extraInput)
+  {
+    vtkStdString name = extraInput->GetName() ? extraInput->GetName() : "";
+    *extraOutput = vtkArrayDownCast<vtkDataArray>(
+      arrays.AddArrayPair(numTuples, extraInput, name, 0.0, /*promote=*/false));
+  }
+  vtkSMPTools::For(0, numTuples,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        arrays.Copy(order[i], i);
+      }
+    });
+}
+
+vtkSmartPointer<vtkIdTypeArray> NewOriginalIds(
+  const char* name, const std::vector<vtkIdType>& order, vtkIdType numIds)
+{
+  auto originalIds = vtkSmartPointer<vtkIdTypeArray>::New();
+  originalIds->SetName(name);
+  originalIds->SetNumberOfValues(numIds);
+  if (order.empty())
+  {
+    std::iota(originalIds->GetPointer(0), originalIds->GetPointer(0) + numIds, 0);
+  }
+  else
+  {
+    std::copy(order.begin(), order.end(), originalIds->GetPointer(0));
+  }
+  return originalIds;
+}
+}
+
+vtkStandardNewMacro(vtkSpatialReorder);
+
+//------------------------------------------------------------------------------
+int vtkSpatialReorder::FillInputPortInformation(int vtkNotUsed(port), vtkInformation* info)
+{
+  info->Set(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkPolyData");
+  info->Append(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkUnstructuredGrid");
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+int vtkSpatialReorder::RequestData(vtkInformation* vtkNotUsed(request),
+  vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  vtkPointSet* input = vtkPointSet::GetData(inputVector[0]);
+  vtkPointSet* output = vtkPointSet::GetData(outputVector);
+  vtkPolyData* polyInput = vtkPolyData::SafeDownCast(input);
+  vtkUnstructuredGrid* gridInput = vtkUnstructuredGrid::SafeDownCast(input);
+  if (!polyInput && !gridInput)
+  {
+    vtkErrorMacro("Only vtkPolyData and vtkUnstructuredGrid are supported.");
+    return 0;
+  }
+
+  const vtkIdType numPts = input->GetNumberOfPoints();
+  const vtkIdType numCells = input->GetNumberOfCells();
+  const bool reorderPoints = this->ReorderPoints && numPts > 0;
+  const bool reorderCells = this->ReorderCells && numCells > 0 && numPts > 0;
+  std::vector<vtkIdType> pointOrder, cellOrder; // new ids to input ids, empty when kept
+
+  if (!reorderPoints && !reorderCells)
+  {
+    output->ShallowCopy(input);
+  }
+  else
+  {
+    double bounds[6];
+    input->GetPoints()->GetBounds(bounds);
+    const CurveKey curveKey(bounds, this->CurveType);
+    vtkPoints* inPoints = input->GetPoints();
+
+    // sort the points along the curve
+    std::vector<vtkIdType> pointMap;
+    if (reorderPoints)
+    {
+      std::vector<KeyedId> keys(static_cast<std::size_t>(numPts));
+      vtkSMPTools::For(0, numPts,
+        [&](vtkIdType begin, vtkIdType end)
+        {
+          double x[3];
+          for (vtkIdType ptId = begin; ptId < end; ++ptId)
+          {
+            inPoints->GetPoint(ptId, x);
+            keys[ptId] = KeyedId(curveKey(x), ptId);
+          }
+        });
+      pointOrder.resize(keys.size());
+      SortKeys(keys, pointOrder.data());
+      pointMap.resize(keys.size());
+      vtkSMPTools::For(0, numPts,
+        [&](vtkIdType begin, vtkIdType end)
+        {
+          for (vtkIdType ptId = begin; ptId < end; ++ptId)
+          {
+            pointMap[pointOrder[ptId]] = ptId;
+          }
+        });
+    }
+    const vtkIdType* valueMap = reorderPoints ? pointMap.data() : nullptr;
+    if (reorderCells)
+    {
+      cellOrder.resize(static_cast<std::size_t>(numCells));
+    }
+    this->UpdateProgress(0.3);
+
+    // sort and copy the cells, the cells of a vtkPolyData within each of its cell arrays
+    if (polyInput)
+    {
+      vtkPolyData* polyOutput = vtkPolyData::SafeDownCast(output);
+      vtkCellArray* inCells[4] = { polyInput->GetVerts(), polyInput->GetLines(),
+        polyInput->GetPolys(), polyInput->GetStrips() };
+      vtkNew<vtkCellArray> outCells[4];
+      vtkIdType cellOffset = 0;
+      for (int i = 0; i < 4; ++i)
+      {
+        const vtkIdType numTypeCells = inCells[i]->GetNumberOfCells();
+        vtkIdType* order = reorderCells ? cellOrder.data() + cellOffset : nullptr;
+        if (order)
+        {
+          SortCells(inCells[i], inPoints, curveKey, order);
+        }
+        inCells[i]->Visit(PermuteCellArray{}, outCells[i], order, valueMap);
+        if (order && cellOffset > 0)
+        {
+          std::transform(order, order + numTypeCells, order,
+            [cellOffset](vtkIdType cellId) { return cellId + cellOffset; });
+        }
+        cellOffset += numTypeCells;
+      }
+      polyOutput->SetVerts(outCells[0]);
+      polyOutput->SetLines(outCells[1]);
+      polyOutput->SetPolys(outCells[2]);
+      polyOutput->SetStrips(outCells[3]);
+    }
+    else if (numCells > 0)
+    {
+      vtkUnstructuredGrid* gridOutput = vtkUnstructuredGrid::SafeDownCast(output);
+      vtkIdType* order = reorderCells ? cellOrder.data() : nullptr;
+      if (order)
+      {
+        SortCells(gridInput->GetCells(), inPoints, curveKey, order);
+      }
+      vtkNew<vtkCellArray> outCells;
+      gridInput->GetCells()->Visit(PermuteCellArray{}, outCells, order, valueMap);
+
+      vtkNew<vtkUnsignedCharArray> outTypes;
+      outTypes->SetNumberOfValues(numCells);
+      const unsigned char* inTypes = gridInput->GetCellTypesArray()->GetPointer(0);
+      vtkSMPTools::For(0, numCells,
+        [&](vtkIdType begin, vtkIdType end)
+        {
+          for (vtkIdType cellId = begin; cellId < end; ++cellId)
+          {
+            outTypes->SetValue(cellId, inTypes[order ? order[cellId] : cellId]);
+          }
+        });
+
+      // the face locations follow the cells, the faces keep their order
+      vtkCellArray* inFaces = gridInput->GetPolyhedronFaces();
+      vtkCellArray* inFaceLocations = gridInput->GetPolyhedronFaceLocations();
+      if (inFaces && inFaceLocations)
+      {
+        vtkNew<vtkCellArray> outFaces;
+        vtkNew<vtkCellArray> outFaceLocations;
+        inFaces->Visit(PermuteCellArray{}, outFaces, nullptr, valueMap);
+        inFaceLocations->Visit(PermuteCellArray{}, outFaceLocations, order, nullptr);
+        gridOutput->SetPolyhedralCells(outTypes, outCells, outFaceLocations, outFaces);
+      }
+      else
+      {
+        gridOutput->SetCells(outTypes, outCells);
+      }
+    }
+    this->UpdateProgress(0.6);
+
+    // permute the points and the attributes
+    if (reorderPoints)
+    {
+      vtkSmartPointer<vtkDataArray> coordinates;
+      PermuteAttributes(input->GetPointData(), output->GetPointData(), pointOrder,
+        inPoints->GetData(), &coordinates);
+      vtkNew<vtkPoints> outPoints;
+      outPoints->SetData(coordinates);
+      output->SetPoints(outPoints);
+    }
+    else
+    {
+      output->SetPoints(inPoints);
+      output->GetPointData()->ShallowCopy(input->GetPointData());
+    }
+    if (reorderCells)
+    {
+      PermuteAttributes(input->GetCellData(), output->GetCellData(), cellOrder);
+    }
+    else
+    {
+      output->GetCellData()->ShallowCopy(input->GetCellData());
+    }
+    output->GetFieldData()->ShallowCopy(input->GetFieldData());
+  }
+
+  if (this->GenerateOriginalIds)
+  {
+    output->GetPointData()->AddArray(NewOriginalIds("vtkOriginalPointIds", pointOrder, numPts));
+    output->GetCellData()->AddArray(NewOriginalIds("vtkOriginalCellIds", cellOrder, numCells));
+  }
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+void vtkSpatialReorder::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "CurveType: " << (this->CurveType == HILBERT ? "Hilbert" : "Morton") << endl;
+  os << indent << "ReorderPoints: " << this->ReorderPoints << endl;
+  os << indent << "ReorderCells: " << this->ReorderCells << endl;
+  os << indent << "GenerateOriginalIds: " << this->GenerateOriginalIds << endl;
+}
+VTK_ABI_NAMESPACE_END
@@ -0,0 +1,111 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class vtkSpatialReorder
+ * @brief reorder points and cells along a space filling curve
+ *
+ * vtkSpatialReorder renumbers the points and the cells of a vtkPolyData or a
+ * vtkUnstructuredGrid so that entities close in space get close ids. The
+ * points are sorted along a Hilbert or Morton (Z-order) curve going through
+ * the bounding box of the data set, and the cells are sorted along the same
+ * curve by the center of their points. The geometry and the attributes are
+ * unchanged, only their order is: the connectivity, the polyhedron faces and
+ * all the point and cell data arrays are permuted consistently.
+ *
+ * Data sets written by some solvers list their points and cells in a nearly
+ * random order. Reordering them once improves the memory locality of every
+ * downstream filter, in particular the ones running in parallel with
+ * vtkSMPTools, and of the rendering.
+ *
+ * The curve keys are computed and sorted in parallel with vtkSMPTools. The
+ * positions are quantized on 21 bits per axis, so points closer than a
+ * 2^-21 fraction of the largest side of the bounding box keep their relative
+ * order. The cells of a vtkPolyData are sorted within each of its vertex,
+ * line, polygon and strip cell arrays.
+ *
+ * @sa
+ * vtkRemoveUnusedPoints vtkStaticCleanUnstructuredGrid
+ */
+
+#ifndef vtkSpatialReorder_h
+#define vtkSpatialReorder_h
+
+#include "vtkFiltersCoreModule.h" // For export macro
+#include "vtkPointSetAlgorithm.h"
+
+VTK_ABI_NAMESPACE_BEGIN
+class VTKFILTERSCORE_EXPORT vtkSpatialReorder : public vtkPointSetAlgorithm
+{
+public:
+  ///@{
+  /**
+   * Standard methods to instantiate, print, and obtain type information.
+   */
+  static vtkSpatialReorder* New();
+  vtkTypeMacro(vtkSpatialReorder, vtkPointSetAlgorithm);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+  ///@}
+
+  enum CurveTypes
+  {
+    HILBERT = 0,
+    MORTON = 1
+  };
+
+  ///@{
+  /**
+   * Specify the space filling curve used to order the points and cells. The
+   * Hilbert curve (the default) only moves between adjacent cells of the
+   * quantization grid, which gives a better locality; the Morton curve keys
+   * are cheaper to compute.
+   */
+  vtkSetClampMacro(CurveType, int, HILBERT, MORTON);
+  vtkGetMacro(CurveType, int);
+  void SetCurveTypeToHilbert() { this->SetCurveType(HILBERT); }
+  void SetCurveTypeToMorton() { this->SetCurveType(MORTON); }
+  ///@}
+
+  ///@{
+  /**
+   * Enable or disable the reordering of the points and of the cells. Both are
+   * on by default.
+   */
+  vtkSetMacro(ReorderPoints, bool);
+  vtkGetMacro(ReorderPoints, bool);
+  vtkBooleanMacro(ReorderPoints, bool);
+  vtkSetMacro(ReorderCells, bool);
+  vtkGetMacro(ReorderCells, bool);
+  vtkBooleanMacro(ReorderCells, bool);
+  ///@}
+
+  ///@{
+  /**
+   * Enable adding `vtkOriginalPointIds` and `vtkOriginalCellIds` arrays to the
+   * point and cell data, which give the input id of each output point and
+   * cell. Default is false.
+   */
+  vtkSetMacro(GenerateOriginalIds, bool);
+  vtkGetMacro(GenerateOriginalIds, bool);
+  vtkBooleanMacro(GenerateOriginalIds, bool);
+  ///@}
+
+protected:
+  vtkSpatialReorder() = default;
+  ~vtkSpatialReorder() override = default;
+
+  int FillInputPortInformation(int port, vtkInformation* info) override;
+  int RequestData(vtkInformation* request, vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector) override;
+
+  int CurveType = HILBERT;
+  bool ReorderPoints = true;
+  bool ReorderCells = true;
+  bool GenerateOriginalIds = false;
+
+private:
+  vtkSpatialReorder(const vtkSpatialReorder&) = delete;
+  void operator=(const vtkSpatialReorder&) = delete;
+};
+
+VTK_ABI_NAMESPACE_END
+#endif
@@ -9,6 +9,7 @@
 #include "vtkDoubleArray.h"
 #include "vtkFloatArray.h"
 #include "vtkGenericCell.h"
+#include "vtkIdList.h"
 #include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
@@ -16,12 +17,17 @@
 #include "vtkLongArray.h"
 #include "vtkLongLongArray.h"
 #include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkProp3D.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkShortArray.h"
 #include "vtkSignedCharArray.h"
+#include "vtkSortDataArray.h"
 #include "vtkTransform.h"
 #include "vtkUnsignedIntArray.h"
 #include "vtkUnsignedLongArray.h"
@@ -31,33 +37,13 @@
 #include <algorithm>
 #include <cstdlib>
 #include <limits>
+#include <type_traits>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 namespace
 {
 
-template <typename T>
-struct greaterf
-{
-  greaterf(const T* az)
-    : z(az)
-  {
-  }
-  bool operator()(vtkIdType l, vtkIdType r) const { return z[l] > z[r]; }
-  const T* z;
-};
-
-template <typename T>
-struct lessf
-{
-  lessf(const T* az)
-    : z(az)
-  {
-  }
-  bool operator()(vtkIdType l, vtkIdType r) const { return z[l] < z[r]; }
-  const T* z;
-};
-
 template <typename T>
 T getCellBoundsCenter(const vtkIdType* pids, vtkIdType nPids, const T* px)
 {
@@ -72,19 +58,24 @@ T getCellBoundsCenter(const vtkIdType* pids, vtkIdType nPids, const T* px)
   return (mn + mx) / T(2);
 }
 
+// Depths are sorted as float keys for float points and as double keys
+// otherwise.
+template <typename T>
+using DepthKeyType = typename std::conditional<std::is_same<T, float>::value, float, double>::type;
+
+// Computes the depth of every cell in the order of the given cell ids, in
+// parallel. With sign = -1 the depths are negated so that sorting them in
+// ascending order sorts the cells from back to front.
 template <typename T>
-void getCellCenterDepth(vtkPolyData* pds, vtkDataArray* gpts, vtkIdType nCells, double* origin,
-  double* direction, T*& depth)
+void getCellDepths(vtkPolyData* pds, vtkDataArray* gpts, vtkIdType nCells, const vtkIdType* order,
+  bool boundsCenter, double* origin, double* direction, double sign, DepthKeyType<T>* depth)
 {
   if (nCells < 1)
   {
     return;
   }
 
-  T* ppts = static_cast<T*>(gpts->GetVoidPointer(0));
-  T* px = ppts;
-  T* py = ppts + 1;
-  T* pz = ppts + 2;
+  const T* ppts = static_cast<T*>(gpts->GetVoidPointer(0));
 
   // this call insures that BuildCells gets done if it's
   // needed and we can use the faster GetCellPoints api
@@ -94,93 +85,82 @@ void getCellCenterDepth(vtkPolyData* pds, vtkDataArray* gpts, vtkIdType nCells,
     pds->BuildCells();
   }
 
-  // compute cell centers
-  T* cx = new T[nCells];
-  T* cy = new T[nCells];
-  T* cz = new T[nCells];
-  for (vtkIdType cid = 0; cid < nCells; ++cid)
-  {
-    // get the cell point ids using the fast api
-    const vtkIdType* pids = nullptr;
-    vtkIdType nPids = 0;
-    pds->GetCellPoints(cid, nPids, pids);
-
-    // compute the center of the cell bounds
-    cx[cid] = getCellBoundsCenter(pids, nPids, px);
-    cy[cid] = getCellBoundsCenter(pids, nPids, py);
-    cz[cid] = getCellBoundsCenter(pids, nPids, pz);
-  }
+  const T x0 = static_cast<T>(origin[0]);
+  const T y0 = static_cast<T>(origin[1]);
+  const T z0 = static_cast<T>(origin[2]);
+  const T vx = static_cast<T>(direction[0]);
+  const T vy = static_cast<T>(direction[1]);
+  const T vz = static_cast<T>(direction[2]);
 
-  // compute the distance to the cell center
-  T x0 = static_cast<T>(origin[0]);
-  T y0 = static_cast<T>(origin[1]);
-  T z0 = static_cast<T>(origin[2]);
-  T vx = static_cast<T>(direction[0]);
-  T vy = static_cast<T>(direction[1]);
-  T vz = static_cast<T>(direction[2]);
-  depth = new T[nCells];
-  for (vtkIdType cid = 0; cid < nCells; ++cid)
-  {
-    depth[cid] = (cx[cid] - x0) * vx + (cy[cid] - y0) * vy + (cz[cid] - z0) * vz;
-  }
-
-  delete[] cx;
-  delete[] cy;
-  delete[] cz;
+  vtkSMPThreadLocalObject<vtkIdList> tlIds;
+  vtkSMPTools::For(0, nCells,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      vtkIdList* ids = tlIds.Local();
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        // get the cell point ids using the fast api
+        const vtkIdType* pids = nullptr;
+        vtkIdType nPids = 0;
+        pds->GetCellPoints(order[i], nPids, pids, ids);
+
+        T cx, cy, cz;
+        if (boundsCenter)
+        {
+          // compute the center of the cell bounds
+          cx = getCellBoundsCenter(pids, nPids, ppts);
+          cy = getCellBoundsCenter(pids, nPids, ppts + 1);
+          cz = getCellBoundsCenter(pids, nPids, ppts + 2);
+        }
+        else
+        {
+          // use the cell's first point
+          cx = ppts[3 * pids[0]];
+          cy = ppts[3 * pids[0] + 1];
+          cz = ppts[3 * pids[0] + 2];
+        }
+        T d = (cx - x0) * vx + (cy - y0) * vy + (cz - z0) * vz;
+        depth[i] = static_cast<DepthKeyType<T>>(sign * d);
+      }
+    });
 }
 
-template <typename T>
-void getCellPoint0Depth(vtkPolyData* pds, vtkDataArray* gpts, vtkIdType nCells, double* origin,
-  double* direction, T*& depth)
+// Same for the parametric centers of the cells.
+void getCellParametricCenterDepths(vtkPolyData* pds, vtkIdType nCells, const vtkIdType* order,
+  double* origin, double* direction, double sign, double* depth)
 {
   if (nCells < 1)
   {
     return;
   }
 
-  T* ppts = static_cast<T*>(gpts->GetVoidPointer(0));
-  T* px = ppts;
-  T* py = ppts + 1;
-  T* pz = ppts + 2;
-
-  // this call insures that BuildCells gets done if it's
-  // needed and we can use the faster GetCellPoints api
-  if (pds->NeedToBuildCells())
-  {
-    pds->BuildCells();
-  }
-
-  T* cx = new T[nCells];
-  T* cy = new T[nCells];
-  T* cz = new T[nCells];
-  const vtkIdType* pids = nullptr;
-  vtkIdType nPids = 0;
-  for (vtkIdType cid = 0; cid < nCells; ++cid)
-  {
-    // get the cell point ids using the fast api
-    pds->GetCellPoints(cid, nPids, pids);
-    vtkIdType ii = pids[0];
-    cx[cid] = px[3 * ii];
-    cy[cid] = py[3 * ii];
-    cz[cid] = pz[3 * ii];
-  }
+  // Make the input ready for GetCell() calls from several threads.
+  vtkNew<vtkGenericCell> firstCell;
+  pds->GetCell(0, firstCell);
+  const size_t maxCellSize = pds->GetMaxCellSize();
 
-  // compute the distance to the cell's first point
-  T x0 = static_cast<T>(origin[0]);
-  T y0 = static_cast<T>(origin[1]);
-  T z0 = static_cast<T>(origin[2]);
-  T vx = static_cast<T>(direction[0]);
-  T vy = static_cast<T>(direction[1]);
-  T vz = static_cast<T>(direction[2]);
-  depth = new T[nCells];
-  for (vtkIdType cid = 0; cid < nCells; ++cid)
-  {
-    depth[cid] = (cx[cid] - x0) * vx + (cy[cid] - y0) * vy + (cz[cid] - z0) * vz;
-  }
+  vtkSMPThreadLocalObject<vtkGenericCell> tlCell;
+  vtkSMPThreadLocal<std::vector<double>> tlWeights;
+  vtkSMPTools::For(0, nCells,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      vtkGenericCell* cell = tlCell.Local();
+      std::vector<double>& weight = tlWeights.Local();
+      weight.resize(maxCellSize);
+      double x[3] = { 0.0 };
+      double p[3] = { 0.0 };
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        pds->GetCell(order[i], cell);
+        int subId = cell->GetParametricCenter(p);
+        cell->EvaluateLocation(subId, p, x, weight.data());
 
-  delete[] cx;
-  delete[] cy;
-  delete[] cz;
+        // compute the distance
+        depth[i] = sign *
+          ((x[0] - origin[0]) * direction[0] + (x[1] - origin[1]) * direction[1] +
+            (x[2] - origin[2]) * direction[2]);
+      }
+    });
 }
 }
 
@@ -195,6 +175,7 @@ vtkDepthSortPolyData::vtkDepthSortPolyData()
   , Prop3D(nullptr)
   , Transform(vtkTransform::New())
   , SortScalars(0)
+  , LastOrder(vtkIdTypeArray::New())
 {
   std::fill_n(this->Vector, 3, 0.0);
   std::fill_n(this->Origin, 3, 0.0);
@@ -203,6 +184,7 @@ vtkDepthSortPolyData::vtkDepthSortPolyData()
 vtkDepthSortPolyData::~vtkDepthSortPolyData()
 {
   this->Transform->Delete();
+  this->LastOrder->Delete();
 
   if (this->Camera)
   {
@@ -261,10 +243,22 @@ int vtkDepthSortPolyData::RequestData(vtkInformation* vtkNotUsed(request),
   vtkIdType nStrips = input->GetStrips()->GetNumberOfCells();
   vtkIdType nCells = nVerts + nLines + nPolys + nStrips;
 
+  // While the input and the sort settings do not change, start from the
+  // order of the last execution.
+  const bool nearlySorted = this->LastOrder->GetNumberOfValues() == nCells &&
+    input->GetMTime() < this->LastSortTime && this->Superclass::GetMTime() < this->LastSortTime;
+
   vtkIdType* order = new vtkIdType[nCells];
-  for (vtkIdType cid = 0; cid < nCells; ++cid)
+  if (nearlySorted)
   {
-    order[cid] = cid;
+    memcpy(order, this->LastOrder->GetPointer(0), nCells * sizeof(vtkIdType));
+  }
+  else
+  {
+    for (vtkIdType cid = 0; cid < nCells; ++cid)
+    {
+      order[cid] = cid;
+    }
   }
 
   vtkIdTypeArray* newCellIds = nullptr;
@@ -273,11 +267,17 @@ int vtkDepthSortPolyData::RequestData(vtkInformation* vtkNotUsed(request),
     newCellIds = vtkIdTypeArray::New();
     newCellIds->SetName("sortedCellIds");
     newCellIds->SetNumberOfTuples(nCells);
-    memcpy(newCellIds->GetPointer(0), order, nCells * sizeof(vtkIdType));
+    vtkIdType* newIds = newCellIds->GetPointer(0);
+    for (vtkIdType cid = 0; cid < nCells; ++cid)
+    {
+      newIds[cid] = cid;
+    }
   }
 
   if (nCells)
   {
+    // depths are sorted in ascending order, negate them to sort back to front
+    const double sign = (this->Direction == VTK_DIRECTION_FRONT_TO_BACK) ? 1.0 : -1.0;
     if ((this->DepthSortMode == VTK_SORT_FIRST_POINT) ||
       (this->DepthSortMode == VTK_SORT_BOUNDS_CENTER))
     {
@@ -287,62 +287,27 @@ int vtkDepthSortPolyData::RequestData(vtkInformation* vtkNotUsed(request),
         vtkTemplateMacro(
 
           // compute the cell's depth
-          VTK_TT* depth = nullptr; if (this->DepthSortMode == VTK_SORT_FIRST_POINT) {
-            ::getCellPoint0Depth(tmpInput, pts, nCells, origin, direction, depth);
-          } else { ::getCellCenterDepth(tmpInput, pts, nCells, origin, direction, depth); }
+          std::vector<::DepthKeyType<VTK_TT>> depth(nCells);
+          ::getCellDepths<VTK_TT>(tmpInput, pts, nCells, order,
+            this->DepthSortMode == VTK_SORT_BOUNDS_CENTER, origin, direction, sign, depth.data());
 
           // sort cell ids by depth
-          if (this->Direction == VTK_DIRECTION_FRONT_TO_BACK) {
-            ::lessf<VTK_TT> comp(depth);
-            std::sort(order, order + nCells, comp);
-          } else {
-            ::greaterf<VTK_TT> comp(depth);
-            std::sort(order, order + nCells, comp);
-          }
-
-          delete[] depth;);
+          vtkSortDataArray::SortRealKeys(depth.data(), order, nCells, nearlySorted););
       }
     }
     else // VTK_SORT_PARAMETRIC_CENTER
     {
-      vtkGenericCell* cell = vtkGenericCell::New();
-
-      double x[3] = { 0.0 };
-      double p[3] = { 0.0 };
-
-      size_t maxCellSize = input->GetMaxCellSize();
-      double* weight = new double[maxCellSize];
-      double* depth = new double[nCells];
-
-      for (vtkIdType cid = 0; cid < nCells; ++cid)
-      {
-        tmpInput->GetCell(cid, cell);
-        int subId = cell->GetParametricCenter(p);
-        cell->EvaluateLocation(subId, p, x, weight);
-
-        // compute the distance
-        depth[cid] = (x[0] - origin[0]) * direction[0] + (x[1] - origin[1]) * direction[1] +
-          (x[2] - origin[2]) * direction[2];
-      }
-
-      // sort
-      if (this->Direction == VTK_DIRECTION_FRONT_TO_BACK)
-      {
-        ::lessf<double> comp(depth);
-        std::sort(order, order + nCells, comp);
-      }
-      else
-      {
-        ::greaterf<double> comp(depth);
-        std::sort(order, order + nCells, comp);
-      }
-
-      delete[] weight;
-      delete[] depth;
-      cell->Delete();
+      std::vector<double> depth(nCells);
+      ::getCellParametricCenterDepths(
+        tmpInput, nCells, order, origin, direction, sign, depth.data());
+      vtkSortDataArray::SortRealKeys(depth.data(), order, nCells, nearlySorted);
     }
   }
 
+  this->LastOrder->SetNumberOfValues(nCells);
+  std::copy(order, order + nCells, this->LastOrder->GetPointer(0));
+  this->LastSortTime.Modified();
+
   // construct the output
   vtkCellData* inCD = input->GetCellData();
   vtkCellData* outCD = output->GetCellData();
@@ -11,6 +11,10 @@
  * specifying a camera and/or prop to define a view direction; or
  * explicitly set a view direction.
  *
+ * Depths are computed and sorted in parallel. While the input does not
+ * change, every execution starts from the order of the previous one, which
+ * is nearly sorted after a small camera motion and cheaper to sort.
+ *
  * @warning
  * The sort operation will not work well for long, thin primitives, or cells
  * that intersect, overlap, or interpenetrate each other.
@@ -21,9 +25,11 @@
 
 #include "vtkFiltersHybridModule.h" // For export macro
 #include "vtkPolyDataAlgorithm.h"
+#include "vtkTimeStamp.h" // For LastSortTime
 
 VTK_ABI_NAMESPACE_BEGIN
 class vtkCamera;
+class vtkIdTypeArray;
 class vtkProp3D;
 class vtkTransform;
 
@@ -152,6 +158,10 @@ protected:
   double Origin[3];
   vtkTypeBool SortScalars;
 
+  // Order of the last sort, the starting point of the next one.
+  vtkIdTypeArray* LastOrder;
+  vtkTimeStamp LastSortTime;
+
 private:
   vtkDepthSortPolyData(const vtkDepthSortPolyData&) = delete;
   void operator=(const vtkDepthSortPolyData&) = delete;
@@ -0,0 +1,97 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Tests vtkPProbeFilter with DistributedProbe on: every process owns a slab
+// of the source and probes points spread over the whole domain.
+
+#include "vtkCharArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkMPIController.h"
+#include "vtkMathUtilities.h"
+#include "vtkNew.h"
+#include "vtkPProbeFilter.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+
+#include <cstdlib>
+#include <iostream>
+
+int TestPProbeFilterDistributed(int argc, char* argv[])
+{
+  vtkNew<vtkMPIController> controller;
+  controller->Initialize(&argc, &argv, 0);
+  vtkMultiProcessController::SetGlobalController(controller);
+
+  const int rank = controller->GetLocalProcessId();
+  const int numProcs = controller->GetNumberOfProcesses();
+
+  // Source: slab [rank, rank + 1] x [0, 1] x [0, 1] with the x coordinate as
+  // point data, so that probed values are known exactly.
+  vtkNew<vtkImageData> source;
+  source->SetExtent(10 * rank, 10 * (rank + 1), 0, 10, 0, 10);
+  source->SetSpacing(0.1, 0.1, 0.1);
+  vtkNew<vtkDoubleArray> xArray;
+  xArray->SetName("x");
+  xArray->SetNumberOfTuples(source->GetNumberOfPoints());
+  for (vtkIdType i = 0; i < source->GetNumberOfPoints(); ++i)
+  {
+    xArray->SetValue(i, source->GetPoint(i)[0]);
+  }
+  source->GetPointData()->AddArray(xArray);
+
+  // Probe points: a line across the whole domain, shifted on every process.
+  const int numProbePoints = 50;
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToDouble();
+  for (int i = 0; i < numProbePoints; ++i)
+  {
+    const double x = numProcs * (i + 0.5 + 0.1 * rank) / (numProbePoints + 1);
+    points->InsertNextPoint(x, 0.25 + 0.1 * rank / numProcs, 0.5);
+  }
+  vtkNew<vtkPolyData> input;
+  input->SetPoints(points);
+
+  vtkNew<vtkPProbeFilter> probe;
+  probe->SetController(controller);
+  probe->DistributedProbeOn();
+  probe->SetInputData(input);
+  probe->SetSourceData(source);
+  probe->Update();
+
+  int success = 1;
+  vtkDataSet* output = probe->GetOutput();
+  vtkCharArray* mask = vtkArrayDownCast<vtkCharArray>(
+    output->GetPointData()->GetArray(probe->GetValidPointMaskArrayName()));
+  vtkDataArray* probed = output->GetPointData()->GetArray("x");
+  if (output->GetNumberOfPoints() != numProbePoints || !mask || !probed)
+  {
+    std::cerr << "Process " << rank << ": missing output points or arrays." << std::endl;
+    success = 0;
+  }
+  vtkIdTypeArray* validPoints = probe->GetValidPoints();
+  if (success && validPoints->GetNumberOfValues() != numProbePoints)
+  {
+    std::cerr << "Process " << rank << ": " << validPoints->GetNumberOfValues()
+              << " valid points instead of " << numProbePoints << std::endl;
+    success = 0;
+  }
+  for (vtkIdType i = 0; success && i < output->GetNumberOfPoints(); ++i)
+  {
+    const double expected = output->GetPoint(i)[0];
+    if (mask->GetValue(i) != 1 ||
+      !vtkMathUtilities::FuzzyCompare(probed->GetTuple1(i), expected, 1e-6))
+    {
+      std::cerr << "Process " << rank << ": wrong value for point " << i << ", got "
+                << probed->GetTuple1(i) << " instead of " << expected << std::endl;
+      success = 0;
+    }
+  }
+
+  int allSuccess = 0;
+  controller->AllReduce(&success, &allSuccess, 1, vtkCommunicator::MIN_OP);
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  controller->Finalize();
+  return allSuccess ? EXIT_SUCCESS : EXIT_FAILURE;
+}
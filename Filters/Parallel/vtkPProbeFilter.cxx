@@ -2,27 +2,188 @@
 // SPDX-License-Identifier: BSD-3-Clause
 #include "vtkPProbeFilter.h"
 
+#include "vtkBoundingBox.h"
 #include "vtkCellData.h"
 #include "vtkCharArray.h"
+#include "vtkCommunicator.h"
 #include "vtkCompositeDataPipeline.h"
+#include "vtkCompositeDataSet.h"
 #include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkMath.h"
 #include "vtkMultiProcessController.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkPoints.h"
 #include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkPProbeFilter);
 
+namespace
+{
+// vtkProbeFilter accepts the points closer to a cell than this fraction of
+// the cell length when ComputeTolerance is on.
+constexpr double CELL_TOLERANCE_FACTOR = 1e-3;
+
+//------------------------------------------------------------------------------
+// Coarse index of the source bounds of all processes: a regular grid of bins
+// over the union of the bounds, each bin listing the processes whose bounds
+// overlap it.
+class PartitionIndex
+{
+public:
+  PartitionIndex(const std::vector<double>& bounds)
+    : Bounds(bounds)
+  {
+    const int numProcs = static_cast<int>(bounds.size() / 6);
+    double global[6] = { VTK_DOUBLE_MAX, -VTK_DOUBLE_MAX, VTK_DOUBLE_MAX, -VTK_DOUBLE_MAX,
+      VTK_DOUBLE_MAX, -VTK_DOUBLE_MAX };
+    for (int proc = 0; proc < numProcs; ++proc)
+    {
+      const double* b = &this->Bounds[6 * proc];
+      if (b[0] > b[1] || b[2] > b[3] || b[4] > b[5])
+      {
+        continue;
+      }
+      for (int axis = 0; axis < 3; ++axis)
+      {
+        global[2 * axis] = std::min(global[2 * axis], b[2 * axis]);
+        global[2 * axis + 1] = std::max(global[2 * axis + 1], b[2 * axis + 1]);
+      }
+    }
+    if (global[0] > global[1])
+    {
+      return;
+    }
+
+    const int resolution =
+      std::min(64, 2 * static_cast<int>(std::ceil(std::cbrt(static_cast<double>(numProcs)))));
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      const double length = global[2 * axis + 1] - global[2 * axis];
+      this->Origin[axis] = global[2 * axis];
+      this->Dimensions[axis] = length > 0.0 ? resolution : 1;
+      this->Spacing[axis] = length > 0.0 ? length / resolution : 1.0;
+    }
+    this->Bins.resize(
+      static_cast<size_t>(this->Dimensions[0]) * this->Dimensions[1] * this->Dimensions[2]);
+
+    for (int proc = 0; proc < numProcs; ++proc)
+    {
+      const double* b = &this->Bounds[6 * proc];
+      if (b[0] > b[1] || b[2] > b[3] || b[4] > b[5])
+      {
+        continue;
+      }
+      int lo[3], hi[3];
+      for (int axis = 0; axis < 3; ++axis)
+      {
+        lo[axis] = this->GetBin(b[2 * axis], axis);
+        hi[axis] = this->GetBin(b[2 * axis + 1], axis);
+      }
+      for (int k = lo[2]; k <= hi[2]; ++k)
+      {
+        for (int j = lo[1]; j <= hi[1]; ++j)
+        {
+          for (int i = lo[0]; i <= hi[0]; ++i)
+          {
+            this->Bins[i + this->Dimensions[0] * (j + this->Dimensions[1] * k)].push_back(proc);
+          }
+        }
+      }
+    }
+  }
+
+  // Fills candidates with the processes whose bounds contain x.
+  void FindCandidates(const double x[3], std::vector<int>& candidates) const
+  {
+    candidates.clear();
+    if (this->Bins.empty())
+    {
+      return;
+    }
+    int ijk[3];
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      ijk[axis] = this->GetBin(x[axis], axis);
+    }
+    const size_t bin = ijk[0] + this->Dimensions[0] * (ijk[1] + this->Dimensions[1] * ijk[2]);
+    for (int proc : this->Bins[bin])
+    {
+      const double* b = &this->Bounds[6 * proc];
+      if (x[0] >= b[0] && x[0] <= b[1] && x[1] >= b[2] && x[1] <= b[3] && x[2] >= b[4] &&
+        x[2] <= b[5])
+      {
+        candidates.push_back(proc);
+      }
+    }
+  }
+
+private:
+  int GetBin(double x, int axis) const
+  {
+    const int bin = static_cast<int>(std::floor((x - this->Origin[axis]) / this->Spacing[axis]));
+    return std::max(0, std::min(bin, this->Dimensions[axis] - 1));
+  }
+
+  std::vector<double> Bounds;
+  double Origin[3] = { 0.0, 0.0, 0.0 };
+  double Spacing[3] = { 1.0, 1.0, 1.0 };
+  int Dimensions[3] = { 0, 0, 0 };
+  std::vector<std::vector<int>> Bins;
+};
+
+//------------------------------------------------------------------------------
+// Exchanges messages with every process that has something to send to or
+// receive from this process. Processes visit their partners in increasing
+// order and the lower process of a pair sends first, so that blocking sends
+// cannot deadlock.
+template <typename SendFunctor, typename ReceiveFunctor>
+void PairwiseExchange(vtkMultiProcessController* controller,
+  const std::vector<vtkIdType>& sendCounts, const std::vector<vtkIdType>& receiveCounts,
+  SendFunctor&& send, ReceiveFunctor&& receive)
+{
+  const int myId = controller->GetLocalProcessId();
+  const int numProcs = controller->GetNumberOfProcesses();
+  for (int proc = 0; proc < numProcs; ++proc)
+  {
+    if (proc == myId)
+    {
+      continue;
+    }
+    if (myId < proc && sendCounts[proc] > 0)
+    {
+      send(proc);
+    }
+    if (receiveCounts[proc] > 0)
+    {
+      receive(proc);
+    }
+    if (myId > proc && sendCounts[proc] > 0)
+    {
+      send(proc);
+    }
+  }
+}
+}
+
 vtkCxxSetObjectMacro(vtkPProbeFilter, Controller, vtkMultiProcessController);
 
 //------------------------------------------------------------------------------
 vtkPProbeFilter::vtkPProbeFilter()
 {
   this->Controller = nullptr;
+  this->DistributedProbe = false;
   this->SetController(vtkMultiProcessController::GetGlobalController());
 }
 
@@ -36,14 +197,28 @@ vtkPProbeFilter::~vtkPProbeFilter()
 int vtkPProbeFilter::RequestData(
   vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
 {
-  if (!this->Superclass::RequestData(request, inputVector, outputVector))
-  {
-    return 0;
-  }
+  const int localStatus = this->Superclass::RequestData(request, inputVector, outputVector);
 
   vtkInformation* outInfo = outputVector->GetInformationObject(0);
   vtkDataSet* output = vtkDataSet::SafeDownCast(outInfo->Get(vtkDataObject::DATA_OBJECT()));
 
+  if (this->DistributedProbe)
+  {
+    if (!this->Controller || this->Controller->GetNumberOfProcesses() <= 1)
+    {
+      return localStatus;
+    }
+    // Even a process that failed takes part in the exchange, which only
+    // starts once all the processes agreed that they can go on.
+    return this->ProbeUnresolvedPoints(
+      localStatus, vtkDataObject::GetData(inputVector[1], 0), output);
+  }
+
+  if (!localStatus)
+  {
+    return 0;
+  }
+
   int procid = 0;
   int numProcs = 1;
   if (this->Controller)
@@ -133,6 +308,228 @@ int vtkPProbeFilter::RequestData(
   return 1;
 }
 
+//------------------------------------------------------------------------------
+int vtkPProbeFilter::ProbeUnresolvedPoints(
+  int localStatus, vtkDataObject* source, vtkDataSet* output)
+{
+  vtkMultiProcessController* controller = this->Controller;
+  const int myId = controller->GetLocalProcessId();
+  const int numProcs = controller->GetNumberOfProcesses();
+
+  vtkPointData* outPD = output ? output->GetPointData() : nullptr;
+  vtkCharArray* mask = outPD
+    ? vtkArrayDownCast<vtkCharArray>(outPD->GetArray(this->ValidPointMaskArrayName))
+    : nullptr;
+  if (localStatus && !output)
+  {
+    vtkErrorMacro("DistributedProbe requires a vtkDataSet input.");
+    localStatus = 0;
+  }
+  else if (localStatus && !mask)
+  {
+    vtkErrorMacro("Missing valid point mask array " << this->ValidPointMaskArrayName);
+    localStatus = 0;
+  }
+  int globalStatus = 0;
+  controller->AllReduce(&localStatus, &globalStatus, 1, vtkCommunicator::MIN_OP);
+  if (!globalStatus)
+  {
+    return 0;
+  }
+
+  // Build the coarse index of the source bounds of all processes, padded by
+  // the tolerance of their probe so that the points it would accept are
+  // routed to them. With ComputeTolerance, the tolerance is proportional to
+  // the length of the cells, which cannot exceed the diagonal of the bounds.
+  double localBounds[6] = { VTK_DOUBLE_MAX, -VTK_DOUBLE_MAX, VTK_DOUBLE_MAX, -VTK_DOUBLE_MAX,
+    VTK_DOUBLE_MAX, -VTK_DOUBLE_MAX };
+  if (vtkDataSet* dsSource = vtkDataSet::SafeDownCast(source))
+  {
+    if (dsSource->GetNumberOfPoints() > 0)
+    {
+      dsSource->GetBounds(localBounds);
+    }
+  }
+  else if (vtkCompositeDataSet* cdSource = vtkCompositeDataSet::SafeDownCast(source))
+  {
+    cdSource->GetBounds(localBounds);
+  }
+  vtkBoundingBox localBox(localBounds);
+  if (localBox.IsValid())
+  {
+    localBox.Inflate(this->ComputeTolerance ? CELL_TOLERANCE_FACTOR * localBox.GetDiagonalLength()
+                                            : this->Tolerance);
+    localBox.GetBounds(localBounds);
+  }
+  std::vector<double> allBounds(6 * numProcs);
+  controller->AllGather(localBounds, allBounds.data(), 6);
+  const PartitionIndex index(allBounds);
+
+  // Route the points that were not found locally to the candidate processes.
+  std::vector<std::vector<vtkIdType>> requestIds(numProcs);
+  std::vector<int> candidates;
+  double x[3];
+  const vtkIdType numPoints = output->GetNumberOfPoints();
+  for (vtkIdType ptId = 0; ptId < numPoints; ++ptId)
+  {
+    if (mask->GetValue(ptId) != 0)
+    {
+      continue;
+    }
+    output->GetPoint(ptId, x);
+    index.FindCandidates(x, candidates);
+    for (int proc : candidates)
+    {
+      if (proc != myId)
+      {
+        requestIds[proc].push_back(ptId);
+      }
+    }
+  }
+
+  std::vector<vtkIdType> requestCounts(numProcs);
+  for (int proc = 0; proc < numProcs; ++proc)
+  {
+    requestCounts[proc] = static_cast<vtkIdType>(requestIds[proc].size());
+  }
+  std::vector<vtkIdType> allCounts(static_cast<size_t>(numProcs) * numProcs);
+  controller->AllGather(requestCounts.data(), allCounts.data(), numProcs);
+  std::vector<vtkIdType> incomingCounts(numProcs);
+  for (int proc = 0; proc < numProcs; ++proc)
+  {
+    incomingCounts[proc] = allCounts[static_cast<size_t>(proc) * numProcs + myId];
+  }
+
+  // Gather the points other processes want probed in a single dataset so
+  // that the local source is only probed once.
+  vtkNew<vtkPoints> incomingPoints;
+  incomingPoints->SetDataTypeToDouble();
+  std::vector<vtkIdType> incomingOffsets(numProcs, 0);
+  PairwiseExchange(
+    controller, requestCounts, incomingCounts,
+    [&](int proc) {
+      vtkNew<vtkPoints> points;
+      points->SetDataTypeToDouble();
+      points->SetNumberOfPoints(requestCounts[proc]);
+      for (vtkIdType i = 0; i < requestCounts[proc]; ++i)
+      {
+        points->SetPoint(i, output->GetPoint(requestIds[proc][i]));
+      }
+      vtkNew<vtkPolyData> request;
+      request->SetPoints(points);
+      controller->Send(request, proc, PROBE_REQUEST_TAG);
+    },
+    [&](int proc) {
+      vtkNew<vtkPolyData> request;
+      controller->Receive(request, proc, PROBE_REQUEST_TAG);
+      incomingOffsets[proc] = incomingPoints->GetNumberOfPoints();
+      incomingPoints->InsertPoints(incomingOffsets[proc], request->GetNumberOfPoints(), 0,
+        request->GetPoints());
+    });
+
+  vtkSmartPointer<vtkDataSet> answers;
+  if (incomingPoints->GetNumberOfPoints() > 0)
+  {
+    vtkNew<vtkPolyData> incoming;
+    incoming->SetPoints(incomingPoints);
+    vtkSmartPointer<vtkDataObject> localSource = vtk::TakeSmartPointer(source->NewInstance());
+    localSource->ShallowCopy(source);
+
+    vtkNew<vtkCompositeDataProbeFilter> prober;
+    prober->SetInputData(incoming);
+    prober->SetSourceData(localSource);
+    prober->SetCategoricalData(this->CategoricalData);
+    prober->SetValidPointMaskArrayName(this->ValidPointMaskArrayName);
+    prober->SetTolerance(this->Tolerance);
+    prober->SetComputeTolerance(this->ComputeTolerance);
+    prober->SetSnapToCellWithClosestPoint(this->SnapToCellWithClosestPoint);
+    prober->SetCellLocatorPrototype(this->CellLocatorPrototype);
+    prober->SetPassPartialArrays(this->PassPartialArrays);
+    prober->Update();
+    answers = prober->GetOutput();
+  }
+
+  // Send the answers back and keep the first valid value found for each point.
+  // The points resolved remotely are appended to the up to date valid points.
+  vtkIdTypeArray* validPoints = this->GetValidPoints();
+  PairwiseExchange(
+    controller, incomingCounts, requestCounts,
+    [&](int proc) {
+      const vtkIdType count = incomingCounts[proc];
+      vtkNew<vtkPoints> points;
+      points->SetDataTypeToDouble();
+      points->InsertPoints(0, count, incomingOffsets[proc], incomingPoints);
+      vtkNew<vtkPolyData> answer;
+      answer->SetPoints(points);
+      answer->GetPointData()->CopyAllocate(answers->GetPointData(), count);
+      answer->GetPointData()->CopyData(answers->GetPointData(), 0, count, incomingOffsets[proc]);
+      controller->Send(answer, proc, PROBE_RESULT_TAG);
+    },
+    [&](int proc) {
+      vtkNew<vtkPolyData> answer;
+      controller->Receive(answer, proc, PROBE_RESULT_TAG);
+      vtkPointData* answerPD = answer->GetPointData();
+      vtkCharArray* answerMask =
+        vtkArrayDownCast<vtkCharArray>(answerPD->GetArray(this->ValidPointMaskArrayName));
+      if (!answerMask)
+      {
+        return;
+      }
+
+      std::vector<std::pair<vtkAbstractArray*, vtkAbstractArray*>> arrays;
+      for (int a = 0; a < answerPD->GetNumberOfArrays(); ++a)
+      {
+        vtkAbstractArray* remote = answerPD->GetAbstractArray(a);
+        if (remote == answerMask || !remote->GetName())
+        {
+          continue;
+        }
+        vtkAbstractArray* local = outPD->GetAbstractArray(remote->GetName());
+        if (!local)
+        {
+          // The local source may not have this array, e.g. when it is empty.
+          vtkSmartPointer<vtkAbstractArray> created = vtk::TakeSmartPointer(remote->NewInstance());
+          created->SetName(remote->GetName());
+          created->SetNumberOfComponents(remote->GetNumberOfComponents());
+          created->SetNumberOfTuples(numPoints);
+          if (vtkDataArray* da = vtkArrayDownCast<vtkDataArray>(created.Get()))
+          {
+            const bool isReal = da->GetDataType() == VTK_FLOAT || da->GetDataType() == VTK_DOUBLE;
+            da->Fill(isReal ? vtkMath::Nan() : 0.0);
+          }
+          outPD->AddArray(created);
+          local = created;
+        }
+        arrays.emplace_back(local, remote);
+      }
+
+      const std::vector<vtkIdType>& ids = requestIds[proc];
+      for (vtkIdType i = 0; i < answer->GetNumberOfPoints(); ++i)
+      {
+        const vtkIdType ptId = ids[i];
+        if (answerMask->GetValue(i) == 0 || mask->GetValue(ptId) != 0)
+        {
+          continue;
+        }
+        mask->SetValue(ptId, 1);
+        validPoints->InsertNextValue(ptId);
+        for (auto& pair : arrays)
+        {
+          pair.first->SetTuple(ptId, i, pair.second);
+        }
+      }
+    });
+
+  // Keep the valid points sorted like GetValidPoints() does, and newer than
+  // the mask so that they are not rebuilt.
+  std::sort(validPoints->GetPointer(0),
+    validPoints->GetPointer(0) + validPoints->GetNumberOfValues());
+  mask->Modified();
+  validPoints->Modified();
+
+  return 1;
+}
+
 VTK_ABI_NAMESPACE_END
 #include "vtkInformationIntegerVectorKey.h"
 //------------------------------------------------------------------------------
@@ -144,8 +541,19 @@ int vtkPProbeFilter::RequestUpdateExtent(
   vtkInformation* sourceInfo = inputVector[1]->GetInformationObject(0);
   vtkInformation* outInfo = outputVector->GetInformationObject(0);
 
-  inInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER(), 0);
-  inInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES(), 1);
+  if (this->DistributedProbe)
+  {
+    // Every process probes its own piece of the geometry.
+    inInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER(),
+      outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER()));
+    inInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES(),
+      outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES()));
+  }
+  else
+  {
+    inInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER(), 0);
+    inInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES(), 1);
+  }
   inInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_GHOST_LEVELS(), 0);
 
   // inInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER(), 0);
@@ -187,5 +595,6 @@ void vtkPProbeFilter::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
   os << indent << "Controller " << this->Controller << endl;
+  os << indent << "DistributedProbe: " << (this->DistributedProbe ? "On" : "Off") << endl;
 }
 VTK_ABI_NAMESPACE_END
@@ -4,9 +4,11 @@
  * @class   vtkPProbeFilter
  * @brief   probe dataset in distributed parallel computation
  *
- * This filter works correctly only if the whole geometry dataset
+ * By default, this filter works correctly only if the whole geometry dataset
  * (that specify the point locations used to probe input) is available on all
- * nodes.
+ * nodes, and the result is only produced on process 0. Turn DistributedProbe
+ * on to probe a distributed geometry dataset against a distributed source
+ * without gathering everything on process 0.
  */
 
 #ifndef vtkPProbeFilter_h
@@ -34,13 +36,33 @@ public:
   vtkGetObjectMacro(Controller, vtkMultiProcessController);
   ///@}
 
+  ///@{
+  /**
+   * When off (the default), the whole geometry dataset is probed on every
+   * process and the probed values are reduced to process 0, which is the only
+   * process producing an output.
+   *
+   * When on, both the geometry dataset and the source are distributed. Each
+   * process first probes its own piece of the geometry against its local part
+   * of the source. The points that were not found locally are then only sent
+   * to the processes whose source bounds contain them, using a coarse index of
+   * the bounds of all the partitions, and the probed values are sent back.
+   * Every process outputs its own piece of the geometry.
+   */
+  vtkSetMacro(DistributedProbe, bool);
+  vtkGetMacro(DistributedProbe, bool);
+  vtkBooleanMacro(DistributedProbe, bool);
+  ///@}
+
 protected:
   vtkPProbeFilter();
   ~vtkPProbeFilter() override;
 
   enum
   {
-    PROBE_COMMUNICATION_TAG = 1970
+    PROBE_COMMUNICATION_TAG = 1970,
+    PROBE_REQUEST_TAG = 1971,
+    PROBE_RESULT_TAG = 1972
   };
 
   // Usual data generation method
@@ -48,7 +70,17 @@ protected:
   int RequestUpdateExtent(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
   int FillInputPortInformation(int port, vtkInformation* info) override;
 
+  /**
+   * Implements DistributedProbe: sends the points of output that were not
+   * found in the local source to the processes that may contain them and
+   * merges their answers into output. All the processes must call it, with
+   * localStatus set to 0 if their local probe failed, in which case none of
+   * them exchanges points and 0 is returned.
+   */
+  int ProbeUnresolvedPoints(int localStatus, vtkDataObject* source, vtkDataSet* output);
+
   vtkMultiProcessController* Controller;
+  bool DistributedProbe;
 
 private:
   vtkPProbeFilter(const vtkPProbeFilter&) = delete;
@@ -0,0 +1,132 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Traces clustered seeds over overlapping partitions with and without work
+// stealing and message batching, checks that the streamlines match and that
+// idle processes did steal some of the seeds.
+#include "TestVectorFieldSource.h"
+#include <vtkCellArray.h>
+#include <vtkIdList.h>
+#include <vtkMPIController.h>
+#include <vtkMath.h>
+#include <vtkNew.h>
+#include <vtkPStreamTracer.h>
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <utility>
+
+namespace
+{
+double ComputeTotalLength(vtkPolyData* out)
+{
+  double length = 0;
+  vtkNew<vtkIdList> polyLine;
+  vtkCellArray* lines = out->GetLines();
+  for (lines->InitTraversal(); lines->GetNextCell(polyLine);)
+  {
+    for (vtkIdType j = 1; j < polyLine->GetNumberOfIds(); j++)
+    {
+      double p[3], q[3];
+      out->GetPoint(polyLine->GetId(j - 1), p);
+      out->GetPoint(polyLine->GetId(j), q);
+      length += std::sqrt(vtkMath::Distance2BetweenPoints(p, q));
+    }
+  }
+  return length;
+}
+
+// Returns the total length of the streamlines and the total number of stolen
+// particles.
+std::pair<double, vtkIdType> Trace(vtkMPIController* c, bool workStealing, int batchSize)
+{
+  const int myRank = c->GetLocalProcessId();
+  const int numProcs = c->GetNumberOfProcesses();
+
+  vtkNew<TestVectorFieldSource> imageSource;
+  imageSource->SetExtent(0, 19, 0, 1, 0, 19);
+  imageSource->SetBoundingBox(-1, 1, -1, 1, -1, 1);
+
+  // All seeds are around the center of the domain, where the partitions
+  // overlap: they all go to the same process and the others can steal them.
+  vtkNew<vtkPolyData> seeds;
+  vtkNew<vtkPoints> seedPoints;
+  for (int i = 0; i < 24; i++)
+  {
+    seedPoints->InsertNextPoint(-0.03 + 0.012 * (i % 6), 0, -0.03 + 0.02 * (i / 6));
+  }
+  seeds->SetPoints(seedPoints);
+
+  const double stepSize = 0.01;
+  vtkNew<vtkPStreamTracer> tracer;
+  tracer->SetController(c);
+  tracer->SetWorkStealing(workStealing);
+  tracer->SetMaximumNumberOfParticlesPerMessage(batchSize);
+  tracer->SetInputConnection(0, imageSource->GetOutputPort());
+  tracer->SetInputData(1, seeds);
+  tracer->SetIntegrationDirectionToForward();
+  tracer->SetIntegratorTypeToRungeKutta4();
+  tracer->SetMaximumNumberOfSteps(2000);
+  tracer->SetMinimumIntegrationStep(stepSize * .1);
+  tracer->SetMaximumIntegrationStep(stepSize);
+  tracer->SetInitialIntegrationStep(stepSize);
+  tracer->SetMaximumPropagation(3);
+  // one ghost level so that partitions overlap and can exchange seeds
+  tracer->UpdatePiece(myRank, numProcs, 1);
+
+  double length = ComputeTotalLength(tracer->GetOutput());
+  double totalLength = 0;
+  c->AllReduce(&length, &totalLength, 1, vtkCommunicator::SUM_OP);
+  vtkIdType stolen = tracer->GetNumberOfStolenParticles();
+  vtkIdType totalStolen = 0;
+  c->AllReduce(&stolen, &totalStolen, 1, vtkCommunicator::SUM_OP);
+  return { totalLength, totalStolen };
+}
+}
+
+int TestPStreamWorkStealing(int argc, char* argv[])
+{
+  vtkNew<vtkMPIController> c;
+  vtkMultiProcessController::SetGlobalController(c);
+  c->Initialize(&argc, &argv);
+
+  const bool isRoot = c->GetLocalProcessId() == 0;
+  const double reference = Trace(c, false, 1).first;
+  bool res = reference > 0;
+  for (int batchSize : { 1, 4 })
+  {
+    const auto result = Trace(c, true, batchSize);
+    if (std::abs(result.first - reference) > 1e-3 * reference)
+    {
+      if (isRoot)
+      {
+        std::cerr << "Total length " << result.first << " with work stealing and batches of "
+                  << batchSize << " instead of " << reference << std::endl;
+      }
+      res = false;
+    }
+    if (result.second == 0)
+    {
+      if (isRoot)
+      {
+        std::cerr << "No particle was stolen with batches of " << batchSize << std::endl;
+      }
+      res = false;
+    }
+  }
+  // batching alone
+  if (std::abs(Trace(c, false, 8).first - reference) > 1e-3 * reference)
+  {
+    if (isRoot)
+    {
+      std::cerr << "Wrong total length with batches of 8 particles." << std::endl;
+    }
+    res = false;
+  }
+
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  c->Finalize();
+  return res ? EXIT_SUCCESS : EXIT_FAILURE;
+}
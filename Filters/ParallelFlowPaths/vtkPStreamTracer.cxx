@@ -477,6 +477,14 @@ public:
   vtkSetObjectMacro(Controller, vtkMultiProcessController);
 
   bool InCurrentProcess(double* p) { return InBB(p, GetBoundingBox(Rank)); }
+  bool InProcess(int rank, double* p) { return InBB(p, GetBoundingBox(rank)); }
+  bool Overlaps(int rank)
+  {
+    const double* a = GetBoundingBox(this->Rank);
+    const double* b = GetBoundingBox(rank);
+    return a[0] <= b[1] && b[0] <= a[1] && a[2] <= b[3] && b[2] <= a[3] && a[4] <= b[5] &&
+      b[4] <= a[5];
+  }
   int FindNextProcess(double* p)
   {
     for (int rank = CNext(this->Rank, this->NumProcs); rank != Rank;
@@ -980,12 +988,16 @@ public:
   {
     NewTask,
     NoMoreTasks,
-    TaskFinished
+    TaskFinished,
+    StealRequest,
+    StealReply
   };
 
-  TaskManager(ProcessLocator* locator, PStreamTracerPoint* proto)
+  TaskManager(ProcessLocator* locator, PStreamTracerPoint* proto, int batchSize, bool workStealing)
     : Locator(locator)
     , Proto(proto)
+    , BatchSize(std::max(batchSize, 1))
+    , WorkStealing(workStealing)
   {
     this->Controller = nullptr;
     this->SetController(
@@ -994,10 +1006,22 @@ public:
     this->NumProcs = this->Controller->GetNumberOfProcesses();
     this->Rank = this->Controller->GetLocalProcessId();
 
+    // a message is made of its type, sender and count, followed by up to
+    // BatchSize tasks
     int prototypeSize = Proto == nullptr ? 0 : Proto->GetSize();
-    this->MessageSize = prototypeSize + sizeof(Task);
+    this->MessageSize = static_cast<int>(
+      3 * sizeof(int) + this->BatchSize * (prototypeSize + sizeof(Task)));
     this->ReceiveBuffer = nullptr;
 
+    this->Outboxes.resize(this->NumProcs);
+    this->NumFinished = 0;
+    this->StealPending = false;
+    this->NumFailedSteals = 0;
+    this->NextVictim = 0;
+    this->NumStealSends.assign(this->NumProcs, 0);
+    this->NumStealReceives = 0;
+    this->NumStolenTasks = 0;
+
     this->NumSends = 0;
     this->Timer = vtkSmartPointer<vtkTimerLog>::New();
     this->ReceiveTime = 0;
@@ -1023,6 +1047,19 @@ public:
       }
     }
 
+    // processes that may trace some of our tasks, starting with the next one
+    // so that idle processes do not all ask the same process first
+    if (this->WorkStealing && this->Locator && hasData)
+    {
+      for (int i = CNext(this->Rank, NumProcs); i != this->Rank; i = CNext(i, NumProcs))
+      {
+        if (this->HasData[i] && this->Locator->Overlaps(i))
+        {
+          this->Victims.push_back(i);
+        }
+      }
+    }
+
     std::vector<int> processMap0(MaxId + 1, -1);
     for (int i = 0; i < numSeeds; i++)
     {
@@ -1077,8 +1114,8 @@ public:
 
       if (task->GetTraceTerminated())
       {
-        // send to the master process
-        this->Send(TaskFinished, this->Leader, task);
+        // notify the master process
+        this->Finish(task);
       }
       else
       {
@@ -1100,13 +1137,13 @@ public:
           {
             task->IncHop();
             // send it to the next guy
-            this->Send(NewTask, NextProcess(task), task);
+            this->Post(nextProcess, task);
           }
         }
 
         if (nextProcess < 0)
         {
-          this->Send(TaskFinished, this->Leader, task); // no one can do it, norminally finished
+          this->Finish(task); // no one can do it, norminally finished
           PRINT("Bail on " << task->GetId());
         }
       }
@@ -1118,25 +1155,43 @@ public:
 
     do
     {
+      if (NTasks.empty())
+      {
+        // nothing left to trace here: hold nothing back and look for work
+        this->Flush();
+        this->Steal();
+      }
       this->Receive(this->TotalNumTasks != 0 && this->Msgs.empty() &&
         NTasks.empty()); // wait if there is nothing to do
       while (!this->Msgs.empty())
       {
-        Message msg = this->Msgs.back();
+        MessageHeader header = this->Msgs.back();
         this->Msgs.pop_back();
-        switch (msg)
+        switch (header.Msg)
         {
           case NewTask:
             break;
           case TaskFinished:
             AssertEq(Rank, this->Leader);
-            this->TotalNumTasks--;
+            this->TotalNumTasks -= header.Count;
             PRINT(TotalNumTasks << " tasks left");
             break;
           case NoMoreTasks:
             AssertNe(Rank, this->Leader);
             this->TotalNumTasks = 0;
             break;
+          case StealRequest:
+            this->ServeSteal(header.Sender);
+            break;
+          case StealReply:
+            this->StealPending = false;
+            if (header.Count == 0)
+            {
+              // try the next victim, until all of them turned us down
+              this->NumFailedSteals++;
+              this->NextVictim = CNext(this->NextVictim, static_cast<int>(this->Victims.size()));
+            }
+            break;
           default:
             assert(false);
         }
@@ -1153,7 +1208,7 @@ public:
         {
           if (this->HasData[i])
           {
-            this->Send(NoMoreTasks, i, nullptr);
+            this->Send(NoMoreTasks, i, 0);
           }
         }
       }
@@ -1163,11 +1218,34 @@ public:
       nextTask = this->NTasks.back();
       this->NTasks.pop_back();
       this->PTasks.push_back(nextTask);
+      this->NumFailedSteals = 0;
     }
 
     return nextTask;
   }
 
+  // Number of tasks handed over on steal requests so far
+  vtkIdType GetNumStolenTasks() const { return this->NumStolenTasks; }
+
+  // Receives the steal requests and replies still in flight so that they are
+  // not mistaken for messages of a later execution. Collective, to be called
+  // once NextTask() returned nullptr.
+  void Finalize()
+  {
+    if (!this->WorkStealing)
+    {
+      return;
+    }
+    std::vector<int> numSends(this->NumProcs);
+    this->Controller->AllReduce(
+      this->NumStealSends.data(), numSends.data(), this->NumProcs, vtkCommunicator::SUM_OP);
+    while (this->NumStealReceives < numSends[this->Rank])
+    {
+      this->Receive(true);
+    }
+    this->Msgs.clear();
+  }
+
   ~TaskManager()
   {
     for (BufferList::iterator itr = SendBuffers.begin(); itr != SendBuffers.end(); ++itr)
@@ -1202,12 +1280,22 @@ public:
   }
 
 private:
+  struct MessageHeader
+  {
+    Message Msg;
+    int Sender;
+    int Count;
+  };
+  typedef std::vector<vtkSmartPointer<Task>> TaskList;
+
   ProcessLocator* Locator;
   vtkSmartPointer<PStreamTracerPoint> Proto;
+  int BatchSize;
+  bool WorkStealing;
   vtkMPIController* Controller;
-  std::vector<vtkSmartPointer<Task>> NTasks;
-  std::vector<vtkSmartPointer<Task>> PTasks;
-  std::vector<Message> Msgs;
+  TaskList NTasks;
+  TaskList PTasks;
+  std::vector<MessageHeader> Msgs;
   int NumProcs;
   int Rank;
   int TotalNumTasks;
@@ -1218,55 +1306,134 @@ private:
   BufferList SendBuffers;
   MessageBuffer* ReceiveBuffer;
 
-  void Send(int msg, int rank, Task* task)
+  // tasks waiting to be sent to each process and number of finished tasks
+  // not reported to the master process yet
+  std::vector<TaskList> Outboxes;
+  int NumFinished;
+
+  std::vector<int> Victims;
+  bool StealPending;
+  int NumFailedSteals;
+  int NextVictim;
+  std::vector<int> NumStealSends;
+  int NumStealReceives;
+  vtkIdType NumStolenTasks;
+
+  void Finish(Task* task)
   {
-    if (task && (msg == TaskFinished))
+    PRINT("Done in " << task->Point->GetNumSteps() << " steps " << task->NumHops << " hops");
+    (void)task;
+    if (this->Rank == this->Leader)
     {
-      PRINT("Done in " << task->Point->GetNumSteps() << " steps " << task->NumHops << " hops");
+      this->TotalNumTasks--;
+      PRINT(TotalNumTasks << " tasks left");
     }
-    if (rank == this->Rank)
+    else if (++this->NumFinished >= this->BatchSize)
     {
-      switch (msg)
-      {
-        case TaskFinished:
-          this->TotalNumTasks--;
-          PRINT(TotalNumTasks << " tasks left");
-          break;
-        default:
-          PRINT("Unhandled message " << msg);
-          assert(false);
-      }
+      this->Send(TaskFinished, this->Leader, this->NumFinished);
+      this->NumFinished = 0;
     }
-    else
-    {
-      MessageBuffer& buf = this->NewSendBuffer();
-      MessageStream& outStream(buf.GetStream());
+  }
 
-      outStream << msg << this->Rank;
-      AssertNe(this->Rank, rank);
+  void Post(int rank, Task* task)
+  {
+    TaskList& outbox = this->Outboxes[rank];
+    outbox.emplace_back(task);
+    if (static_cast<int>(outbox.size()) >= this->BatchSize)
+    {
+      this->Send(NewTask, rank, static_cast<int>(outbox.size()), outbox.data());
+      outbox.clear();
+    }
+  }
 
-      if (task)
+  void Flush()
+  {
+    for (int rank = 0; rank < this->NumProcs; rank++)
+    {
+      TaskList& outbox = this->Outboxes[rank];
+      if (!outbox.empty())
       {
-        outStream << (*task);
+        this->Send(NewTask, rank, static_cast<int>(outbox.size()), outbox.data());
+        outbox.clear();
       }
+    }
+    if (this->NumFinished > 0)
+    {
+      this->Send(TaskFinished, this->Leader, this->NumFinished);
+      this->NumFinished = 0;
+    }
+  }
 
-      AssertGe(this->MessageSize, outStream.GetLength());
-      this->Controller->NoBlockSend(
-        outStream.GetRawData(), outStream.GetLength(), rank, 561, buf.GetRequest());
+  void Steal()
+  {
+    if (!this->WorkStealing || this->StealPending || this->TotalNumTasks == 0 ||
+      this->NumFailedSteals >= static_cast<int>(this->Victims.size()))
+    {
+      return;
+    }
+    this->Send(StealRequest, this->Victims[this->NextVictim], 0);
+    this->StealPending = true;
+  }
 
-      NumSends++;
-      if (task)
+  void ServeSteal(int thief)
+  {
+    // hand over up to half of the pending tasks the thief can trace, oldest
+    // first since they are the last ones this process would get to
+    TaskList stolen;
+    const size_t maxStolen = NTasks.size() / 2;
+    auto keep = NTasks.begin();
+    for (auto itr = NTasks.begin(); itr != NTasks.end(); ++itr)
+    {
+      PStreamTracerPoint* p = (*itr)->GetPoint();
+      if (stolen.size() < maxStolen && this->Locator && p->GetRank() < 0 &&
+        this->Locator->InProcess(thief, p->GetSeed()))
       {
-        PRINT("Send " << msg << "; task "
-                      << task->GetId()); //<<" "<<task->Seed[0]<<" "<<task->Seed[1]<<"
-                                         //"<<task->Seed[2]<<" to "<<rank);
+        stolen.push_back(*itr);
       }
       else
       {
-        PRINT("Send " << msg);
+        *(keep++) = *itr;
       }
     }
+    NTasks.erase(keep, NTasks.end());
+    this->NumStolenTasks += static_cast<vtkIdType>(stolen.size());
+    PRINT("Give " << stolen.size() << " tasks to " << thief);
+
+    // a message holds up to BatchSize tasks: the first batches are sent as new
+    // tasks and the last one as the reply, which MPI delivers after them
+    size_t sent = 0;
+    while (stolen.size() - sent > static_cast<size_t>(this->BatchSize))
+    {
+      this->Send(NewTask, thief, this->BatchSize, stolen.data() + sent);
+      sent += this->BatchSize;
+    }
+    this->Send(StealReply, thief, static_cast<int>(stolen.size() - sent), stolen.data() + sent);
   }
+
+  void Send(int msg, int rank, int count, vtkSmartPointer<Task>* tasks = nullptr)
+  {
+    AssertNe(this->Rank, rank);
+    MessageBuffer& buf = this->NewSendBuffer();
+    MessageStream& outStream(buf.GetStream());
+
+    outStream << msg << this->Rank << count;
+    for (int i = 0; tasks && i < count; i++)
+    {
+      outStream << (*tasks[i]);
+    }
+
+    AssertGe(this->MessageSize, outStream.GetLength());
+    this->Controller->NoBlockSend(
+      outStream.GetRawData(), outStream.GetLength(), rank, 561, buf.GetRequest());
+
+    NumSends++;
+    if (msg == StealRequest || msg == StealReply)
+    {
+      this->NumStealSends[rank]++;
+    }
+    PRINT("Send " << msg << " with count " << count << " to " << rank);
+  }
+
   int NextProcess(Task* task)
   {
     PStreamTracerPoint* p = task->GetPoint();
@@ -1327,6 +1494,7 @@ private:
   {
     int msg = -1;
     int sender(0);
+    int count(0);
 
 #ifdef DEBUGTRACE
     //    this->StartTimer();
@@ -1339,17 +1507,22 @@ private:
     if (ReceiveBuffer && ReceiveBuffer->GetRequest().Test())
     {
       MyStream& inStream(ReceiveBuffer->GetStream());
-      inStream >> msg >> sender;
-      this->Msgs.push_back((Message)msg);
-      if (msg == NewTask)
+      inStream >> msg >> sender >> count;
+      this->Msgs.push_back({ static_cast<Message>(msg), sender, count });
+      PRINT("Received message " << msg << " with count " << count << " from " << sender)
+      if (msg == NewTask || msg == StealReply)
       {
-        PRINT("Received message " << msg << " from " << sender)
-
-        vtkSmartPointer<Task> task = this->NewTaskInstance();
-        this->Read(inStream, *task);
-        PRINT("Received task "
-          << task->GetId()); //<<" "<<task->Seed[0]<<" "<<task->Seed[1]<<" "<<task->Seed[2]);
-        this->NTasks.push_back(task);
+        for (int i = 0; i < count; i++)
+        {
+          vtkSmartPointer<Task> task = this->NewTaskInstance();
+          this->Read(inStream, *task);
+          PRINT("Received task " << task->GetId());
+          this->NTasks.push_back(task);
+        }
+      }
+      if (msg == StealRequest || msg == StealReply)
+      {
+        this->NumStealReceives++;
       }
       delete ReceiveBuffer;
       ReceiveBuffer = nullptr;
@@ -1392,6 +1565,9 @@ vtkPStreamTracer::vtkPStreamTracer()
   this->GenerateNormalsInIntegrate = false;
 
   this->EmptyData = 0;
+  this->WorkStealing = false;
+  this->MaximumNumberOfParticlesPerMessage = 1;
+  this->NumberOfStolenParticles = 0;
 
   // This class does some non-thread-safe stuff (TBD). Force serial execution.
   this->SerialExecution = true;
@@ -1441,6 +1617,7 @@ int vtkPStreamTracer::RequestUpdateExtent(vtkInformation* vtkNotUsed(request),
 int vtkPStreamTracer::RequestData(
   vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
 {
+  this->NumberOfStolenParticles = 0;
   if (!vtkMPIController::SafeDownCast(this->Controller) ||
     this->Controller->GetNumberOfProcesses() == 1)
   {
@@ -1543,7 +1720,8 @@ int vtkPStreamTracer::RequestData(
   typedef std::vector<vtkSmartPointer<vtkPolyData>> traceOutputsType;
   traceOutputsType traceOutputs;
 
-  TaskManager taskManager(this->Utils->GetProcessLocator(), this->Utils->GetProto());
+  TaskManager taskManager(this->Utils->GetProcessLocator(), this->Utils->GetProto(),
+    this->MaximumNumberOfParticlesPerMessage, this->WorkStealing);
   PStreamTracerPointArray seedPoints;
 
   int maxId;
@@ -1600,6 +1778,8 @@ int vtkPStreamTracer::RequestData(
     traceIds.push_back(task->GetId());
     traceOutputs.push_back(traceOut);
   }
+  taskManager.Finalize();
+  this->NumberOfStolenParticles = taskManager.GetNumStolenTasks();
 
   this->Controller->Barrier();
 
@@ -1711,6 +1891,10 @@ void vtkPStreamTracer::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
   os << indent << "Controller: " << this->Controller << endl;
+  os << indent << "WorkStealing: " << (this->WorkStealing ? "On" : "Off") << endl;
+  os << indent << "MaximumNumberOfParticlesPerMessage: "
+     << this->MaximumNumberOfParticlesPerMessage << endl;
+  os << indent << "NumberOfStolenParticles: " << this->NumberOfStolenParticles << endl;
 }
 
 //------------------------------------------------------------------------------
@@ -9,6 +9,17 @@
  * be identical on all processes. If property `UseLocalSeedSource` is set to
  * false then this filter will aggregate seed sources from all ranks into a
  * single dataset.
+ *
+ * Streamlines are advected asynchronously: a particle leaving the partition of
+ * a process is queued and sent to the process owning the next partition while
+ * the sender keeps tracing its other particles. Two options help when seeds
+ * are clustered in a few partitions:
+ * - `WorkStealing` lets idle processes request pending particles from the
+ *   processes whose partition bounds overlap their own, e.g. with ghost
+ *   levels or replicated data.
+ * - `MaximumNumberOfParticlesPerMessage` batches the particles sent to the
+ *   same process, as well as the termination notifications, into fewer
+ *   messages.
  * @sa
  * vtkStreamTracer
  */
@@ -54,6 +65,40 @@ public:
   vtkGetObjectMacro(Controller, vtkMultiProcessController);
   ///@}
 
+  ///@{
+  /**
+   * When enabled, a process that runs out of particles asks the processes
+   * whose partition bounds overlap its own for some of their pending
+   * particles. The process asked hands over up to half of its pending
+   * particles, among the ones the requester can trace. This only helps when
+   * partitions overlap, since a particle can only be traced by a process
+   * holding the data around it.
+   * Must be the same on all processes. Default is false.
+   */
+  vtkSetMacro(WorkStealing, bool);
+  vtkGetMacro(WorkStealing, bool);
+  vtkBooleanMacro(WorkStealing, bool);
+  ///@}
+
+  ///@{
+  /**
+   * Maximum number of particles sent to another process in a single message.
+   * Particles leaving the partition are held back until this many are going
+   * to the same process, or until this process has nothing else to trace.
+   * Termination notifications are batched the same way. The default, 1, sends
+   * every particle as soon as it leaves the partition.
+   * Must be the same on all processes.
+   */
+  vtkSetClampMacro(MaximumNumberOfParticlesPerMessage, int, 1, 1024);
+  vtkGetMacro(MaximumNumberOfParticlesPerMessage, int);
+  ///@}
+
+  /**
+   * Number of particles this process handed over to idle processes on their
+   * steal requests during the last execution. Always 0 without WorkStealing.
+   */
+  vtkGetMacro(NumberOfStolenParticles, vtkIdType);
+
 protected:
   vtkPStreamTracer();
   ~vtkPStreamTracer() override;
@@ -68,6 +113,10 @@ protected:
 
   int EmptyData;
 
+  bool WorkStealing;
+  int MaximumNumberOfParticlesPerMessage;
+  vtkIdType NumberOfStolenParticles;
+
 private:
   vtkPStreamTracer(const vtkPStreamTracer&) = delete;
   void operator=(const vtkPStreamTracer&) = delete;
@@ -0,0 +1,129 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Stages steps with vtkConduitStagingSender and reads them back with
+// vtkConduitStagingSource over a localhost socket.
+
+#include "vtkConduitStagingSender.h"
+#include "vtkConduitStagingSource.h"
+#include "vtkImageData.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPartitionedDataSet.h"
+#include "vtkServerSocket.h"
+#include "vtkSocketCommunicator.h"
+#include "vtkSocketController.h"
+
+#include <catalyst_conduit.hpp>
+
+#include <cstdlib>
+#include <thread>
+
+#define VERIFY(x, ...)                                                                             \
+  if ((x) == false)                                                                                \
+  {                                                                                                \
+    vtkLogF(ERROR, __VA_ARGS__);                                                                   \
+    return false;                                                                                  \
+  }
+
+namespace
+{
+//----------------------------------------------------------------------------
+bool Connect(vtkSocketController* simulation, vtkSocketController* analysis)
+{
+  vtkNew<vtkServerSocket> server;
+  if (server->CreateServer(0) != 0)
+  {
+    return false;
+  }
+  int accepted = 0;
+  std::thread acceptThread([&] {
+    accepted = vtkSocketCommunicator::SafeDownCast(analysis->GetCommunicator())
+                 ->WaitForConnection(server, 10000);
+  });
+  int connected = simulation->ConnectTo("localhost", server->GetServerPort());
+  acceptThread.join();
+  return connected && accepted;
+}
+
+//----------------------------------------------------------------------------
+void CreateUniformMesh(int step, conduit_cpp::Node& mesh)
+{
+  mesh["coordsets/coords/type"] = "uniform";
+  mesh["coordsets/coords/dims/i"] = 3 + step;
+  mesh["coordsets/coords/dims/j"] = 3;
+  mesh["topologies/mesh/type"] = "uniform";
+  mesh["topologies/mesh/coordset"] = "coords";
+}
+
+//----------------------------------------------------------------------------
+bool ValidateStaging(int policy, int numSteps, bool expectAll)
+{
+  vtkNew<vtkSocketController> simulation;
+  vtkNew<vtkSocketController> analysis;
+  simulation->Initialize();
+  VERIFY(Connect(simulation, analysis), "could not connect the controllers");
+
+  vtkNew<vtkConduitStagingSource> source;
+  source->SetController(analysis);
+  source->SetMaximumNumberOfQueuedSteps(numSteps);
+  // start receiving before the simulation sends anything
+  source->HasPendingSteps();
+
+  {
+    vtkNew<vtkConduitStagingSender> sender;
+    sender->SetController(simulation);
+    sender->SetOverflowPolicy(policy);
+    sender->SetMaximumNumberOfQueuedSteps(1);
+    for (int step = 0; step < numSteps; ++step)
+    {
+      if (step % 2 == 0)
+      {
+        conduit_cpp::Node mesh;
+        CreateUniformMesh(step, mesh);
+        sender->StageNode(conduit_cpp::c_node(&mesh), step, 0.5 * step);
+      }
+      else
+      {
+        vtkNew<vtkImageData> image;
+        image->SetDimensions(3 + step, 3, 1);
+        vtkNew<vtkPartitionedDataSet> pds;
+        pds->SetPartition(0, image);
+        sender->Stage(pds, step, 0.5 * step);
+      }
+    }
+    sender->Finalize();
+    VERIFY(!expectAll || sender->GetNumberOfDroppedSteps() == 0, "steps dropped by the sender");
+  }
+
+  int numReceived = 0;
+  vtkIdType lastStep = -1;
+  while (source->UpdateNextStep())
+  {
+    auto pds = vtkPartitionedDataSet::SafeDownCast(source->GetOutputDataObject(0));
+    VERIFY(pds != nullptr, "incorrect data type, expected vtkPartitionedDataSet");
+    auto image = vtkImageData::SafeDownCast(pds->GetPartition(0));
+    VERIFY(image != nullptr, "missing partition 0");
+    VERIFY(source->GetStep() > lastStep, "steps received out of order");
+    VERIFY(source->GetTime() == 0.5 * source->GetStep(), "incorrect time");
+    int dims[3];
+    image->GetDimensions(dims);
+    VERIFY(dims[0] == 3 + source->GetStep(), "incorrect x dimension for step %d",
+      static_cast<int>(source->GetStep()));
+    lastStep = source->GetStep();
+    ++numReceived;
+  }
+  VERIFY(source->IsEndOfStream(), "end of stream not reached");
+  VERIFY(lastStep == numSteps - 1, "last step not received");
+  VERIFY(!expectAll || numReceived == numSteps, "expected %d steps, got %d", numSteps, numReceived);
+  return true;
+}
+} // end namespace
+
+//----------------------------------------------------------------------------
+int TestConduitStaging(int, char*[])
+{
+  // blocking the simulation delivers every step, dropping delivers the last one
+  bool ret = ValidateStaging(vtkConduitStagingSender::BLOCK, 6, true) &&
+    ValidateStaging(vtkConduitStagingSender::DROP_OLDEST, 6, false);
+  return ret ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,241 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkConduitStagingSender.h"
+
+#include "vtkConduitSource.h"
+#include "vtkDataObject.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkSmartPointer.h"
+#include "vtkSocketController.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+VTK_ABI_NAMESPACE_BEGIN
+class vtkConduitStagingSender::vtkInternals
+{
+public:
+  struct Step
+  {
+    vtkSmartPointer<vtkDataObject> Data;
+    vtkIdType Id;
+    double Time;
+  };
+
+  vtkNew<vtkConduitSource> ConduitSource;
+
+  std::thread Worker;
+  std::mutex Mutex;
+  std::condition_variable Condition;
+  std::deque<Step> Queue;
+  bool Stopping = false;
+  bool ConnectionLost = false;
+  bool ConnectionLostReported = false;
+  vtkIdType NumberOfDroppedSteps = 0;
+
+  // Sends the queued steps until Finalize() is called and the queue is empty.
+  void Run(vtkSocketController* controller)
+  {
+    bool connected = true;
+    while (connected)
+    {
+      Step step;
+      {
+        std::unique_lock<std::mutex> lock(this->Mutex);
+        this->Condition.wait(lock, [this] { return this->Stopping || !this->Queue.empty(); });
+        if (this->Queue.empty())
+        {
+          break;
+        }
+        step = std::move(this->Queue.front());
+        this->Queue.pop_front();
+      }
+      // wakes up a Stage() call waiting for room in the queue
+      this->Condition.notify_all();
+
+      double header[3] = { 0, static_cast<double>(step.Id), step.Time };
+      connected =
+        controller->Send(header, 3, 1, vtkConduitStagingSender::STEP_HEADER_TAG) != 0 &&
+        controller->Send(step.Data, 1, vtkConduitStagingSender::STEP_DATA_TAG) != 0;
+    }
+
+    if (connected)
+    {
+      // end of stream
+      double header[3] = { 1, 0, 0 };
+      controller->Send(header, 3, 1, vtkConduitStagingSender::STEP_HEADER_TAG);
+    }
+    else
+    {
+      std::lock_guard<std::mutex> lock(this->Mutex);
+      this->ConnectionLost = true;
+      this->NumberOfDroppedSteps += static_cast<vtkIdType>(this->Queue.size());
+      this->Queue.clear();
+    }
+    this->Condition.notify_all();
+  }
+};
+
+vtkStandardNewMacro(vtkConduitStagingSender);
+vtkCxxSetObjectMacro(vtkConduitStagingSender, Controller, vtkSocketController);
+
+//------------------------------------------------------------------------------
+vtkConduitStagingSender::vtkConduitStagingSender()
+  : Controller(nullptr)
+  , MaximumNumberOfQueuedSteps(2)
+  , OverflowPolicy(DROP_OLDEST)
+  , Internals(new vtkInternals())
+{
+}
+
+//------------------------------------------------------------------------------
+vtkConduitStagingSender::~vtkConduitStagingSender()
+{
+  this->Finalize();
+  this->SetController(nullptr);
+}
+
+//------------------------------------------------------------------------------
+vtkConduitSource* vtkConduitStagingSender::GetConduitSource()
+{
+  return this->Internals->ConduitSource;
+}
+
+//------------------------------------------------------------------------------
+bool vtkConduitStagingSender::StageNode(const conduit_node* node, vtkIdType step, double time)
+{
+  vtkConduitSource* source = this->Internals->ConduitSource;
+  source->SetNode(node);
+  // the node may be the same with new content
+  source->Modified();
+  source->Update();
+  bool staged = this->Stage(source->GetOutputDataObject(0), step, time);
+  // do not keep references to the simulation memory
+  source->GetOutputDataObject(0)->Initialize();
+  return staged;
+}
+
+//------------------------------------------------------------------------------
+bool vtkConduitStagingSender::Stage(vtkDataObject* data, vtkIdType step, double time)
+{
+  if (!data)
+  {
+    vtkErrorMacro("No data to stage.");
+    return false;
+  }
+  if (!this->Controller)
+  {
+    vtkErrorMacro("No controller set.");
+    return false;
+  }
+
+  vtkInternals& internals = *this->Internals;
+  {
+    std::unique_lock<std::mutex> lock(internals.Mutex);
+    if (internals.ConnectionLost)
+    {
+      if (!internals.ConnectionLostReported)
+      {
+        vtkWarningMacro("Connection to the analysis lost, steps are no longer sent.");
+        internals.ConnectionLostReported = true;
+      }
+      internals.NumberOfDroppedSteps++;
+      return false;
+    }
+    if (internals.Stopping)
+    {
+      vtkErrorMacro("Cannot stage steps once finalized.");
+      return false;
+    }
+    const size_t maxSize = static_cast<size_t>(this->MaximumNumberOfQueuedSteps);
+    if (internals.Queue.size() >= maxSize)
+    {
+      switch (this->OverflowPolicy)
+      {
+        case SKIP_NEWEST:
+          internals.NumberOfDroppedSteps++;
+          return false;
+        case BLOCK:
+          internals.Condition.wait(lock,
+            [&] { return internals.Queue.size() < maxSize || internals.ConnectionLost; });
+          break;
+        case DROP_OLDEST:
+        default:
+          while (internals.Queue.size() >= maxSize)
+          {
+            internals.Queue.pop_front();
+            internals.NumberOfDroppedSteps++;
+          }
+          break;
+      }
+    }
+  }
+
+  // copy outside of the lock so that the background thread keeps sending
+  vtkSmartPointer<vtkDataObject> copy = vtk::TakeSmartPointer(data->NewInstance());
+  copy->DeepCopy(data);
+
+  {
+    std::lock_guard<std::mutex> lock(internals.Mutex);
+    if (internals.ConnectionLost)
+    {
+      internals.NumberOfDroppedSteps++;
+      return false;
+    }
+    internals.Queue.push_back({ copy, step, time });
+    if (!internals.Worker.joinable())
+    {
+      internals.Worker = std::thread(&vtkInternals::Run, &internals, this->Controller);
+    }
+  }
+  internals.Condition.notify_all();
+  return true;
+}
+
+//------------------------------------------------------------------------------
+void vtkConduitStagingSender::Finalize()
+{
+  vtkInternals& internals = *this->Internals;
+  bool stopped;
+  {
+    std::lock_guard<std::mutex> lock(internals.Mutex);
+    stopped = internals.Stopping;
+    internals.Stopping = true;
+  }
+  if (stopped)
+  {
+    return;
+  }
+  internals.Condition.notify_all();
+  if (internals.Worker.joinable())
+  {
+    internals.Worker.join();
+  }
+  else if (this->Controller)
+  {
+    // nothing was staged, the analysis side still expects the end of stream
+    double header[3] = { 1, 0, 0 };
+    this->Controller->Send(header, 3, 1, STEP_HEADER_TAG);
+  }
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkConduitStagingSender::GetNumberOfDroppedSteps()
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  return this->Internals->NumberOfDroppedSteps;
+}
+
+//------------------------------------------------------------------------------
+void vtkConduitStagingSender::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Controller: " << this->Controller << endl;
+  os << indent << "MaximumNumberOfQueuedSteps: " << this->MaximumNumberOfQueuedSteps << endl;
+  os << indent << "OverflowPolicy: " << this->OverflowPolicy << endl;
+  os << indent << "NumberOfDroppedSteps: " << this->GetNumberOfDroppedSteps() << endl;
+}
+VTK_ABI_NAMESPACE_END
@@ -0,0 +1,146 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class vtkConduitStagingSender
+ * @brief ships meshes to separate analysis processes without blocking the simulation.
+ * @ingroup Insitu
+ *
+ * vtkConduitStagingSender is the simulation side of in-transit staging: every
+ * staged time step is copied into a bounded queue and sent by a background
+ * thread over a connected vtkSocketController, so that the simulation resumes
+ * as soon as the copy is done. The analysis side reads the steps with
+ * vtkConduitStagingSource.
+ *
+ * Steps can be staged either as Conduit Mesh Blueprint nodes, which are
+ * converted with the vtkConduitSource returned by GetConduitSource(), or as
+ * data objects, e.g. the output of a vtkConduitSource configured by the
+ * caller.
+ *
+ * When the analysis is slower than the simulation and the queue is full,
+ * OverflowPolicy selects whether the oldest queued step is dropped
+ * (DROP_OLDEST, the default), the new step is skipped (SKIP_NEWEST) or the
+ * simulation waits for room in the queue (BLOCK).
+ *
+ * Once a step was staged, the controller is used by the background thread
+ * only and must not be used by the caller until Finalize() returns.
+ *
+ * @sa vtkConduitStagingSource vtkConduitSource vtkSocketController
+ */
+
+#ifndef vtkConduitStagingSender_h
+#define vtkConduitStagingSender_h
+
+#include "vtkIOCatalystConduitModule.h" // for exports
+#include "vtkObject.h"
+
+#include "conduit.h" // for conduit_node
+
+#include <memory> // for std::unique_ptr
+
+VTK_ABI_NAMESPACE_BEGIN
+class vtkConduitSource;
+class vtkDataObject;
+class vtkSocketController;
+
+class VTKIOCATALYSTCONDUIT_EXPORT vtkConduitStagingSender : public vtkObject
+{
+public:
+  static vtkConduitStagingSender* New();
+  vtkTypeMacro(vtkConduitStagingSender, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * Tags of the messages exchanged with vtkConduitStagingSource.
+   */
+  enum Tags
+  {
+    STEP_HEADER_TAG = 46781,
+    STEP_DATA_TAG = 46782
+  };
+
+  enum OverflowPolicies
+  {
+    DROP_OLDEST = 0,
+    SKIP_NEWEST,
+    BLOCK
+  };
+
+  ///@{
+  /**
+   * The controller connected to the analysis process. It must be connected,
+   * e.g. with vtkSocketController::ConnectTo(), before the first step is
+   * staged.
+   */
+  void SetController(vtkSocketController*);
+  vtkGetObjectMacro(Controller, vtkSocketController);
+  ///@}
+
+  ///@{
+  /**
+   * Maximum number of steps waiting to be sent. Default is 2.
+   */
+  vtkSetClampMacro(MaximumNumberOfQueuedSteps, int, 1, VTK_INT_MAX);
+  vtkGetMacro(MaximumNumberOfQueuedSteps, int);
+  ///@}
+
+  ///@{
+  /**
+   * What to do when a step is staged while the queue is full.
+   * Default is DROP_OLDEST.
+   */
+  vtkSetClampMacro(OverflowPolicy, int, DROP_OLDEST, BLOCK);
+  vtkGetMacro(OverflowPolicy, int);
+  void SetOverflowPolicyToDropOldest() { this->SetOverflowPolicy(DROP_OLDEST); }
+  void SetOverflowPolicyToSkipNewest() { this->SetOverflowPolicy(SKIP_NEWEST); }
+  void SetOverflowPolicyToBlock() { this->SetOverflowPolicy(BLOCK); }
+  ///@}
+
+  /**
+   * The source used by StageNode() to convert Conduit nodes, which can be
+   * used to select the mesh protocol.
+   */
+  vtkConduitSource* GetConduitSource();
+
+  /**
+   * Converts a Conduit Mesh Blueprint node and stages the result. The node is
+   * not referenced once this method returns.
+   */
+  bool StageNode(const conduit_node* node, vtkIdType step, double time);
+
+  /**
+   * Stages a deep copy of `data`. Returns false if the step was not queued,
+   * either because of the SKIP_NEWEST policy or because the connection was
+   * lost.
+   */
+  bool Stage(vtkDataObject* data, vtkIdType step, double time);
+
+  /**
+   * Waits for all queued steps to be sent, notifies the analysis side that no
+   * more steps will come and stops the background thread. Called by the
+   * destructor.
+   */
+  void Finalize();
+
+  /**
+   * Number of steps dropped or skipped because the queue was full.
+   */
+  vtkIdType GetNumberOfDroppedSteps();
+
+protected:
+  vtkConduitStagingSender();
+  ~vtkConduitStagingSender() override;
+
+  vtkSocketController* Controller;
+  int MaximumNumberOfQueuedSteps;
+  int OverflowPolicy;
+
+private:
+  vtkConduitStagingSender(const vtkConduitStagingSender&) = delete;
+  void operator=(const vtkConduitStagingSender&) = delete;
+
+  class vtkInternals;
+  std::unique_ptr<vtkInternals> Internals;
+};
+VTK_ABI_NAMESPACE_END
+
+#endif
@@ -0,0 +1,255 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkConduitStagingSource.h"
+
+#include "vtkClientSocket.h"
+#include "vtkConduitStagingSender.h"
+#include "vtkDataObject.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkObjectFactory.h"
+#include "vtkSmartPointer.h"
+#include "vtkSocketCommunicator.h"
+#include "vtkSocketController.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+VTK_ABI_NAMESPACE_BEGIN
+class vtkConduitStagingSource::vtkInternals
+{
+public:
+  struct Step
+  {
+    vtkSmartPointer<vtkDataObject> Data;
+    vtkIdType Id;
+    double Time;
+  };
+
+  std::thread Worker;
+  std::mutex Mutex;
+  std::condition_variable Condition;
+  std::deque<Step> Queue;
+  bool Stopping = false;
+  bool EndOfStream = false;
+  vtkIdType NumberOfDroppedSteps = 0;
+  // whether the last execution produced a step
+  bool HasOutputStep = false;
+
+  // Receives steps until the end of the stream, a communication error or the
+  // destruction of the source.
+  void Run(vtkSocketController* controller, size_t maxSize)
+  {
+    vtkSocketCommunicator* comm =
+      vtkSocketCommunicator::SafeDownCast(controller->GetCommunicator());
+    while (true)
+    {
+      {
+        std::lock_guard<std::mutex> lock(this->Mutex);
+        if (this->Stopping)
+        {
+          break;
+        }
+      }
+      // poll the socket so that the destructor does not wait for the simulation
+      if (comm && comm->GetSocket() && !comm->HasBufferredMessages())
+      {
+        int socket = comm->GetSocket()->GetSocketDescriptor();
+        int selected;
+        int res = vtkSocket::SelectSockets(&socket, 1, 100, &selected);
+        if (res == 0)
+        {
+          continue;
+        }
+        else if (res < 0)
+        {
+          break;
+        }
+      }
+
+      double header[3];
+      if (!controller->Receive(header, 3, 1, vtkConduitStagingSender::STEP_HEADER_TAG) ||
+        header[0] != 0)
+      {
+        break;
+      }
+      vtkSmartPointer<vtkDataObject> data = vtk::TakeSmartPointer(
+        controller->ReceiveDataObject(1, vtkConduitStagingSender::STEP_DATA_TAG));
+      if (!data)
+      {
+        break;
+      }
+
+      {
+        std::lock_guard<std::mutex> lock(this->Mutex);
+        while (this->Queue.size() >= maxSize)
+        {
+          this->Queue.pop_front();
+          this->NumberOfDroppedSteps++;
+        }
+        this->Queue.push_back({ data, static_cast<vtkIdType>(header[1]), header[2] });
+      }
+      this->Condition.notify_all();
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(this->Mutex);
+      this->EndOfStream = true;
+    }
+    this->Condition.notify_all();
+  }
+};
+
+vtkStandardNewMacro(vtkConduitStagingSource);
+vtkCxxSetObjectMacro(vtkConduitStagingSource, Controller, vtkSocketController);
+
+//------------------------------------------------------------------------------
+vtkConduitStagingSource::vtkConduitStagingSource()
+  : Controller(nullptr)
+  , MaximumNumberOfQueuedSteps(1)
+  , Step(-1)
+  , Time(0.0)
+  , Internals(new vtkInternals())
+{
+  this->SetNumberOfInputPorts(0);
+  this->SetNumberOfOutputPorts(1);
+}
+
+//------------------------------------------------------------------------------
+vtkConduitStagingSource::~vtkConduitStagingSource()
+{
+  vtkInternals& internals = *this->Internals;
+  {
+    std::lock_guard<std::mutex> lock(internals.Mutex);
+    internals.Stopping = true;
+  }
+  if (internals.Worker.joinable())
+  {
+    internals.Worker.join();
+  }
+  this->SetController(nullptr);
+}
+
+//------------------------------------------------------------------------------
+void vtkConduitStagingSource::StartReceiving()
+{
+  vtkInternals& internals = *this->Internals;
+  if (internals.Worker.joinable())
+  {
+    return;
+  }
+  if (!this->Controller)
+  {
+    std::lock_guard<std::mutex> lock(internals.Mutex);
+    internals.EndOfStream = true;
+    return;
+  }
+  internals.Worker = std::thread(&vtkInternals::Run, &internals, this->Controller,
+    static_cast<size_t>(this->MaximumNumberOfQueuedSteps));
+}
+
+//------------------------------------------------------------------------------
+bool vtkConduitStagingSource::UpdateNextStep()
+{
+  this->Modified();
+  this->Update();
+  return this->Internals->HasOutputStep;
+}
+
+//------------------------------------------------------------------------------
+bool vtkConduitStagingSource::HasPendingSteps()
+{
+  this->StartReceiving();
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  return !this->Internals->Queue.empty();
+}
+
+//------------------------------------------------------------------------------
+bool vtkConduitStagingSource::IsEndOfStream()
+{
+  this->StartReceiving();
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  return this->Internals->EndOfStream && this->Internals->Queue.empty();
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkConduitStagingSource::GetNumberOfDroppedSteps()
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  return this->Internals->NumberOfDroppedSteps;
+}
+
+//------------------------------------------------------------------------------
+int vtkConduitStagingSource::RequestDataObject(
+  vtkInformation*, vtkInformationVector**, vtkInformationVector* outputVector)
+{
+  if (!this->Controller)
+  {
+    vtkErrorMacro("No controller set.");
+    return 0;
+  }
+  this->StartReceiving();
+
+  vtkInternals& internals = *this->Internals;
+  int dataType = VTK_PARTITIONED_DATA_SET;
+  {
+    std::unique_lock<std::mutex> lock(internals.Mutex);
+    internals.Condition.wait(
+      lock, [&] { return !internals.Queue.empty() || internals.EndOfStream; });
+    if (!internals.Queue.empty())
+    {
+      dataType = internals.Queue.front().Data->GetDataObjectType();
+    }
+    else if (vtkDataObject::GetData(outputVector, 0))
+    {
+      // end of stream, keep the current output
+      return 1;
+    }
+  }
+  return this->SetOutputDataObject(dataType, outputVector->GetInformationObject(0), true) ? 1 : 0;
+}
+
+//------------------------------------------------------------------------------
+int vtkConduitStagingSource::RequestData(
+  vtkInformation*, vtkInformationVector**, vtkInformationVector* outputVector)
+{
+  vtkInternals& internals = *this->Internals;
+  vtkInternals::Step step;
+  {
+    std::lock_guard<std::mutex> lock(internals.Mutex);
+    if (!internals.Queue.empty())
+    {
+      step = std::move(internals.Queue.front());
+      internals.Queue.pop_front();
+    }
+  }
+
+  vtkInformation* outInfo = outputVector->GetInformationObject(0);
+  vtkDataObject* output = vtkDataObject::GetData(outInfo);
+  internals.HasOutputStep = step.Data != nullptr;
+  if (!step.Data)
+  {
+    // end of stream
+    output->Initialize();
+    return 1;
+  }
+
+  output->ShallowCopy(step.Data);
+  output->GetInformation()->Set(vtkDataObject::DATA_TIME_STEP(), step.Time);
+  this->Step = step.Id;
+  this->Time = step.Time;
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+void vtkConduitStagingSource::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Controller: " << this->Controller << endl;
+  os << indent << "MaximumNumberOfQueuedSteps: " << this->MaximumNumberOfQueuedSteps << endl;
+  os << indent << "Step: " << this->Step << endl;
+  os << indent << "Time: " << this->Time << endl;
+}
+VTK_ABI_NAMESPACE_END
@@ -0,0 +1,122 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class vtkConduitStagingSource
+ * @brief data source for steps staged by a vtkConduitStagingSender.
+ * @ingroup Insitu
+ *
+ * vtkConduitStagingSource is the analysis side of in-transit staging. A
+ * background thread receives the steps sent by a vtkConduitStagingSender over
+ * a connected vtkSocketController and keeps up to MaximumNumberOfQueuedSteps
+ * of them, dropping the oldest ones when the analysis falls behind so that the
+ * simulation is never slowed down by the analysis.
+ *
+ * Every execution outputs the next queued step, waiting for it if needed, with
+ * the same data type as the staged data, i.e. a `vtkPartitionedDataSet` or
+ * `vtkPartitionedDataSetCollection` for steps staged from Conduit nodes.
+ * UpdateNextStep() is the usual way to drive the source:
+ *
+ * @code
+ * while (source->UpdateNextStep())
+ * {
+ *   // process source->GetOutputDataObject(0)
+ * }
+ * @endcode
+ *
+ * Once the source executed, the controller is used by the background thread
+ * only and must not be used by the caller anymore.
+ *
+ * @sa vtkConduitStagingSender vtkConduitSource
+ */
+
+#ifndef vtkConduitStagingSource_h
+#define vtkConduitStagingSource_h
+
+#include "vtkDataObjectAlgorithm.h"
+#include "vtkIOCatalystConduitModule.h" // for exports
+
+#include <memory> // for std::unique_ptr
+
+VTK_ABI_NAMESPACE_BEGIN
+class vtkSocketController;
+
+class VTKIOCATALYSTCONDUIT_EXPORT vtkConduitStagingSource : public vtkDataObjectAlgorithm
+{
+public:
+  static vtkConduitStagingSource* New();
+  vtkTypeMacro(vtkConduitStagingSource, vtkDataObjectAlgorithm);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  ///@{
+  /**
+   * The controller connected to the simulation process, e.g. with
+   * vtkSocketController::WaitForConnection().
+   */
+  void SetController(vtkSocketController*);
+  vtkGetObjectMacro(Controller, vtkSocketController);
+  ///@}
+
+  ///@{
+  /**
+   * Maximum number of received steps waiting to be processed. Must be set
+   * before the first execution. Default is 1, i.e. only the latest step is
+   * kept.
+   */
+  vtkSetClampMacro(MaximumNumberOfQueuedSteps, int, 1, VTK_INT_MAX);
+  vtkGetMacro(MaximumNumberOfQueuedSteps, int);
+  ///@}
+
+  /**
+   * Executes the source on the next step. Returns false once the simulation
+   * finalized its sender, or the connection was lost, and all steps were
+   * processed.
+   */
+  bool UpdateNextStep();
+
+  /**
+   * Returns true if a received step is waiting to be processed.
+   */
+  bool HasPendingSteps();
+
+  /**
+   * Returns true if no more steps will be received.
+   */
+  bool IsEndOfStream();
+
+  ///@{
+  /**
+   * Step id and time of the current output, as given to the sender.
+   */
+  vtkGetMacro(Step, vtkIdType);
+  vtkGetMacro(Time, double);
+  ///@}
+
+  /**
+   * Number of steps received but dropped because the queue was full.
+   */
+  vtkIdType GetNumberOfDroppedSteps();
+
+protected:
+  vtkConduitStagingSource();
+  ~vtkConduitStagingSource() override;
+
+  int RequestDataObject(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
+  int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
+
+  vtkSocketController* Controller;
+  int MaximumNumberOfQueuedSteps;
+  vtkIdType Step;
+  double Time;
+
+private:
+  vtkConduitStagingSource(const vtkConduitStagingSource&) = delete;
+  void operator=(const vtkConduitStagingSource&) = delete;
+
+  void StartReceiving();
+
+  class vtkInternals;
+  std::unique_ptr<vtkInternals> Internals;
+};
+VTK_ABI_NAMESPACE_END
+
+#endif
@@ -0,0 +1,114 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Checks that vtkHDFWriter writes the dequantized values of vtkQuantizedArray.
+
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkHDFReader.h"
+#include "vtkHDFWriter.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkQuantizedArray.h"
+#include "vtkSphereSource.h"
+#include "vtkTestUtilities.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+namespace
+{
+template <typename ValueType>
+vtkSmartPointer<vtkQuantizedArray<ValueType>> Quantize(vtkDataArray* array)
+{
+  auto quantized = vtkSmartPointer<vtkQuantizedArray<ValueType>>::New();
+  quantized->SetBackend(std::make_shared<vtkQuantizedImplicitBackend<ValueType>>(array));
+  quantized->SetNumberOfComponents(array->GetNumberOfComponents());
+  quantized->SetNumberOfTuples(array->GetNumberOfTuples());
+  quantized->SetName(array->GetName());
+  return quantized;
+}
+
+bool CheckArray(vtkDataArray* expected, vtkDataArray* read)
+{
+  if (!read || read->GetDataType() != expected->GetDataType() ||
+    read->GetNumberOfComponents() != expected->GetNumberOfComponents() ||
+    read->GetNumberOfTuples() != expected->GetNumberOfTuples())
+  {
+    std::cerr << "Wrong type or size for array " << expected->GetName() << std::endl;
+    return false;
+  }
+  for (vtkIdType tupleId = 0; tupleId < expected->GetNumberOfTuples(); ++tupleId)
+  {
+    for (int comp = 0; comp < expected->GetNumberOfComponents(); ++comp)
+    {
+      if (read->GetComponent(tupleId, comp) != expected->GetComponent(tupleId, comp))
+      {
+        std::cerr << "Wrong value " << read->GetComponent(tupleId, comp) << " for tuple "
+                  << tupleId << " and component " << comp << " of array " << expected->GetName()
+                  << ", expected " << expected->GetComponent(tupleId, comp) << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
+
+int TestHDFWriterQuantizedArray(int argc, char* argv[])
+{
+  char* tempDirCStr =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  std::string tempDir{ tempDirCStr };
+  delete[] tempDirCStr;
+
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(40);
+  sphere->SetPhiResolution(40);
+  sphere->Update();
+  vtkNew<vtkPolyData> polyData;
+  polyData->ShallowCopy(sphere->GetOutput());
+
+  // float normals and double scalars, stored as quantized arrays
+  auto normals = Quantize<float>(polyData->GetPointData()->GetNormals());
+  vtkNew<vtkDoubleArray> height;
+  height->SetName("Height");
+  height->SetNumberOfTuples(polyData->GetNumberOfPoints());
+  for (vtkIdType ptId = 0; ptId < polyData->GetNumberOfPoints(); ++ptId)
+  {
+    height->SetValue(ptId, 1000. * polyData->GetPoint(ptId)[2]);
+  }
+  auto scalars = Quantize<double>(height);
+  polyData->GetPointData()->SetNormals(normals);
+  polyData->GetPointData()->SetScalars(scalars);
+
+  const std::string filePath = tempDir + "/HDFWriterQuantizedArray.vtkhdf";
+  vtkNew<vtkHDFWriter> writer;
+  writer->SetInputData(polyData);
+  writer->SetFileName(filePath.c_str());
+  if (!writer->Write())
+  {
+    std::cerr << "Could not write the quantized arrays to " << filePath << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkHDFReader> reader;
+  reader->SetFileName(filePath.c_str());
+  reader->Update();
+  vtkPolyData* output = vtkPolyData::SafeDownCast(reader->GetOutputDataObject(0));
+  if (!output)
+  {
+    std::cerr << "Could not read back " << filePath << std::endl;
+    return EXIT_FAILURE;
+  }
+  vtkPointData* pointData = output->GetPointData();
+  if (!CheckArray(normals, pointData->GetArray(normals->GetName())) ||
+    !CheckArray(scalars, pointData->GetArray(scalars->GetName())))
+  {
+    std::cerr << "Wrong arrays read back from " << filePath << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,108 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Checks that the XML writer writes the dequantized values of vtkQuantizedArray in the ascii,
+// binary and appended data modes.
+
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkQuantizedArray.h"
+#include "vtkSphereSource.h"
+#include "vtkXMLPolyDataReader.h"
+#include "vtkXMLPolyDataWriter.h"
+
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+template <typename ValueType>
+vtkSmartPointer<vtkQuantizedArray<ValueType>> Quantize(vtkDataArray* array)
+{
+  auto quantized = vtkSmartPointer<vtkQuantizedArray<ValueType>>::New();
+  quantized->SetBackend(std::make_shared<vtkQuantizedImplicitBackend<ValueType>>(array));
+  quantized->SetNumberOfComponents(array->GetNumberOfComponents());
+  quantized->SetNumberOfTuples(array->GetNumberOfTuples());
+  quantized->SetName(array->GetName());
+  return quantized;
+}
+
+bool CheckArray(vtkDataArray* expected, vtkDataArray* read)
+{
+  if (!read || read->GetDataType() != expected->GetDataType() ||
+    read->GetNumberOfComponents() != expected->GetNumberOfComponents() ||
+    read->GetNumberOfTuples() != expected->GetNumberOfTuples())
+  {
+    std::cerr << "Wrong type or size for array " << expected->GetName() << std::endl;
+    return false;
+  }
+  for (vtkIdType tupleId = 0; tupleId < expected->GetNumberOfTuples(); ++tupleId)
+  {
+    for (int comp = 0; comp < expected->GetNumberOfComponents(); ++comp)
+    {
+      if (read->GetComponent(tupleId, comp) != expected->GetComponent(tupleId, comp))
+      {
+        std::cerr << "Wrong value " << read->GetComponent(tupleId, comp) << " for tuple "
+                  << tupleId << " and component " << comp << " of array " << expected->GetName()
+                  << ", expected " << expected->GetComponent(tupleId, comp) << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
+
+int TestXMLQuantizedArrayIO(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(40);
+  sphere->SetPhiResolution(40);
+  sphere->Update();
+  vtkNew<vtkPolyData> polyData;
+  polyData->ShallowCopy(sphere->GetOutput());
+
+  // float normals and double scalars, stored as quantized arrays
+  auto normals = Quantize<float>(polyData->GetPointData()->GetNormals());
+  vtkNew<vtkDoubleArray> height;
+  height->SetName("Height");
+  height->SetNumberOfTuples(polyData->GetNumberOfPoints());
+  for (vtkIdType ptId = 0; ptId < polyData->GetNumberOfPoints(); ++ptId)
+  {
+    height->SetValue(ptId, 1000. * polyData->GetPoint(ptId)[2]);
+  }
+  auto scalars = Quantize<double>(height);
+  polyData->GetPointData()->SetNormals(normals);
+  polyData->GetPointData()->SetScalars(scalars);
+
+  int res = EXIT_SUCCESS;
+  for (int dataMode : { vtkXMLWriter::Ascii, vtkXMLWriter::Binary, vtkXMLWriter::Appended })
+  {
+    vtkNew<vtkXMLPolyDataWriter> writer;
+    writer->SetInputData(polyData);
+    writer->SetDataMode(dataMode);
+    writer->WriteToOutputStringOn();
+    if (!writer->Write())
+    {
+      std::cerr << "Could not write the quantized arrays in data mode " << dataMode << std::endl;
+      res = EXIT_FAILURE;
+      continue;
+    }
+
+    vtkNew<vtkXMLPolyDataReader> reader;
+    reader->ReadFromInputStringOn();
+    reader->SetInputString(writer->GetOutputString());
+    reader->Update();
+    vtkPointData* pointData = reader->GetOutput()->GetPointData();
+    if (!CheckArray(normals, pointData->GetArray(normals->GetName())) ||
+      !CheckArray(scalars, pointData->GetArray(scalars->GetName())))
+    {
+      std::cerr << "Wrong arrays read back in data mode " << dataMode << std::endl;
+      res = EXIT_FAILURE;
+    }
+  }
+
+  return res;
+}
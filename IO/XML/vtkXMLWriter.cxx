@@ -31,6 +31,7 @@
 #include "vtkOutputStream.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
+#include "vtkSmartPointer.h"
 #include "vtkStdString.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkUnsignedCharArray.h"
@@ -1963,7 +1964,23 @@ int vtkXMLWriteAsciiData(ostream& os, iterT* iter, vtkIndent indent)
 //------------------------------------------------------------------------------
 int vtkXMLWriter::WriteAsciiData(vtkAbstractArray* a, vtkIndent indent)
 {
+  // The array iterators only handle the standard memory layout: SOA and implicit arrays, such as
+  // vtkQuantizedArray, are written from an array of struct copy.
+  vtkSmartPointer<vtkAbstractArray> aosCopy;
+  vtkDataArray* da = vtkArrayDownCast<vtkDataArray>(a);
+  if (da && !da->HasStandardMemoryLayout())
+  {
+    aosCopy =
+      vtkSmartPointer<vtkAbstractArray>::Take(vtkDataArray::CreateDataArray(a->GetDataType()));
+    aosCopy->DeepCopy(a);
+    a = aosCopy;
+  }
   vtkArrayIterator* iter = a->NewIterator();
+  if (!iter)
+  {
+    vtkErrorMacro("Cannot iterate over the values of array " << (a->GetName() ? a->GetName() : ""));
+    return 0;
+  }
   ostream& os = *(this->Stream);
   int ret;
   switch (a->GetDataType())
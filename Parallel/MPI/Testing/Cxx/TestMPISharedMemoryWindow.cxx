@@ -0,0 +1,151 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Tests sharing arrays between the processes of a node with
+// vtkMPISharedMemoryWindow.
+
+#include "vtkDoubleArray.h"
+#include "vtkIntArray.h"
+#include "vtkMPIController.h"
+#include "vtkMPISharedMemoryWindow.h"
+#include "vtkNew.h"
+#include "vtkSmartPointer.h"
+
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+// Whether the checks passed on every process. It is called by all the processes before each
+// collective step so that they all stop at the same step when one of them fails.
+bool AllPassed(vtkMPIController* controller, bool passed)
+{
+  int localPassed = passed ? 1 : 0;
+  int allPassed = 0;
+  controller->AllReduce(&localPassed, &allPassed, 1, vtkCommunicator::MIN_OP);
+  return allPassed == 1;
+}
+
+bool TestShareArray(vtkMPISharedMemoryWindow* window, vtkMPIController* controller)
+{
+  const int rank = controller->GetLocalProcessId();
+  vtkNew<vtkIntArray> local;
+  local->SetNumberOfComponents(2);
+  local->SetNumberOfTuples(10 + rank);
+  for (vtkIdType i = 0; i < local->GetNumberOfValues(); ++i)
+  {
+    local->SetValue(i, static_cast<int>(1000 * rank + i));
+  }
+  bool passed = window->ShareArray(local);
+  if (!passed)
+  {
+    std::cerr << "ShareArray failed." << std::endl;
+  }
+
+  vtkMPIController* nodeController = window->GetNodeController();
+  if (passed && window->GetNumberOfSharedArrays() != nodeController->GetNumberOfProcesses())
+  {
+    std::cerr << "Wrong number of shared arrays." << std::endl;
+    passed = false;
+  }
+  if (!AllPassed(controller, passed))
+  {
+    window->Release();
+    return false;
+  }
+
+  // Read the arrays of all the other processes of the node by reference.
+  vtkNew<vtkIntArray> ranks;
+  ranks->SetNumberOfTuples(nodeController->GetNumberOfProcesses());
+  nodeController->AllGather(&rank, ranks->GetPointer(0), 1);
+  for (int peer = 0; passed && peer < window->GetNumberOfSharedArrays(); ++peer)
+  {
+    vtkSmartPointer<vtkDataArray> shared;
+    shared.TakeReference(window->NewSharedArray(peer));
+    const int peerRank = ranks->GetValue(peer);
+    if (!shared || shared->GetDataType() != VTK_INT || shared->GetNumberOfComponents() != 2 ||
+      shared->GetNumberOfTuples() != 10 + peerRank)
+    {
+      std::cerr << "Wrong layout for the array of process " << peerRank << std::endl;
+      passed = false;
+      break;
+    }
+    for (vtkIdType i = 0; i < shared->GetNumberOfValues(); ++i)
+    {
+      if (shared->GetComponent(i / 2, i % 2) != 1000 * peerRank + i)
+      {
+        std::cerr << "Wrong value in the array of process " << peerRank << std::endl;
+        passed = false;
+        break;
+      }
+    }
+  }
+  window->Release();
+  return AllPassed(controller, passed);
+}
+
+bool TestBroadcastArray(vtkMPISharedMemoryWindow* window, vtkMPIController* controller)
+{
+  const int source = controller->GetNumberOfProcesses() - 1;
+  vtkNew<vtkDoubleArray> data;
+  if (controller->GetLocalProcessId() == source)
+  {
+    data->SetNumberOfComponents(3);
+    data->SetNumberOfTuples(100);
+    for (vtkIdType i = 0; i < data->GetNumberOfValues(); ++i)
+    {
+      data->SetValue(i, 0.5 * i);
+    }
+  }
+  bool passed = window->BroadcastArray(data, source);
+  if (!passed)
+  {
+    std::cerr << "BroadcastArray failed." << std::endl;
+  }
+  if (!AllPassed(controller, passed))
+  {
+    window->Release();
+    return false;
+  }
+
+  vtkSmartPointer<vtkDataArray> shared;
+  shared.TakeReference(window->NewSharedArray(0));
+  if (!shared || shared->GetNumberOfComponents() != 3 || shared->GetNumberOfTuples() != 100)
+  {
+    std::cerr << "Wrong layout for the broadcast array." << std::endl;
+    passed = false;
+  }
+  for (vtkIdType i = 0; passed && i < shared->GetNumberOfValues(); ++i)
+  {
+    if (shared->GetComponent(i / 3, i % 3) != 0.5 * i)
+    {
+      std::cerr << "Wrong value in the broadcast array." << std::endl;
+      passed = false;
+    }
+  }
+  shared = nullptr;
+  window->Release();
+  return AllPassed(controller, passed);
+}
+}
+
+int TestMPISharedMemoryWindow(int argc, char* argv[])
+{
+  vtkNew<vtkMPIController> controller;
+  controller->Initialize(&argc, &argv, 0);
+
+  int success = 1;
+  {
+    vtkNew<vtkMPISharedMemoryWindow> window;
+    window->SetController(controller);
+    success = TestShareArray(window, controller) ? 1 : 0;
+    if (success)
+    {
+      success = TestBroadcastArray(window, controller) ? 1 : 0;
+    }
+  }
+
+  int allSuccess = 0;
+  controller->AllReduce(&success, &allSuccess, 1, vtkCommunicator::MIN_OP);
+  controller->Finalize();
+  return allSuccess ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -817,6 +817,56 @@ int vtkMPICommunicator::SplitInitialize(vtkCommunicator* oldcomm, int color, int
   return 1;
 }
 
+//------------------------------------------------------------------------------
+int vtkMPICommunicator::SplitSharedMemoryInitialize(vtkCommunicator* oldcomm, int key)
+{
+  if (this->Initialized)
+    return 0;
+
+  vtkMPICommunicator* mpiComm = vtkMPICommunicator::SafeDownCast(oldcomm);
+  if (!mpiComm)
+  {
+    vtkErrorMacro("Split communicator must be an MPI communicator.");
+    return 0;
+  }
+
+  if (!mpiComm->Initialized)
+  {
+    vtkWarningMacro("The communicator passed has not been initialized!");
+    return 0;
+  }
+
+#if MPI_VERSION >= 3
+  this->KeepHandleOff();
+
+  this->MPIComm->Handle = new MPI_Comm;
+  int err;
+  if ((err = MPI_Comm_split_type(*(mpiComm->MPIComm->Handle), MPI_COMM_TYPE_SHARED, key,
+         MPI_INFO_NULL, this->MPIComm->Handle)) != MPI_SUCCESS)
+  {
+    delete this->MPIComm->Handle;
+    this->MPIComm->Handle = nullptr;
+
+    char* msg = vtkMPIController::ErrorString(err);
+    vtkErrorMacro("MPI error occurred: " << msg);
+    delete[] msg;
+
+    return 0;
+  }
+
+  this->InitializeNumberOfProcesses();
+  this->Initialized = 1;
+
+  this->Modified();
+
+  return 1;
+#else
+  (void)key;
+  vtkErrorMacro("Shared memory communicators require MPI 3 or newer.");
+  return 0;
+#endif
+}
+
 int vtkMPICommunicator::InitializeExternal(vtkMPICommunicatorOpaqueComm* comm)
 {
   this->KeepHandleOn();
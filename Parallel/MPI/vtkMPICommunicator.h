@@ -79,6 +79,15 @@ public:
    */
   int SplitInitialize(vtkCommunicator* oldcomm, int color, int key);
 
+  /**
+   * Used to initialize the communicator (i.e. create the underlying MPI_Comm)
+   * with the processes of oldcomm that can share memory with this process,
+   * typically the processes running on the same node. Requires MPI 3 or
+   * newer. This is a collective operation on oldcomm. key is used to order
+   * the processes in the new communicator as in SplitInitialize().
+   */
+  int SplitSharedMemoryInitialize(vtkCommunicator* oldcomm, int key);
+
   ///@{
   /**
    * Performs the actual communication.  You will usually use the convenience
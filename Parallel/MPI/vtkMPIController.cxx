@@ -328,6 +328,21 @@ vtkMPIController* vtkMPIController::PartitionController(int localColor, int loca
   return controller;
 }
 
+//------------------------------------------------------------------------------
+vtkMPIController* vtkMPIController::CreateNodeController(int localKey)
+{
+  VTK_CREATE(vtkMPICommunicator, subcomm);
+
+  if (!subcomm->SplitSharedMemoryInitialize(this->Communicator, localKey))
+  {
+    return nullptr;
+  }
+
+  vtkMPIController* controller = vtkMPIController::New();
+  controller->SetCommunicator(subcomm);
+  return controller;
+}
+
 //------------------------------------------------------------------------------
 int vtkMPIController::WaitSome(
   int count, vtkMPICommunicator::Request rqsts[], vtkIntArray* completed)
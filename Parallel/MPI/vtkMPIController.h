@@ -120,6 +120,17 @@ public:
 
   vtkMPIController* PartitionController(int localColor, int localKey) override;
 
+  /**
+   * Creates a new controller with the processes of this controller that can
+   * share memory with the local process, i.e. the processes running on the
+   * same node, ordered by localKey. Requires MPI 3 or newer. This is a
+   * collective operation and the caller is responsible for deleting the
+   * returned controller. Returns nullptr on failure.
+   *
+   * @sa vtkMPISharedMemoryWindow
+   */
+  vtkMPIController* CreateNodeController(int localKey);
+
   ///@{
   /**
    * This method sends data to another process (non-blocking).
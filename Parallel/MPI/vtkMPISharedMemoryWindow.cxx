@@ -0,0 +1,300 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkMPISharedMemoryWindow.h"
+
+#include "vtkDataArray.h"
+#include "vtkMPI.h"
+#include "vtkMPIController.h"
+#include "vtkObjectFactory.h"
+#include "vtkSmartPointer.h"
+
+#include <algorithm>
+#include <vector>
+
+VTK_ABI_NAMESPACE_BEGIN
+class vtkMPISharedMemoryWindow::vtkInternals
+{
+public:
+  vtkSmartPointer<vtkMPIController> NodeController;
+  // Splits Controller into the first process of every node (color 0) and
+  // all other processes (color 1).
+  vtkSmartPointer<vtkMPIController> LeaderController;
+#if MPI_VERSION >= 3
+  MPI_Win Window = MPI_WIN_NULL;
+#endif
+  // Data type (VTK_VOID when nothing is shared), number of components and
+  // number of tuples of the array stored in the segment of each process.
+  std::vector<long long> Layouts;
+
+  void* GetSegment(int nodeProcessId)
+  {
+    void* ptr = nullptr;
+#if MPI_VERSION >= 3
+    MPI_Aint size;
+    int dispUnit;
+    MPI_Win_shared_query(this->Window, nodeProcessId, &size, &dispUnit, &ptr);
+#else
+    (void)nodeProcessId;
+#endif
+    return ptr;
+  }
+
+  // Makes the stores of all processes of the node visible to each other.
+  void Synchronize()
+  {
+#if MPI_VERSION >= 3
+    MPI_Win_sync(this->Window);
+    this->NodeController->Barrier();
+    MPI_Win_sync(this->Window);
+#endif
+  }
+};
+
+namespace
+{
+//------------------------------------------------------------------------------
+vtkDataArray* NewArrayOnMemory(void* ptr, const long long layout[3])
+{
+  vtkDataArray* array = vtkDataArray::CreateDataArray(static_cast<int>(layout[0]));
+  array->SetNumberOfComponents(static_cast<int>(layout[1]));
+  array->SetVoidArray(ptr, static_cast<vtkIdType>(layout[1] * layout[2]), 1);
+  return array;
+}
+
+//------------------------------------------------------------------------------
+void CopyToMemory(vtkDataArray* source, void* ptr, const long long layout[3])
+{
+  if (layout[2] == 0)
+  {
+    return;
+  }
+  vtkDataArray* target = NewArrayOnMemory(ptr, layout);
+  target->InsertTuples(0, static_cast<vtkIdType>(layout[2]), 0, source);
+  target->Delete();
+}
+
+//------------------------------------------------------------------------------
+vtkIdType GetLayoutSize(const long long layout[3])
+{
+  if (layout[0] == VTK_VOID)
+  {
+    return 0;
+  }
+  return static_cast<vtkIdType>(
+    layout[1] * layout[2] * vtkDataArray::GetDataTypeSize(static_cast<int>(layout[0])));
+}
+}
+
+vtkStandardNewMacro(vtkMPISharedMemoryWindow);
+
+//------------------------------------------------------------------------------
+vtkMPISharedMemoryWindow::vtkMPISharedMemoryWindow()
+  : Internals(new vtkInternals)
+{
+  this->Controller = nullptr;
+  this->SetController(
+    vtkMPIController::SafeDownCast(vtkMultiProcessController::GetGlobalController()));
+}
+
+//------------------------------------------------------------------------------
+vtkMPISharedMemoryWindow::~vtkMPISharedMemoryWindow()
+{
+  this->SetController(nullptr);
+}
+
+//------------------------------------------------------------------------------
+void vtkMPISharedMemoryWindow::SetController(vtkMPIController* controller)
+{
+  if (this->Controller == controller)
+  {
+    return;
+  }
+  this->Release();
+  this->Internals->NodeController = nullptr;
+  this->Internals->LeaderController = nullptr;
+  vtkSetObjectBodyMacro(Controller, vtkMPIController, controller);
+}
+
+//------------------------------------------------------------------------------
+vtkMPIController* vtkMPISharedMemoryWindow::GetNodeController()
+{
+  vtkInternals& internals = *this->Internals;
+  if (!internals.NodeController && this->Controller)
+  {
+    const int rank = this->Controller->GetLocalProcessId();
+    internals.NodeController.TakeReference(this->Controller->CreateNodeController(rank));
+    if (internals.NodeController)
+    {
+      const int color = internals.NodeController->GetLocalProcessId() == 0 ? 0 : 1;
+      internals.LeaderController.TakeReference(this->Controller->PartitionController(color, rank));
+    }
+  }
+  return internals.NodeController;
+}
+
+//------------------------------------------------------------------------------
+bool vtkMPISharedMemoryWindow::Allocate(vtkIdType localSize)
+{
+  this->Release();
+  vtkMPIController* nodeController = this->GetNodeController();
+  if (!nodeController || !this->Internals->LeaderController)
+  {
+    vtkErrorMacro("Could not create the node controller.");
+    return false;
+  }
+
+#if MPI_VERSION >= 3
+  vtkMPICommunicator* comm = static_cast<vtkMPICommunicator*>(nodeController->GetCommunicator());
+  void* base = nullptr;
+  int err = MPI_Win_allocate_shared(static_cast<MPI_Aint>(localSize), 1, MPI_INFO_NULL,
+    *comm->GetMPIComm()->GetHandle(), &base, &this->Internals->Window);
+  if (err != MPI_SUCCESS)
+  {
+    this->Internals->Window = MPI_WIN_NULL;
+    char* msg = vtkMPIController::ErrorString(err);
+    vtkErrorMacro("MPI error occurred: " << msg);
+    delete[] msg;
+    return false;
+  }
+  MPI_Win_lock_all(MPI_MODE_NOCHECK, this->Internals->Window);
+  this->Internals->Layouts.assign(3 * nodeController->GetNumberOfProcesses(), 0);
+  return true;
+#else
+  (void)localSize;
+  vtkErrorMacro("Shared memory windows require MPI 3 or newer.");
+  return false;
+#endif
+}
+
+//------------------------------------------------------------------------------
+bool vtkMPISharedMemoryWindow::ShareArray(vtkDataArray* array)
+{
+  long long layout[3] = { VTK_VOID, 0, 0 };
+  if (array && array->GetDataType() != VTK_BIT)
+  {
+    layout[0] = array->GetDataType();
+    layout[1] = array->GetNumberOfComponents();
+    layout[2] = array->GetNumberOfTuples();
+  }
+  else if (array)
+  {
+    vtkErrorMacro("Bit arrays cannot be shared.");
+  }
+
+  if (!this->Allocate(GetLayoutSize(layout)))
+  {
+    return false;
+  }
+
+  vtkInternals& internals = *this->Internals;
+  vtkMPIController* nodeController = internals.NodeController;
+  nodeController->AllGather(layout, internals.Layouts.data(), 3);
+  if (layout[0] != VTK_VOID)
+  {
+    CopyToMemory(array, internals.GetSegment(nodeController->GetLocalProcessId()), layout);
+  }
+  internals.Synchronize();
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool vtkMPISharedMemoryWindow::BroadcastArray(vtkDataArray* array, int srcProcessId)
+{
+  if (!this->Controller)
+  {
+    vtkErrorMacro("No controller set.");
+    return false;
+  }
+
+  const int rank = this->Controller->GetLocalProcessId();
+  long long layout[3] = { VTK_VOID, 0, 0 };
+  if (rank == srcProcessId && array && array->GetDataType() != VTK_BIT)
+  {
+    layout[0] = array->GetDataType();
+    layout[1] = array->GetNumberOfComponents();
+    layout[2] = array->GetNumberOfTuples();
+  }
+  this->Controller->Broadcast(layout, 3, srcProcessId);
+
+  vtkMPIController* nodeController = this->GetNodeController();
+  const bool isLeader = nodeController && nodeController->GetLocalProcessId() == 0;
+  const vtkIdType size = GetLayoutSize(layout);
+  if (!this->Allocate(isLeader ? size : 0))
+  {
+    return false;
+  }
+
+  vtkInternals& internals = *this->Internals;
+  std::copy(layout, layout + 3, internals.Layouts.begin());
+  void* nodeCopy = internals.GetSegment(0);
+
+  // The source process fills the copy of its own node directly, which is
+  // then broadcast between the first processes of all nodes.
+  int isSource = rank == srcProcessId ? 1 : 0;
+  int sourceOnNode = 0;
+  nodeController->AllReduce(&isSource, &sourceOnNode, 1, vtkCommunicator::MAX_OP);
+  if (isSource && layout[0] != VTK_VOID)
+  {
+    CopyToMemory(array, nodeCopy, layout);
+  }
+  internals.Synchronize();
+
+  if (isLeader)
+  {
+    vtkMPIController* leaders = internals.LeaderController;
+    int candidate = sourceOnNode ? leaders->GetLocalProcessId() : -1;
+    int root = -1;
+    leaders->AllReduce(&candidate, &root, 1, vtkCommunicator::MAX_OP);
+    if (size > 0 && leaders->GetNumberOfProcesses() > 1)
+    {
+      leaders->Broadcast(static_cast<char*>(nodeCopy), size, root);
+    }
+  }
+  internals.Synchronize();
+  return true;
+}
+
+//------------------------------------------------------------------------------
+int vtkMPISharedMemoryWindow::GetNumberOfSharedArrays()
+{
+  return static_cast<int>(this->Internals->Layouts.size() / 3);
+}
+
+//------------------------------------------------------------------------------
+vtkDataArray* vtkMPISharedMemoryWindow::NewSharedArray(int nodeProcessId)
+{
+  vtkInternals& internals = *this->Internals;
+  if (nodeProcessId < 0 || nodeProcessId >= this->GetNumberOfSharedArrays())
+  {
+    return nullptr;
+  }
+  const long long* layout = internals.Layouts.data() + 3 * nodeProcessId;
+  if (layout[0] == VTK_VOID)
+  {
+    return nullptr;
+  }
+  return NewArrayOnMemory(internals.GetSegment(nodeProcessId), layout);
+}
+
+//------------------------------------------------------------------------------
+void vtkMPISharedMemoryWindow::Release()
+{
+#if MPI_VERSION >= 3
+  if (this->Internals->Window != MPI_WIN_NULL)
+  {
+    MPI_Win_unlock_all(this->Internals->Window);
+    MPI_Win_free(&this->Internals->Window);
+  }
+#endif
+  this->Internals->Layouts.clear();
+}
+
+//------------------------------------------------------------------------------
+void vtkMPISharedMemoryWindow::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Controller: " << this->Controller << endl;
+  os << indent << "NodeController: " << this->Internals->NodeController.Get() << endl;
+  os << indent << "NumberOfSharedArrays: " << this->GetNumberOfSharedArrays() << endl;
+}
+VTK_ABI_NAMESPACE_END
@@ -0,0 +1,121 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkMPISharedMemoryWindow
+ * @brief   Node-local data sharing through MPI 3 shared memory windows.
+ *
+ * vtkMPISharedMemoryWindow lets processes running on the same node access
+ * each other's arrays directly instead of copying them through MPI sends
+ * and receives. It splits the given vtkMPIController into node controllers
+ * (see vtkMPIController::CreateNodeController()) and allocates an MPI shared
+ * memory window on each node.
+ *
+ * Two usage patterns are supported:
+ * - ShareArray(): every process publishes one array, after which any process
+ *   of the node, typically the one aggregating the node-local pieces, can
+ *   wrap the arrays of its peers with NewSharedArray() without copying them.
+ * - BroadcastArray(): read-only data owned by one process is broadcast so
+ *   that it is stored only once per node. NewSharedArray(0) then returns the
+ *   node copy on every process.
+ *
+ * All methods except GetNumberOfSharedArrays() and NewSharedArray() are
+ * collective over the controller. Arrays returned by NewSharedArray() do not
+ * own their memory and must not be used once the window has been released by
+ * Release() or by a new ShareArray()/BroadcastArray(). They must be treated as
+ * read-only unless the application synchronizes writes itself. Since
+ * releasing the window is collective, Release() should be called explicitly
+ * by all processes rather than relying on the destructor.
+ *
+ * Requires MPI 3 or newer; with older MPI implementations every collective
+ * method fails and returns false.
+ *
+ * @sa
+ * vtkMPIController vtkMPICommunicator
+ */
+
+#ifndef vtkMPISharedMemoryWindow_h
+#define vtkMPISharedMemoryWindow_h
+
+#include "vtkObject.h"
+#include "vtkParallelMPIModule.h" // For export macro
+
+#include <memory> // For std::unique_ptr
+
+VTK_ABI_NAMESPACE_BEGIN
+class vtkDataArray;
+class vtkMPIController;
+
+class VTKPARALLELMPI_EXPORT vtkMPISharedMemoryWindow : public vtkObject
+{
+public:
+  static vtkMPISharedMemoryWindow* New();
+  vtkTypeMacro(vtkMPISharedMemoryWindow, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  ///@{
+  /**
+   * The controller whose processes share data. Changing it releases the
+   * current window. By default, the global controller is used if it is a
+   * vtkMPIController.
+   */
+  void SetController(vtkMPIController*);
+  vtkGetObjectMacro(Controller, vtkMPIController);
+  ///@}
+
+  /**
+   * Controller made of the processes of Controller running on the same node
+   * as this process. It is created on the first collective call.
+   */
+  vtkMPIController* GetNodeController();
+
+  /**
+   * Copies `array` into this process' segment of a new shared window so that
+   * the other processes of the node can access it with NewSharedArray().
+   * `array` may be nullptr, in which case this process shares nothing.
+   */
+  bool ShareArray(vtkDataArray* array);
+
+  /**
+   * Broadcasts `array` from srcProcessId (a process id of Controller) to all
+   * processes. The values are only stored once per node, in the segment of
+   * the node's first process: use NewSharedArray(0) to access them. `array`
+   * is only used on srcProcessId.
+   */
+  bool BroadcastArray(vtkDataArray* array, int srcProcessId);
+
+  /**
+   * Number of processes of the node, i.e. of segments in the window.
+   */
+  int GetNumberOfSharedArrays();
+
+  /**
+   * Returns a new array that references the values shared by process
+   * nodeProcessId of the node controller, or nullptr if it shared nothing.
+   * The caller is responsible for deleting the returned array, which must not
+   * be used after the window is released.
+   */
+  vtkDataArray* NewSharedArray(int nodeProcessId);
+
+  /**
+   * Frees the shared window. Collective over the node controller.
+   */
+  void Release();
+
+protected:
+  vtkMPISharedMemoryWindow();
+  ~vtkMPISharedMemoryWindow() override;
+
+  vtkMPIController* Controller;
+
+private:
+  vtkMPISharedMemoryWindow(const vtkMPISharedMemoryWindow&) = delete;
+  void operator=(const vtkMPISharedMemoryWindow&) = delete;
+
+  bool Allocate(vtkIdType localSize);
+
+  class vtkInternals;
+  std::unique_ptr<vtkInternals> Internals;
+};
+
+VTK_ABI_NAMESPACE_END
+#endif
@@ -0,0 +1,103 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Checks that picking with the cell locator cache of vtkCellPicker gives the
+// same results as intersecting every cell, also after the picked data set was
+// modified.
+
+#include "vtkActor.h"
+#include "vtkCellPicker.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPolyDataMapper.h"
+#include "vtkRenderWindow.h"
+#include "vtkRenderer.h"
+#include "vtkSphereSource.h"
+
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+bool ComparePicks(vtkCellPicker* picker, vtkDoubleArray* selectionPoints, vtkRenderer* renderer)
+{
+  vtkNew<vtkIdTypeArray> expectedIds;
+  vtkNew<vtkDoubleArray> expectedPositions;
+  picker->UseCellLocatorCacheOff();
+  vtkIdType expectedPicked =
+    picker->PickBatch(selectionPoints, renderer, expectedIds, expectedPositions);
+
+  vtkNew<vtkIdTypeArray> ids;
+  vtkNew<vtkDoubleArray> positions;
+  picker->UseCellLocatorCacheOn();
+  vtkIdType picked = picker->PickBatch(selectionPoints, renderer, ids, positions);
+
+  if (expectedPicked == 0 || picked != expectedPicked)
+  {
+    std::cerr << "Picked " << picked << " points instead of " << expectedPicked << std::endl;
+    return false;
+  }
+  for (vtkIdType i = 0; i < selectionPoints->GetNumberOfTuples(); ++i)
+  {
+    double expected[3], x[3];
+    expectedPositions->GetTypedTuple(i, expected);
+    positions->GetTypedTuple(i, x);
+    // neighbor cells may be picked on their shared edges, but not elsewhere
+    if ((ids->GetValue(i) < 0) != (expectedIds->GetValue(i) < 0) ||
+      vtkMath::Distance2BetweenPoints(x, expected) > 1e-8)
+    {
+      std::cerr << "Incorrect pick " << i << ": cell " << ids->GetValue(i) << " instead of "
+                << expectedIds->GetValue(i) << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestCellPickerLocatorCache(int, char*[])
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(200);
+  sphere->SetPhiResolution(200);
+
+  vtkNew<vtkPolyDataMapper> mapper;
+  mapper->SetInputConnection(sphere->GetOutputPort());
+  vtkNew<vtkActor> actor;
+  actor->SetMapper(mapper);
+  actor->SetPosition(0.1, 0.2, 0.0);
+
+  vtkNew<vtkRenderer> renderer;
+  renderer->AddActor(actor);
+  vtkNew<vtkRenderWindow> renWin;
+  renWin->SetSize(200, 200);
+  renWin->AddRenderer(renderer);
+  renWin->Render();
+
+  vtkNew<vtkDoubleArray> selectionPoints;
+  selectionPoints->SetNumberOfComponents(3);
+  for (int j = 0; j < 200; j += 10)
+  {
+    for (int i = 0; i < 200; i += 10)
+    {
+      selectionPoints->InsertNextTuple3(i + 0.5, j + 0.25, 0.0);
+    }
+  }
+
+  vtkNew<vtkCellPicker> picker;
+  if (!ComparePicks(picker, selectionPoints, renderer))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // the cached locator is rebuilt for the modified data set
+  sphere->SetCenter(0.2, 0.0, 0.1);
+  sphere->SetRadius(0.4);
+  sphere->Update();
+  if (!ComparePicks(picker, selectionPoints, renderer))
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,145 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Checks that vtkColorTransferFunction and vtkDiscretizableColorTransferFunction map a large
+// array, which is done in parallel chunks, to the same colors as every value mapped on its own.
+
+#include "vtkColorTransferFunction.h"
+#include "vtkDiscretizableColorTransferFunction.h"
+#include "vtkNew.h"
+#include "vtkPiecewiseFunction.h"
+#include "vtkSMPTools.h"
+#include "vtkVariant.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+namespace
+{
+// Values of every other tuple, in and out of the [1, 1000] range of the functions, with NaNs for
+// floating point types.
+template <typename T>
+std::vector<T> MakeInput(int numberOfValues)
+{
+  std::vector<T> input(2 * numberOfValues);
+  for (int i = 0; i < numberOfValues; ++i)
+  {
+    if (std::numeric_limits<T>::has_quiet_NaN && i % 7 == 0)
+    {
+      input[2 * i] = std::numeric_limits<T>::quiet_NaN();
+    }
+    else
+    {
+      input[2 * i] = static_cast<T>(std::numeric_limits<T>::is_signed ? (i % 1500) - 100 : i);
+    }
+  }
+  return input;
+}
+
+template <typename T>
+bool TestParallelMapping(vtkScalarsToColors* function, int inputType, int outputFormat)
+{
+  const int numberOfValues = 100000;
+  std::vector<T> input = MakeInput<T>(numberOfValues);
+  std::vector<unsigned char> output(outputFormat * numberOfValues);
+  function->MapScalarsThroughTable2(
+    input.data(), output.data(), inputType, numberOfValues, 2, outputFormat);
+
+  unsigned char expected[4];
+  for (int i = 0; i < numberOfValues; ++i)
+  {
+    function->MapScalarsThroughTable2(&input[2 * i], expected, inputType, 1, 2, outputFormat);
+    for (int c = 0; c < outputFormat; ++c)
+    {
+      if (output[outputFormat * i + c] != expected[c])
+      {
+        std::cerr << function->GetClassName() << ": mismatch for value " << i << " of type "
+                  << inputType << " with output format " << outputFormat << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool TestAllInputTypes(vtkScalarsToColors* function)
+{
+  bool success = true;
+  for (int outputFormat : { VTK_LUMINANCE, VTK_LUMINANCE_ALPHA, VTK_RGB, VTK_RGBA })
+  {
+    success &= TestParallelMapping<double>(function, VTK_DOUBLE, outputFormat);
+    success &= TestParallelMapping<float>(function, VTK_FLOAT, outputFormat);
+    success &= TestParallelMapping<int>(function, VTK_INT, outputFormat);
+    // mapped through the 8 and 16 bit tables of vtkColorTransferFunction
+    success &= TestParallelMapping<unsigned char>(function, VTK_UNSIGNED_CHAR, outputFormat);
+    success &= TestParallelMapping<unsigned short>(function, VTK_UNSIGNED_SHORT, outputFormat);
+  }
+  return success;
+}
+
+template <typename FunctionT>
+void AddPoints(FunctionT* function)
+{
+  function->AddRGBPoint(1.0, 0.23, 0.3, 0.75);
+  function->AddRGBPoint(500.0, 0.87, 0.87, 0.87);
+  function->AddRGBPoint(1000.0, 0.7, 0.02, 0.15);
+  function->SetNanColor(1.0, 1.0, 0.0);
+  function->SetBelowRangeColor(0.0, 1.0, 0.0);
+  function->SetAboveRangeColor(1.0, 0.0, 1.0);
+}
+}
+
+int TestColorTransferFunctionThreaded(int, char*[])
+{
+  bool success = true;
+  vtkSMPTools::LocalScope(vtkSMPTools::Config{ 4 },
+    [&]()
+    {
+      vtkNew<vtkColorTransferFunction> ctf;
+      AddPoints(ctf.Get());
+      for (int scale : { VTK_CTF_LINEAR, VTK_CTF_LOG10 })
+      {
+        ctf->SetScale(scale);
+        ctf->SetClamping(true);
+        ctf->SetAlpha(1.0);
+        success &= TestAllInputTypes(ctf);
+        ctf->SetClamping(false);
+        ctf->SetUseBelowRangeColor(true);
+        ctf->SetUseAboveRangeColor(true);
+        ctf->SetAlpha(0.5);
+        success &= TestAllInputTypes(ctf);
+        ctf->SetUseBelowRangeColor(false);
+        ctf->SetUseAboveRangeColor(false);
+      }
+      ctf->SetScale(VTK_CTF_LINEAR);
+      ctf->SetAlpha(1.0);
+      ctf->IndexedLookupOn();
+      for (int i = 0; i < 10; ++i)
+      {
+        ctf->SetAnnotation(vtkVariant(10.0 * i), "annotation");
+      }
+      success &= TestParallelMapping<double>(ctf, VTK_DOUBLE, VTK_RGBA);
+
+      vtkNew<vtkDiscretizableColorTransferFunction> dctf;
+      AddPoints(dctf.Get());
+      dctf->SetNumberOfValues(16);
+      vtkNew<vtkPiecewiseFunction> opacity;
+      opacity->AddPoint(1.0, 0.0);
+      opacity->AddPoint(1000.0, 1.0);
+      dctf->SetScalarOpacityFunction(opacity);
+      for (bool discretize : { false, true })
+      {
+        dctf->SetDiscretize(discretize);
+        dctf->EnableOpacityMappingOff();
+        dctf->Build();
+        success &= TestAllInputTypes(dctf);
+        dctf->EnableOpacityMappingOn();
+        dctf->Build();
+        success &= TestAllInputTypes(dctf);
+      }
+    });
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,121 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Checks that culling the blocks outside of the view frustum does not change
+// the rendered image while skipping most of the blocks, and that the blocks
+// smaller than the minimum coverage are not drawn.
+
+#include "vtkActor.h"
+#include "vtkCamera.h"
+#include "vtkCompositePolyDataMapper.h"
+#include "vtkImageData.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkRenderWindow.h"
+#include "vtkRenderer.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkWindowToImageFilter.h"
+
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+vtkSmartPointer<vtkUnsignedCharArray> Capture(vtkRenderWindow* win)
+{
+  win->Render();
+  vtkNew<vtkWindowToImageFilter> w2i;
+  w2i->SetInput(win);
+  w2i->Update();
+  auto pixels = vtkSmartPointer<vtkUnsignedCharArray>::New();
+  pixels->DeepCopy(w2i->GetOutput()->GetPointData()->GetScalars());
+  return pixels;
+}
+}
+
+int TestCompositePolyDataMapperBlockCulling(int, char*[])
+{
+  // a grid of 32x32 spheres, one per block
+  const int gridSize = 32;
+  vtkNew<vtkMultiBlockDataSet> data;
+  data->SetNumberOfBlocks(gridSize * gridSize);
+  for (int j = 0; j < gridSize; ++j)
+  {
+    for (int i = 0; i < gridSize; ++i)
+    {
+      vtkNew<vtkSphereSource> sphere;
+      sphere->SetCenter(i, j, 0.0);
+      sphere->SetRadius(0.4);
+      sphere->Update();
+      data->SetBlock(j * gridSize + i, sphere->GetOutput());
+    }
+  }
+
+  vtkNew<vtkCompositePolyDataMapper> mapper;
+  mapper->SetInputDataObject(data);
+  vtkNew<vtkActor> actor;
+  actor->SetMapper(mapper);
+  // the culling planes are transformed to the block coordinates
+  actor->SetPosition(0.5, -0.25, 1.0);
+  actor->SetOrientation(0.0, 0.0, 10.0);
+
+  vtkNew<vtkRenderer> ren;
+  ren->AddActor(actor);
+  vtkNew<vtkRenderWindow> win;
+  win->SetSize(300, 300);
+  win->SetMultiSamples(0);
+  win->AddRenderer(ren);
+
+  // only a few blocks are in the view frustum
+  ren->ResetCamera();
+  ren->GetActiveCamera()->Zoom(6.0);
+  ren->GetActiveCamera()->Azimuth(20.0);
+  ren->ResetCameraClippingRange();
+
+  const vtkIdType numberOfBlocks = gridSize * gridSize;
+  auto expected = Capture(win);
+  if (mapper->GetNumberOfCulledBlocks() != 0)
+  {
+    std::cerr << "Culled " << mapper->GetNumberOfCulledBlocks()
+              << " blocks with BlockCulling off." << std::endl;
+    return EXIT_FAILURE;
+  }
+  mapper->BlockCullingOn();
+  auto culled = Capture(win);
+  if (mapper->GetNumberOfCulledBlocks() < numberOfBlocks / 2 ||
+    mapper->GetNumberOfCulledBlocks() >= numberOfBlocks)
+  {
+    std::cerr << "Culled " << mapper->GetNumberOfCulledBlocks() << " blocks out of "
+              << numberOfBlocks << " instead of all but the few blocks in view." << std::endl;
+    return EXIT_FAILURE;
+  }
+  for (vtkIdType i = 0; i < expected->GetNumberOfValues(); ++i)
+  {
+    if (expected->GetValue(i) != culled->GetValue(i))
+    {
+      std::cerr << "Culling the blocks changed the image." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // no block covers the whole viewport
+  mapper->SetMinimumBlockCoverage(1.0);
+  auto empty = Capture(win);
+  if (mapper->GetNumberOfCulledBlocks() != numberOfBlocks)
+  {
+    std::cerr << "Culled " << mapper->GetNumberOfCulledBlocks() << " blocks out of "
+              << numberOfBlocks << " with a minimum coverage of 1." << std::endl;
+    return EXIT_FAILURE;
+  }
+  for (vtkIdType i = 0; i < empty->GetNumberOfValues(); ++i)
+  {
+    if (empty->GetValue(i) != 0)
+    {
+      std::cerr << "Blocks smaller than the minimum coverage were drawn." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
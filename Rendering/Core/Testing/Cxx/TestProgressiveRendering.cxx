@@ -0,0 +1,98 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Checks that progressive rendering increases the time given to the props for
+// each render of the same view, up to the time budget, and starts over from the
+// allocated render time when the view changes.
+
+#include "vtkCamera.h"
+#include "vtkLODProp3D.h"
+#include "vtkNew.h"
+#include "vtkPolyDataMapper.h"
+#include "vtkRenderWindow.h"
+#include "vtkRenderer.h"
+#include "vtkSphereSource.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+bool CheckRenderTime(vtkRenderWindow* win, vtkRenderer* ren, double expected, bool refine)
+{
+  win->Render();
+  if (std::abs(ren->GetProgressiveRenderTime() - expected) > 1e-12 ||
+    ren->GetProgressiveRefinementNeeded() != refine)
+  {
+    std::cerr << "Expected a render time of " << expected << " but got "
+              << ren->GetProgressiveRenderTime() << ", refinement needed "
+              << ren->GetProgressiveRefinementNeeded() << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestProgressiveRendering(int, char*[])
+{
+  vtkNew<vtkSphereSource> coarse;
+  coarse->SetThetaResolution(8);
+  coarse->SetPhiResolution(8);
+  vtkNew<vtkPolyDataMapper> coarseMapper;
+  coarseMapper->SetInputConnection(coarse->GetOutputPort());
+  vtkNew<vtkSphereSource> fine;
+  fine->SetThetaResolution(256);
+  fine->SetPhiResolution(256);
+  vtkNew<vtkPolyDataMapper> fineMapper;
+  fineMapper->SetInputConnection(fine->GetOutputPort());
+
+  vtkNew<vtkLODProp3D> prop;
+  prop->AddLOD(coarseMapper, 0.0);
+  prop->AddLOD(fineMapper, 0.0);
+
+  vtkNew<vtkRenderer> ren;
+  ren->AddViewProp(prop);
+  vtkNew<vtkRenderWindow> win;
+  win->SetSize(200, 200);
+  win->AddRenderer(ren);
+  ren->ResetCamera();
+
+  ren->ProgressiveRenderingOn();
+  ren->SetProgressiveTimeBudget(0.5);
+  ren->SetProgressiveRefinementFactor(4.0);
+  ren->SetAllocatedRenderTime(0.01);
+
+  // the first render of a view gets the allocated render time, the following
+  // ones refine it up to the budget
+  if (!CheckRenderTime(win, ren, 0.01, true) || !CheckRenderTime(win, ren, 0.04, true) ||
+    !CheckRenderTime(win, ren, 0.16, true) || !CheckRenderTime(win, ren, 0.5, false) ||
+    !CheckRenderTime(win, ren, 0.5, false))
+  {
+    return EXIT_FAILURE;
+  }
+  if (std::abs(prop->GetAllocatedRenderTime() - 0.5) > 1e-12)
+  {
+    std::cerr << "The prop was not given the refined render time." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // moving the camera or modifying a prop starts over
+  ren->GetActiveCamera()->Azimuth(10.0);
+  if (!CheckRenderTime(win, ren, 0.01, true) || !CheckRenderTime(win, ren, 0.04, true))
+  {
+    return EXIT_FAILURE;
+  }
+  prop->SetPosition(1.0, 0.0, 0.0);
+  if (!CheckRenderTime(win, ren, 0.01, true))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // without progressive rendering, the allocated render time is used
+  ren->ProgressiveRenderingOff();
+  if (!CheckRenderTime(win, ren, 0.01, false))
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
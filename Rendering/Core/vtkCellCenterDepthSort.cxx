@@ -7,15 +7,21 @@
 #include "vtkCell.h"
 #include "vtkDataSet.h"
 #include "vtkFloatArray.h"
+#include "vtkGenericCell.h"
 #include "vtkIdTypeArray.h"
 #include "vtkMath.h"
 #include "vtkMatrix4x4.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkSortDataArray.h"
 
 #include <algorithm>
 #include <stack>
 #include <utility>
+#include <vector>
 
 //------------------------------------------------------------------------------
 
@@ -112,39 +118,60 @@ void vtkCellCenterDepthSort::ComputeCellCenters()
 {
   vtkIdType numcells = this->Input->GetNumberOfCells();
   this->CellCenters->SetNumberOfTuples(numcells);
-
-  float* center = this->CellCenters->GetPointer(0);
-  double dcenter[3];
-  double* weights = new double[this->Input->GetMaxCellSize()]; // Dummy array.
-
-  for (vtkIdType i = 0; i < numcells; i++)
+  if (numcells == 0)
   {
-    vtkCell* cell = this->Input->GetCell(i);
-    double pcenter[3];
-    int subId;
-    subId = cell->GetParametricCenter(pcenter);
-    cell->EvaluateLocation(subId, pcenter, dcenter, weights);
-    center[0] = dcenter[0];
-    center[1] = dcenter[1];
-    center[2] = dcenter[2];
-    center += 3;
+    return;
   }
 
-  delete[] weights;
+  float* centers = this->CellCenters->GetPointer(0);
+  const size_t maxCellSize = this->Input->GetMaxCellSize();
+
+  // Make the input ready for GetCell() calls from several threads.
+  vtkNew<vtkGenericCell> firstCell;
+  this->Input->GetCell(0, firstCell);
+
+  vtkSMPThreadLocalObject<vtkGenericCell> tlCell;
+  vtkSMPThreadLocal<std::vector<double>> tlWeights;
+  vtkSMPTools::For(0, numcells,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      vtkGenericCell* cell = tlCell.Local();
+      std::vector<double>& weights = tlWeights.Local();
+      weights.resize(maxCellSize); // Dummy array.
+      float* center = centers + 3 * begin;
+      for (vtkIdType i = begin; i < end; i++)
+      {
+        this->Input->GetCell(i, cell);
+        double pcenter[3];
+        double dcenter[3];
+        int subId = cell->GetParametricCenter(pcenter);
+        cell->EvaluateLocation(subId, pcenter, dcenter, weights.data());
+        center[0] = dcenter[0];
+        center[1] = dcenter[1];
+        center[2] = dcenter[2];
+        center += 3;
+      }
+    });
 }
 
+// Computes the depths of the cells in the order of SortedCells, so that the
+// depths of the last sort order are nearly sorted after a small camera motion.
 void vtkCellCenterDepthSort::ComputeDepths()
 {
   float* vector = this->ComputeProjectionVector();
   vtkIdType numcells = this->Input->GetNumberOfCells();
 
-  float* center = this->CellCenters->GetPointer(0);
-  float* depth = this->CellDepths->GetPointer(0);
-  for (vtkIdType i = 0; i < numcells; i++)
-  {
-    *(depth++) = vtkMath::Dot(center, vector);
-    center += 3;
-  }
+  const float* centers = this->CellCenters->GetPointer(0);
+  const vtkIdType* cellIds = this->SortedCells->GetPointer(0);
+  float* depths = this->CellDepths->GetPointer(0);
+  vtkSMPTools::For(0, numcells,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType i = begin; i < end; i++)
+      {
+        depths[i] = vtkMath::Dot(centers + 3 * cellIds[i], vector);
+      }
+    });
 }
 
 void vtkCellCenterDepthSort::InitTraversal()
@@ -153,7 +180,9 @@ void vtkCellCenterDepthSort::InitTraversal()
 
   vtkIdType numcells = this->Input->GetNumberOfCells();
 
-  if ((this->LastSortTime < this->Input->GetMTime()) || (this->LastSortTime < this->MTime))
+  bool rebuild = (this->LastSortTime < this->Input->GetMTime()) ||
+    (this->LastSortTime < this->MTime) || (this->SortedCells->GetNumberOfTuples() != numcells);
+  if (rebuild)
   {
     vtkDebugMacro("Building cell centers array.");
 
@@ -161,18 +190,24 @@ void vtkCellCenterDepthSort::InitTraversal()
     this->ComputeCellCenters();
     this->CellDepths->SetNumberOfTuples(numcells);
     this->SortedCells->SetNumberOfTuples(numcells);
-  }
 
-  vtkDebugMacro("Filling SortedCells to initial values.");
-  vtkIdType* id = this->SortedCells->GetPointer(0);
-  for (vtkIdType i = 0; i < numcells; i++)
-  {
-    *(id++) = i;
+    vtkDebugMacro("Filling SortedCells to initial values.");
+    vtkIdType* id = this->SortedCells->GetPointer(0);
+    for (vtkIdType i = 0; i < numcells; i++)
+    {
+      *(id++) = i;
+    }
   }
 
   vtkDebugMacro("Calculating depths.");
   this->ComputeDepths();
 
+  // Otherwise the cells are still in the order of the last sort, which is
+  // nearly the right one when the camera moved a little since.
+  vtkDebugMacro("Sorting depths.");
+  vtkSortDataArray::SortRealKeys(
+    this->CellDepths->GetPointer(0), this->SortedCells->GetPointer(0), numcells, !rebuild);
+
   while (!this->ToSort->Stack.empty())
     this->ToSort->Stack.pop();
   this->ToSort->Stack.emplace(0, numcells);
@@ -184,57 +219,28 @@ vtkIdTypeArray* vtkCellCenterDepthSort::GetNextCells()
 {
   if (this->ToSort->Stack.empty())
   {
-    // Already sorted and returned everything.
+    // Already returned everything.
     return nullptr;
   }
 
-  vtkIdType* cellIds = this->SortedCells->GetPointer(0);
-  float* cellDepths = this->CellDepths->GetPointer(0);
-  vtkIdPair partition;
-
-  partition = this->ToSort->Stack.top();
+  // The cells are sorted by InitTraversal(), return the next ones.
+  vtkIdPair partition = this->ToSort->Stack.top();
   this->ToSort->Stack.pop();
-  while (partition.second - partition.first > this->MaxCellsReturned)
+  vtkIdType firstcell = partition.first;
+  vtkIdType numcells = std::min<vtkIdType>(partition.second - firstcell, this->MaxCellsReturned);
+  if (firstcell + numcells < partition.second)
   {
-    vtkIdType left = partition.first;
-    vtkIdType right = partition.second - 1;
-    float pivot = cellDepths[static_cast<vtkIdType>(vtkMath::Random(left, right))];
-    while (left <= right)
-    {
-      while ((left <= right) && (cellDepths[left] < pivot))
-        left++;
-      while ((left <= right) && (cellDepths[right] > pivot))
-        right--;
-
-      if (left > right)
-        break;
-
-      std::swap(cellIds[left], cellIds[right]);
-      std::swap(cellDepths[left], cellDepths[right]);
-
-      left++;
-      right--;
-    }
-
-    this->ToSort->Stack.emplace(left, partition.second);
-    partition.second = left;
+    this->ToSort->Stack.emplace(firstcell + numcells, partition.second);
   }
-
-  if (partition.second <= partition.first)
+  if (numcells <= 0)
   {
-    // Got a partition of zero size.  Just recurse to get the next one.
-    return this->GetNextCells();
+    return nullptr;
   }
 
-  vtkIdType firstcell = partition.first;
-  vtkIdType numcells = partition.second - partition.first;
-
-  this->SortedCellPartition->SetArray(cellIds + firstcell, numcells, 1);
+  this->SortedCellPartition->SetArray(this->SortedCells->GetPointer(firstcell), numcells, 1);
   this->SortedCellPartition->SetNumberOfTuples(numcells);
-  this->CellPartitionDepths->SetArray(cellDepths + firstcell, numcells, 1);
+  this->CellPartitionDepths->SetArray(this->CellDepths->GetPointer(firstcell), numcells, 1);
   this->CellPartitionDepths->SetNumberOfTuples(numcells);
-
-  vtkSortDataArray::Sort(this->CellPartitionDepths, this->SortedCellPartition);
   return this->SortedCellPartition;
 }
 VTK_ABI_NAMESPACE_END
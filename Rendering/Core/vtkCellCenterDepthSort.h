@@ -11,8 +11,10 @@
  * sort, but it only provides approximate results.  The sorting algorithm
  * finds the centroids of all the cells.  It then performs the dot product
  * of the centroids against a vector pointing in the direction of the
- * camera transformed into object space.  It then performs an ordinary sort
- * on the result.
+ * camera transformed into object space.  It then sorts the result with a
+ * parallel radix sort.  When the data did not change since the last
+ * traversal, the cells are sorted starting from their last order, which is
+ * nearly sorted after a small camera motion and therefore cheaper to sort.
  *
  */
 
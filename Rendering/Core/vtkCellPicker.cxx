@@ -17,6 +17,7 @@
 #include "vtkDoubleArray.h"
 #include "vtkGenericCell.h"
 #include "vtkHyperTreeGridNonOrientedGeometryCursor.h"
+#include "vtkIdTypeArray.h"
 #include "vtkImageData.h"
 #include "vtkImageMapper3D.h"
 #include "vtkLODProp3D.h"
@@ -28,6 +29,8 @@
 #include "vtkPoints.h"
 #include "vtkPolygon.h"
 #include "vtkRenderer.h"
+#include "vtkSmartPointer.h"
+#include "vtkStaticCellLocator.h"
 #include "vtkTexture.h"
 #include "vtkTransform.h"
 #include "vtkUniformHyperTreeGrid.h"
@@ -36,8 +39,46 @@
 #include "vtkVoxel.h"
 
 #include <algorithm>
+#include <map>
 
 VTK_ABI_NAMESPACE_BEGIN
+//------------------------------------------------------------------------------
+// The locators built by the picker for the picked data sets.
+class vtkCellPicker::vtkCellLocatorCache
+{
+public:
+  vtkAbstractCellLocator* GetLocator(vtkDataSet* dataSet)
+  {
+    vtkSmartPointer<vtkStaticCellLocator>& locator = this->Locators[dataSet];
+    if (!locator)
+    {
+      locator = vtkSmartPointer<vtkStaticCellLocator>::New();
+      locator->SetDataSet(dataSet);
+    }
+    // Only rebuilds the locator if the data set was modified since the last build
+    locator->BuildLocator();
+    return locator;
+  }
+
+  // Release the locators whose data set is not referenced by anything else anymore.
+  void Prune()
+  {
+    for (auto it = this->Locators.begin(); it != this->Locators.end();)
+    {
+      if (it->first->GetReferenceCount() == 1)
+      {
+        it = this->Locators.erase(it);
+      }
+      else
+      {
+        ++it;
+      }
+    }
+  }
+
+  std::map<vtkDataSet*, vtkSmartPointer<vtkStaticCellLocator>> Locators;
+};
+
 vtkStandardNewMacro(vtkCellPicker);
 
 //------------------------------------------------------------------------------
@@ -45,6 +86,9 @@ vtkCellPicker::vtkCellPicker()
 {
   // List of locators for accelerating polydata picking
   this->Locators = vtkCollection::New();
+  this->UseCellLocatorCache = 0;
+  this->CellLocatorCacheMinimumNumberOfCells = 1000;
+  this->CellLocatorCache.reset(new vtkCellLocatorCache);
 
   // For polydata picking
   this->Cell = vtkGenericCell::New();
@@ -115,6 +159,11 @@ void vtkCellPicker::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "VolumeOpacityIsovalue: " << this->VolumeOpacityIsovalue << "\n";
   os << indent << "UseVolumeGradientOpacity: " << (this->UseVolumeGradientOpacity ? "On" : "Off")
      << "\n";
+
+  os << indent << "UseCellLocatorCache: " << (this->UseCellLocatorCache ? "On" : "Off") << "\n";
+  os << indent
+     << "CellLocatorCacheMinimumNumberOfCells: " << this->CellLocatorCacheMinimumNumberOfCells
+     << "\n";
 }
 
 //------------------------------------------------------------------------------
@@ -122,6 +171,10 @@ void vtkCellPicker::Initialize()
 {
   this->ResetPickInfo();
   this->Superclass::Initialize();
+  if (this->CellLocatorCache)
+  {
+    this->CellLocatorCache->Prune();
+  }
 }
 
 //------------------------------------------------------------------------------
@@ -191,6 +244,54 @@ void vtkCellPicker::RemoveAllLocators()
   this->Locators->RemoveAllItems();
 }
 
+//------------------------------------------------------------------------------
+void vtkCellPicker::ClearCellLocatorCache()
+{
+  this->CellLocatorCache->Locators.clear();
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkCellPicker::PickBatch(vtkDataArray* selectionPoints, vtkRenderer* renderer,
+  vtkIdTypeArray* cellIds, vtkDoubleArray* pickPositions)
+{
+  vtkIdType numPicks = selectionPoints ? selectionPoints->GetNumberOfTuples() : 0;
+  if (selectionPoints && selectionPoints->GetNumberOfComponents() != 3)
+  {
+    vtkErrorMacro("The selection points must have 3 components.");
+    numPicks = 0;
+  }
+  if (cellIds)
+  {
+    cellIds->SetNumberOfComponents(1);
+    cellIds->SetNumberOfTuples(numPicks);
+  }
+  if (pickPositions)
+  {
+    pickPositions->SetNumberOfComponents(3);
+    pickPositions->SetNumberOfTuples(numPicks);
+  }
+
+  vtkIdType numPicked = 0;
+  for (vtkIdType i = 0; i < numPicks; ++i)
+  {
+    double x[3];
+    selectionPoints->GetTuple(i, x);
+    if (this->Pick(x[0], x[1], x[2], renderer))
+    {
+      ++numPicked;
+    }
+    if (cellIds)
+    {
+      cellIds->SetValue(i, this->CellId);
+    }
+    if (pickPositions)
+    {
+      pickPositions->SetTypedTuple(i, this->PickPosition);
+    }
+  }
+  return numPicked;
+}
+
 //------------------------------------------------------------------------------
 int vtkCellPicker::Pick(
   double selectionX, double selectionY, double selectionZ, vtkRenderer* renderer)
@@ -629,6 +730,13 @@ bool vtkCellPicker::IntersectDataSetWithLine(vtkDataSet* dataSet, const double p
     }
   }
 
+  // Otherwise use the cached locator of the data set, if it is large enough
+  if (!locator && this->UseCellLocatorCache &&
+    dataSet->GetNumberOfCells() >= this->CellLocatorCacheMinimumNumberOfCells)
+  {
+    locator = this->CellLocatorCache->GetLocator(dataSet);
+  }
+
   if (locator)
   {
     double t = tMin;
@@ -32,6 +32,8 @@
 #include "vtkPicker.h"
 #include "vtkRenderingCoreModule.h" // For export macro
 
+#include <memory> // for std::unique_ptr
+
 VTK_ABI_NAMESPACE_BEGIN
 class vtkMapper;
 class vtkTexture;
@@ -43,6 +45,7 @@ class vtkPiecewiseFunction;
 class vtkDataArray;
 class vtkDoubleArray;
 class vtkIdList;
+class vtkIdTypeArray;
 class vtkCell;
 class vtkGenericCell;
 class vtkImageData;
@@ -95,6 +98,47 @@ public:
    */
   void RemoveAllLocators();
 
+  ///@{
+  /**
+   * When on, a vtkStaticCellLocator is built for each picked data set that
+   * has at least CellLocatorCacheMinimumNumberOfCells cells and no locator
+   * added with AddLocator(). The locators are kept by the picker, rebuilt when
+   * their data set is modified and released with their data set, so that
+   * repeated picks in an unchanged scene, e.g. when hovering, only traverse
+   * the locators instead of intersecting every cell. Default is off.
+   */
+  vtkSetMacro(UseCellLocatorCache, vtkTypeBool);
+  vtkBooleanMacro(UseCellLocatorCache, vtkTypeBool);
+  vtkGetMacro(UseCellLocatorCache, vtkTypeBool);
+  ///@}
+
+  ///@{
+  /**
+   * The minimum number of cells of a data set for a locator to be cached for
+   * it. Smaller data sets are intersected cell by cell. Default is 1000.
+   */
+  vtkSetClampMacro(CellLocatorCacheMinimumNumberOfCells, vtkIdType, 0, VTK_ID_MAX);
+  vtkGetMacro(CellLocatorCacheMinimumNumberOfCells, vtkIdType);
+  ///@}
+
+  /**
+   * Release all the locators cached by the picker.
+   */
+  void ClearCellLocatorCache();
+
+  /**
+   * Perform a pick for each of the selection points of the given array, whose
+   * tuples are (x, y, z) display positions as for Pick(). The id of the picked
+   * cell, or -1, and the pick position of each pick are stored in the cellIds
+   * and pickPositions arrays, which are resized to the number of selection
+   * points. Either array may be nullptr. Batches of picks benefit from the
+   * cell locator cache, only the first pick builds the locators. The pick
+   * information of the last pick is kept by the picker. Returns the number of
+   * successful picks.
+   */
+  vtkIdType PickBatch(vtkDataArray* selectionPoints, vtkRenderer* renderer,
+    vtkIdTypeArray* cellIds, vtkDoubleArray* pickPositions);
+
   ///@{
   /**
    * Set the opacity isovalue to use for defining volume surfaces.  The
@@ -302,6 +346,8 @@ protected:
     vtkPiecewiseFunction* gradientOpacity);
 
   vtkCollection* Locators;
+  vtkTypeBool UseCellLocatorCache;
+  vtkIdType CellLocatorCacheMinimumNumberOfCells;
 
   double VolumeOpacityIsovalue;
   vtkTypeBool UseVolumeGradientOpacity;
@@ -332,6 +378,9 @@ private:
   vtkIdList* PointIds;       // used to accelerate picking
   vtkDoubleArray* Gradients; // used in volume picking
 
+  class vtkCellLocatorCache;
+  std::unique_ptr<vtkCellLocatorCache> CellLocatorCache;
+
   vtkCellPicker(const vtkCellPicker&) = delete;
   void operator=(const vtkCellPicker&) = delete;
 };
@@ -6,6 +6,7 @@
 #include "vtkDoubleArray.h"
 #include "vtkMath.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
 
 #include <algorithm>
 #include <cmath>
@@ -1770,6 +1771,21 @@ void vtkColorTransferFunctionIndexedMapData(vtkColorTransferFunction* self, T* i
   } // alpha blending
 }
 
+//------------------------------------------------------------------------------
+// Every value is mapped independently, so chunks of values are mapped in
+// parallel with the serial functions above, which keeps the output identical.
+// The output format is also the number of output components.
+template <class T, class Kernel>
+void vtkColorTransferFunctionMapInParallel(
+  T* input, unsigned char* output, int length, int inIncr, int outFormat, Kernel&& kernel)
+{
+  vtkSMPTools::For(0, length, 10000,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      kernel(input + begin * inIncr, output + begin * outFormat, static_cast<int>(end - begin));
+    });
+}
+
 //------------------------------------------------------------------------------
 void vtkColorTransferFunction::MapScalarsThroughTable2(void* input, unsigned char* output,
   int inputDataType, int numberOfValues, int inputIncrement, int outputFormat)
@@ -1784,8 +1800,12 @@ void vtkColorTransferFunction::MapScalarsThroughTable2(void* input, unsigned cha
     switch (inputDataType)
     {
       // Use vtkExtendedTemplateMacro to cover case of VTK_STRING input
-      vtkExtendedTemplateMacro(vtkColorTransferFunctionIndexedMapData(this,
-        static_cast<VTK_TT*>(input), output, numberOfValues, inputIncrement, outputFormat, 1));
+      vtkExtendedTemplateMacro(vtkColorTransferFunctionMapInParallel(static_cast<VTK_TT*>(input),
+        output, numberOfValues, inputIncrement, outputFormat,
+        [&](VTK_TT* in, unsigned char* out, int length) {
+          vtkColorTransferFunctionIndexedMapData(
+            this, in, out, length, inputIncrement, outputFormat, 1);
+        }));
 
       default:
         vtkErrorMacro(<< "MapImageThroughTable: Unknown input ScalarType");
@@ -1794,10 +1814,23 @@ void vtkColorTransferFunction::MapScalarsThroughTable2(void* input, unsigned cha
   }
   else
   {
+    // build the tables used for 8 and 16 bit inputs before mapping in parallel
+    if (inputDataType == VTK_UNSIGNED_CHAR)
+    {
+      this->GetTable(0, 255, 256);
+    }
+    else if (inputDataType == VTK_UNSIGNED_SHORT)
+    {
+      this->GetTable(0, 65535, 65536);
+    }
+
     switch (inputDataType)
     {
-      vtkTemplateMacro(vtkColorTransferFunctionMapData(this, static_cast<VTK_TT*>(input), output,
-        numberOfValues, inputIncrement, outputFormat, 1));
+      vtkTemplateMacro(vtkColorTransferFunctionMapInParallel(static_cast<VTK_TT*>(input), output,
+        numberOfValues, inputIncrement, outputFormat,
+        [&](VTK_TT* in, unsigned char* out, int length) {
+          vtkColorTransferFunctionMapData(this, in, out, length, inputIncrement, outputFormat, 1);
+        }));
       default:
         vtkErrorMacro(<< "MapImageThroughTable: Unknown input ScalarType");
         return;
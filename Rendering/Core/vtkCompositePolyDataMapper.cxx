@@ -167,6 +167,8 @@ void vtkCompositePolyDataMapper::ShallowCopy(vtkAbstractMapper* mapper)
   {
     this->SetCompositeDataDisplayAttributes(cpdm->GetCompositeDataDisplayAttributes());
     this->SetColorMissingArraysWithNanColor(cpdm->GetColorMissingArraysWithNanColor());
+    this->SetBlockCulling(cpdm->GetBlockCulling());
+    this->SetMinimumBlockCoverage(cpdm->GetMinimumBlockCoverage());
     this->SetCompositeIdArrayName(cpdm->GetCompositeIdArrayName());
   }
   // Now do superclass
@@ -227,6 +229,9 @@ void vtkCompositePolyDataMapper::SetPauseShiftScale(bool pauseShiftScale)
 void vtkCompositePolyDataMapper::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "BlockCulling: " << this->BlockCulling << endl;
+  os << indent << "MinimumBlockCoverage: " << this->MinimumBlockCoverage << endl;
+  os << indent << "NumberOfCulledBlocks: " << this->NumberOfCulledBlocks << endl;
 }
 
 //------------------------------------------------------------------------------
@@ -433,10 +438,12 @@ void vtkCompositePolyDataMapper::Render(vtkRenderer* renderer, vtkActor* actor)
     delegators.emplace_back(pair.second);
   }
   this->PreRender(delegators, renderer, actor);
+  this->NumberOfCulledBlocks = 0;
   for (auto& iter : internals.BatchedDelegators)
   {
     auto& delegator = iter.second;
     delegator->GetDelegate()->RenderPiece(renderer, actor);
+    this->NumberOfCulledBlocks += delegator->GetNumberOfCulledBlocks();
 
     for (auto& polydata : delegator->GetRenderedList())
     {
@@ -192,6 +192,35 @@ public:
   vtkBooleanMacro(ColorMissingArraysWithNanColor, bool);
   ///@}
 
+  ///@{
+  /**
+   * When on, blocks whose bounds are outside of the view frustum are not
+   * drawn. The block bounds are kept in a bounding volume hierarchy so that
+   * groups of blocks are culled together, which pays off for datasets with
+   * thousands of blocks. Default is false.
+   */
+  vtkSetMacro(BlockCulling, bool);
+  vtkGetMacro(BlockCulling, bool);
+  vtkBooleanMacro(BlockCulling, bool);
+  ///@}
+
+  ///@{
+  /**
+   * Blocks whose projected bounds cover less than this fraction of the
+   * viewport are not drawn. It is a cheap level of detail for datasets with
+   * many small blocks, only used when BlockCulling is on and ignored while
+   * selecting. Default is 0, i.e. only the frustum culling is done.
+   */
+  vtkSetClampMacro(MinimumBlockCoverage, double, 0.0, 1.0);
+  vtkGetMacro(MinimumBlockCoverage, double);
+  ///@}
+
+  /**
+   * Number of blocks that were not drawn by the last render because of
+   * BlockCulling.
+   */
+  vtkGetMacro(NumberOfCulledBlocks, vtkIdType);
+
   ///@{
   /**
    * Call SetInputArrayToProcess on helpers.
@@ -317,6 +346,10 @@ protected:
    */
   bool ColorMissingArraysWithNanColor = false;
 
+  bool BlockCulling = false;
+  double MinimumBlockCoverage = 0.0;
+  vtkIdType NumberOfCulledBlocks = 0;
+
   /**
    * Time stamp for computation of bounds.
    */
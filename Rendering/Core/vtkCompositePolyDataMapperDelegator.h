@@ -104,6 +104,13 @@ public:
    */
   virtual std::vector<vtkPolyData*> GetRenderedList() const = 0;
 
+  /**
+   * Number of blocks the delegate did not draw in the last render because
+   * of the BlockCulling of the parent mapper. 0 for delegates which do not
+   * cull blocks.
+   */
+  virtual vtkIdType GetNumberOfCulledBlocks() const { return 0; }
+
   /**
    * Assign a parent mapper. The parent enables delegates to access
    * higher level attributes.
@@ -7,6 +7,7 @@
 #include "vtkMath.h"
 #include "vtkObjectFactory.h"
 #include "vtkPiecewiseFunction.h"
+#include "vtkSMPTools.h"
 #include "vtkTemplateAliasMacro.h"
 #include "vtkTuple.h"
 #include "vtkUnsignedCharArray.h"
@@ -387,6 +388,21 @@ static void vtkDiscretizableColorTransferFunctionMapOpacity(
   }
 }
 
+//------------------------------------------------------------------------------
+// Opacities are mapped in parallel chunks like the colors.
+template <class T>
+static void vtkDiscretizableColorTransferFunctionMapOpacityInParallel(
+  vtkDiscretizableColorTransferFunction* self, T* input, unsigned char* output, int length,
+  int inIncr, int outFormat)
+{
+  vtkSMPTools::For(0, length, 10000,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      vtkDiscretizableColorTransferFunctionMapOpacity(self, input + begin * inIncr,
+        output + begin * outFormat, static_cast<int>(end - begin), inIncr, outFormat);
+    });
+}
+
 //------------------------------------------------------------------------------
 void vtkDiscretizableColorTransferFunction::MapScalarsThroughTable2(void* input,
   unsigned char* output, int inputDataType, int numberOfValues, int inputIncrement,
@@ -410,7 +426,7 @@ void vtkDiscretizableColorTransferFunction::MapScalarsThroughTable2(void* input,
   {
     switch (inputDataType)
     {
-      vtkTemplateMacro(vtkDiscretizableColorTransferFunctionMapOpacity(
+      vtkTemplateMacro(vtkDiscretizableColorTransferFunctionMapOpacityInParallel(
         this, static_cast<VTK_TT*>(input), output, numberOfValues, inputIncrement, outputFormat));
       default:
         vtkErrorMacro(<< "MapImageThroughTable: Unknown input ScalarType");
@@ -28,6 +28,7 @@
 #include "vtkTimerLog.h"
 #include "vtkVector.h"
 
+#include <algorithm>
 #include <sstream>
 
 VTK_ABI_NAMESPACE_BEGIN
@@ -55,6 +56,10 @@ vtkRenderer::vtkRenderer()
 
   this->AllocatedRenderTime = 100;
   this->TimeFactor = 1.0;
+  this->ProgressiveRendering = 0;
+  this->ProgressiveTimeBudget = 1.0;
+  this->ProgressiveRefinementFactor = 4.0;
+  this->ProgressiveRenderTime = 0.0;
 
   this->CreatedLight = nullptr;
   this->AutomaticLightCreation = 1;
@@ -323,6 +328,15 @@ void vtkRenderer::Render()
     }
   }
 
+  if (this->ProgressiveRendering)
+  {
+    this->UpdateProgressiveRenderTime();
+  }
+  else
+  {
+    this->ProgressiveRenderTime = this->AllocatedRenderTime;
+  }
+
   timer->MarkStartEvent("Culling props");
 
   // Create the initial list of visible props
@@ -422,11 +436,44 @@ void vtkRenderer::Render()
     {
       this->LastRenderTimeInSeconds = 0.0001;
     }
-    this->TimeFactor = this->AllocatedRenderTime / this->LastRenderTimeInSeconds;
+    this->TimeFactor = this->ProgressiveRenderTime / this->LastRenderTimeInSeconds;
   }
+  this->ProgressiveRenderTimeStamp.Modified();
   this->InvokeEvent(vtkCommand::EndEvent, nullptr);
 }
 
+//------------------------------------------------------------------------------
+void vtkRenderer::UpdateProgressiveRenderTime()
+{
+  // the view changed if the camera or a visible prop was modified since the
+  // last render, in which case the refinement starts over
+  bool viewChanged = this->ProgressiveRenderTime <= 0.0 ||
+    (this->ActiveCamera && this->ActiveCamera->GetMTime() > this->ProgressiveRenderTimeStamp);
+  vtkProp* aProp;
+  vtkCollectionSimpleIterator pit;
+  for (this->Props->InitTraversal(pit); !viewChanged && (aProp = this->Props->GetNextProp(pit));)
+  {
+    viewChanged = aProp->GetVisibility() &&
+      aProp->GetRedrawMTime() > this->ProgressiveRenderTimeStamp;
+  }
+
+  if (viewChanged)
+  {
+    this->ProgressiveRenderTime = std::min(this->AllocatedRenderTime, this->ProgressiveTimeBudget);
+  }
+  else
+  {
+    this->ProgressiveRenderTime = std::min(
+      this->ProgressiveRenderTime * this->ProgressiveRefinementFactor, this->ProgressiveTimeBudget);
+  }
+}
+
+//------------------------------------------------------------------------------
+bool vtkRenderer::GetProgressiveRefinementNeeded()
+{
+  return this->ProgressiveRendering && this->ProgressiveRenderTime < this->ProgressiveTimeBudget;
+}
+
 //------------------------------------------------------------------------------
 void vtkRenderer::DeviceRenderOpaqueGeometry(vtkFrameBufferObjectBase* vtkNotUsed(fbo))
 {
@@ -600,7 +647,7 @@ void vtkRenderer::AllocateTime()
     // We need to divide by total time so that the total rendering time
     // (all prop's AllocatedRenderTime added together) would be equal
     // to the renderer's AllocatedRenderTime.
-    aProp->SetAllocatedRenderTime((renderTime / totalTime) * this->AllocatedRenderTime, this);
+    aProp->SetAllocatedRenderTime((renderTime / totalTime) * this->ProgressiveRenderTime, this);
   }
 }
 
@@ -728,9 +775,20 @@ int vtkRenderer::UpdateTranslucentPolygonalGeometry()
 int vtkRenderer::UpdateOpaquePolygonalGeometry()
 {
   int result = 0;
+  vtkRenderTimerLog* timer = this->RenderWindow->GetRenderTimer();
+  // the event names are only built when the timer records them
+  const bool logProps = timer->GetLoggingEnabled();
   for (int i = 0; i < this->PropArrayCount; i++)
   {
-    result += this->PropArray[i]->RenderOpaqueGeometry(this);
+    vtkProp* prop = this->PropArray[i];
+    vtkRenderTimerLog::ScopedEventLogger propEvent;
+    if (logProps)
+    {
+      std::ostringstream eventName;
+      eventName << prop->GetClassName() << "::RenderOpaqueGeometry this=@" << std::hex << prop;
+      propEvent = timer->StartScopedEvent(eventName.str());
+    }
+    result += prop->RenderOpaqueGeometry(this);
   }
   this->NumberOfPropsRendered += result;
   return result;
@@ -1777,6 +1835,10 @@ void vtkRenderer::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Interactive = " << (this->Interactive ? "On" : "Off") << "\n";
 
   os << indent << "Allocated Render Time: " << this->AllocatedRenderTime << "\n";
+  os << indent << "ProgressiveRendering: " << (this->ProgressiveRendering ? "On" : "Off") << "\n";
+  os << indent << "ProgressiveTimeBudget: " << this->ProgressiveTimeBudget << "\n";
+  os << indent << "ProgressiveRefinementFactor: " << this->ProgressiveRefinementFactor << "\n";
+  os << indent << "ProgressiveRenderTime: " << this->ProgressiveRenderTime << "\n";
 
   os << indent << "Last Time To Render (Seconds): " << this->LastRenderTimeInSeconds << endl;
   os << indent << "TimeFactor: " << this->TimeFactor << endl;
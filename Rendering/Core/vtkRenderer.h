@@ -275,6 +275,54 @@ public:
   virtual double GetAllocatedRenderTime();
   ///@}
 
+  ///@{
+  /**
+   * Turn on/off progressive rendering. When on, the first render after the
+   * camera or a visible prop changed is given the AllocatedRenderTime (i.e.
+   * the interactive budget set by the render window), and each following
+   * render of the same view multiplies the time given to the props by
+   * ProgressiveRefinementFactor, until ProgressiveTimeBudget is reached. The
+   * level of detail props (vtkLODActor, vtkLODProp3D, ...) use the larger
+   * budgets to switch to their finer levels. Call Render() while
+   * GetProgressiveRefinementNeeded() is true, from an idle or a timer callback,
+   * to refine the image. Default is off.
+   */
+  vtkSetMacro(ProgressiveRendering, vtkTypeBool);
+  vtkGetMacro(ProgressiveRendering, vtkTypeBool);
+  vtkBooleanMacro(ProgressiveRendering, vtkTypeBool);
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get the time, in seconds, allowed to the last refinement render of a
+   * view in progressive rendering. Default is 1 second.
+   */
+  vtkSetClampMacro(ProgressiveTimeBudget, double, 0.0, VTK_DOUBLE_MAX);
+  vtkGetMacro(ProgressiveTimeBudget, double);
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get how much the render time is increased between two renders of the
+   * same view in progressive rendering. Default is 4.
+   */
+  vtkSetClampMacro(ProgressiveRefinementFactor, double, 1.0, VTK_DOUBLE_MAX);
+  vtkGetMacro(ProgressiveRefinementFactor, double);
+  ///@}
+
+  /**
+   * Get the time, in seconds, given to the props for the last render. It is the
+   * AllocatedRenderTime unless progressive rendering is on.
+   */
+  vtkGetMacro(ProgressiveRenderTime, double);
+
+  /**
+   * Return true when progressive rendering is on and the last render was not
+   * given the full ProgressiveTimeBudget, i.e. rendering again the same view
+   * would refine the image.
+   */
+  bool GetProgressiveRefinementNeeded();
+
   /**
    * Get the ratio between allocated time and actual render time.
    * TimeFactor has been taken out of the render process.
@@ -956,6 +1004,11 @@ protected:
   vtkRenderWindow* RenderWindow;
   double AllocatedRenderTime;
   double TimeFactor;
+  vtkTypeBool ProgressiveRendering;
+  double ProgressiveTimeBudget;
+  double ProgressiveRefinementFactor;
+  double ProgressiveRenderTime;
+  vtkTimeStamp ProgressiveRenderTimeStamp;
   vtkTypeBool TwoSidedLighting;
   vtkTypeBool AutomaticLightCreation;
   vtkTypeBool BackingStore;
@@ -967,6 +1020,12 @@ protected:
 
   vtkTypeBool LightFollowCamera;
 
+  /**
+   * Compute ProgressiveRenderTime, the time given to the props for the current
+   * render, from the changes made since the last render.
+   */
+  void UpdateProgressiveRenderTime();
+
   // Allocate the time for each prop
   void AllocateTime();
 
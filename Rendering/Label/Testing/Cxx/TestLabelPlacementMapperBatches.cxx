@@ -0,0 +1,209 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Checks that vtkLabelPlacementMapper places the same labels when they are tested for conflicts
+// by batches as when they are placed one at a time, and that the placement is only reused while
+// the labels move by less than the PlacementReuseTolerance.
+
+#include "vtkActor2D.h"
+#include "vtkCamera.h"
+#include "vtkDoubleArray.h"
+#include "vtkLabelPlacementMapper.h"
+#include "vtkLabelRenderStrategy.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPointSetToLabelHierarchy.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkRenderWindow.h"
+#include "vtkRenderer.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkStringArray.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <string>
+
+namespace
+{
+// Gives every character of the labels the same size and records the rendered labels instead of
+// drawing them.
+class vtkRecordingLabelRenderStrategy : public vtkLabelRenderStrategy
+{
+public:
+  static vtkRecordingLabelRenderStrategy* New();
+  vtkTypeMacro(vtkRecordingLabelRenderStrategy, vtkLabelRenderStrategy);
+
+  void ComputeLabelBounds(vtkTextProperty*, vtkStdString label, double bds[4]) override
+  {
+    ++this->NumberOfBoundsComputed;
+    bds[0] = 0.;
+    bds[1] = 6. * label.size();
+    bds[2] = 0.;
+    bds[3] = 10.;
+  }
+
+  void RenderLabel(int x[2], vtkTextProperty*, vtkStdString label) override
+  {
+    this->Labels[label] = { x[0], x[1] };
+  }
+
+  void StartFrame() override
+  {
+    this->Labels.clear();
+    this->NumberOfBoundsComputed = 0;
+  }
+
+  // display position of the labels rendered by the last frame
+  std::map<std::string, std::pair<int, int>> Labels;
+  int NumberOfBoundsComputed = 0;
+
+protected:
+  vtkRecordingLabelRenderStrategy() = default;
+  ~vtkRecordingLabelRenderStrategy() override = default;
+
+private:
+  vtkRecordingLabelRenderStrategy(const vtkRecordingLabelRenderStrategy&) = delete;
+  void operator=(const vtkRecordingLabelRenderStrategy&) = delete;
+};
+vtkStandardNewMacro(vtkRecordingLabelRenderStrategy);
+
+// Labels with random priorities scattered over the unit square, which is viewed by a 400x400
+// window, so that most of them overlap.
+vtkSmartPointer<vtkPolyData> MakeLabeledPoints()
+{
+  const int numberOfLabels = 5000;
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkStringArray> labels;
+  labels->SetName("labels");
+  vtkNew<vtkDoubleArray> priorities;
+  priorities->SetName("priority");
+  for (int i = 0; i < numberOfLabels; ++i)
+  {
+    double x = random->GetNextValue();
+    double y = random->GetNextValue();
+    points->InsertNextPoint(x, y, 0.);
+    labels->InsertNextValue("L" + std::to_string(i));
+    priorities->InsertNextValue(random->GetNextValue());
+  }
+  auto labeledPoints = vtkSmartPointer<vtkPolyData>::New();
+  labeledPoints->SetPoints(points);
+  labeledPoints->GetPointData()->AddArray(labels);
+  labeledPoints->GetPointData()->AddArray(priorities);
+  return labeledPoints;
+}
+
+struct Scene
+{
+  vtkNew<vtkRenderWindow> RenderWindow;
+  vtkNew<vtkRenderer> Renderer;
+  vtkNew<vtkPointSetToLabelHierarchy> Hierarchy;
+  vtkNew<vtkLabelPlacementMapper> Mapper;
+  vtkNew<vtkRecordingLabelRenderStrategy> Strategy;
+  vtkNew<vtkActor2D> Actor;
+
+  Scene(vtkPolyData* labeledPoints)
+  {
+    this->Hierarchy->AddInputData(labeledPoints);
+    this->Hierarchy->SetLabelArrayName("labels");
+    this->Hierarchy->SetPriorityArrayName("priority");
+    this->Hierarchy->SetMaximumDepth(5);
+    this->Hierarchy->SetTargetLabelCount(32);
+    this->Mapper->SetInputConnection(this->Hierarchy->GetOutputPort());
+    this->Mapper->SetRenderStrategy(this->Strategy);
+    this->Actor->SetMapper(this->Mapper);
+    this->Renderer->AddActor(this->Actor);
+    this->RenderWindow->SetSize(400, 400);
+    this->RenderWindow->AddRenderer(this->Renderer);
+
+    vtkCamera* camera = this->Renderer->GetActiveCamera();
+    camera->ParallelProjectionOn();
+    camera->SetParallelScale(0.5);
+    this->Pan(0.);
+  }
+
+  // Center the view dx pixels right of the center of the unit square.
+  void Pan(double dx)
+  {
+    vtkCamera* camera = this->Renderer->GetActiveCamera();
+    camera->SetFocalPoint(0.5 + dx / 400., 0.5, 0.);
+    camera->SetPosition(0.5 + dx / 400., 0.5, 1.);
+    camera->SetViewUp(0., 1., 0.);
+    camera->SetClippingRange(0.1, 10.);
+  }
+};
+}
+
+int TestLabelPlacementMapperBatches(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  int res = EXIT_SUCCESS;
+  vtkSmartPointer<vtkPolyData> labeledPoints = MakeLabeledPoints();
+
+  // labels placed one at a time
+  Scene greedy(labeledPoints);
+  greedy.Mapper->SetPlacementBatchSize(1);
+  greedy.RenderWindow->Render();
+  const auto& expected = greedy.Strategy->Labels;
+  if (expected.size() < 10 || expected.size() >= 1000)
+  {
+    std::cerr << "Placed " << expected.size() << " labels, the scene does not test the conflicts"
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // labels placed by batches, with several threads
+  for (int batchSize : { 7, 256 })
+  {
+    vtkSMPTools::LocalScope(vtkSMPTools::Config{ 4 },
+      [&]()
+      {
+        Scene batched(labeledPoints);
+        batched.Mapper->SetPlacementBatchSize(batchSize);
+        batched.RenderWindow->Render();
+        if (batched.Strategy->Labels != expected)
+        {
+          std::cerr << "Batches of " << batchSize << " labels placed "
+                    << batched.Strategy->Labels.size() << " labels instead of the "
+                    << expected.size() << " labels placed one at a time" << std::endl;
+          res = EXIT_FAILURE;
+        }
+      });
+  }
+
+  // The placement is reused while the labels move by less than the tolerance.
+  Scene reused(labeledPoints);
+  reused.Mapper->SetPlacementReuseTolerance(5.);
+  reused.RenderWindow->Render();
+  auto placed = reused.Strategy->Labels;
+  reused.Pan(2.);
+  reused.RenderWindow->Render();
+  bool sameLabels = reused.Strategy->Labels.size() == placed.size();
+  for (const auto& label : reused.Strategy->Labels)
+  {
+    auto it = placed.find(label.first);
+    sameLabels = sameLabels && it != placed.end() &&
+      std::abs(label.second.first - it->second.first + 2) <= 1 &&
+      label.second.second == it->second.second;
+  }
+  if (reused.Strategy->NumberOfBoundsComputed != 0 || !sameLabels)
+  {
+    std::cerr << "The placement was not reused after moving the labels by 2 pixels" << std::endl;
+    res = EXIT_FAILURE;
+  }
+
+  // and recomputed once they moved by more.
+  reused.Pan(20.);
+  reused.RenderWindow->Render();
+  if (reused.Strategy->NumberOfBoundsComputed == 0 || reused.Strategy->Labels == placed)
+  {
+    std::cerr << "The placement was reused after moving the labels by 20 pixels" << std::endl;
+    res = EXIT_FAILURE;
+  }
+
+  return res;
+}
@@ -23,11 +23,13 @@
 #include "vtkPolyData.h"
 #include "vtkPythagoreanQuadruples.h"
 #include "vtkRenderer.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkTextProperty.h"
 
 #include <deque>
 #include <map>
+#include <numeric>
 #include <octree/octree>
 #include <set>
 #include <vector>
@@ -2378,9 +2380,33 @@ void vtkLabelHierarchy::Implementation::PrepareSortedAnchors(LabelSet& anchors)
 {
   anchors.clear();
   vtkIdType npts = this->Husk->GetPoints()->GetNumberOfPoints();
-  for (vtkIdType i = 0; i < npts; ++i)
+  std::vector<vtkIdType> sorted(npts);
+  std::iota(sorted.begin(), sorted.end(), 0);
+
+  // Cache the priorities and sort the anchors in parallel, so that they can be
+  // appended to the set in linear time instead of being inserted one by one.
+  this->PriorityValues.clear();
+  vtkDataArray* priorities = this->Husk->GetPriorities();
+  if (priorities)
+  {
+    this->PriorityValues.resize(npts);
+    vtkSMPTools::For(0, npts,
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        for (vtkIdType i = begin; i < end; ++i)
+        {
+          this->PriorityValues[i] = priorities->GetComponent(i, 0);
+        }
+      });
+    // Anchors with the same priority keep their id order, as they would in the multiset.
+    const std::vector<double>& values = this->PriorityValues;
+    vtkSMPTools::Sort(sorted.begin(), sorted.end(),
+      [&values](vtkIdType a, vtkIdType b)
+      { return values[a] > values[b] || (values[a] == values[b] && a < b); });
+  }
+  for (vtkIdType anchor : sorted)
   {
-    anchors.insert(i);
+    anchors.insert(anchors.end(), anchor);
   }
 }
 
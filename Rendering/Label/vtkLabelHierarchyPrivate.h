@@ -4,6 +4,7 @@
 #define vtkLabelHierarchyPrivate_h
 
 #include <set>
+#include <vector>
 
 #include "octree/octree"
 
@@ -30,6 +31,10 @@ public:
 
   bool ComparePriorities(vtkIdType a, vtkIdType b)
   {
+    if (!this->PriorityValues.empty())
+    {
+      return this->PriorityValues[a] > this->PriorityValues[b];
+    }
     vtkDataArray* priorities = this->Husk->GetPriorities();
     return priorities ? priorities->GetTuple1(a) > priorities->GetTuple1(b) : a < b;
   }
@@ -185,6 +190,9 @@ public:
     Hierarchy3; // 3-D octree of label anchors (input point bounds have non-zero z range)
   vtkTimeStamp HierarchyTime;
   HierarchyType3::size_type ActualDepth;
+  // Priority of each anchor, cached while building the hierarchy so that the
+  // comparisons do not go through the virtual vtkDataArray API.
+  std::vector<double> PriorityValues;
   vtkLabelHierarchy* Husk;
 
   static vtkLabelHierarchy* Current;
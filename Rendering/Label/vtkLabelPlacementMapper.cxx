@@ -16,6 +16,7 @@
 #include "vtkLabelRenderStrategy.h"
 #include "vtkLabeledDataMapper.h"
 #include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPoints.h"
 #include "vtkPolyDataMapper.h"
@@ -23,12 +24,17 @@
 #include "vtkProperty2D.h"
 #include "vtkRenderWindow.h"
 #include "vtkRenderer.h"
+#include "vtkSMPTools.h"
 #include "vtkSelectVisiblePoints.h"
 #include "vtkSmartPointer.h"
 #include "vtkTextProperty.h"
 #include "vtkTimerLog.h"
 #include "vtkTransformCoordinateSystems.h"
 
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
 // From: http://www.flipcode.com/archives/2D_OBB_Intersection.shtml
 VTK_ABI_NAMESPACE_BEGIN
 class LabelRect
@@ -309,15 +315,16 @@ public:
   struct ScreenTile
   {
     std::vector<LabelRect> Labels;
+    /// Number of labels in the tile when the current batch of labels started.
+    size_t BatchStart = 0;
     ScreenTile() = default;
     /// Is there space to place the given rectangle in this tile so that it doesn't overlap any
-    /// labels in this tile?
-    bool IsSpotOpen(const LabelRect& r)
+    /// labels in this tile? Only the labels from index start onwards are tested.
+    bool IsSpotOpen(const LabelRect& r, size_t start = 0) const
     {
-      for (std::vector<LabelRect>::iterator it = this->Labels.begin(); it != this->Labels.end();
-           ++it)
+      for (size_t i = start; i < this->Labels.size(); ++i)
       {
-        if (r.Overlaps(*it))
+        if (r.Overlaps(this->Labels[i]))
         {
           return false;
         }
@@ -326,9 +333,45 @@ public:
     }
 
     /// Prepare for the next frame.
-    void Reset() { this->Labels.clear(); }
+    void Reset()
+    {
+      this->Labels.clear();
+      this->BatchStart = 0;
+    }
     void Insert(const LabelRect& rect) { this->Labels.push_back(rect); }
   };
+
+  /// A label that was rendered, kept so it can be rendered again while the camera barely moves.
+  struct PlacedLabel
+  {
+    vtkLabelHierarchy* Hierarchy;
+    vtkIdType LabelId;
+    vtkIdType Type;
+    vtkStdString Label;
+    double Anchor[3];
+    int Origin[2];
+    double LabelBounds[4];
+    double Orientation;
+    /// Maximum width of labels with a bounded size, -1 for labels placed in the tiles.
+    int BoundedWidth;
+  };
+
+  /// A label waiting for its conflict tests, which are done for a batch of labels at once.
+  struct Candidate
+  {
+    PlacedLabel Label;
+    LabelRect Rect;
+    int TileRange[4];
+    bool Open;
+
+    Candidate(const PlacedLabel& label, const LabelRect& rect)
+      : Label(label)
+      , Rect(rect)
+      , Open(false)
+    {
+    }
+  };
+
   std::vector<std::vector<ScreenTile>> Tiles;
   float ScreenOrigin[2];
   float TileSize[2];
@@ -336,6 +379,13 @@ public:
   vtkSmartPointer<vtkIdTypeArray> NewLabelsPlaced;
   vtkSmartPointer<vtkIdTypeArray> LastLabelsPlaced;
 
+  // The labels rendered by the last full placement and what they depend on.
+  std::vector<PlacedLabel> Placement;
+  std::vector<vtkDataObject*> PlacementInputs;
+  float PlacementViewport[4];
+  vtkTimeStamp PlacementTime;
+  bool PlacementValid = false;
+
   Internal(float viewport[4], float tilesize[2])
   {
     this->NewLabelsPlaced = vtkSmartPointer<vtkIdTypeArray>::New();
@@ -351,9 +401,10 @@ public:
       this->Tiles[i].resize(this->NumTiles[1]);
   }
 
-  bool PlaceLabel(const LabelRect& r)
+  /// Compute the range of tiles intersected by a label. Returns false if the label is not on
+  /// the screen.
+  bool GetTileRange(const LabelRect& r, int range[4]) const
   {
-    // Determine intersected tiles
     float rx0 = r.Bounds[0] / TileSize[0];
     float rx1 = r.Bounds[1] / TileSize[0];
     float ry0 = r.Bounds[2] / TileSize[1];
@@ -364,46 +415,171 @@ public:
     int ty1 = static_cast<int>(ceil(ry1));
     if (tx0 > NumTiles[0] || tx1 < 0 || ty0 > NumTiles[1] || ty1 < 0)
       return false; // Don't intersect screen.
-    if (tx0 < 0)
+    range[0] = tx0 < 0 ? 0 : tx0;
+    range[1] = tx1 >= this->NumTiles[0] ? this->NumTiles[0] - 1 : tx1;
+    range[2] = ty0 < 0 ? 0 : ty0;
+    range[3] = ty1 >= this->NumTiles[1] ? this->NumTiles[1] - 1 : ty1;
+    return true;
+  }
+
+  /// Check all the tiles of a range for overlap. When inBatch is true, only the labels
+  /// inserted since the start of the current batch are tested. This method does not modify
+  /// the tiles, so it may be called from several threads at once.
+  bool IsSpotOpen(const LabelRect& r, const int range[4], bool inBatch = false) const
+  {
+    for (int tx = range[0]; tx <= range[1]; ++tx)
+    {
+      for (int ty = range[2]; ty <= range[3]; ++ty)
+      {
+        const ScreenTile& tile = this->Tiles[tx][ty];
+        if (!tile.IsSpotOpen(r, inBatch ? tile.BatchStart : 0))
+          return false;
+      }
+    }
+    return true;
+  }
+
+  /// Add a label to each tile of a range.
+  void Insert(const LabelRect& r, const int range[4])
+  {
+    for (int tx = range[0]; tx <= range[1]; ++tx)
+    {
+      for (int ty = range[2]; ty <= range[3]; ++ty)
+      {
+        this->Tiles[tx][ty].Insert(r);
+      }
+    }
+  }
+
+  /// Remember the number of labels in each tile before placing a batch of labels.
+  void StartBatch()
+  {
+    for (int tx = 0; tx < this->NumTiles[0]; ++tx)
+      for (int ty = 0; ty < this->NumTiles[1]; ++ty)
+        this->Tiles[tx][ty].BatchStart = this->Tiles[tx][ty].Labels.size();
+  }
+
+  /// The rectangle covered by a label, translated to the origin of the screen to simplify
+  /// bucketing.
+  LabelRect GetLabelRect(const int origin[2], const double bds[4], double orientation) const
+  {
+    // Offset display position by lower left corner of bounding box
+    int dispx[2];
+    dispx[0] = static_cast<int>(origin[0] + bds[0]);
+    dispx[1] = static_cast<int>(origin[1] + bds[2]);
+
+    double xTrans[4];
+    xTrans[0] = dispx[0] - this->ScreenOrigin[0];
+    xTrans[1] = dispx[0] + fabs(bds[1] - bds[0]) - this->ScreenOrigin[0];
+    xTrans[2] = dispx[1] - this->ScreenOrigin[1];
+    xTrans[3] = dispx[1] + fabs(bds[3] - bds[2]) - this->ScreenOrigin[1];
+
+    double originTrans[2];
+    originTrans[0] = origin[0] - this->ScreenOrigin[0];
+    originTrans[1] = origin[1] - this->ScreenOrigin[1];
+
+    return LabelRect(xTrans, originTrans, vtkMath::RadiansFromDegrees(orientation));
+  }
+
+  /// Render a label and its background at the given display position.
+  void RenderLabel(vtkLabelPlacementMapper* self, vtkRenderer* ren, const PlacedLabel& label,
+    int origin[2], vtkTextProperty* tprop) const
+  {
+    tprop->ShallowCopy(label.Hierarchy->GetTextProperty());
+    if (self->RenderStrategy->SupportsRotation() && label.Hierarchy->GetOrientations())
     {
-      tx0 = 0;
-      rx0 = 0.;
+      tprop->SetOrientation(label.Orientation);
     }
-    if (ty0 < 0)
+
+    if (label.BoundedWidth >= 0)
     {
-      ty0 = 0;
-      ry0 = 0.;
+      self->RenderStrategy->RenderLabel(origin, tprop, label.Label, label.BoundedWidth);
+      return;
     }
-    if (tx1 >= this->NumTiles[0])
+
+    LabelRect r = this->GetLabelRect(origin, label.LabelBounds, label.Orientation);
+    r.Render(ren, self->Shape, self->Style, self->Margin, self->BackgroundColor,
+      self->BackgroundOpacity);
+    if (label.Type == 0)
     {
-      tx1 = this->NumTiles[0] - 1;
-      rx1 = tx1;
+      // label is text
+      self->RenderStrategy->RenderLabel(origin, tprop, label.Label);
+
+      // TODO: 1. Perturb coincident points.
+      //       2. Use GeneratePerturbedLabelSpokes to possibly render perturbed points.
     }
-    if (ty1 >= this->NumTiles[1])
+    else
+    { // label is an icon
+      // TODO: Do something ...
+    }
+  }
+
+  /// Render the labels of the last full placement again if neither the input nor the
+  /// viewport changed since, and if none of them moved by more than the reuse tolerance.
+  bool RenderLastPlacement(
+    vtkLabelPlacementMapper* self, vtkRenderer* ren, vtkCamera* cam, const float viewport[4])
+  {
+    if (!this->PlacementValid || self->PlacementReuseTolerance <= 0. || self->UseDepthBuffer ||
+      self->OutputTraversedBounds || self->GetMTime() > this->PlacementTime)
     {
-      ty1 = this->NumTiles[1] - 1;
-      ry1 = ty1;
+      return false;
     }
-    // Check all applicable tiles for overlap.
-    for (int tx = tx0; tx <= tx1; ++tx)
+    for (int i = 0; i < 4; ++i)
     {
-      for (int ty = ty0; ty <= ty1; ++ty)
+      if (viewport[i] != this->PlacementViewport[i])
       {
-        std::vector<ScreenTile>* trow = &this->Tiles[tx];
-        // Do this check here for speed, even though we repeat w/ small mod below.
-        if (!(*trow)[ty].IsSpotOpen(r))
-          return false;
+        return false;
       }
     }
-    // OK, we made it this far... we can place the label.
-    // Add it to each tile it overlaps.
-    for (int tx = tx0; tx <= tx1; ++tx)
+    int numInputs = self->GetNumberOfInputConnections(0);
+    if (numInputs != static_cast<int>(this->PlacementInputs.size()))
     {
-      for (int ty = ty0; ty <= ty1; ++ty)
+      return false;
+    }
+    for (int i = 0; i < numInputs; ++i)
+    {
+      vtkDataObject* input = self->GetInputDataObject(0, i);
+      if (input != this->PlacementInputs[i] || input->GetMTime() > this->PlacementTime)
       {
-        this->Tiles[tx][ty].Insert(r);
+        return false;
+      }
+    }
+
+    // Project the anchors before rendering anything, the placement must be redone as
+    // soon as one of the labels moved too much.
+    bool world = self->AnchorTransform->GetCoordinateSystem() == VTK_WORLD;
+    double* eye = cam->GetPosition();
+    double* dir = cam->GetViewPlaneNormal();
+    std::vector<int> origins(2 * this->Placement.size());
+    for (size_t i = 0; i < this->Placement.size(); ++i)
+    {
+      const double* x = this->Placement[i].Anchor;
+      if (world &&
+        (x[0] - eye[0]) * dir[0] + (x[1] - eye[1]) * dir[1] + (x[2] - eye[2]) * dir[2] > 0)
+      {
+        return false;
+      }
+      self->AnchorTransform->SetValue(x[0], x[1], x[2]);
+      int* originPtr = self->AnchorTransform->GetComputedDisplayValue(ren);
+      if (std::abs(originPtr[0] - this->Placement[i].Origin[0]) >
+          self->PlacementReuseTolerance ||
+        std::abs(originPtr[1] - this->Placement[i].Origin[1]) > self->PlacementReuseTolerance)
+      {
+        return false;
       }
+      origins[2 * i] = originPtr[0];
+      origins[2 * i + 1] = originPtr[1];
+    }
+
+    vtkNew<vtkTextProperty> tprop;
+    self->RenderStrategy->SetRenderer(ren);
+    self->RenderStrategy->StartFrame();
+    for (size_t i = 0; i < this->Placement.size(); ++i)
+    {
+      this->RenderLabel(self, ren, this->Placement[i], &origins[2 * i], tprop);
     }
+    self->RenderStrategy->EndFrame();
+    self->RenderStrategy->SetRenderer(nullptr);
     return true;
   }
 
@@ -452,6 +628,8 @@ vtkLabelPlacementMapper::vtkLabelPlacementMapper()
   this->VisiblePoints->SetTolerance(0.002);
   this->PlaceAllLabels = false;
   this->OutputTraversedBounds = false;
+  this->PlacementReuseTolerance = 0.0;
+  this->PlacementBatchSize = 256;
   this->GeneratePerturbedLabelSpokes = false;
   this->Style = FILLED;
   this->Shape = NONE;
@@ -561,8 +739,14 @@ void vtkLabelPlacementMapper::RenderOverlay(vtkViewport* viewport, vtkActor2D* v
   if (!this->Buckets || this->Buckets->NumTiles[0] * this->Buckets->TileSize[0] < tvpsz[2] ||
     this->Buckets->NumTiles[1] * this->Buckets->TileSize[1] < tvpsz[3])
   {
+    delete this->Buckets;
     this->Buckets = new Internal(kdbounds, tileSize);
   }
+  else if (this->Buckets->RenderLastPlacement(this, ren, cam, kdbounds))
+  {
+    vtkDebugMacro("Reused the placement of " << this->Buckets->Placement.size() << " labels");
+    return;
+  }
   else
   {
     this->Buckets->Reset(kdbounds, tileSize);
@@ -641,6 +825,59 @@ void vtkLabelPlacementMapper::RenderOverlay(vtkViewport* viewport, vtkActor2D* v
 
   vtkSmartPointer<vtkTextProperty> tpropCopy = vtkSmartPointer<vtkTextProperty>::New();
 
+  this->Buckets->Placement.clear();
+  this->Buckets->PlacementValid = false;
+
+  // The labels are tested for conflicts by batches: each label of a batch is first tested in
+  // parallel against the labels placed by the previous batches, then the labels are placed in
+  // order, testing them only against the labels placed earlier in the same batch. This gives
+  // the same result as testing and placing the labels one at a time.
+  const size_t batchSize = static_cast<size_t>(this->PlacementBatchSize);
+  std::vector<Internal::Candidate> batch;
+  batch.reserve(batchSize);
+  auto placeBatch = [&]()
+  {
+    if (!this->PlaceAllLabels)
+    {
+      this->Buckets->StartBatch();
+      vtkSMPTools::For(0, static_cast<vtkIdType>(batch.size()),
+        [&](vtkIdType begin, vtkIdType end)
+        {
+          for (vtkIdType i = begin; i < end; ++i)
+          {
+            Internal::Candidate& c = batch[i];
+            c.Open = c.Label.BoundedWidth >= 0 || this->Buckets->IsSpotOpen(c.Rect, c.TileRange);
+          }
+        });
+    }
+    for (Internal::Candidate& c : batch)
+    {
+      if (c.Label.BoundedWidth < 0 && !this->PlaceAllLabels)
+      {
+        if (!c.Open || !this->Buckets->IsSpotOpen(c.Rect, c.TileRange, true))
+        {
+          continue;
+        }
+        this->Buckets->Insert(c.Rect, c.TileRange);
+      }
+      this->Buckets->RenderLabel(this, ren, c.Label, c.Label.Origin, tpropCopy);
+      this->Buckets->Placement.push_back(c.Label);
+      if (c.Label.BoundedWidth < 0)
+      {
+#ifndef NDEBUG
+        const double* bds = c.Label.LabelBounds;
+        renderedLabelArea +=
+          static_cast<unsigned long>(fabs(bds[1] - bds[0]) * fabs(bds[3] - bds[2]));
+#endif
+        vtkDebugMacro("Placed: " << c.Label.LabelId << " (" << c.Rect.Bounds[0] << ", "
+                                 << c.Rect.Bounds[2] << "  " << c.Rect.Bounds[1] << ","
+                                 << c.Rect.Bounds[3] << ") " << c.Label.Type);
+        placed++;
+      }
+    }
+    batch.clear();
+  };
+
   for (; !inIter->IsAtEnd(); inIter->Next())
   {
     // Ignore labels that don't have text or an icon.
@@ -697,8 +934,18 @@ void vtkLabelPlacementMapper::RenderOverlay(vtkViewport* viewport, vtkActor2D* v
       tpropCopy->SetOrientation(inIter->GetOrientation());
     }
 
-    double bds[4];
-    this->RenderStrategy->ComputeLabelBounds(tpropCopy, inIter->GetLabel(), bds);
+    Internal::PlacedLabel label;
+    label.Hierarchy = inIter->GetHierarchy();
+    label.LabelId = inIter->GetLabelId();
+    label.Type = labelType;
+    label.Label = inIter->GetLabel();
+    std::copy(x, x + 3, label.Anchor);
+    std::copy(origin, origin + 2, label.Origin);
+    label.Orientation = tpropCopy->GetOrientation();
+    label.BoundedWidth = -1;
+
+    double* bds = label.LabelBounds;
+    this->RenderStrategy->ComputeLabelBounds(tpropCopy, label.Label, bds);
 
     // Offset display position by lower left corner of bounding box
     dispx[0] = static_cast<int>(origin[0] + bds[0]);
@@ -763,73 +1010,58 @@ void vtkLabelPlacementMapper::RenderOverlay(vtkViewport* viewport, vtkActor2D* v
         continue;
       }
 
-      // Render it
-      this->RenderStrategy->RenderLabel(origin, tpropCopy, inIter->GetLabel(), width);
+      // Render it along with the labels of its batch
+      label.BoundedWidth = width;
+      batch.emplace_back(label, this->Buckets->GetLabelRect(origin, bds, label.Orientation));
 
 #ifndef NDEBUG
       int renderedHeight = static_cast<int>(bds[3] - bds[2]);
       int renderedWidth = static_cast<int>((bds[1] - bds[0] < width) ? (bds[1] - bds[0]) : width);
       renderedLabelArea += static_cast<unsigned long>(renderedWidth * renderedHeight);
 #endif
-      continue;
     }
-
-    if (this->Debug)
+    else
     {
-      vtkDebugMacro("Try: " << inIter->GetLabelId() << " (" << ll[0] << ", " << ll[1] << "  "
-                            << ur[0] << "," << ur[1] << ")");
-      if (labelType == 0)
+      if (this->Debug)
       {
-        vtkDebugMacro("Area: " << renderedLabelArea << "  /  " << allowableLabelArea << " \""
-                               << inIter->GetLabel() << "\"");
+        vtkDebugMacro("Try: " << inIter->GetLabelId() << " (" << ll[0] << ", " << ll[1] << "  "
+                              << ur[0] << "," << ur[1] << ")");
+        if (labelType == 0)
+        {
+          vtkDebugMacro("Area: " << renderedLabelArea << "  /  " << allowableLabelArea << " \""
+                                 << inIter->GetLabel() << "\"");
+        }
+        else
+        {
+          vtkDebugMacro("Area: " << renderedLabelArea << "  /  " << allowableLabelArea);
+        }
       }
-      else
+
+      Internal::Candidate candidate(
+        label, this->Buckets->GetLabelRect(origin, bds, label.Orientation));
+      if (!this->PlaceAllLabels &&
+        !this->Buckets->GetTileRange(candidate.Rect, candidate.TileRange))
       {
-        vtkDebugMacro("Area: " << renderedLabelArea << "  /  " << allowableLabelArea);
+        continue; // Don't intersect screen.
       }
+      batch.push_back(candidate);
     }
 
-    double orient = tpropCopy->GetOrientation();
-
-    // Translate to origin to simplify bucketing
-    double xTrans[4];
-    xTrans[0] = ll[0] - kdbounds[0];
-    xTrans[1] = ur[0] - kdbounds[0];
-    xTrans[2] = ll[1] - kdbounds[2];
-    xTrans[3] = ur[1] - kdbounds[2];
-
-    double originTrans[2];
-    originTrans[0] = origin[0] - kdbounds[0];
-    originTrans[1] = origin[1] - kdbounds[2];
-
-    double orientRad = vtkMath::RadiansFromDegrees(orient);
-    LabelRect r(xTrans, originTrans, orientRad);
-
-    if (this->PlaceAllLabels || this->Buckets->PlaceLabel(r))
+    if (batch.size() == batchSize)
     {
-      r.Render(ren, this->Shape, this->Style, this->Margin, this->BackgroundColor,
-        this->BackgroundOpacity);
-#ifndef NDEBUG
-      renderedLabelArea += static_cast<unsigned long>(sz[0] * sz[1]);
-#endif
-      if (labelType == 0)
-      {
-        // label is text
-        this->RenderStrategy->RenderLabel(origin, tpropCopy, inIter->GetLabel());
-
-        // TODO: 1. Perturb coincident points.
-        //       2. Use GeneratePerturbedLabelSpokes to possibly render perturbed points.
-      }
-      else
-      { // label is an icon
-        // TODO: Do something ...
-      }
-
-      vtkDebugMacro("Placed: " << inIter->GetLabelId() << " (" << ll[0] << ", " << ll[1] << "  "
-                               << ur[0] << "," << ur[1] << ") " << labelType);
-      placed++;
+      placeBatch();
     }
   }
+  placeBatch();
+
+  this->Buckets->PlacementInputs.clear();
+  for (int i = 0; i < numInputs; ++i)
+  {
+    this->Buckets->PlacementInputs.push_back(this->GetInputDataObject(0, i));
+  }
+  std::copy(kdbounds, kdbounds + 4, this->Buckets->PlacementViewport);
+  this->Buckets->PlacementTime.Modified();
+  this->Buckets->PlacementValid = true;
 
   // Done rendering labels
   this->RenderStrategy->EndFrame();
@@ -888,6 +1120,8 @@ void vtkLabelPlacementMapper::PrintSelf(ostream& os, vtkIndent indent)
      << "GeneratePerturbedLabelSpokes: " << (this->GeneratePerturbedLabelSpokes ? "ON" : "OFF")
      << "\n";
   os << indent << "UseDepthBuffer: " << (this->UseDepthBuffer ? "ON" : "OFF") << "\n";
+  os << indent << "PlacementReuseTolerance: " << this->PlacementReuseTolerance << "\n";
+  os << indent << "PlacementBatchSize: " << this->PlacementBatchSize << "\n";
   os << indent << "Style: " << this->Style << "\n";
   os << indent << "Shape: " << this->Shape << "\n";
   os << indent << "Margin: " << this->Margin << "\n";
@@ -179,6 +179,32 @@ public:
   vtkGetMacro(BackgroundOpacity, double);
   ///@}
 
+  ///@{
+  /**
+   * When positive, the labels rendered for a view are rendered again, without
+   * traversing the label hierarchies nor testing the labels for conflicts, as
+   * long as none of their anchors moved by more than this number of pixels on
+   * the screen and neither the inputs nor the viewport changed. This keeps the
+   * interaction smooth with large numbers of labels, but the labels coming into
+   * view are not placed until the camera moved enough. Not used with
+   * UseDepthBuffer or OutputTraversedBounds. Default is 0, i.e. the labels are
+   * placed for every render.
+   */
+  vtkSetClampMacro(PlacementReuseTolerance, double, 0.0, VTK_DOUBLE_MAX);
+  vtkGetMacro(PlacementReuseTolerance, double);
+  ///@}
+
+  ///@{
+  /**
+   * The number of labels tested for conflicts at once. The labels of a batch
+   * are tested in parallel against the labels placed by the previous batches,
+   * then placed in order, so the placed labels do not depend on this number.
+   * 1 places the labels one at a time. Default is 256.
+   */
+  vtkSetClampMacro(PlacementBatchSize, int, 1, VTK_INT_MAX);
+  vtkGetMacro(PlacementBatchSize, int);
+  ///@}
+
   ///@{
   /**
    * Get the transform for the anchor points.
@@ -213,6 +239,8 @@ protected:
   bool UseDepthBuffer;
   bool PlaceAllLabels;
   bool OutputTraversedBounds;
+  double PlacementReuseTolerance;
+  int PlacementBatchSize;
 
   int LastRendererSize[2];
   double LastCameraPosition[3];
@@ -0,0 +1,140 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Checks the index buffers built in parallel against a serial traversal of the
+// cells. No OpenGL context is needed to build the indices.
+
+#include "vtkCellArray.h"
+#include "vtkNew.h"
+#include "vtkOpenGLIndexBufferObject.h"
+#include "vtkPoints.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+constexpr vtkIdType NumberOfCells = 50000;
+constexpr vtkIdType VertexOffset = 7;
+
+//------------------------------------------------------------------------------
+// Polygons with 3 to 6 points, some of them with coincident points.
+void CreatePolygons(vtkPoints* points, vtkCellArray* polys)
+{
+  for (vtkIdType i = 0; i < NumberOfCells; ++i)
+  {
+    const vtkIdType size = 3 + i % 4;
+    const vtkIdType first = points->GetNumberOfPoints();
+    polys->InsertNextCell(static_cast<int>(size));
+    for (vtkIdType j = 0; j < size; ++j)
+    {
+      // every 5th polygon repeats its first point
+      const double x = (i % 5 == 0 && j == 1) ? 0.0 : static_cast<double>(j);
+      points->InsertNextPoint(x, static_cast<double>(i), 0.0);
+      polys->InsertCellPoint(first + j);
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+bool TestTriangles(vtkPoints* points, vtkCellArray* polys, vtkUnsignedCharArray* edgeFlags)
+{
+  std::vector<unsigned int> expected = { 1, 2, 3 };
+  std::vector<unsigned char> expectedEdges = { 1 };
+  const unsigned char* ef = edgeFlags->GetPointer(0);
+  vtkIdType npts;
+  const vtkIdType* pts;
+  for (polys->InitTraversal(); polys->GetNextCell(npts, pts);)
+  {
+    for (vtkIdType i = 1; i < npts - 1; ++i)
+    {
+      double p1[3], p2[3], p3[3];
+      points->GetPoint(pts[0], p1);
+      points->GetPoint(pts[i], p2);
+      points->GetPoint(pts[i + 1], p3);
+      if ((p1[0] == p2[0] && p1[1] == p2[1]) || (p1[0] == p3[0] && p1[1] == p3[1]) ||
+        (p2[0] == p3[0] && p2[1] == p3[1]))
+      {
+        continue;
+      }
+      expected.push_back(static_cast<unsigned int>(pts[0] + VertexOffset));
+      expected.push_back(static_cast<unsigned int>(pts[i] + VertexOffset));
+      expected.push_back(static_cast<unsigned int>(pts[i + 1] + VertexOffset));
+      int val = npts == 3 ? 7 : i == 1 ? 3 : i == npts - 2 ? 6 : 2;
+      int mask = ef[pts[0]] + ef[pts[i]] * 2 + ef[pts[i + 1]] * 4;
+      expectedEdges.push_back(static_cast<unsigned char>(val & mask));
+    }
+  }
+
+  std::vector<unsigned int> indices = { 1, 2, 3 };
+  std::vector<unsigned char> edges = { 1 };
+  vtkOpenGLIndexBufferObject::AppendTriangleIndexBuffer(
+    indices, polys, points, VertexOffset, &edges, edgeFlags);
+  if (indices != expected || edges != expectedEdges)
+  {
+    std::cerr << "Incorrect triangle index buffer, got " << indices.size() << " indices, expected "
+              << expected.size() << std::endl;
+    return false;
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool TestLinesAndPoints(vtkCellArray* polys)
+{
+  std::vector<unsigned int> expectedPoints = { 4 };
+  std::vector<unsigned int> expectedLines = { 4 };
+  vtkIdType npts;
+  const vtkIdType* pts;
+  for (polys->InitTraversal(); polys->GetNextCell(npts, pts);)
+  {
+    for (vtkIdType i = 0; i < npts; ++i)
+    {
+      expectedPoints.push_back(static_cast<unsigned int>(pts[i] + VertexOffset));
+      expectedLines.push_back(static_cast<unsigned int>(pts[i] + VertexOffset));
+      expectedLines.push_back(static_cast<unsigned int>(pts[(i + 1) % npts] + VertexOffset));
+    }
+  }
+
+  std::vector<unsigned int> pointIndices = { 4 };
+  vtkOpenGLIndexBufferObject::AppendPointIndexBuffer(pointIndices, polys, VertexOffset);
+  if (pointIndices != expectedPoints)
+  {
+    std::cerr << "Incorrect point index buffer" << std::endl;
+    return false;
+  }
+
+  std::vector<unsigned int> lineIndices = { 4 };
+  vtkOpenGLIndexBufferObject::AppendTriangleLineIndexBuffer(lineIndices, polys, VertexOffset);
+  if (lineIndices != expectedLines)
+  {
+    std::cerr << "Incorrect line index buffer" << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+//------------------------------------------------------------------------------
+int UnitTestOpenGLIndexBufferObject(int, char*[])
+{
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkCellArray> polys;
+  CreatePolygons(points, polys);
+
+  vtkNew<vtkUnsignedCharArray> edgeFlags;
+  edgeFlags->SetNumberOfValues(points->GetNumberOfPoints());
+  for (vtkIdType i = 0; i < points->GetNumberOfPoints(); ++i)
+  {
+    edgeFlags->SetValue(i, static_cast<unsigned char>(i % 3 != 0));
+  }
+
+  bool success = TestTriangles(points, polys, edgeFlags) && TestLinesAndPoints(polys);
+
+  // same with 32 bit connectivity
+  polys->ConvertTo32BitStorage();
+  success = success && TestTriangles(points, polys, edgeFlags) && TestLinesAndPoints(polys);
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
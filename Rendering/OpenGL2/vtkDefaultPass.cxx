@@ -4,6 +4,8 @@
 #include "vtkDefaultPass.h"
 #include "vtkObjectFactory.h"
 #include "vtkProp.h"
+#include "vtkRenderTimerLog.h"
+#include "vtkRenderWindow.h"
 #include "vtkRenderState.h"
 #include "vtkRenderer.h"
 #include <cassert>
@@ -46,11 +48,21 @@ void vtkDefaultPass::RenderOpaqueGeometry(const vtkRenderState* s)
 {
   assert("pre s_exits" && s != nullptr);
 
+  vtkRenderTimerLog* timer = s->GetRenderer()->GetRenderWindow()->GetRenderTimer();
+  const bool logProps = timer->GetLoggingEnabled();
   int c = s->GetPropArrayCount();
   int i = 0;
   while (i < c)
   {
-    int rendered = s->GetPropArray()[i]->RenderOpaqueGeometry(s->GetRenderer());
+    vtkProp* p = s->GetPropArray()[i];
+    vtkRenderTimerLog::ScopedEventLogger propEvent;
+    if (logProps)
+    {
+      std::ostringstream eventName;
+      eventName << p->GetClassName() << "::RenderOpaqueGeometry this=@" << std::hex << p;
+      propEvent = timer->StartScopedEvent(eventName.str());
+    }
+    int rendered = p->RenderOpaqueGeometry(s->GetRenderer());
     this->NumberOfRenderedProps += rendered;
     ++i;
   }
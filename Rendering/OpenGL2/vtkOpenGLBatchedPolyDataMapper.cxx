@@ -4,6 +4,8 @@
 #include "vtkOpenGLBatchedPolyDataMapper.h"
 
 #include "vtkArrayDispatch.h"
+#include "vtkBoundingBox.h"
+#include "vtkCamera.h"
 #include "vtkCellData.h"
 #include "vtkColorTransferFunction.h"
 #include "vtkCompositePolyDataMapper.h"
@@ -12,6 +14,8 @@
 #include "vtkHardwareSelector.h"
 #include "vtkImageData.h"
 #include "vtkLookupTable.h"
+#include "vtkMath.h"
+#include "vtkMatrix4x4.h"
 #include "vtkObjectFactory.h"
 #include "vtkOpenGLCellToVTKCellMap.h"
 #include "vtkOpenGLCompositePolyDataMapperDelegator.h"
@@ -24,6 +28,7 @@
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkProperty.h"
+#include "vtkRenderTimerLog.h"
 #include "vtkRenderWindow.h"
 #include "vtkRenderer.h"
 #include "vtkShaderProgram.h"
@@ -32,6 +37,7 @@
 #include "vtkTransform.h"
 #include "vtkUnsignedIntArray.h"
 
+#include <algorithm>
 #include <sstream>
 
 namespace
@@ -66,6 +72,187 @@ VTK_ABI_NAMESPACE_BEGIN
 #define SCOPED_ROLLBACK_ARRAY_ELEMENT(type, varName, idx)                                          \
   ScopedValueRollback<type> saver_##varName##idx(this->varName[idx], batchElement.varName[idx])
 
+//------------------------------------------------------------------------------
+class vtkOpenGLBatchedPolyDataMapper::vtkBlockHierarchy
+{
+public:
+  struct Node
+  {
+    double Bounds[6];
+    // range of the node elements in Elements
+    size_t Begin;
+    size_t End;
+    // index of the first child, the second one follows it. 0 for leaves.
+    size_t Child;
+  };
+
+  // culling planes with inward normals and projection, in model coordinates
+  struct Frustum
+  {
+    double Planes[24];
+    double Matrix[16];
+    double MinimumCoverage;
+  };
+
+  static constexpr size_t LeafSize = 4;
+
+  std::vector<Node> Nodes;
+  std::vector<GLBatchElement*> Elements;
+
+  void Build(const std::map<std::uintptr_t, std::unique_ptr<GLBatchElement>>& elements)
+  {
+    this->Nodes.clear();
+    this->Elements.clear();
+    for (const auto& iter : elements)
+    {
+      // empty polydata are never culled
+      if (vtkMath::AreBoundsInitialized(iter.second->Bounds))
+      {
+        this->Elements.push_back(iter.second.get());
+      }
+    }
+    if (!this->Elements.empty())
+    {
+      this->Nodes.emplace_back();
+      this->BuildNode(0, 0, this->Elements.size());
+    }
+  }
+
+  // Flags the culled elements, returns their number.
+  vtkIdType Cull(const Frustum& frustum) const
+  {
+    return this->Nodes.empty() ? 0 : this->CullNode(0, frustum, 0x3f);
+  }
+
+private:
+  void BuildNode(size_t nodeId, size_t begin, size_t end)
+  {
+    vtkBoundingBox bbox;
+    for (size_t i = begin; i < end; ++i)
+    {
+      bbox.AddBounds(this->Elements[i]->Bounds);
+    }
+    Node& node = this->Nodes[nodeId];
+    bbox.GetBounds(node.Bounds);
+    node.Begin = begin;
+    node.End = end;
+    node.Child = 0;
+    if (end - begin <= LeafSize)
+    {
+      return;
+    }
+
+    // split at the median of the element centers along the longest axis
+    double lengths[3];
+    bbox.GetLengths(lengths);
+    const int axis = static_cast<int>(std::max_element(lengths, lengths + 3) - lengths);
+    const size_t middle = begin + (end - begin) / 2;
+    std::nth_element(this->Elements.begin() + begin, this->Elements.begin() + middle,
+      this->Elements.begin() + end, [axis](const GLBatchElement* a, const GLBatchElement* b)
+      {
+        return a->Bounds[2 * axis] + a->Bounds[2 * axis + 1] <
+          b->Bounds[2 * axis] + b->Bounds[2 * axis + 1];
+      });
+
+    const size_t child = this->Nodes.size();
+    node.Child = child;
+    this->Nodes.resize(child + 2);
+    this->BuildNode(child, begin, middle);
+    this->BuildNode(child + 1, middle, end);
+  }
+
+  vtkIdType CullNode(size_t nodeId, const Frustum& frustum, int planeMask) const
+  {
+    const Node& node = this->Nodes[nodeId];
+    if (IsCulled(node.Bounds, frustum, planeMask))
+    {
+      for (size_t i = node.Begin; i < node.End; ++i)
+      {
+        this->Elements[i]->Culled = true;
+      }
+      return static_cast<vtkIdType>(node.End - node.Begin);
+    }
+    if (planeMask == 0 && frustum.MinimumCoverage == 0.0)
+    {
+      // the whole node is inside of the frustum
+      return 0;
+    }
+    if (node.Child == 0)
+    {
+      vtkIdType numberOfCulled = 0;
+      for (size_t i = node.Begin; i < node.End; ++i)
+      {
+        int elementMask = planeMask;
+        GLBatchElement* element = this->Elements[i];
+        element->Culled = IsCulled(element->Bounds, frustum, elementMask);
+        numberOfCulled += element->Culled ? 1 : 0;
+      }
+      return numberOfCulled;
+    }
+    return this->CullNode(node.Child, frustum, planeMask) +
+      this->CullNode(node.Child + 1, frustum, planeMask);
+  }
+
+  // Returns true when the bounds are outside of one of the planes in
+  // planeMask or too small. The planes the bounds are completely inside of
+  // are removed from planeMask.
+  static bool IsCulled(const double bounds[6], const Frustum& frustum, int& planeMask)
+  {
+    for (int p = 0; p < 6; ++p)
+    {
+      if (!(planeMask & (1 << p)))
+      {
+        continue;
+      }
+      const double* plane = frustum.Planes + 4 * p;
+      double farthest = plane[3];
+      double nearest = plane[3];
+      for (int k = 0; k < 3; ++k)
+      {
+        const double low = plane[k] * bounds[2 * k];
+        const double high = plane[k] * bounds[2 * k + 1];
+        farthest += std::max(low, high);
+        nearest += std::min(low, high);
+      }
+      if (farthest < 0.0)
+      {
+        return true;
+      }
+      if (nearest >= 0.0)
+      {
+        planeMask &= ~(1 << p);
+      }
+    }
+    return frustum.MinimumCoverage > 0.0 &&
+      ComputeCoverage(bounds, frustum.Matrix) < frustum.MinimumCoverage;
+  }
+
+  // Fraction of the viewport covered by the projected bounds.
+  static double ComputeCoverage(const double bounds[6], const double matrix[16])
+  {
+    double range[4] = { VTK_DOUBLE_MAX, -VTK_DOUBLE_MAX, VTK_DOUBLE_MAX, -VTK_DOUBLE_MAX };
+    for (int c = 0; c < 8; ++c)
+    {
+      const double corner[4] = { bounds[c & 1], bounds[2 + ((c >> 1) & 1)],
+        bounds[4 + ((c >> 2) & 1)], 1.0 };
+      double projected[4];
+      vtkMatrix4x4::MultiplyPoint(matrix, corner, projected);
+      if (projected[3] <= 0.0)
+      {
+        // behind the camera, the projection is unbounded
+        return 1.0;
+      }
+      for (int k = 0; k < 2; ++k)
+      {
+        const double value = std::min(std::max(projected[k] / projected[3], -1.0), 1.0);
+        range[2 * k] = std::min(range[2 * k], value);
+        range[2 * k + 1] = std::max(range[2 * k + 1], value);
+      }
+    }
+    return 0.25 * (range[1] - range[0]) * (range[3] - range[2]);
+  }
+};
+
 //------------------------------------------------------------------------------
 vtkStandardNewMacro(vtkOpenGLBatchedPolyDataMapper);
 
@@ -130,6 +317,7 @@ void vtkOpenGLBatchedPolyDataMapper::ClearBatchElements()
 {
   this->VTKPolyDataToGLBatchElement.clear();
   this->FlatIndexToPolyData.clear();
+  this->BlockHierarchy.reset();
 }
 
 //------------------------------------------------------------------------------
@@ -153,6 +341,7 @@ void vtkOpenGLBatchedPolyDataMapper::SetParent(vtkCompositePolyDataMapper* paren
 //------------------------------------------------------------------------------
 void vtkOpenGLBatchedPolyDataMapper::RenderPiece(vtkRenderer* renderer, vtkActor* actor)
 {
+  this->NumberOfCulledBlocks = 0;
   // Make sure that we have been properly initialized.
   if (renderer->GetRenderWindow()->CheckAbortStatus())
   {
@@ -171,10 +360,61 @@ void vtkOpenGLBatchedPolyDataMapper::RenderPiece(vtkRenderer* renderer, vtkActor
 
   this->UpdateCameraShiftScale(renderer, actor);
   this->RenderPieceStart(renderer, actor);
-  this->RenderPieceDraw(renderer, actor);
+
+  vtkRenderTimerLog* timer = renderer->GetRenderWindow()->GetRenderTimer();
+  {
+    VTK_SCOPED_RENDER_EVENT("vtkOpenGLBatchedPolyDataMapper::CullBatchElements", timer);
+    this->NumberOfCulledBlocks = this->CullBatchElements(renderer, actor);
+  }
+  {
+    VTK_SCOPED_RENDER_EVENT("vtkOpenGLBatchedPolyDataMapper::RenderPieceDraw ("
+        << static_cast<vtkIdType>(this->VTKPolyDataToGLBatchElement.size()) -
+          this->NumberOfCulledBlocks
+        << " blocks)",
+      timer);
+    this->RenderPieceDraw(renderer, actor);
+  }
   this->RenderPieceFinish(renderer, actor);
 }
 
+//------------------------------------------------------------------------------
+vtkIdType vtkOpenGLBatchedPolyDataMapper::CullBatchElements(vtkRenderer* renderer, vtkActor* actor)
+{
+  for (auto& iter : this->VTKPolyDataToGLBatchElement)
+  {
+    iter.second->Culled = false;
+  }
+  if (!this->Parent->GetBlockCulling() || !this->BlockHierarchy)
+  {
+    return 0;
+  }
+
+  // the element bounds are in model coordinates, so are the culling planes
+  vtkCamera* camera = renderer->GetActiveCamera();
+  const double aspect = renderer->GetTiledAspectRatio();
+  double worldPlanes[24];
+  camera->GetFrustumPlanes(aspect, worldPlanes);
+  const double* model = actor->GetMatrix()->GetData();
+  vtkBlockHierarchy::Frustum frustum;
+  for (int p = 0; p < 6; ++p)
+  {
+    for (int k = 0; k < 4; ++k)
+    {
+      frustum.Planes[4 * p + k] = 0.0;
+      for (int r = 0; r < 4; ++r)
+      {
+        frustum.Planes[4 * p + k] += worldPlanes[4 * p + r] * model[4 * r + k];
+      }
+    }
+  }
+  vtkMatrix4x4::Multiply4x4(
+    camera->GetCompositeProjectionTransformMatrix(aspect, -1, 1)->GetData(), model, frustum.Matrix);
+  // small blocks are still pickable
+  frustum.MinimumCoverage = renderer->GetSelector() ? 0.0 : this->Parent->GetMinimumBlockCoverage();
+
+  return this->BlockHierarchy->Cull(frustum);
+}
+
 //------------------------------------------------------------------------------
 void vtkOpenGLBatchedPolyDataMapper::UnmarkBatchElements()
 {
@@ -194,6 +434,7 @@ void vtkOpenGLBatchedPolyDataMapper::ClearUnmarkedBatchElements()
     if (!iter->second->Parent.Marked)
     {
       this->VTKPolyDataToGLBatchElement.erase(iter++);
+      this->BlockHierarchy.reset();
       this->Modified();
     }
     else
@@ -718,6 +959,31 @@ void vtkOpenGLBatchedPolyDataMapper::DrawIBO(vtkRenderer* renderer, vtkActor* ac
     bool selecting = this->CurrentSelector != nullptr;
     bool tpass = actor->IsRenderingTranslucentPolygonalGeometry();
 
+    // Consecutive elements with contiguous indices are drawn with a single
+    // call, unless they need different uniforms.
+    const bool canMerge = !selecting && !this->DrawingSelection && !this->PrimIDUsed &&
+      !this->Parent->GetColorMissingArraysWithNanColor();
+    GLBatchElement* pending = nullptr;
+    unsigned int pendingNextIndex = 0;
+    unsigned int pendingStartVertex = 0;
+    unsigned int pendingNextVertex = 0;
+    auto drawPending = [&]()
+    {
+      if (!pending)
+      {
+        return;
+      }
+      unsigned int count = this->DrawingSelection
+        ? static_cast<unsigned int>(CellBO.IBO->IndexCount)
+        : pendingNextIndex - pending->StartIndex[primType];
+
+      glDrawRangeElements(mode, static_cast<GLuint>(pendingStartVertex),
+        static_cast<GLuint>(pendingNextVertex > 0 ? pendingNextVertex - 1 : 0), count,
+        GL_UNSIGNED_INT,
+        reinterpret_cast<const GLvoid*>(pending->StartIndex[primType] * sizeof(GLuint)));
+      pending = nullptr;
+    };
+
     for (auto& pair : this->FlatIndexToPolyData)
     {
       if (this->VTKPolyDataToGLBatchElement.find(pair.second) ==
@@ -731,31 +997,44 @@ void vtkOpenGLBatchedPolyDataMapper::DrawIBO(vtkRenderer* renderer, vtkActor* ac
       auto glBatchElement = this->VTKPolyDataToGLBatchElement[pair.second].get();
       auto& batchElement = glBatchElement->Parent;
       bool shouldDraw = batchElement.Visibility     // must be visible
+        && !glBatchElement->Culled                  // and not culled
         && (!selecting || batchElement.Pickability) // and pickable when selecting
         && (((selecting || batchElement.IsOpaque || actor->GetForceOpaque()) &&
               !tpass) // opaque during opaque or when selecting
              || ((!batchElement.IsOpaque || actor->GetForceTranslucent()) && tpass &&
                   !selecting)); // translucent during translucent and never selecting
-      if (shouldDraw && glBatchElement->NextIndex[primType] > glBatchElement->StartIndex[primType])
+      if (!shouldDraw ||
+        glBatchElement->NextIndex[primType] <= glBatchElement->StartIndex[primType])
       {
-        // compilers think this can exceed the bounds so we also
-        // test against primType even though we should not need to
-        if (primType <= vtkOpenGLPolyDataMapper::PrimitiveTriStrips)
-        {
-          this->SetShaderValues(
-            prog, glBatchElement, glBatchElement->CellCellMap->GetPrimitiveOffsets()[primType]);
-        }
+        continue;
+      }
 
-        unsigned int count = this->DrawingSelection
-          ? static_cast<unsigned int>(CellBO.IBO->IndexCount)
-          : glBatchElement->NextIndex[primType] - glBatchElement->StartIndex[primType];
+      if (pending && canMerge && glBatchElement->StartIndex[primType] == pendingNextIndex &&
+        batchElement.Opacity == pending->Parent.Opacity &&
+        batchElement.AmbientColor == pending->Parent.AmbientColor &&
+        batchElement.DiffuseColor == pending->Parent.DiffuseColor &&
+        batchElement.OverridesColor == pending->Parent.OverridesColor)
+      {
+        pendingNextIndex = glBatchElement->NextIndex[primType];
+        pendingStartVertex = std::min(pendingStartVertex, glBatchElement->StartVertex);
+        pendingNextVertex = std::max(pendingNextVertex, glBatchElement->NextVertex);
+        continue;
+      }
+      drawPending();
 
-        glDrawRangeElements(mode, static_cast<GLuint>(glBatchElement->StartVertex),
-          static_cast<GLuint>(glBatchElement->NextVertex > 0 ? glBatchElement->NextVertex - 1 : 0),
-          count, GL_UNSIGNED_INT,
-          reinterpret_cast<const GLvoid*>(glBatchElement->StartIndex[primType] * sizeof(GLuint)));
+      // compilers think this can exceed the bounds so we also
+      // test against primType even though we should not need to
+      if (primType <= vtkOpenGLPolyDataMapper::PrimitiveTriStrips)
+      {
+        this->SetShaderValues(
+          prog, glBatchElement, glBatchElement->CellCellMap->GetPrimitiveOffsets()[primType]);
       }
+      pending = glBatchElement;
+      pendingNextIndex = glBatchElement->NextIndex[primType];
+      pendingStartVertex = glBatchElement->StartVertex;
+      pendingNextVertex = glBatchElement->NextVertex;
     }
+    drawPending();
     CellBO.IBO->Release();
   }
 }
@@ -953,8 +1232,8 @@ void vtkOpenGLBatchedPolyDataMapper::BuildBufferObjects(vtkRenderer* renderer, v
       auto glBatchElement = iter.second.get();
       auto& batchElement = glBatchElement->Parent;
 
-      batchElement.PolyData->GetPoints()->GetBounds(bounds);
-      bbox.AddBounds(bounds);
+      batchElement.PolyData->GetPoints()->GetBounds(glBatchElement->Bounds);
+      bbox.AddBounds(glBatchElement->Bounds);
 
       for (int i = 0; i < vtkOpenGLPolyDataMapper::PrimitiveEnd; i++)
       {
@@ -993,6 +1272,12 @@ void vtkOpenGLBatchedPolyDataMapper::BuildBufferObjects(vtkRenderer* renderer, v
     }
   }
 
+  if (!this->BlockHierarchy)
+  {
+    this->BlockHierarchy.reset(new vtkBlockHierarchy());
+  }
+  this->BlockHierarchy->Build(this->VTKPolyDataToGLBatchElement);
+
   // clear color cache
   for (auto& iter : this->ColorArrayMap)
   {
@@ -9,6 +9,14 @@
  * On OpenGL ES, the parent class is vtkOpenGLES30PolyDataMapper.
  * Everywhere else, the parent class is vtkOpenGLPolyDataMapper.
  *
+ * When the parent vtkCompositePolyDataMapper has BlockCulling on, the bounds of
+ * the batch elements are organized in a bounding volume hierarchy, rebuilt with
+ * the buffer objects, which is traversed on every render to skip the elements
+ * outside of the view frustum or smaller than the MinimumBlockCoverage.
+ * Consecutive elements with the same rendering attributes are drawn with a
+ * single call. The culling and the drawing are reported to the render window's
+ * vtkRenderTimerLog.
+ *
  * @sa vtkOpenGLPolyDataMapper vtkOpenGLES30PolyDataMapper vtkOpenGLCompositePolyDataMapperDelegator
  */
 
@@ -25,7 +33,7 @@
 #include "vtk_glad.h"                                  // for OpenGL defs
 
 #include <cstdint> // for std::uintptr_t
-#include <memory>  // for shared_ptr
+#include <memory>  // for shared_ptr, unique_ptr
 
 VTK_ABI_NAMESPACE_BEGIN
 class vtkCompositePolyDataMapper;
@@ -55,6 +63,11 @@ public:
   std::vector<vtkPolyData*> GetRenderedList() const;
   void SetParent(vtkCompositePolyDataMapper* parent);
 
+  /**
+   * Number of batch elements skipped by the block culling of the last render.
+   */
+  vtkGetMacro(NumberOfCulledBlocks, vtkIdType);
+
   /**
    * Implemented by sub classes. Actual rendering is done here.
    */
@@ -84,6 +97,13 @@ protected:
   void RenderPieceDraw(vtkRenderer* renderer, vtkActor* actor) override;
   void UpdateCameraShiftScale(vtkRenderer* renderer, vtkActor* actoror) override;
 
+  /**
+   * Flags the batch elements culled by the parent's BlockCulling and
+   * MinimumBlockCoverage for the current render. Returns the number of culled
+   * elements.
+   */
+  vtkIdType CullBatchElements(vtkRenderer* renderer, vtkActor* actor);
+
   /**
    * Draws primitives
    */
@@ -156,6 +176,11 @@ protected:
 private:
   vtkOpenGLBatchedPolyDataMapper(const vtkOpenGLBatchedPolyDataMapper&) = delete;
   void operator=(const vtkOpenGLBatchedPolyDataMapper&) = delete;
+
+  // bounding volume hierarchy of the batch element bounds
+  class vtkBlockHierarchy;
+  std::unique_ptr<vtkBlockHierarchy> BlockHierarchy;
+  vtkIdType NumberOfCulledBlocks = 0;
 };
 
 VTK_ABI_NAMESPACE_END
@@ -59,6 +59,17 @@ std::vector<vtkPolyData*> vtkOpenGLCompositePolyDataMapperDelegator::GetRendered
   return this->GLDelegate->GetRenderedList();
 }
 
+//------------------------------------------------------------------------------
+vtkIdType vtkOpenGLCompositePolyDataMapperDelegator::GetNumberOfCulledBlocks() const
+{
+#ifdef GL_ES_VERSION_3_0
+  // the low memory mapper does not cull blocks
+  return 0;
+#else
+  return this->GLDelegate->GetNumberOfCulledBlocks();
+#endif
+}
+
 //------------------------------------------------------------------------------
 void vtkOpenGLCompositePolyDataMapperDelegator::SetParent(vtkCompositePolyDataMapper* mapper)
 {
@@ -53,6 +53,11 @@ public:
 
     // stores the mapping from vtk cells to gl_PrimitiveId
     vtkNew<vtkOpenGLCellToVTKCellMap> CellCellMap;
+
+    // bounds of the points, used to cull the element
+    double Bounds[6];
+    // whether the element was culled for the current render
+    bool Culled = false;
   };
 
   ///@{
@@ -74,6 +79,7 @@ protected:
    * Implement parent class API.
    */
   std::vector<vtkPolyData*> GetRenderedList() const override;
+  vtkIdType GetNumberOfCulledBlocks() const override;
   void SetParent(vtkCompositePolyDataMapper* mapper) override;
   void Insert(BatchElement&& item) override;
   BatchElement* Get(vtkPolyData* polydata) override;
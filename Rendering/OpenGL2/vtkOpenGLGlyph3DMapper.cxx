@@ -21,10 +21,13 @@
 #include "vtkQuaternion.h"
 #include "vtkRenderWindow.h"
 #include "vtkRenderer.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkTransform.h"
 #include "vtkUnsignedCharArray.h"
 
+#include <algorithm>
+#include <atomic>
 #include <map>
 
 VTK_ABI_NAMESPACE_BEGIN
@@ -715,302 +718,351 @@ void vtkOpenGLGlyph3DMapper::RebuildStructures(
   this->ColorMapper->MapScalars(actor->GetProperty()->GetOpacity());
   vtkUnsignedCharArray* colors =
     ((vtkOpenGLGlyph3DMappervtkColorMapper*)this->ColorMapper)->GetColors();
-  // Traverse all Input points, transforming Source points
 
-  int numEntries = (int)subarray->Entries.size();
-
-  // how many points for each source
-  int* numPointsPerSource = new int[numEntries];
-  std::fill(numPointsPerSource, numPointsPerSource + numEntries, 0);
-  if (numEntries > 1 && indexArray)
-  {
-    // loop over every point
-    int index = 0;
-    for (vtkIdType inPtId = 0; inPtId < numPts; inPtId++)
-    {
-      if (maskArray && maskArray->GetValue(inPtId) == 0)
-      {
-        continue;
-      }
-
-      // Compute index into table of glyphs
-      double value =
-        vtkMath::Norm(indexArray->GetTuple(inPtId), indexArray->GetNumberOfComponents());
-      index = static_cast<int>(value);
-      index = vtkMath::ClampValue(index, 0, numEntries - 1);
-      numPointsPerSource[index]++;
-    }
-  }
-  else
-  {
-    numPointsPerSource[0] = numPts;
-  }
-
-  // for each entry start with a reasonable allocation
-  for (size_t cc = 0; cc < subarray->Entries.size(); cc++)
-  {
-    vtkOpenGLGlyph3DMapper::vtkOpenGLGlyph3DMapperEntry* entry = subarray->Entries[cc];
-    entry->PickIds.resize(numPointsPerSource[cc]);
-    entry->Colors.resize(numPointsPerSource[cc] * 4);
-    entry->Matrices.resize(numPointsPerSource[cc] * 16);
-    entry->NormalMatrices.resize(numPointsPerSource[cc] * 9);
-    entry->NumberOfPoints = 0;
-    entry->BuildTime.Modified();
-  }
-  delete[] numPointsPerSource;
-
-  // loop over every point and fill structures
-  int index = 0;
-  vtkDataObjectTree* sourceTableTree = this->GetSourceTableTree();
+  const int numEntries = static_cast<int>(subarray->Entries.size());
 
   // cache sources to improve performances
+  vtkDataObjectTree* sourceTableTree = this->GetSourceTableTree();
   std::vector<vtkDataObject*> sourceCache(numEntries);
-  for (vtkIdType i = 0; i < numEntries; i++)
+  for (int i = 0; i < numEntries; i++)
   {
     sourceCache[i] =
       this->UseSourceTableTree ? getChildDataObject(sourceTableTree, i) : this->GetSource(i);
   }
 
-  double trans[16];
-  double normalTrans[9];
-
-  for (vtkIdType inPtId = 0; inPtId < numPts; inPtId++)
+  // report the invalid arrays once, before the parallel loops
+  bool scaleByComponents = this->ScaleMode == SCALE_BY_COMPONENTS;
+  if (scaleArray && scaleByComponents && scaleArray->GetNumberOfComponents() != 3)
   {
-    if (!(inPtId % 10000))
-    {
-      this->UpdateProgress(static_cast<double>(inPtId) / static_cast<double>(numPts));
-      if (this->GetAbortExecute())
-      {
-        break;
-      }
-    }
-
-    if (maskArray && maskArray->GetValue(inPtId) == 0)
+    vtkErrorMacro("Cannot scale by components since " << scaleArray->GetName()
+                                                      << " does not have 3 components.");
+    scaleByComponents = false;
+  }
+  bool useSelectionArray = false;
+  if (this->UseSelectionIds)
+  {
+    if (selectionArray == nullptr || selectionArray->GetNumberOfTuples() == 0)
     {
-      continue;
+      vtkWarningMacro(<< "UseSelectionIds is true, but selection array"
+                         " is invalid. Ignoring selection array.");
     }
-
-    // Compute index into table of glyphs
-    if (indexArray)
+    else
     {
-      double value =
-        vtkMath::Norm(indexArray->GetTuple(inPtId), indexArray->GetNumberOfComponents());
-      index = static_cast<int>(value);
-      index = vtkMath::ClampValue(index, 0, numEntries - 1);
+      useSelectionArray = true;
     }
+  }
+  if (numPts > 0)
+  {
+    // makes the next GetPoint calls thread safe
+    double x[3];
+    dataset->GetPoint(0, x);
+  }
 
-    // source can be null.
-    vtkDataObject* source =
-      index < static_cast<int>(sourceCache.size()) ? sourceCache[index] : nullptr;
-
-    // Make sure we're not indexing into empty glyph
-    if (source)
+  // The points are processed by chunks. The glyph entry of every point is
+  // computed first, -1 when the point is masked or its glyph is empty, with the
+  // number of points of each chunk per entry. These counts then give the offset
+  // of every chunk in the entries, so that the structures are filled in
+  // parallel in the order of the points.
+  const vtkIdType chunkSize = 10000;
+  const vtkIdType numChunks = (numPts + chunkSize - 1) / chunkSize;
+  std::vector<int> pointEntries(numPts);
+  std::vector<int> chunkOffsets(numChunks * numEntries, 0);
+  vtkSMPTools::For(0, numChunks, 1,
+    [&](vtkIdType firstChunk, vtkIdType lastChunk)
     {
-      vtkOpenGLGlyph3DMapper::vtkOpenGLGlyph3DMapperEntry* entry = subarray->Entries[index];
-
-      entry->Colors[entry->NumberOfPoints * 4] = color[0];
-      entry->Colors[entry->NumberOfPoints * 4 + 1] = color[1];
-      entry->Colors[entry->NumberOfPoints * 4 + 2] = color[2];
-      entry->Colors[entry->NumberOfPoints * 4 + 3] = color[3];
-
-      double scalex = 1.0;
-      double scaley = 1.0;
-      double scalez = 1.0;
-      // Get the scalar and vector data
-      if (scaleArray)
+      std::vector<double> indexTuple(indexArray ? indexArray->GetNumberOfComponents() : 0);
+      for (vtkIdType chunk = firstChunk; chunk < lastChunk; ++chunk)
       {
-        double* tuple = scaleArray->GetTuple(inPtId);
-        switch (this->ScaleMode)
+        int* counts = chunkOffsets.data() + chunk * numEntries;
+        const vtkIdType lastPtId = std::min(numPts, (chunk + 1) * chunkSize);
+        for (vtkIdType inPtId = chunk * chunkSize; inPtId < lastPtId; inPtId++)
         {
-          case SCALE_BY_MAGNITUDE:
-            scalex = scaley = scalez = vtkMath::Norm(tuple, scaleArray->GetNumberOfComponents());
-            break;
-          case SCALE_BY_COMPONENTS:
-            if (scaleArray->GetNumberOfComponents() != 3)
+          int index = -1;
+          if (!maskArray || maskArray->GetValue(inPtId) != 0)
+          {
+            index = 0;
+            // Compute index into table of glyphs
+            if (indexArray)
             {
-              vtkErrorMacro("Cannot scale by components since " << scaleArray->GetName()
-                                                                << " does not have 3 components.");
+              indexArray->GetTuple(inPtId, indexTuple.data());
+              double value = vtkMath::Norm(indexTuple.data(), static_cast<int>(indexTuple.size()));
+              index = vtkMath::ClampValue(static_cast<int>(value), 0, numEntries - 1);
             }
-            else
+            // Make sure we're not indexing into empty glyph
+            if (index >= numEntries || !sourceCache[index])
             {
-              scalex = tuple[0];
-              scaley = tuple[1];
-              scalez = tuple[2];
+              index = -1;
             }
-            break;
-          case NO_DATA_SCALING:
-          default:
-            break;
+          }
+          pointEntries[inPtId] = index;
+          if (index >= 0)
+          {
+            counts[index]++;
+          }
         }
+      }
+    });
+
+  for (int cc = 0; cc < numEntries; cc++)
+  {
+    int numEntryPoints = 0;
+    for (vtkIdType chunk = 0; chunk < numChunks; ++chunk)
+    {
+      int& offset = chunkOffsets[chunk * numEntries + cc];
+      const int count = offset;
+      offset = numEntryPoints;
+      numEntryPoints += count;
+    }
+
+    vtkOpenGLGlyph3DMapper::vtkOpenGLGlyph3DMapperEntry* entry = subarray->Entries[cc];
+    entry->PickIds.resize(numEntryPoints);
+    entry->Colors.resize(numEntryPoints * 4);
+    entry->Matrices.resize(numEntryPoints * 16);
+    entry->NormalMatrices.resize(numEntryPoints * 9);
+    entry->NumberOfPoints = numEntryPoints;
+    entry->BuildTime.Modified();
+  }
 
-        // Clamp data scale if enabled
-        if (this->Clamping && this->ScaleMode != NO_DATA_SCALING)
+  // loop over every point and fill structures
+  std::atomic<bool> aborted(false);
+  vtkSMPTools::For(0, numChunks, 1,
+    [&](vtkIdType firstChunk, vtkIdType lastChunk)
+    {
+      std::vector<double> scaleTuple(scaleArray ? scaleArray->GetNumberOfComponents() : 0);
+      std::vector<int> slots(numEntries);
+      double trans[16];
+      double normalTrans[9];
+      bool isFirst = vtkSMPTools::GetSingleThread();
+      for (vtkIdType chunk = firstChunk; chunk < lastChunk; ++chunk)
+      {
+        if (isFirst)
         {
-          scalex = (scalex < this->Range[0] ? this->Range[0]
-                                            : (scalex > this->Range[1] ? this->Range[1] : scalex));
-          scalex = (scalex - this->Range[0]) / den;
-          scaley = (scaley < this->Range[0] ? this->Range[0]
-                                            : (scaley > this->Range[1] ? this->Range[1] : scaley));
-          scaley = (scaley - this->Range[0]) / den;
-          scalez = (scalez < this->Range[0] ? this->Range[0]
-                                            : (scalez > this->Range[1] ? this->Range[1] : scalez));
-          scalez = (scalez - this->Range[0]) / den;
+          this->UpdateProgress(static_cast<double>(chunk) / numChunks);
+          if (this->GetAbortExecute())
+          {
+            aborted = true;
+          }
+        }
+        if (aborted)
+        {
+          break;
         }
-      }
-      scalex *= this->ScaleFactor;
-      scaley *= this->ScaleFactor;
-      scalez *= this->ScaleFactor;
-
-      // Now begin copying/transforming glyph
-      vtkMatrix4x4::Identity(trans);
-      vtkMatrix3x3::Identity(normalTrans);
-
-      // translate Source to Input point
-      double x[3];
-      dataset->GetPoint(inPtId, x);
-      trans[3] = x[0];
-      trans[7] = x[1];
-      trans[11] = x[2];
-
-      if (orientArray)
-      {
-        double orientation[4];
-        orientArray->GetTuple(inPtId, orientation);
-
-        double rotMatrix[3][3];
-        vtkQuaterniond quaternion;
 
-        switch (this->OrientationMode)
+        std::copy_n(chunkOffsets.data() + chunk * numEntries, numEntries, slots.data());
+        const vtkIdType lastPtId = std::min(numPts, (chunk + 1) * chunkSize);
+        for (vtkIdType inPtId = chunk * chunkSize; inPtId < lastPtId; inPtId++)
         {
-          case ROTATION:
+          const int index = pointEntries[inPtId];
+          if (index < 0)
           {
-            double angle = vtkMath::RadiansFromDegrees(orientation[2]);
-            vtkQuaterniond qz(cos(0.5 * angle), 0.0, 0.0, sin(0.5 * angle));
+            continue;
+          }
+          vtkOpenGLGlyph3DMapper::vtkOpenGLGlyph3DMapperEntry* entry = subarray->Entries[index];
+          const int slot = slots[index]++;
 
-            angle = vtkMath::RadiansFromDegrees(orientation[0]);
-            vtkQuaterniond qx(cos(0.5 * angle), sin(0.5 * angle), 0.0, 0.0);
+          unsigned char* entryColor = &entry->Colors[slot * 4];
+          std::copy_n(color, 4, entryColor);
 
-            angle = vtkMath::RadiansFromDegrees(orientation[1]);
-            vtkQuaterniond qy(cos(0.5 * angle), 0.0, sin(0.5 * angle), 0.0);
+          double scalex = 1.0;
+          double scaley = 1.0;
+          double scalez = 1.0;
+          // Get the scalar and vector data
+          if (scaleArray)
+          {
+            scaleArray->GetTuple(inPtId, scaleTuple.data());
+            const double* tuple = scaleTuple.data();
+            switch (this->ScaleMode)
+            {
+              case SCALE_BY_MAGNITUDE:
+                scalex = scaley = scalez =
+                  vtkMath::Norm(tuple, static_cast<int>(scaleTuple.size()));
+                break;
+              case SCALE_BY_COMPONENTS:
+                if (scaleByComponents)
+                {
+                  scalex = tuple[0];
+                  scaley = tuple[1];
+                  scalez = tuple[2];
+                }
+                break;
+              case NO_DATA_SCALING:
+              default:
+                break;
+            }
 
-            quaternion = qz * qx * qy;
+            // Clamp data scale if enabled
+            if (this->Clamping && this->ScaleMode != NO_DATA_SCALING)
+            {
+              scalex = (scalex < this->Range[0]
+                  ? this->Range[0]
+                  : (scalex > this->Range[1] ? this->Range[1] : scalex));
+              scalex = (scalex - this->Range[0]) / den;
+              scaley = (scaley < this->Range[0]
+                  ? this->Range[0]
+                  : (scaley > this->Range[1] ? this->Range[1] : scaley));
+              scaley = (scaley - this->Range[0]) / den;
+              scalez = (scalez < this->Range[0]
+                  ? this->Range[0]
+                  : (scalez > this->Range[1] ? this->Range[1] : scalez));
+              scalez = (scalez - this->Range[0]) / den;
+            }
           }
-          break;
+          scalex *= this->ScaleFactor;
+          scaley *= this->ScaleFactor;
+          scalez *= this->ScaleFactor;
+
+          // Now begin copying/transforming glyph
+          vtkMatrix4x4::Identity(trans);
+          vtkMatrix3x3::Identity(normalTrans);
+
+          // translate Source to Input point
+          double x[3];
+          dataset->GetPoint(inPtId, x);
+          trans[3] = x[0];
+          trans[7] = x[1];
+          trans[11] = x[2];
+
+          if (orientArray)
+          {
+            double orientation[4];
+            orientArray->GetTuple(inPtId, orientation);
 
-          case DIRECTION:
-            if (orientation[1] == 0.0 && orientation[2] == 0.0)
+            double rotMatrix[3][3];
+            vtkQuaterniond quaternion;
+
+            switch (this->OrientationMode)
             {
-              if (orientation[0] < 0) // just flip x if we need to
+              case ROTATION:
               {
-                quaternion.Set(0.0, 0.0, 1.0, 0.0);
+                double angle = vtkMath::RadiansFromDegrees(orientation[2]);
+                vtkQuaterniond qz(cos(0.5 * angle), 0.0, 0.0, sin(0.5 * angle));
+
+                angle = vtkMath::RadiansFromDegrees(orientation[0]);
+                vtkQuaterniond qx(cos(0.5 * angle), sin(0.5 * angle), 0.0, 0.0);
+
+                angle = vtkMath::RadiansFromDegrees(orientation[1]);
+                vtkQuaterniond qy(cos(0.5 * angle), 0.0, sin(0.5 * angle), 0.0);
+
+                quaternion = qz * qx * qy;
               }
+              break;
+
+              case DIRECTION:
+                if (orientation[1] == 0.0 && orientation[2] == 0.0)
+                {
+                  if (orientation[0] < 0) // just flip x if we need to
+                  {
+                    quaternion.Set(0.0, 0.0, 1.0, 0.0);
+                  }
+                }
+                else
+                {
+                  double vMag = vtkMath::Norm(orientation);
+                  double vNew[3];
+                  vNew[0] = (orientation[0] + vMag) / 2.0;
+                  vNew[1] = orientation[1] / 2.0;
+                  vNew[2] = orientation[2] / 2.0;
+
+                  double f = 1.0 / sqrt(vNew[0] * vNew[0] + vNew[1] * vNew[1] + vNew[2] * vNew[2]);
+                  vNew[0] *= f;
+                  vNew[1] *= f;
+                  vNew[2] *= f;
+
+                  quaternion.Set(0.0, vNew[0], vNew[1], vNew[2]);
+                }
+                break;
+
+              case QUATERNION:
+                quaternion.Set(orientation);
+                break;
             }
-            else
-            {
-              double vMag = vtkMath::Norm(orientation);
-              double vNew[3];
-              vNew[0] = (orientation[0] + vMag) / 2.0;
-              vNew[1] = orientation[1] / 2.0;
-              vNew[2] = orientation[2] / 2.0;
-
-              double f = 1.0 / sqrt(vNew[0] * vNew[0] + vNew[1] * vNew[1] + vNew[2] * vNew[2]);
-              vNew[0] *= f;
-              vNew[1] *= f;
-              vNew[2] *= f;
-
-              quaternion.Set(0.0, vNew[0], vNew[1], vNew[2]);
-            }
-            break;
 
-          case QUATERNION:
-            quaternion.Set(orientation);
-            break;
-        }
+            quaternion.ToMatrix3x3(rotMatrix);
 
-        quaternion.ToMatrix3x3(rotMatrix);
+            for (int i = 0; i < 3; i++)
+            {
+              for (int j = 0; j < 3; j++)
+              {
+                trans[4 * i + j] = rotMatrix[i][j];
+                normalTrans[3 * i + j] = rotMatrix[j][i]; // transpose
+              }
+            }
+          }
 
-        for (int i = 0; i < 3; i++)
-        {
-          for (int j = 0; j < 3; j++)
+          // Set pickid
+          // Use selectionArray value or glyph point ID.
+          vtkIdType selectionId = inPtId;
+          if (useSelectionArray)
           {
-            trans[4 * i + j] = rotMatrix[i][j];
-            normalTrans[3 * i + j] = rotMatrix[j][i]; // transpose
+            selectionId = static_cast<vtkIdType>(selectionArray->GetComponent(inPtId, 0));
           }
-        }
-      }
+          entry->PickIds[slot] = selectionId;
 
-      // Set pickid
-      // Use selectionArray value or glyph point ID.
-      vtkIdType selectionId = inPtId;
-      if (this->UseSelectionIds)
-      {
-        if (selectionArray == nullptr || selectionArray->GetNumberOfTuples() == 0)
-        {
-          vtkWarningMacro(<< "UseSelectionIds is true, but selection array"
-                             " is invalid. Ignoring selection array.");
-        }
-        else
-        {
-          selectionId = static_cast<vtkIdType>(*selectionArray->GetTuple(inPtId));
-        }
-      }
-      entry->PickIds[entry->NumberOfPoints] = selectionId;
+          if (colors)
+          {
+            colors->GetTypedTuple(inPtId, entryColor);
+          }
 
-      if (colors)
-      {
-        colors->GetTypedTuple(inPtId, &(entry->Colors[entry->NumberOfPoints * 4]));
-      }
+          // scale data if appropriate
+          if (this->Scaling)
+          {
+            if (scalex == 0.0)
+            {
+              scalex = 1.0e-10;
+            }
+            if (scaley == 0.0)
+            {
+              scaley = 1.0e-10;
+            }
+            if (scalez == 0.0)
+            {
+              scalez = 1.0e-10;
+            }
 
-      // scale data if appropriate
-      if (this->Scaling)
-      {
-        if (scalex == 0.0)
-        {
-          scalex = 1.0e-10;
-        }
-        if (scaley == 0.0)
-        {
-          scaley = 1.0e-10;
-        }
-        if (scalez == 0.0)
-        {
-          scalez = 1.0e-10;
-        }
+            for (int i = 0; i < 3; i++)
+            {
+              // inverse of normal matrix is directly computed with inverse scale
+              trans[4 * i] *= scalex;
+              normalTrans[i] /= scalex;
+              trans[4 * i + 1] *= scaley;
+              normalTrans[i + 3] /= scaley;
+              trans[4 * i + 2] *= scalez;
+              normalTrans[i + 6] /= scalez;
+            }
+          }
 
-        for (int i = 0; i < 3; i++)
-        {
-          // inverse of normal matrix is directly computed with inverse scale
-          trans[4 * i] *= scalex;
-          normalTrans[i] /= scalex;
-          trans[4 * i + 1] *= scaley;
-          normalTrans[i + 3] /= scaley;
-          trans[4 * i + 2] *= scalez;
-          normalTrans[i + 6] /= scalez;
-        }
-      }
+          float* matrices = &entry->Matrices[slot * 16];
+          float* normalMatrices = &entry->NormalMatrices[slot * 9];
 
-      float* matrices = &entry->Matrices[entry->NumberOfPoints * 16];
-      float* normalMatrices = &entry->NormalMatrices[entry->NumberOfPoints * 9];
+          for (int i = 0; i < 4; i++)
+          {
+            for (int j = 0; j < 4; j++)
+            {
+              matrices[i * 4 + j] = trans[j * 4 + i];
+            }
+          }
 
-      for (int i = 0; i < 4; i++)
-      {
-        for (int j = 0; j < 4; j++)
-        {
-          matrices[i * 4 + j] = trans[j * 4 + i];
+          for (int i = 0; i < 3; i++)
+          {
+            for (int j = 0; j < 3; j++)
+            {
+              normalMatrices[i * 3 + j] = normalTrans[i * 3 + j];
+            }
+          }
         }
       }
+    });
 
-      for (int i = 0; i < 3; i++)
-      {
-        for (int j = 0; j < 3; j++)
-        {
-          normalMatrices[i * 3 + j] = normalTrans[i * 3 + j];
-        }
-      }
-      entry->NumberOfPoints++;
+  // The chunks are not filled in order, so nothing is kept from an aborted build, which is
+  // started over on the next render.
+  if (aborted)
+  {
+    for (int cc = 0; cc < numEntries; cc++)
+    {
+      subarray->Entries[cc]->NumberOfPoints = 0;
     }
+    return;
   }
-
   subarray->BuildTime.Modified();
 }
 
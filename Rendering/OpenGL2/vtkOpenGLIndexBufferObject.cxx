@@ -11,10 +11,12 @@
 #include "vtkPoints.h"
 #include "vtkPolygon.h"
 #include "vtkProperty.h"
+#include "vtkSMPTools.h"
 #include "vtkUnsignedCharArray.h"
 
 #include "vtk_glad.h"
 
+#include <algorithm>
 #include <set>
 
 VTK_ABI_NAMESPACE_BEGIN
@@ -30,6 +32,9 @@ vtkOpenGLIndexBufferObject::~vtkOpenGLIndexBufferObject() = default;
 
 namespace
 {
+// Number of cells fanned into triangles by a single task.
+constexpr vtkIdType TRIANGLE_BATCH_SIZE = 10000;
+
 // A worker functor. The calculation is implemented in the function template
 // for operator().
 struct AppendTrianglesWorker
@@ -40,49 +45,42 @@ struct AppendTrianglesWorker
   vtkCellArray* cells;
   vtkIdType vOffset;
 
-  // AoS fast path
-  template <typename ValueType>
-  void operator()(vtkAOSDataArrayTemplate<ValueType>* src)
+  // Fans the cells [begin, end) into the triangles for which isDistinct(id1, id2, id3)
+  // is true, i.e. the non degenerate ones.
+  template <typename CellStateT, typename IsDistinct>
+  void AppendCells(CellStateT& state, vtkIdType begin, vtkIdType end,
+    std::vector<unsigned int>& indices, std::vector<unsigned char>* edges,
+    const IsDistinct& isDistinct)
   {
-    ValueType* points = src->Begin();
-
-    auto cellIter = vtk::TakeSmartPointer(cells->NewIterator());
-
-    for (cellIter->GoToFirstCell(); !cellIter->IsDoneWithTraversal(); cellIter->GoToNextCell())
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
     {
-      vtkIdType cellSize;
-      const vtkIdType* cell;
-      cellIter->GetCurrentCell(cellSize, cell);
+      const auto cell = state.GetCellRange(cellId);
+      const vtkIdType cellSize = cell.size();
 
       if (cellSize >= 3)
       {
-        vtkIdType id1 = cell[0];
-        ValueType* p1 = points + id1 * 3;
+        const vtkIdType id1 = cell[0];
         for (int i = 1; i < cellSize - 1; i++)
         {
-          vtkIdType id2 = cell[i];
-          vtkIdType id3 = cell[i + 1];
-          ValueType* p2 = points + id2 * 3;
-          ValueType* p3 = points + id3 * 3;
-          if ((p1[0] != p2[0] || p1[1] != p2[1] || p1[2] != p2[2]) &&
-            (p3[0] != p2[0] || p3[1] != p2[1] || p3[2] != p2[2]) &&
-            (p3[0] != p1[0] || p3[1] != p1[1] || p3[2] != p1[2]))
+          const vtkIdType id2 = cell[i];
+          const vtkIdType id3 = cell[i + 1];
+          if (isDistinct(id1, id2, id3))
           {
-            indexArray->push_back(static_cast<unsigned int>(id1 + vOffset));
-            indexArray->push_back(static_cast<unsigned int>(id2 + vOffset));
-            indexArray->push_back(static_cast<unsigned int>(id3 + vOffset));
-            if (edgeArray)
+            indices.push_back(static_cast<unsigned int>(id1 + vOffset));
+            indices.push_back(static_cast<unsigned int>(id2 + vOffset));
+            indices.push_back(static_cast<unsigned int>(id3 + vOffset));
+            if (edges)
             {
               int val = cellSize == 3 ? 7 : i == 1 ? 3 : i == cellSize - 2 ? 6 : 2;
               if (edgeFlags)
               {
                 int mask = 0;
                 mask = edgeFlags[id1] + edgeFlags[id2] * 2 + edgeFlags[id3] * 4;
-                edgeArray->push_back(val & mask);
+                edges->push_back(val & mask);
               }
               else
               {
-                edgeArray->push_back(val);
+                edges->push_back(val);
               }
             }
           }
@@ -91,6 +89,69 @@ struct AppendTrianglesWorker
     }
   }
 
+  // Large cell arrays are split in batches fanned in parallel into their own
+  // arrays, which are then appended in order so that the buffers are the same
+  // as with a serial traversal.
+  template <typename IsDistinct>
+  void Execute(const IsDistinct& isDistinct)
+  {
+    this->cells->Visit(
+      [&](auto& state)
+      {
+        const vtkIdType numCells = state.GetNumberOfCells();
+        const vtkIdType numBatches = (numCells + TRIANGLE_BATCH_SIZE - 1) / TRIANGLE_BATCH_SIZE;
+        if (numBatches <= 1)
+        {
+          this->AppendCells(state, 0, numCells, *this->indexArray, this->edgeArray, isDistinct);
+          return;
+        }
+
+        std::vector<std::vector<unsigned int>> batchIndices(numBatches);
+        std::vector<std::vector<unsigned char>> batchEdges(this->edgeArray ? numBatches : 0);
+        vtkSMPTools::For(0, numBatches,
+          [&](vtkIdType firstBatch, vtkIdType lastBatch)
+          {
+            for (vtkIdType batch = firstBatch; batch < lastBatch; ++batch)
+            {
+              const vtkIdType begin = batch * TRIANGLE_BATCH_SIZE;
+              const vtkIdType end = std::min(begin + TRIANGLE_BATCH_SIZE, numCells);
+              batchIndices[batch].reserve(3 * (end - begin));
+              this->AppendCells(state, begin, end, batchIndices[batch],
+                this->edgeArray ? &batchEdges[batch] : nullptr, isDistinct);
+            }
+          });
+
+        for (vtkIdType batch = 0; batch < numBatches; ++batch)
+        {
+          this->indexArray->insert(
+            this->indexArray->end(), batchIndices[batch].begin(), batchIndices[batch].end());
+          if (this->edgeArray)
+          {
+            this->edgeArray->insert(
+              this->edgeArray->end(), batchEdges[batch].begin(), batchEdges[batch].end());
+          }
+        }
+      });
+  }
+
+  // AoS fast path
+  template <typename ValueType>
+  void operator()(vtkAOSDataArrayTemplate<ValueType>* src)
+  {
+    const ValueType* points = src->Begin();
+
+    this->Execute(
+      [points](vtkIdType id1, vtkIdType id2, vtkIdType id3)
+      {
+        const ValueType* p1 = points + id1 * 3;
+        const ValueType* p2 = points + id2 * 3;
+        const ValueType* p3 = points + id3 * 3;
+        return (p1[0] != p2[0] || p1[1] != p2[1] || p1[2] != p2[2]) &&
+          (p3[0] != p2[0] || p3[1] != p2[1] || p3[2] != p2[2]) &&
+          (p3[0] != p1[0] || p3[1] != p1[1] || p3[2] != p1[2]);
+      });
+  }
+
   // Generic API, on VS13 Rel this is about 80% slower than
   // the AOS template above. (We should retest this now that it uses ranges).
   template <typename PointArray>
@@ -98,35 +159,57 @@ struct AppendTrianglesWorker
   {
     const auto points = vtk::DataArrayTupleRange<3>(pointArray);
 
-    auto cellIter = vtk::TakeSmartPointer(cells->NewIterator());
-
-    for (cellIter->GoToFirstCell(); !cellIter->IsDoneWithTraversal(); cellIter->GoToNextCell())
-    {
-      vtkIdType cellSize;
-      const vtkIdType* cell;
-      cellIter->GetCurrentCell(cellSize, cell);
+    this->Execute(
+      [&points](vtkIdType id1, vtkIdType id2, vtkIdType id3)
+      {
+        const auto pt1 = points[id1];
+        const auto pt2 = points[id2];
+        const auto pt3 = points[id3];
+        return pt1 != pt2 && pt1 != pt3 && pt2 != pt3;
+      });
+  }
+};
 
-      if (cellSize >= 3)
+// Copies the connectivity, offset by vOffset, in parallel.
+struct AppendPointsImpl
+{
+  template <typename CellStateT>
+  void operator()(CellStateT& state, unsigned int* output, vtkIdType vOffset)
+  {
+    const auto connectivity = vtk::DataArrayValueRange<1>(state.GetConnectivity());
+    vtkSMPTools::For(0, connectivity.size(),
+      [&](vtkIdType begin, vtkIdType end)
       {
-        const vtkIdType id1 = cell[0];
-        for (int i = 1; i < cellSize - 1; i++)
+        for (vtkIdType i = begin; i < end; ++i)
         {
-          const vtkIdType id2 = cell[i];
-          const vtkIdType id3 = cell[i + 1];
-
-          const auto pt1 = points[id1];
-          const auto pt2 = points[id2];
-          const auto pt3 = points[id3];
+          output[i] = static_cast<unsigned int>(connectivity[i] + vOffset);
+        }
+      });
+  }
+};
 
-          if (pt1 != pt2 && pt1 != pt3 && pt2 != pt3)
+// Writes the closed loop of segments of every cell in parallel. Each cell of
+// n points produces n segments, so its segments start at twice its offset.
+struct AppendTriangleLinesImpl
+{
+  template <typename CellStateT>
+  void operator()(CellStateT& state, unsigned int* output, vtkIdType vOffset)
+  {
+    vtkSMPTools::For(0, state.GetNumberOfCells(),
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        for (vtkIdType cellId = begin; cellId < end; ++cellId)
+        {
+          const auto indices = state.GetCellRange(cellId);
+          const vtkIdType npts = indices.size();
+          unsigned int* segments = output + 2 * state.GetBeginOffset(cellId);
+          for (vtkIdType i = 0; i < npts; ++i)
           {
-            indexArray->push_back(static_cast<unsigned int>(id1 + vOffset));
-            indexArray->push_back(static_cast<unsigned int>(id2 + vOffset));
-            indexArray->push_back(static_cast<unsigned int>(id3 + vOffset));
+            *(segments++) = static_cast<unsigned int>(indices[i] + vOffset);
+            *(segments++) = static_cast<unsigned int>(indices[i < npts - 1 ? i + 1 : 0] + vOffset);
           }
         }
-      }
-    }
+      });
   }
 };
 
@@ -220,8 +303,6 @@ size_t vtkOpenGLIndexBufferObject::CreateTriangleIndexBuffer(vtkCellArray* cells
 void vtkOpenGLIndexBufferObject::AppendPointIndexBuffer(
   std::vector<unsigned int>& indexArray, vtkCellArray* cells, vtkIdType vOffset)
 {
-  const vtkIdType* indices(nullptr);
-  vtkIdType npts(0);
   size_t targetSize = indexArray.size() + cells->GetNumberOfConnectivityIds();
   if (targetSize > indexArray.capacity())
   {
@@ -232,13 +313,9 @@ void vtkOpenGLIndexBufferObject::AppendPointIndexBuffer(
     indexArray.reserve(targetSize);
   }
 
-  for (cells->InitTraversal(); cells->GetNextCell(npts, indices);)
-  {
-    for (int i = 0; i < npts; ++i)
-    {
-      indexArray.push_back(static_cast<unsigned int>(*(indices++) + vOffset));
-    }
-  }
+  const size_t offset = indexArray.size();
+  indexArray.resize(offset + cells->GetNumberOfConnectivityIds());
+  cells->Visit(AppendPointsImpl{}, indexArray.data() + offset, vOffset);
 }
 
 // used to create an IBO for triangle primitives
@@ -263,8 +340,6 @@ size_t vtkOpenGLIndexBufferObject::CreatePointIndexBuffer(vtkCellArray* cells)
 void vtkOpenGLIndexBufferObject::AppendTriangleLineIndexBuffer(
   std::vector<unsigned int>& indexArray, vtkCellArray* cells, vtkIdType vOffset)
 {
-  const vtkIdType* indices(nullptr);
-  vtkIdType npts(0);
   size_t targetSize = indexArray.size() + 2 * cells->GetNumberOfConnectivityIds();
   if (targetSize > indexArray.capacity())
   {
@@ -275,14 +350,9 @@ void vtkOpenGLIndexBufferObject::AppendTriangleLineIndexBuffer(
     indexArray.reserve(targetSize);
   }
 
-  for (cells->InitTraversal(); cells->GetNextCell(npts, indices);)
-  {
-    for (int i = 0; i < npts; ++i)
-    {
-      indexArray.push_back(static_cast<unsigned int>(indices[i] + vOffset));
-      indexArray.push_back(static_cast<unsigned int>(indices[i < npts - 1 ? i + 1 : 0] + vOffset));
-    }
-  }
+  const size_t offset = indexArray.size();
+  indexArray.resize(offset + 2 * cells->GetNumberOfConnectivityIds());
+  cells->Visit(AppendTriangleLinesImpl{}, indexArray.data() + offset, vOffset);
 }
 
 // used to create an IBO for primitives as lines.  This method treats each line segment
@@ -10,6 +10,7 @@
 #include "vtkOpenGLVertexBufferObjectCache.h"
 #include "vtkPoints.h"
 #include "vtkProp3D.h"
+#include "vtkSMPTools.h"
 
 #include "vtk_glad.h"
 
@@ -286,13 +287,14 @@ void vtkAppendVBOWorker<destType>::operator()(vtkAOSDataArrayTemplate<ValueType>
 
   destType* VBOit = reinterpret_cast<destType*>(&this->VBO->GetPackedVBO()[this->Offset]);
 
-  ValueType* input = src->Begin();
+  const ValueType* input = src->Begin();
   unsigned int numComps = this->VBO->GetNumberOfComponents();
   unsigned int numTuples = src->GetNumberOfTuples();
 
   // compute extra padding required
   int bytesNeeded = this->VBO->GetDataTypeSize() * this->VBO->GetNumberOfComponents();
   int extraComponents = ((4 - (bytesNeeded % 4)) % 4) / this->VBO->GetDataTypeSize();
+  const vtkIdType vboStride = numComps + extraComponents;
 
   // If not shift & scale
   if (!this->VBO->GetCoordShiftAndScaleEnabled())
@@ -304,26 +306,40 @@ void vtkAppendVBOWorker<destType>::operator()(vtkAOSDataArrayTemplate<ValueType>
     }
     else
     {
-      for (unsigned int i = 0; i < numTuples; ++i)
-      {
-        for (unsigned int j = 0; j < numComps; j++)
+      vtkSMPTools::For(0, numTuples,
+        [&](vtkIdType begin, vtkIdType end)
         {
-          *(VBOit++) = *(input++);
-        }
-        VBOit += extraComponents;
-      }
+          const ValueType* in = input + begin * numComps;
+          destType* out = VBOit + begin * vboStride;
+          for (vtkIdType i = begin; i < end; ++i)
+          {
+            for (unsigned int j = 0; j < numComps; j++)
+            {
+              *(out++) = *(in++);
+            }
+            out += extraComponents;
+          }
+        });
     }
   }
   else
   {
-    for (unsigned int i = 0; i < numTuples; ++i)
-    {
-      for (unsigned int j = 0; j < numComps; j++)
+    const double* shift = this->Shift.data();
+    const double* scale = this->Scale.data();
+    vtkSMPTools::For(0, numTuples,
+      [&](vtkIdType begin, vtkIdType end)
       {
-        *(VBOit++) = (*(input++) - this->Shift.at(j)) * this->Scale.at(j);
-      }
-      VBOit += extraComponents;
-    }
+        const ValueType* in = input + begin * numComps;
+        destType* out = VBOit + begin * vboStride;
+        for (vtkIdType i = begin; i < end; ++i)
+        {
+          for (unsigned int j = 0; j < numComps; j++)
+          {
+            *(out++) = (*(in++) - shift[j]) * scale[j];
+          }
+          out += extraComponents;
+        }
+      });
   } // end if shift*scale
 }
 
@@ -340,32 +356,39 @@ void vtkAppendVBOWorker<destType>::operator()(DataArray* array)
 
   destType* VBOit = reinterpret_cast<destType*>(&this->VBO->GetPackedVBO()[this->Offset]);
 
-  const auto dataRange = vtk::DataArrayTupleRange(array);
-
   // compute extra padding required
   int bytesNeeded = this->VBO->GetDataTypeSize() * this->VBO->GetNumberOfComponents();
   int extraComponents = ((4 - (bytesNeeded % 4)) % 4) / this->VBO->GetDataTypeSize();
+  const vtkIdType vboStride = this->VBO->GetNumberOfComponents() + extraComponents;
+  const bool shiftScale = this->VBO->GetCoordShiftAndScaleEnabled();
 
-  // If not shift & scale
-  if (!this->VBO->GetCoordShiftAndScaleEnabled())
-  {
-    for (const auto tuple : dataRange)
-    {
-      VBOit = std::copy(tuple.cbegin(), tuple.cend(), VBOit);
-      VBOit += extraComponents;
-    }
-  }
-  else
-  {
-    for (const auto tuple : dataRange)
+  vtkSMPTools::For(0, array->GetNumberOfTuples(),
+    [&](vtkIdType begin, vtkIdType end)
     {
-      for (int j = 0; j < tuple.size(); ++j)
+      const auto dataRange = vtk::DataArrayTupleRange(array, begin, end);
+      destType* out = VBOit + begin * vboStride;
+
+      // If not shift & scale
+      if (!shiftScale)
       {
-        *(VBOit++) = (tuple[j] - this->Shift[j]) * this->Scale[j];
+        for (const auto tuple : dataRange)
+        {
+          out = std::copy(tuple.cbegin(), tuple.cend(), out);
+          out += extraComponents;
+        }
       }
-      VBOit += extraComponents;
-    }
-  } // end if shift*scale
+      else
+      {
+        for (const auto tuple : dataRange)
+        {
+          for (int j = 0; j < tuple.size(); ++j)
+          {
+            *(out++) = (tuple[j] - this->Shift[j]) * this->Scale[j];
+          }
+          out += extraComponents;
+        }
+      } // end if shift*scale
+    });
 }
 
 } // end anon namespace
@@ -538,9 +561,10 @@ void vtkOpenGLVertexBufferObject::UploadDataArray(vtkDataArray* array)
   // handle any shift scale calcs required before upload
   this->UpdateShiftScale(array);
 
-  // can we use the fast path and just upload the raw array?
+  // can we use the fast path and just upload the raw array? Arrays with another memory layout,
+  // e.g. implicit or quantized arrays, would be copied to a contiguous buffer by GetVoidPointer.
   if (!this->GetCoordShiftAndScaleEnabled() && this->DataType == array->GetDataType() &&
-    extraComponents == 0)
+    extraComponents == 0 && array->HasStandardMemoryLayout())
   {
     this->NumberOfTuples = array->GetNumberOfTuples();
     this->PackedVBO.resize(0);
@@ -548,7 +572,8 @@ void vtkOpenGLVertexBufferObject::UploadDataArray(vtkDataArray* array)
       this->NumberOfTuples * this->Stride / sizeof(float), vtkOpenGLBufferObject::ArrayBuffer);
     this->UploadTime.Modified();
   }
-  // otherwise use a worker to build the array to upload
+  // otherwise use a worker to build the array to upload, quantized arrays are
+  // dequantized to the data type of the VBO
   else
   {
     this->NumberOfTuples = array->GetNumberOfTuples();
@@ -0,0 +1,124 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Composites synthetic images with vtkRadixKCompositer and compares the
+// result on process 0 with a depth test of all the images done locally.
+
+#include "vtkFloatArray.h"
+#include "vtkMPIController.h"
+#include "vtkNew.h"
+#include "vtkRadixKCompositer.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+const int Width = 97;
+const int Height = 61;
+
+// Each process draws a disk at its own depth; everything else is background.
+void FillImage(int rank, int numProcs, vtkUnsignedCharArray* colors, vtkFloatArray* depths)
+{
+  const int numPixels = Width * Height;
+  colors->SetNumberOfComponents(4);
+  colors->SetNumberOfTuples(numPixels);
+  depths->SetNumberOfTuples(numPixels);
+  const double cx = Width * (rank + 1.0) / (numProcs + 1.0);
+  const double cy = Height * 0.5;
+  const double radius = Height * 0.3;
+  for (int j = 0; j < Height; ++j)
+  {
+    for (int i = 0; i < Width; ++i)
+    {
+      const int idx = j * Width + i;
+      const bool inside = (i - cx) * (i - cx) + (j - cy) * (j - cy) < radius * radius;
+      unsigned char pixel[4] = { 0, 0, 0, 255 };
+      if (inside)
+      {
+        pixel[0] = static_cast<unsigned char>(10 + rank);
+        pixel[1] = static_cast<unsigned char>(rank);
+      }
+      colors->SetTypedTuple(idx, pixel);
+      depths->SetValue(idx, inside ? static_cast<float>(0.9 - 0.1 * ((rank * 7) % 5)) : 1.0f);
+    }
+  }
+}
+
+bool RunComposite(vtkMPIController* controller, int radix, int tileSize, bool compress)
+{
+  const int rank = controller->GetLocalProcessId();
+  const int numProcs = controller->GetNumberOfProcesses();
+
+  vtkNew<vtkUnsignedCharArray> colors;
+  vtkNew<vtkFloatArray> depths;
+  vtkNew<vtkUnsignedCharArray> tmpColors;
+  vtkNew<vtkFloatArray> tmpDepths;
+  FillImage(rank, numProcs, colors, depths);
+
+  vtkNew<vtkRadixKCompositer> compositer;
+  compositer->SetController(controller);
+  compositer->SetRadix(radix);
+  compositer->SetTileSize(tileSize);
+  compositer->SetCompressTiles(compress);
+  compositer->CompositeBuffer(colors, depths, tmpColors, tmpDepths);
+
+  int ok = 1;
+  if (rank == 0)
+  {
+    vtkNew<vtkUnsignedCharArray> expectedColors;
+    vtkNew<vtkFloatArray> expectedDepths;
+    FillImage(0, numProcs, expectedColors, expectedDepths);
+    for (int p = 1; p < numProcs; ++p)
+    {
+      vtkNew<vtkUnsignedCharArray> otherColors;
+      vtkNew<vtkFloatArray> otherDepths;
+      FillImage(p, numProcs, otherColors, otherDepths);
+      for (vtkIdType i = 0; i < expectedDepths->GetNumberOfTuples(); ++i)
+      {
+        if (otherDepths->GetValue(i) < expectedDepths->GetValue(i))
+        {
+          expectedDepths->SetValue(i, otherDepths->GetValue(i));
+          unsigned char pixel[4];
+          otherColors->GetTypedTuple(i, pixel);
+          expectedColors->SetTypedTuple(i, pixel);
+        }
+      }
+    }
+
+    for (vtkIdType i = 0; i < expectedDepths->GetNumberOfTuples() && ok; ++i)
+    {
+      unsigned char expected[4];
+      unsigned char actual[4];
+      expectedColors->GetTypedTuple(i, expected);
+      colors->GetTypedTuple(i, actual);
+      if (expectedDepths->GetValue(i) != depths->GetValue(i) || expected[0] != actual[0] ||
+        expected[1] != actual[1] || expected[2] != actual[2] || expected[3] != actual[3])
+      {
+        std::cerr << "Radix " << radix << ", tile size " << tileSize << ", compression "
+                  << compress << ": wrong pixel " << i << std::endl;
+        ok = 0;
+      }
+    }
+  }
+  controller->Broadcast(&ok, 1, 0);
+  return ok == 1;
+}
+}
+
+int TestRadixKCompositer(int argc, char* argv[])
+{
+  vtkNew<vtkMPIController> controller;
+  controller->Initialize(&argc, &argv, 0);
+
+  bool success = true;
+  for (int radix : { 2, 3, 4 })
+  {
+    success &= RunComposite(controller, radix, 16, false);
+    success &= RunComposite(controller, radix, 64, true);
+    success &= RunComposite(controller, radix, 4096, true);
+  }
+
+  controller->Finalize();
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,400 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkRadixKCompositer.h"
+
+#include "vtkDataArray.h"
+#include "vtkFloatArray.h"
+#include "vtkMultiProcessController.h"
+#include "vtkObjectFactory.h"
+#include "vtkTimerLog.h"
+
+#include "vtk_lz4.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+VTK_ABI_NAMESPACE_BEGIN
+vtkStandardNewMacro(vtkRadixKCompositer);
+
+namespace
+{
+constexpr int RADIXK_HEADER_TAG = 197;
+constexpr int RADIXK_DATA_TAG = 198;
+
+// Messages smaller than this are not worth compressing.
+constexpr int RADIXK_MIN_COMPRESS_SIZE = 1024;
+
+struct ImageView
+{
+  float* Z;
+  unsigned char* P;
+  size_t PixelSize;
+};
+
+//------------------------------------------------------------------------------
+// Chooses the radix of every round. The product of the radices is the
+// number of processes that take part in the swap; any process beyond
+// that folds its image into a partner first.
+std::vector<int> ComputeRounds(int numProcs, int radix)
+{
+  std::vector<int> rounds;
+  int product = 1;
+  while (product * radix <= numProcs)
+  {
+    rounds.push_back(radix);
+    product *= radix;
+  }
+  for (int k = radix - 1; k >= 2; --k)
+  {
+    if (product * k <= numProcs)
+    {
+      rounds.push_back(k);
+      break;
+    }
+  }
+  return rounds;
+}
+
+//------------------------------------------------------------------------------
+// Range of pixels that piece j out of k covers in [begin, end).
+void SplitRange(vtkIdType begin, vtkIdType end, int j, int k, vtkIdType& pieceBegin,
+  vtkIdType& pieceEnd)
+{
+  const vtkIdType length = end - begin;
+  pieceBegin = begin + (length * j) / k;
+  pieceEnd = begin + (length * (j + 1)) / k;
+}
+
+//------------------------------------------------------------------------------
+// Range of pixels process id is responsible for once all rounds are done.
+void ComputeRegion(
+  int id, const std::vector<int>& rounds, vtkIdType numPixels, vtkIdType& begin, vtkIdType& end)
+{
+  begin = 0;
+  end = numPixels;
+  int stride = 1;
+  for (int k : rounds)
+  {
+    SplitRange(begin, end, (id / stride) % k, k, begin, end);
+    stride *= k;
+  }
+}
+
+//------------------------------------------------------------------------------
+// Serializes pixels [begin, end) of the image. The layout is one flag per
+// tile (1 when the tile contains geometry), one background pixel, then the
+// depth values followed by the colors of the non-empty tiles only.
+void EncodePiece(const ImageView& image, vtkIdType begin, vtkIdType end, vtkIdType tileSize,
+  std::vector<unsigned char>& buffer)
+{
+  const vtkIdType numTiles = (end - begin + tileSize - 1) / tileSize;
+  buffer.assign(numTiles + image.PixelSize, 0);
+
+  vtkIdType numPixels = 0;
+  bool haveBackground = false;
+  for (vtkIdType t = 0; t < numTiles; ++t)
+  {
+    const vtkIdType tileBegin = begin + t * tileSize;
+    const vtkIdType tileEnd = std::min(tileBegin + tileSize, end);
+    const float* z = image.Z + tileBegin;
+    const float* zEnd = image.Z + tileEnd;
+    if (std::find_if(z, zEnd, [](float depth) { return depth < 1.0f; }) != zEnd)
+    {
+      buffer[t] = 1;
+      numPixels += tileEnd - tileBegin;
+    }
+    else if (!haveBackground)
+    {
+      std::memcpy(&buffer[numTiles], image.P + tileBegin * image.PixelSize, image.PixelSize);
+      haveBackground = true;
+    }
+  }
+
+  const size_t offset = buffer.size();
+  buffer.resize(offset + numPixels * (sizeof(float) + image.PixelSize));
+  unsigned char* zOut = buffer.data() + offset;
+  unsigned char* pOut = zOut + numPixels * sizeof(float);
+  for (vtkIdType t = 0; t < numTiles; ++t)
+  {
+    if (!buffer[t])
+    {
+      continue;
+    }
+    const vtkIdType tileBegin = begin + t * tileSize;
+    const vtkIdType count = std::min(tileBegin + tileSize, end) - tileBegin;
+    std::memcpy(zOut, image.Z + tileBegin, count * sizeof(float));
+    std::memcpy(pOut, image.P + tileBegin * image.PixelSize, count * image.PixelSize);
+    zOut += count * sizeof(float);
+    pOut += count * image.PixelSize;
+  }
+}
+
+//------------------------------------------------------------------------------
+// Reads a piece written by EncodePiece into pixels [begin, end) of the
+// image. When composite is true, incoming pixels only replace closer ones
+// and empty tiles leave the image untouched. Otherwise the piece is copied
+// as is and empty tiles are filled with the background pixel.
+void DecodePiece(const std::vector<unsigned char>& buffer, const ImageView& image,
+  vtkIdType begin, vtkIdType end, vtkIdType tileSize, bool composite)
+{
+  const vtkIdType numTiles = (end - begin + tileSize - 1) / tileSize;
+  const unsigned char* background = buffer.data() + numTiles;
+
+  vtkIdType numPixels = 0;
+  for (vtkIdType t = 0; t < numTiles; ++t)
+  {
+    if (buffer[t])
+    {
+      const vtkIdType tileBegin = begin + t * tileSize;
+      numPixels += std::min(tileBegin + tileSize, end) - tileBegin;
+    }
+  }
+  const unsigned char* zIn = background + image.PixelSize;
+  const unsigned char* pIn = zIn + numPixels * sizeof(float);
+
+  for (vtkIdType t = 0; t < numTiles; ++t)
+  {
+    const vtkIdType tileBegin = begin + t * tileSize;
+    const vtkIdType count = std::min(tileBegin + tileSize, end) - tileBegin;
+    float* z = image.Z + tileBegin;
+    unsigned char* p = image.P + tileBegin * image.PixelSize;
+    if (!buffer[t])
+    {
+      if (!composite)
+      {
+        std::fill(z, z + count, 1.0f);
+        for (vtkIdType i = 0; i < count; ++i, p += image.PixelSize)
+        {
+          std::memcpy(p, background, image.PixelSize);
+        }
+      }
+      continue;
+    }
+
+    if (composite)
+    {
+      for (vtkIdType i = 0; i < count; ++i)
+      {
+        float remoteZ;
+        std::memcpy(&remoteZ, zIn + i * sizeof(float), sizeof(float));
+        if (remoteZ < z[i])
+        {
+          z[i] = remoteZ;
+          std::memcpy(p + i * image.PixelSize, pIn + i * image.PixelSize, image.PixelSize);
+        }
+      }
+    }
+    else
+    {
+      std::memcpy(z, zIn, count * sizeof(float));
+      std::memcpy(p, pIn, count * image.PixelSize);
+    }
+    zIn += count * sizeof(float);
+    pIn += count * image.PixelSize;
+  }
+}
+
+//------------------------------------------------------------------------------
+void SendPiece(vtkMultiProcessController* controller, int remoteId,
+  const std::vector<unsigned char>& raw, bool compress, std::vector<unsigned char>& scratch)
+{
+  // header[0] is the size of the encoded piece, header[1] the size of its
+  // LZ4 compressed form or 0 when it is sent uncompressed.
+  int header[2] = { static_cast<int>(raw.size()), 0 };
+  const unsigned char* payload = raw.data();
+  vtkIdType payloadSize = header[0];
+
+  if (compress && header[0] >= RADIXK_MIN_COMPRESS_SIZE)
+  {
+    scratch.resize(LZ4_compressBound(header[0]));
+    const int compressedSize = LZ4_compress_default(reinterpret_cast<const char*>(raw.data()),
+      reinterpret_cast<char*>(scratch.data()), header[0], static_cast<int>(scratch.size()));
+    if (compressedSize > 0 && compressedSize < header[0])
+    {
+      header[1] = compressedSize;
+      payload = scratch.data();
+      payloadSize = compressedSize;
+    }
+  }
+
+  controller->Send(header, 2, remoteId, RADIXK_HEADER_TAG);
+  controller->Send(payload, payloadSize, remoteId, RADIXK_DATA_TAG);
+}
+
+//------------------------------------------------------------------------------
+bool ReceivePiece(vtkMultiProcessController* controller, int remoteId,
+  std::vector<unsigned char>& raw, std::vector<unsigned char>& scratch)
+{
+  int header[2] = { 0, 0 };
+  controller->Receive(header, 2, remoteId, RADIXK_HEADER_TAG);
+  raw.resize(header[0]);
+  if (header[1] == 0)
+  {
+    controller->Receive(raw.data(), header[0], remoteId, RADIXK_DATA_TAG);
+    return true;
+  }
+
+  scratch.resize(header[1]);
+  controller->Receive(scratch.data(), header[1], remoteId, RADIXK_DATA_TAG);
+  return LZ4_decompress_safe(reinterpret_cast<const char*>(scratch.data()),
+           reinterpret_cast<char*>(raw.data()), header[1], header[0]) == header[0];
+}
+}
+
+//------------------------------------------------------------------------------
+vtkRadixKCompositer::vtkRadixKCompositer()
+{
+  this->Radix = 2;
+  this->TileSize = 4096;
+  this->CompressTiles = true;
+}
+
+//------------------------------------------------------------------------------
+vtkRadixKCompositer::~vtkRadixKCompositer() = default;
+
+//------------------------------------------------------------------------------
+void vtkRadixKCompositer::CompositeBuffer(
+  vtkDataArray* pBuf, vtkFloatArray* zBuf, vtkDataArray* pTmp, vtkFloatArray* zTmp)
+{
+  // The exchanged pieces are kept in internal buffers.
+  (void)pTmp;
+  (void)zTmp;
+
+  int myId = this->Controller->GetLocalProcessId();
+  int numProcs = this->NumberOfProcesses;
+  if (numProcs <= 1 || myId >= numProcs)
+  {
+    return;
+  }
+
+  const vtkIdType numPixels = zBuf->GetNumberOfTuples();
+  if (pBuf->GetNumberOfTuples() != numPixels)
+  {
+    vtkErrorMacro("Color and depth buffers do not have the same number of pixels.");
+    return;
+  }
+
+  ImageView image;
+  image.Z = zBuf->GetPointer(0);
+  image.P = static_cast<unsigned char*>(pBuf->GetVoidPointer(0));
+  image.PixelSize = static_cast<size_t>(pBuf->GetNumberOfComponents()) * pBuf->GetDataTypeSize();
+  const vtkIdType tileSize = this->TileSize;
+  const bool compress = this->CompressTiles;
+  vtkMultiProcessController* controller = this->Controller;
+
+  vtkTimerLog::MarkStartEvent("RadixK Composite");
+
+  std::vector<int> rounds = ComputeRounds(numProcs, this->Radix);
+  int numActive = 1;
+  for (int k : rounds)
+  {
+    numActive *= k;
+  }
+
+  std::vector<unsigned char> raw;
+  std::vector<unsigned char> scratch;
+
+  // Processes that do not fit in the rounds hand their whole image over.
+  if (myId >= numActive)
+  {
+    EncodePiece(image, 0, numPixels, tileSize, raw);
+    SendPiece(controller, myId - numActive, raw, compress, scratch);
+    vtkTimerLog::MarkEndEvent("RadixK Composite");
+    return;
+  }
+  if (myId + numActive < numProcs)
+  {
+    if (ReceivePiece(controller, myId + numActive, raw, scratch))
+    {
+      DecodePiece(raw, image, 0, numPixels, tileSize, true);
+    }
+    else
+    {
+      vtkErrorMacro("Could not decompress image from process " << myId + numActive);
+    }
+  }
+
+  // Within every group of k processes, member j keeps the j-th piece of the
+  // current region and exchanges all other pieces with the other members.
+  vtkIdType begin = 0;
+  vtkIdType end = numPixels;
+  int stride = 1;
+  for (int k : rounds)
+  {
+    const int member = (myId / stride) % k;
+    const int groupBase = myId - member * stride;
+    vtkIdType keepBegin, keepEnd;
+    SplitRange(begin, end, member, k, keepBegin, keepEnd);
+
+    // All members visit their pairs in the same order: the lower member of
+    // a pair sends first. This does not deadlock with blocking sends.
+    for (int m = 0; m < k; ++m)
+    {
+      if (m == member)
+      {
+        continue;
+      }
+      const int partner = groupBase + m * stride;
+      vtkIdType sendBegin, sendEnd;
+      SplitRange(begin, end, m, k, sendBegin, sendEnd);
+
+      if (member < m)
+      {
+        EncodePiece(image, sendBegin, sendEnd, tileSize, raw);
+        SendPiece(controller, partner, raw, compress, scratch);
+      }
+      if (ReceivePiece(controller, partner, raw, scratch))
+      {
+        DecodePiece(raw, image, keepBegin, keepEnd, tileSize, true);
+      }
+      else
+      {
+        vtkErrorMacro("Could not decompress image piece from process " << partner);
+      }
+      if (member > m)
+      {
+        EncodePiece(image, sendBegin, sendEnd, tileSize, raw);
+        SendPiece(controller, partner, raw, compress, scratch);
+      }
+    }
+
+    begin = keepBegin;
+    end = keepEnd;
+    stride *= k;
+  }
+
+  // Collect the composited regions on process 0.
+  if (myId == 0)
+  {
+    for (int id = 1; id < numActive; ++id)
+    {
+      ComputeRegion(id, rounds, numPixels, begin, end);
+      if (ReceivePiece(controller, id, raw, scratch))
+      {
+        DecodePiece(raw, image, begin, end, tileSize, false);
+      }
+      else
+      {
+        vtkErrorMacro("Could not decompress image piece from process " << id);
+      }
+    }
+  }
+  else
+  {
+    EncodePiece(image, begin, end, tileSize, raw);
+    SendPiece(controller, 0, raw, compress, scratch);
+  }
+
+  vtkTimerLog::MarkEndEvent("RadixK Composite");
+}
+
+//------------------------------------------------------------------------------
+void vtkRadixKCompositer::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Radix: " << this->Radix << endl;
+  os << indent << "TileSize: " << this->TileSize << endl;
+  os << indent << "CompressTiles: " << (this->CompressTiles ? "On" : "Off") << endl;
+}
+VTK_ABI_NAMESPACE_END
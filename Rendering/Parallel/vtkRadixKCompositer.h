@@ -0,0 +1,89 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkRadixKCompositer
+ * @brief   Implements radix-k (and binary-swap) sort-last compositing.
+ *
+ *
+ * vtkRadixKCompositer composites the color and depth buffers of all
+ * processes by repeatedly splitting the image among groups of processes,
+ * so that each process only ever exchanges the part of the image it is
+ * responsible for instead of the whole frame. With a Radix of 2 this is the
+ * classic binary-swap algorithm; larger radices reduce the number of rounds
+ * at the cost of more messages per round. When the number of processes is
+ * not a product of the chosen radices, the extra processes first fold their
+ * image into a partner.
+ *
+ * Every exchanged piece is split into tiles of TileSize pixels. Tiles that
+ * only contain background (depth of 1.0) are not sent at all, and the
+ * remaining payload can be compressed with LZ4 (see CompressTiles). At the
+ * end, every process sends its fully composited region to process 0, where
+ * the final image is put into pBuf and zBuf.
+ *
+ * Like the other compositers, it will not handle transparency. Use it with
+ * vtkCompositeRenderManager::SetCompositer().
+ *
+ * @sa
+ * vtkCompositer vtkTreeCompositer vtkCompressCompositer vtkCompositeRenderManager
+ */
+
+#ifndef vtkRadixKCompositer_h
+#define vtkRadixKCompositer_h
+
+#include "vtkCompositer.h"
+#include "vtkRenderingParallelModule.h" // For export macro
+
+VTK_ABI_NAMESPACE_BEGIN
+class VTKRENDERINGPARALLEL_EXPORT vtkRadixKCompositer : public vtkCompositer
+{
+public:
+  static vtkRadixKCompositer* New();
+  vtkTypeMacro(vtkRadixKCompositer, vtkCompositer);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  void CompositeBuffer(
+    vtkDataArray* pBuf, vtkFloatArray* zBuf, vtkDataArray* pTmp, vtkFloatArray* zTmp) override;
+
+  ///@{
+  /**
+   * Number of processes that exchange image pieces in each round.
+   * 2 (the default) gives binary-swap compositing.
+   */
+  vtkSetClampMacro(Radix, int, 2, 64);
+  vtkGetMacro(Radix, int);
+  ///@}
+
+  ///@{
+  /**
+   * Number of pixels per tile. Tiles containing only background pixels are
+   * skipped when pieces are exchanged. Default is 4096.
+   */
+  vtkSetClampMacro(TileSize, int, 16, VTK_INT_MAX);
+  vtkGetMacro(TileSize, int);
+  ///@}
+
+  ///@{
+  /**
+   * When on (the default), the non-empty tiles of every message are
+   * compressed with LZ4 whenever that makes the message smaller.
+   */
+  vtkSetMacro(CompressTiles, bool);
+  vtkGetMacro(CompressTiles, bool);
+  vtkBooleanMacro(CompressTiles, bool);
+  ///@}
+
+protected:
+  vtkRadixKCompositer();
+  ~vtkRadixKCompositer() override;
+
+  int Radix;
+  int TileSize;
+  bool CompressTiles;
+
+private:
+  vtkRadixKCompositer(const vtkRadixKCompositer&) = delete;
+  void operator=(const vtkRadixKCompositer&) = delete;
+};
+
+VTK_ABI_NAMESPACE_END
+#endif
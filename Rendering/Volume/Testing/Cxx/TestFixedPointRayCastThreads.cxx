@@ -0,0 +1,22 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Checks that vtkFixedPointVolumeRayCastMapper renders the same image whatever the number of
+// threads casting the image tiles.
+
+#include "TestRayCastThreadsInternal.h"
+
+#include "vtkFixedPointVolumeRayCastMapper.h"
+#include "vtkNew.h"
+#include "vtkRTAnalyticSource.h"
+#include "vtkRenderWindow.h"
+
+int TestFixedPointRayCastThreads(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  vtkNew<vtkRTAnalyticSource> source;
+  source->SetWholeExtent(-20, 20, -20, 20, -20, 20);
+  vtkNew<vtkFixedPointVolumeRayCastMapper> mapper;
+  mapper->SetInputConnection(source->GetOutputPort());
+
+  vtkNew<vtkRenderWindow> renWin;
+  return TestRayCastThreadsInternal(mapper.Get(), true, renWin);
+}
@@ -0,0 +1,99 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#ifndef TestRayCastThreadsInternal_h
+#define TestRayCastThreadsInternal_h
+
+#include "vtkCamera.h"
+#include "vtkColorTransferFunction.h"
+#include "vtkImageData.h"
+#include "vtkNew.h"
+#include "vtkPiecewiseFunction.h"
+#include "vtkPointData.h"
+#include "vtkRenderWindow.h"
+#include "vtkRenderer.h"
+#include "vtkSMPTools.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkVolume.h"
+#include "vtkVolumeProperty.h"
+#include "vtkWindowToImageFilter.h"
+
+#include <cstdlib>
+#include <iostream>
+
+// Renders the input of the ray cast mapper, scalars in the range of
+// vtkRTAnalyticSource, in renWin with 1, 2, 3, 4 and 8 threads casting the
+// image tiles and checks that the images match the one rendered with 1 thread.
+template <typename MapperT>
+int TestRayCastThreadsInternal(MapperT* mapper, bool shade, vtkRenderWindow* renWin)
+{
+  vtkNew<vtkPiecewiseFunction> opacity;
+  opacity->AddPoint(40., 0.);
+  opacity->AddPoint(280., 0.2);
+  vtkNew<vtkColorTransferFunction> color;
+  color->AddRGBPoint(40., 0.23, 0.3, 0.75);
+  color->AddRGBPoint(160., 0.87, 0.87, 0.87);
+  color->AddRGBPoint(280., 0.7, 0.02, 0.15);
+  vtkNew<vtkVolumeProperty> property;
+  property->SetScalarOpacity(opacity);
+  property->SetColor(color);
+  property->SetInterpolationTypeToLinear();
+  property->SetShade(shade);
+
+  // The sample distances must not depend on the render times.
+  mapper->AutoAdjustSampleDistancesOff();
+  mapper->SetImageTileSize(8);
+  vtkNew<vtkVolume> volume;
+  volume->SetMapper(mapper);
+  volume->SetProperty(property);
+
+  vtkNew<vtkRenderer> renderer;
+  renderer->AddVolume(volume);
+  renWin->SetSize(301, 300);
+  renWin->AddRenderer(renderer);
+  renderer->ResetCamera();
+  renderer->GetActiveCamera()->Azimuth(30.);
+  renderer->GetActiveCamera()->Elevation(20.);
+
+  vtkNew<vtkWindowToImageFilter> windowToImage;
+  windowToImage->SetInput(renWin);
+
+  vtkNew<vtkUnsignedCharArray> reference;
+  int res = EXIT_SUCCESS;
+  for (int numberOfThreads : { 1, 2, 3, 4, 8 })
+  {
+    vtkSMPTools::Initialize(numberOfThreads);
+    mapper->SetNumberOfThreads(numberOfThreads);
+    renWin->Render();
+    windowToImage->Modified();
+    windowToImage->Update();
+    auto* pixels =
+      vtkUnsignedCharArray::SafeDownCast(windowToImage->GetOutput()->GetPointData()->GetScalars());
+    if (numberOfThreads == 1)
+    {
+      reference->DeepCopy(pixels);
+      continue;
+    }
+    if (!pixels || pixels->GetNumberOfValues() != reference->GetNumberOfValues())
+    {
+      std::cerr << "Wrong image size with " << numberOfThreads << " threads" << std::endl;
+      res = EXIT_FAILURE;
+      continue;
+    }
+    vtkIdType numberOfDifferences = 0;
+    for (vtkIdType i = 0; i < reference->GetNumberOfValues(); ++i)
+    {
+      numberOfDifferences += pixels->GetValue(i) != reference->GetValue(i);
+    }
+    if (numberOfDifferences > 0)
+    {
+      std::cerr << "The image rendered with " << numberOfThreads << " threads differs by "
+                << numberOfDifferences << " values from the one rendered with 1 thread"
+                << std::endl;
+      res = EXIT_FAILURE;
+    }
+  }
+  vtkSMPTools::Initialize();
+  return res;
+}
+
+#endif
@@ -0,0 +1,34 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Checks that vtkUnstructuredGridVolumeRayCastMapper renders the same image whatever the number
+// of threads casting the image tiles, each of them using its own ray cast iterator, and that the
+// tiled image matches the baseline.
+
+#include "TestRayCastThreadsInternal.h"
+
+#include "vtkDataSetTriangleFilter.h"
+#include "vtkNew.h"
+#include "vtkRTAnalyticSource.h"
+#include "vtkRegressionTestImage.h"
+#include "vtkRenderWindow.h"
+#include "vtkUnstructuredGridVolumeRayCastMapper.h"
+
+int TestUnstructuredGridRayCastThreads(int argc, char* argv[])
+{
+  vtkNew<vtkRTAnalyticSource> source;
+  source->SetWholeExtent(-10, 10, -10, 10, -10, 10);
+  vtkNew<vtkDataSetTriangleFilter> tetrahedra;
+  tetrahedra->SetInputConnection(source->GetOutputPort());
+  vtkNew<vtkUnstructuredGridVolumeRayCastMapper> mapper;
+  mapper->SetInputConnection(tetrahedra->GetOutputPort());
+
+  vtkNew<vtkRenderWindow> renWin;
+  const int res = TestRayCastThreadsInternal(mapper.Get(), false, renWin);
+
+  const int retVal = vtkRegressionTestImage(renWin);
+  if (res != EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+  return !((retVal == vtkTesting::PASSED) || (retVal == vtkTesting::DO_INTERACTOR));
+}
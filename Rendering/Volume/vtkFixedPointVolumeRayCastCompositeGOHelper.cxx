@@ -35,7 +35,7 @@ vtkFixedPointVolumeRayCastCompositeGOHelper::~vtkFixedPointVolumeRayCastComposit
 // Finally we move on to the next sample along the ray.
 template <class T>
 void vtkFixedPointCompositeGOHelperGenerateImageOneSimpleNN(
-  T* data, int threadID, int threadCount, vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vol)
+  T* data, int firstTile, int tileStride, vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vol)
 {
   VTKKWRCHelper_InitializationAndLoopStartGONN
   VTKKWRCHelper_InitializeCompositeOneNN
@@ -77,7 +77,7 @@ void vtkFixedPointCompositeGOHelperGenerateImageOneSimpleNN(
 // Finally we move on to the next sample along the ray.
 template <class T>
 void vtkFixedPointCompositeGOHelperGenerateImageOneNN(
-  T* data, int threadID, int threadCount, vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vol)
+  T* data, int firstTile, int tileStride, vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vol)
 {
   VTKKWRCHelper_InitializationAndLoopStartGONN
   VTKKWRCHelper_InitializeCompositeOneNN
@@ -120,7 +120,7 @@ void vtkFixedPointCompositeGOHelperGenerateImageOneNN(
 // threshold). Finally we move to the next sample along the ray.
 template <class T>
 void vtkFixedPointCompositeGOHelperGenerateImageTwoDependentNN(
-  T* data, int threadID, int threadCount, vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vol)
+  T* data, int firstTile, int tileStride, vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vol)
 {
   VTKKWRCHelper_InitializationAndLoopStartGONN
   VTKKWRCHelper_InitializeCompositeOneNN
@@ -175,7 +175,7 @@ void vtkFixedPointCompositeGOHelperGenerateImageTwoDependentNN(
 // Finally we move onto the next sample along the ray.
 template <class T>
 void vtkFixedPointCompositeGOHelperGenerateImageFourDependentNN(
-  T* data, int threadID, int threadCount, vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vol)
+  T* data, int firstTile, int tileStride, vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vol)
 {
   VTKKWRCHelper_InitializationAndLoopStartGONN
   VTKKWRCHelper_InitializeCompositeOneNN
@@ -229,7 +229,7 @@ void vtkFixedPointCompositeGOHelperGenerateImageFourDependentNN(
 // threshold). Finally we increment to the next sample on the ray.
 template <class T>
 void vtkFixedPointCompositeGOHelperGenerateImageIndependentNN(
-  T* data, int threadID, int threadCount, vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vol)
+  T* data, int firstTile, int tileStride, vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vol)
 {
   VTKKWRCHelper_InitializeWeights
   VTKKWRCHelper_InitializationAndLoopStartGONN
@@ -278,7 +278,7 @@ void vtkFixedPointCompositeGOHelperGenerateImageIndependentNN(
 // sample along the ray.
 template <class T>
 void vtkFixedPointCompositeGOHelperGenerateImageOneSimpleTrilin(
-  T* data, int threadID, int threadCount, vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vol)
+  T* data, int firstTile, int tileStride, vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vol)
 {
   VTKKWRCHelper_InitializationAndLoopStartGOTrilin
   VTKKWRCHelper_InitializeCompositeOneTrilin
@@ -358,7 +358,7 @@ void vtkFixedPointCompositeGOHelperGenerateImageOneSimpleTrilin(
 // threshold). Finally we move on to the next sample along the ray.
 template <class T>
 void vtkFixedPointCompositeGOHelperGenerateImageOneTrilin(
-  T* data, int threadID, int threadCount, vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vol)
+  T* data, int firstTile, int tileStride, vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vol)
 {
   VTKKWRCHelper_InitializationAndLoopStartGOTrilin
   VTKKWRCHelper_InitializeCompositeOneTrilin
@@ -440,7 +440,7 @@ void vtkFixedPointCompositeGOHelperGenerateImageOneTrilin(
 // the ray.
 template <class T>
 void vtkFixedPointCompositeGOHelperGenerateImageTwoDependentTrilin(
-  T* data, int threadID, int threadCount, vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vol)
+  T* data, int firstTile, int tileStride, vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vol)
 {
   VTKKWRCHelper_InitializationAndLoopStartGOTrilin
   VTKKWRCHelper_InitializeCompositeMultiTrilin
@@ -527,7 +527,7 @@ void vtkFixedPointCompositeGOHelperGenerateImageTwoDependentTrilin(
 // move on to the next sample along the ray.
 template <class T>
 void vtkFixedPointCompositeGOHelperGenerateImageFourDependentTrilin(
-  T* data, int threadID, int threadCount, vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vol)
+  T* data, int firstTile, int tileStride, vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vol)
 {
   VTKKWRCHelper_InitializationAndLoopStartGOTrilin
   VTKKWRCHelper_InitializeCompositeMultiTrilin
@@ -616,7 +616,7 @@ void vtkFixedPointCompositeGOHelperGenerateImageFourDependentTrilin(
 // move on to the next sample along the ray.
 template <class T>
 void vtkFixedPointCompositeGOHelperGenerateImageIndependentTrilin(
-  T* data, int threadID, int threadCount, vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vol)
+  T* data, int firstTile, int tileStride, vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vol)
 {
   VTKKWRCHelper_InitializeWeights
   VTKKWRCHelper_InitializationAndLoopStartGOTrilin
@@ -693,7 +693,7 @@ void vtkFixedPointCompositeGOHelperGenerateImageIndependentTrilin(
 }
 
 void vtkFixedPointVolumeRayCastCompositeGOHelper::GenerateImage(
-  int threadID, int threadCount, vtkVolume* vol, vtkFixedPointVolumeRayCastMapper* mapper)
+  int firstTile, int tileStride, vtkVolume* vol, vtkFixedPointVolumeRayCastMapper* mapper)
 {
   void* data = mapper->GetCurrentScalars()->GetVoidPointer(0);
   int scalarType = mapper->GetCurrentScalars()->GetDataType();
@@ -710,7 +710,7 @@ void vtkFixedPointVolumeRayCastCompositeGOHelper::GenerateImage(
         switch (scalarType)
         {
           vtkTemplateMacro(vtkFixedPointCompositeGOHelperGenerateImageOneSimpleNN(
-            static_cast<VTK_TT*>(data), threadID, threadCount, mapper, vol));
+            static_cast<VTK_TT*>(data), firstTile, tileStride, mapper, vol));
         }
       }
       else
@@ -718,7 +718,7 @@ void vtkFixedPointVolumeRayCastCompositeGOHelper::GenerateImage(
         switch (scalarType)
         {
           vtkTemplateMacro(vtkFixedPointCompositeGOHelperGenerateImageOneNN(
-            static_cast<VTK_TT*>(data), threadID, threadCount, mapper, vol));
+            static_cast<VTK_TT*>(data), firstTile, tileStride, mapper, vol));
         }
       }
     }
@@ -728,7 +728,7 @@ void vtkFixedPointVolumeRayCastCompositeGOHelper::GenerateImage(
       switch (scalarType)
       {
         vtkTemplateMacro(vtkFixedPointCompositeGOHelperGenerateImageIndependentNN(
-          static_cast<VTK_TT*>(data), threadID, threadCount, mapper, vol));
+          static_cast<VTK_TT*>(data), firstTile, tileStride, mapper, vol));
       }
     }
     // Dependent (color) components
@@ -741,7 +741,7 @@ void vtkFixedPointVolumeRayCastCompositeGOHelper::GenerateImage(
         switch (scalarType)
         {
           vtkTemplateMacro(vtkFixedPointCompositeGOHelperGenerateImageTwoDependentNN(
-            static_cast<VTK_TT*>(data), threadID, threadCount, mapper, vol));
+            static_cast<VTK_TT*>(data), firstTile, tileStride, mapper, vol));
         }
       }
       // Four components - they must be unsigned char, the first three directly
@@ -751,7 +751,7 @@ void vtkFixedPointVolumeRayCastCompositeGOHelper::GenerateImage(
         if (scalarType == VTK_UNSIGNED_CHAR)
         {
           vtkFixedPointCompositeGOHelperGenerateImageFourDependentNN(
-            static_cast<unsigned char*>(data), threadID, threadCount, mapper, vol);
+            static_cast<unsigned char*>(data), firstTile, tileStride, mapper, vol);
         }
         else
         {
@@ -772,7 +772,7 @@ void vtkFixedPointVolumeRayCastCompositeGOHelper::GenerateImage(
         switch (scalarType)
         {
           vtkTemplateMacro(vtkFixedPointCompositeGOHelperGenerateImageOneSimpleTrilin(
-            static_cast<VTK_TT*>(data), threadID, threadCount, mapper, vol));
+            static_cast<VTK_TT*>(data), firstTile, tileStride, mapper, vol));
         }
       }
       // Scale != 1.0 or shift != 0.0 - must apply scale/shift in inner loop
@@ -781,7 +781,7 @@ void vtkFixedPointVolumeRayCastCompositeGOHelper::GenerateImage(
         switch (scalarType)
         {
           vtkTemplateMacro(vtkFixedPointCompositeGOHelperGenerateImageOneTrilin(
-            static_cast<VTK_TT*>(data), threadID, threadCount, mapper, vol));
+            static_cast<VTK_TT*>(data), firstTile, tileStride, mapper, vol));
         }
       }
     }
@@ -791,7 +791,7 @@ void vtkFixedPointVolumeRayCastCompositeGOHelper::GenerateImage(
       switch (scalarType)
       {
         vtkTemplateMacro(vtkFixedPointCompositeGOHelperGenerateImageIndependentTrilin(
-          static_cast<VTK_TT*>(data), threadID, threadCount, mapper, vol));
+          static_cast<VTK_TT*>(data), firstTile, tileStride, mapper, vol));
       }
     }
     // Dependent components
@@ -804,7 +804,7 @@ void vtkFixedPointVolumeRayCastCompositeGOHelper::GenerateImage(
         switch (scalarType)
         {
           vtkTemplateMacro(vtkFixedPointCompositeGOHelperGenerateImageTwoDependentTrilin(
-            static_cast<VTK_TT*>(data), threadID, threadCount, mapper, vol));
+            static_cast<VTK_TT*>(data), firstTile, tileStride, mapper, vol));
         }
       }
       // Four components - they must be unsigned char, the first three directly
@@ -815,7 +815,7 @@ void vtkFixedPointVolumeRayCastCompositeGOHelper::GenerateImage(
         if (scalarType == VTK_UNSIGNED_CHAR)
         {
           vtkFixedPointCompositeGOHelperGenerateImageFourDependentTrilin(
-            static_cast<unsigned char*>(data), threadID, threadCount, mapper, vol);
+            static_cast<unsigned char*>(data), firstTile, tileStride, mapper, vol);
         }
         else
         {
@@ -35,7 +35,7 @@ vtkFixedPointVolumeRayCastCompositeGOShadeHelper::
 // Finally we move on to the next sample along the ray.
 template <class T>
 void vtkFixedPointCompositeGOShadeHelperGenerateImageOneSimpleNN(
-  T* data, int threadID, int threadCount, vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vol)
+  T* data, int firstTile, int tileStride, vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vol)
 {
   VTKKWRCHelper_InitializationAndLoopStartGOShadeNN
   VTKKWRCHelper_InitializeCompositeOneNN
@@ -79,7 +79,7 @@ void vtkFixedPointCompositeGOShadeHelperGenerateImageOneSimpleNN(
 // Finally we move on to the next sample along the ray.
 template <class T>
 void vtkFixedPointCompositeGOShadeHelperGenerateImageOneNN(
-  T* data, int threadID, int threadCount, vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vol)
+  T* data, int firstTile, int tileStride, vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vol)
 {
   VTKKWRCHelper_InitializationAndLoopStartGOShadeNN
   VTKKWRCHelper_InitializeCompositeOneNN
@@ -124,7 +124,7 @@ void vtkFixedPointCompositeGOShadeHelperGenerateImageOneNN(
 // threshold). Finally we move to the next sample along the ray.
 template <class T>
 void vtkFixedPointCompositeGOShadeHelperGenerateImageTwoDependentNN(
-  T* data, int threadID, int threadCount, vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vol)
+  T* data, int firstTile, int tileStride, vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vol)
 {
   VTKKWRCHelper_InitializationAndLoopStartGOShadeNN
   VTKKWRCHelper_InitializeCompositeOneNN
@@ -184,7 +184,7 @@ void vtkFixedPointCompositeGOShadeHelperGenerateImageTwoDependentNN(
 // Finally we move onto the next sample along the ray.
 template <class T>
 void vtkFixedPointCompositeGOShadeHelperGenerateImageFourDependentNN(
-  T* data, int threadID, int threadCount, vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vol)
+  T* data, int firstTile, int tileStride, vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vol)
 {
   VTKKWRCHelper_InitializationAndLoopStartGOShadeNN
   VTKKWRCHelper_InitializeCompositeOneNN
@@ -243,7 +243,7 @@ void vtkFixedPointCompositeGOShadeHelperGenerateImageFourDependentNN(
 // threshold). Finally we increment to the next sample on the ray.
 template <class T>
 void vtkFixedPointCompositeGOShadeHelperGenerateImageIndependentNN(
-  T* data, int threadID, int threadCount, vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vol)
+  T* data, int firstTile, int tileStride, vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vol)
 {
   VTKKWRCHelper_InitializeWeights
   VTKKWRCHelper_InitializationAndLoopStartGOShadeNN
@@ -295,7 +295,7 @@ void vtkFixedPointCompositeGOShadeHelperGenerateImageIndependentNN(
 // sample along the ray.
 template <class T>
 void vtkFixedPointCompositeGOShadeHelperGenerateImageOneSimpleTrilin(
-  T* data, int threadID, int threadCount, vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vol)
+  T* data, int firstTile, int tileStride, vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vol)
 {
   VTKKWRCHelper_InitializationAndLoopStartGOShadeTrilin
   VTKKWRCHelper_InitializeCompositeOneTrilin
@@ -388,7 +388,7 @@ void vtkFixedPointCompositeGOShadeHelperGenerateImageOneSimpleTrilin(
 // threshold). Finally we move on to the next sample along the ray.
 template <class T>
 void vtkFixedPointCompositeGOShadeHelperGenerateImageOneTrilin(
-  T* data, int threadID, int threadCount, vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vol)
+  T* data, int firstTile, int tileStride, vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vol)
 {
   VTKKWRCHelper_InitializationAndLoopStartGOShadeTrilin
   VTKKWRCHelper_InitializeCompositeOneTrilin
@@ -483,7 +483,7 @@ void vtkFixedPointCompositeGOShadeHelperGenerateImageOneTrilin(
 // the ray.
 template <class T>
 void vtkFixedPointCompositeGOShadeHelperGenerateImageTwoDependentTrilin(
-  T* data, int threadID, int threadCount, vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vol)
+  T* data, int firstTile, int tileStride, vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vol)
 {
   VTKKWRCHelper_InitializationAndLoopStartGOShadeTrilin
   VTKKWRCHelper_InitializeCompositeMultiTrilin
@@ -583,7 +583,7 @@ void vtkFixedPointCompositeGOShadeHelperGenerateImageTwoDependentTrilin(
 // move on to the next sample along the ray.
 template <class T>
 void vtkFixedPointCompositeGOShadeHelperGenerateImageFourDependentTrilin(
-  T* data, int threadID, int threadCount, vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vol)
+  T* data, int firstTile, int tileStride, vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vol)
 {
   VTKKWRCHelper_InitializationAndLoopStartGOShadeTrilin
   VTKKWRCHelper_InitializeCompositeMultiTrilin
@@ -684,7 +684,7 @@ void vtkFixedPointCompositeGOShadeHelperGenerateImageFourDependentTrilin(
 // move on to the next sample along the ray.
 template <class T>
 void vtkFixedPointCompositeGOShadeHelperGenerateImageIndependentTrilin(
-  T* data, int threadID, int threadCount, vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vol)
+  T* data, int firstTile, int tileStride, vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vol)
 {
   VTKKWRCHelper_InitializeWeights
   VTKKWRCHelper_InitializationAndLoopStartGOShadeTrilin
@@ -784,7 +784,7 @@ void vtkFixedPointCompositeGOShadeHelperGenerateImageIndependentTrilin(
 }
 
 void vtkFixedPointVolumeRayCastCompositeGOShadeHelper::GenerateImage(
-  int threadID, int threadCount, vtkVolume* vol, vtkFixedPointVolumeRayCastMapper* mapper)
+  int firstTile, int tileStride, vtkVolume* vol, vtkFixedPointVolumeRayCastMapper* mapper)
 {
   void* data = mapper->GetCurrentScalars()->GetVoidPointer(0);
   int scalarType = mapper->GetCurrentScalars()->GetDataType();
@@ -801,7 +801,7 @@ void vtkFixedPointVolumeRayCastCompositeGOShadeHelper::GenerateImage(
         switch (scalarType)
         {
           vtkTemplateMacro(vtkFixedPointCompositeGOShadeHelperGenerateImageOneSimpleNN(
-            static_cast<VTK_TT*>(data), threadID, threadCount, mapper, vol));
+            static_cast<VTK_TT*>(data), firstTile, tileStride, mapper, vol));
         }
       }
       else
@@ -809,7 +809,7 @@ void vtkFixedPointVolumeRayCastCompositeGOShadeHelper::GenerateImage(
         switch (scalarType)
         {
           vtkTemplateMacro(vtkFixedPointCompositeGOShadeHelperGenerateImageOneNN(
-            static_cast<VTK_TT*>(data), threadID, threadCount, mapper, vol));
+            static_cast<VTK_TT*>(data), firstTile, tileStride, mapper, vol));
         }
       }
     }
@@ -819,7 +819,7 @@ void vtkFixedPointVolumeRayCastCompositeGOShadeHelper::GenerateImage(
       switch (scalarType)
       {
         vtkTemplateMacro(vtkFixedPointCompositeGOShadeHelperGenerateImageIndependentNN(
-          static_cast<VTK_TT*>(data), threadID, threadCount, mapper, vol));
+          static_cast<VTK_TT*>(data), firstTile, tileStride, mapper, vol));
       }
     }
     // Dependent (color) components
@@ -832,7 +832,7 @@ void vtkFixedPointVolumeRayCastCompositeGOShadeHelper::GenerateImage(
         switch (scalarType)
         {
           vtkTemplateMacro(vtkFixedPointCompositeGOShadeHelperGenerateImageTwoDependentNN(
-            static_cast<VTK_TT*>(data), threadID, threadCount, mapper, vol));
+            static_cast<VTK_TT*>(data), firstTile, tileStride, mapper, vol));
         }
       }
       // Four components - they must be unsigned char, the first three directly
@@ -843,7 +843,7 @@ void vtkFixedPointVolumeRayCastCompositeGOShadeHelper::GenerateImage(
         if (scalarType == VTK_UNSIGNED_CHAR)
         {
           vtkFixedPointCompositeGOShadeHelperGenerateImageFourDependentNN(
-            static_cast<unsigned char*>(data), threadID, threadCount, mapper, vol);
+            static_cast<unsigned char*>(data), firstTile, tileStride, mapper, vol);
         }
         else
         {
@@ -864,7 +864,7 @@ void vtkFixedPointVolumeRayCastCompositeGOShadeHelper::GenerateImage(
         switch (scalarType)
         {
           vtkTemplateMacro(vtkFixedPointCompositeGOShadeHelperGenerateImageOneSimpleTrilin(
-            static_cast<VTK_TT*>(data), threadID, threadCount, mapper, vol));
+            static_cast<VTK_TT*>(data), firstTile, tileStride, mapper, vol));
         }
       }
       // Scale != 1.0 or shift != 0.0 - must apply scale/shift in inner loop
@@ -873,7 +873,7 @@ void vtkFixedPointVolumeRayCastCompositeGOShadeHelper::GenerateImage(
         switch (scalarType)
         {
           vtkTemplateMacro(vtkFixedPointCompositeGOShadeHelperGenerateImageOneTrilin(
-            static_cast<VTK_TT*>(data), threadID, threadCount, mapper, vol));
+            static_cast<VTK_TT*>(data), firstTile, tileStride, mapper, vol));
         }
       }
     }
@@ -883,7 +883,7 @@ void vtkFixedPointVolumeRayCastCompositeGOShadeHelper::GenerateImage(
       switch (scalarType)
       {
         vtkTemplateMacro(vtkFixedPointCompositeGOShadeHelperGenerateImageIndependentTrilin(
-          static_cast<VTK_TT*>(data), threadID, threadCount, mapper, vol));
+          static_cast<VTK_TT*>(data), firstTile, tileStride, mapper, vol));
       }
     }
     // Dependent components
@@ -896,7 +896,7 @@ void vtkFixedPointVolumeRayCastCompositeGOShadeHelper::GenerateImage(
         switch (scalarType)
         {
           vtkTemplateMacro(vtkFixedPointCompositeGOShadeHelperGenerateImageTwoDependentTrilin(
-            static_cast<VTK_TT*>(data), threadID, threadCount, mapper, vol));
+            static_cast<VTK_TT*>(data), firstTile, tileStride, mapper, vol));
         }
       }
       // Four components - they must be unsigned char, the first three directly
@@ -907,7 +907,7 @@ void vtkFixedPointVolumeRayCastCompositeGOShadeHelper::GenerateImage(
         if (scalarType == VTK_UNSIGNED_CHAR)
         {
           vtkFixedPointCompositeGOShadeHelperGenerateImageFourDependentTrilin(
-            static_cast<unsigned char*>(data), threadID, threadCount, mapper, vol);
+            static_cast<unsigned char*>(data), firstTile, tileStride, mapper, vol);
         }
         else
         {
@@ -32,7 +32,7 @@ vtkFixedPointVolumeRayCastCompositeHelper::~vtkFixedPointVolumeRayCastCompositeH
 // this point (if the accumulated opacity is higher than some threshold).
 // Finally we move on to the next sample along the ray.
 template <class T>
-void vtkFixedPointCompositeHelperGenerateImageOneSimpleNN(T* data, int threadID, int threadCount,
+void vtkFixedPointCompositeHelperGenerateImageOneSimpleNN(T* data, int firstTile, int tileStride,
   vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vtkNotUsed(vol))
 {
   VTKKWRCHelper_InitializationAndLoopStartNN
@@ -72,7 +72,7 @@ void vtkFixedPointCompositeHelperGenerateImageOneSimpleNN(T* data, int threadID,
 // this point (if the accumulated opacity is higher than some threshold).
 // Finally we move on to the next sample along the ray.
 template <class T>
-void vtkFixedPointCompositeHelperGenerateImageOneNN(T* data, int threadID, int threadCount,
+void vtkFixedPointCompositeHelperGenerateImageOneNN(T* data, int firstTile, int tileStride,
   vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vtkNotUsed(vol))
 {
   VTKKWRCHelper_InitializationAndLoopStartNN
@@ -112,7 +112,7 @@ void vtkFixedPointCompositeHelperGenerateImageOneNN(T* data, int threadID, int t
 // see if we can terminate here (if the opacity accumulated exceed some
 // threshold). Finally we move to the next sample along the ray.
 template <class T>
-void vtkFixedPointCompositeHelperGenerateImageTwoDependentNN(T* data, int threadID, int threadCount,
+void vtkFixedPointCompositeHelperGenerateImageTwoDependentNN(T* data, int firstTile, int tileStride,
   vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vtkNotUsed(vol))
 {
   VTKKWRCHelper_InitializationAndLoopStartNN
@@ -165,8 +165,8 @@ void vtkFixedPointCompositeHelperGenerateImageTwoDependentNN(T* data, int thread
 // terminate here (if our accumulated opacity has exceed some threshold).
 // Finally we move onto the next sample along the ray.
 template <class T>
-void vtkFixedPointCompositeHelperGenerateImageFourDependentNN(T* data, int threadID,
-  int threadCount, vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vtkNotUsed(vol))
+void vtkFixedPointCompositeHelperGenerateImageFourDependentNN(T* data, int firstTile,
+  int tileStride, vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vtkNotUsed(vol))
 {
   VTKKWRCHelper_InitializationAndLoopStartNN
   VTKKWRCHelper_InitializeCompositeOneNN
@@ -217,7 +217,7 @@ void vtkFixedPointCompositeHelperGenerateImageFourDependentNN(T* data, int threa
 // threshold). Finally we increment to the next sample on the ray.
 template <class T>
 void vtkFixedPointCompositeHelperGenerateImageIndependentNN(
-  T* data, int threadID, int threadCount, vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vol)
+  T* data, int firstTile, int tileStride, vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vol)
 {
   VTKKWRCHelper_InitializeWeights
   VTKKWRCHelper_InitializationAndLoopStartNN
@@ -261,8 +261,8 @@ void vtkFixedPointCompositeHelperGenerateImageIndependentNN(
 // opacity is higher than some threshold). Finally we move on to the next
 // sample along the ray.
 template <class T>
-void vtkFixedPointCompositeHelperGenerateImageOneSimpleTrilin(T* data, int threadID,
-  int threadCount, vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vtkNotUsed(vol))
+void vtkFixedPointCompositeHelperGenerateImageOneSimpleTrilin(T* data, int firstTile,
+  int tileStride, vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vtkNotUsed(vol))
 {
   VTKKWRCHelper_InitializationAndLoopStartTrilin
   VTKKWRCHelper_InitializeCompositeOneTrilin
@@ -312,7 +312,7 @@ void vtkFixedPointCompositeHelperGenerateImageOneSimpleTrilin(T* data, int threa
 // terminate at this point (if the accumulated opacity is higher than some
 // threshold). Finally we move on to the next sample along the ray.
 template <class T>
-void vtkFixedPointCompositeHelperGenerateImageOneTrilin(T* data, int threadID, int threadCount,
+void vtkFixedPointCompositeHelperGenerateImageOneTrilin(T* data, int firstTile, int tileStride,
   vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vtkNotUsed(vol))
 {
   VTKKWRCHelper_InitializationAndLoopStartTrilin
@@ -364,8 +364,8 @@ void vtkFixedPointCompositeHelperGenerateImageOneTrilin(T* data, int threadID, i
 // higher than some threshold). Finally we move on to the next sample along
 // the ray.
 template <class T>
-void vtkFixedPointCompositeHelperGenerateImageTwoDependentTrilin(T* data, int threadID,
-  int threadCount, vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vtkNotUsed(vol))
+void vtkFixedPointCompositeHelperGenerateImageTwoDependentTrilin(T* data, int firstTile,
+  int tileStride, vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vtkNotUsed(vol))
 {
   VTKKWRCHelper_InitializationAndLoopStartTrilin
   VTKKWRCHelper_InitializeCompositeMultiTrilin
@@ -432,8 +432,8 @@ void vtkFixedPointCompositeHelperGenerateImageTwoDependentTrilin(T* data, int th
 // point (if the accumulated opacity is higher than some threshold). Finally we
 // move on to the next sample along the ray.
 template <class T>
-void vtkFixedPointCompositeHelperGenerateImageFourDependentTrilin(T* data, int threadID,
-  int threadCount, vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vtkNotUsed(vol))
+void vtkFixedPointCompositeHelperGenerateImageFourDependentTrilin(T* data, int firstTile,
+  int tileStride, vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vtkNotUsed(vol))
 {
   VTKKWRCHelper_InitializationAndLoopStartTrilin
   VTKKWRCHelper_InitializeCompositeMultiTrilin
@@ -503,7 +503,7 @@ void vtkFixedPointCompositeHelperGenerateImageFourDependentTrilin(T* data, int t
 // move on to the next sample along the ray.
 template <class T>
 void vtkFixedPointCompositeHelperGenerateImageIndependentTrilin(
-  T* data, int threadID, int threadCount, vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vol)
+  T* data, int firstTile, int tileStride, vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vol)
 {
   VTKKWRCHelper_InitializeWeights
   VTKKWRCHelper_InitializationAndLoopStartTrilin
@@ -558,7 +558,7 @@ void vtkFixedPointCompositeHelperGenerateImageIndependentTrilin(
 }
 
 void vtkFixedPointVolumeRayCastCompositeHelper::GenerateImage(
-  int threadID, int threadCount, vtkVolume* vol, vtkFixedPointVolumeRayCastMapper* mapper)
+  int firstTile, int tileStride, vtkVolume* vol, vtkFixedPointVolumeRayCastMapper* mapper)
 {
   void* data = mapper->GetCurrentScalars()->GetVoidPointer(0);
   int scalarType = mapper->GetCurrentScalars()->GetDataType();
@@ -575,7 +575,7 @@ void vtkFixedPointVolumeRayCastCompositeHelper::GenerateImage(
         switch (scalarType)
         {
           vtkTemplateMacro(vtkFixedPointCompositeHelperGenerateImageOneSimpleNN(
-            static_cast<VTK_TT*>(data), threadID, threadCount, mapper, vol));
+            static_cast<VTK_TT*>(data), firstTile, tileStride, mapper, vol));
         }
       }
       else
@@ -583,7 +583,7 @@ void vtkFixedPointVolumeRayCastCompositeHelper::GenerateImage(
         switch (scalarType)
         {
           vtkTemplateMacro(vtkFixedPointCompositeHelperGenerateImageOneNN(
-            static_cast<VTK_TT*>(data), threadID, threadCount, mapper, vol));
+            static_cast<VTK_TT*>(data), firstTile, tileStride, mapper, vol));
         }
       }
     }
@@ -593,7 +593,7 @@ void vtkFixedPointVolumeRayCastCompositeHelper::GenerateImage(
       switch (scalarType)
       {
         vtkTemplateMacro(vtkFixedPointCompositeHelperGenerateImageIndependentNN(
-          static_cast<VTK_TT*>(data), threadID, threadCount, mapper, vol));
+          static_cast<VTK_TT*>(data), firstTile, tileStride, mapper, vol));
       }
     }
     // Dependent (color) components
@@ -606,7 +606,7 @@ void vtkFixedPointVolumeRayCastCompositeHelper::GenerateImage(
         switch (scalarType)
         {
           vtkTemplateMacro(vtkFixedPointCompositeHelperGenerateImageTwoDependentNN(
-            static_cast<VTK_TT*>(data), threadID, threadCount, mapper, vol));
+            static_cast<VTK_TT*>(data), firstTile, tileStride, mapper, vol));
         }
       }
       // Four components - they must be unsigned char, the first three directly
@@ -617,7 +617,7 @@ void vtkFixedPointVolumeRayCastCompositeHelper::GenerateImage(
         if (scalarType == VTK_UNSIGNED_CHAR)
         {
           vtkFixedPointCompositeHelperGenerateImageFourDependentNN(
-            static_cast<unsigned char*>(data), threadID, threadCount, mapper, vol);
+            static_cast<unsigned char*>(data), firstTile, tileStride, mapper, vol);
         }
         else
         {
@@ -638,7 +638,7 @@ void vtkFixedPointVolumeRayCastCompositeHelper::GenerateImage(
         switch (scalarType)
         {
           vtkTemplateMacro(vtkFixedPointCompositeHelperGenerateImageOneSimpleTrilin(
-            static_cast<VTK_TT*>(data), threadID, threadCount, mapper, vol));
+            static_cast<VTK_TT*>(data), firstTile, tileStride, mapper, vol));
         }
       }
       // Scale != 1.0 or shift != 0.0 - must apply scale/shift in inner loop
@@ -647,7 +647,7 @@ void vtkFixedPointVolumeRayCastCompositeHelper::GenerateImage(
         switch (scalarType)
         {
           vtkTemplateMacro(vtkFixedPointCompositeHelperGenerateImageOneTrilin(
-            static_cast<VTK_TT*>(data), threadID, threadCount, mapper, vol));
+            static_cast<VTK_TT*>(data), firstTile, tileStride, mapper, vol));
         }
       }
     }
@@ -657,7 +657,7 @@ void vtkFixedPointVolumeRayCastCompositeHelper::GenerateImage(
       switch (scalarType)
       {
         vtkTemplateMacro(vtkFixedPointCompositeHelperGenerateImageIndependentTrilin(
-          static_cast<VTK_TT*>(data), threadID, threadCount, mapper, vol));
+          static_cast<VTK_TT*>(data), firstTile, tileStride, mapper, vol));
       }
     }
     // Dependent components
@@ -670,7 +670,7 @@ void vtkFixedPointVolumeRayCastCompositeHelper::GenerateImage(
         switch (scalarType)
         {
           vtkTemplateMacro(vtkFixedPointCompositeHelperGenerateImageTwoDependentTrilin(
-            static_cast<VTK_TT*>(data), threadID, threadCount, mapper, vol));
+            static_cast<VTK_TT*>(data), firstTile, tileStride, mapper, vol));
         }
       }
       // Four components - they must be unsigned char, the first three directly
@@ -681,7 +681,7 @@ void vtkFixedPointVolumeRayCastCompositeHelper::GenerateImage(
         if (scalarType == VTK_UNSIGNED_CHAR)
         {
           vtkFixedPointCompositeHelperGenerateImageFourDependentTrilin(
-            static_cast<unsigned char*>(data), threadID, threadCount, mapper, vol);
+            static_cast<unsigned char*>(data), firstTile, tileStride, mapper, vol);
         }
         else
         {
@@ -35,7 +35,7 @@ vtkFixedPointVolumeRayCastCompositeShadeHelper::~vtkFixedPointVolumeRayCastCompo
 // Finally we move on to the next sample along the ray.
 template <class T>
 void vtkFixedPointCompositeShadeHelperGenerateImageOneSimpleNN(
-  T* data, int threadID, int threadCount, vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vol)
+  T* data, int firstTile, int tileStride, vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vol)
 {
   VTKKWRCHelper_InitializationAndLoopStartShadeNN
   VTKKWRCHelper_InitializeCompositeOneNN
@@ -75,7 +75,7 @@ void vtkFixedPointCompositeShadeHelperGenerateImageOneSimpleNN(
 // Finally we move on to the next sample along the ray.
 template <class T>
 void vtkFixedPointCompositeShadeHelperGenerateImageOneNN(
-  T* data, int threadID, int threadCount, vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vol)
+  T* data, int firstTile, int tileStride, vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vol)
 {
   VTKKWRCHelper_InitializationAndLoopStartShadeNN
   VTKKWRCHelper_InitializeCompositeOneNN
@@ -116,7 +116,7 @@ void vtkFixedPointCompositeShadeHelperGenerateImageOneNN(
 // threshold). Finally we move to the next sample along the ray.
 template <class T>
 void vtkFixedPointCompositeShadeHelperGenerateImageTwoDependentNN(
-  T* data, int threadID, int threadCount, vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vol)
+  T* data, int firstTile, int tileStride, vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vol)
 {
   VTKKWRCHelper_InitializationAndLoopStartShadeNN
   VTKKWRCHelper_InitializeCompositeOneNN
@@ -169,7 +169,7 @@ void vtkFixedPointCompositeShadeHelperGenerateImageTwoDependentNN(
 // Finally we move onto the next sample along the ray.
 template <class T>
 void vtkFixedPointCompositeShadeHelperGenerateImageFourDependentNN(
-  T* data, int threadID, int threadCount, vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vol)
+  T* data, int firstTile, int tileStride, vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vol)
 {
   VTKKWRCHelper_InitializationAndLoopStartShadeNN
   VTKKWRCHelper_InitializeCompositeOneNN
@@ -222,7 +222,7 @@ void vtkFixedPointCompositeShadeHelperGenerateImageFourDependentNN(
 // TODO: short circuit calculations when opacity is 0
 template <class T>
 void vtkFixedPointCompositeShadeHelperGenerateImageIndependentNN(
-  T* data, int threadID, int threadCount, vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vol)
+  T* data, int firstTile, int tileStride, vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vol)
 {
   VTKKWRCHelper_InitializeWeights
   VTKKWRCHelper_InitializationAndLoopStartShadeNN
@@ -271,7 +271,7 @@ void vtkFixedPointCompositeShadeHelperGenerateImageIndependentNN(
 // sample along the ray.
 template <class T>
 void vtkFixedPointCompositeShadeHelperGenerateImageOneSimpleTrilin(
-  T* data, int threadID, int threadCount, vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vol)
+  T* data, int firstTile, int tileStride, vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vol)
 {
   VTKKWRCHelper_InitializationAndLoopStartShadeTrilin
   VTKKWRCHelper_InitializeCompositeOneTrilin
@@ -333,7 +333,7 @@ void vtkFixedPointCompositeShadeHelperGenerateImageOneSimpleTrilin(
 // threshold). Finally we move on to the next sample along the ray.
 template <class T>
 void vtkFixedPointCompositeShadeHelperGenerateImageOneTrilin(
-  T* data, int threadID, int threadCount, vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vol)
+  T* data, int firstTile, int tileStride, vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vol)
 {
   VTKKWRCHelper_InitializationAndLoopStartShadeTrilin
   VTKKWRCHelper_InitializeCompositeOneTrilin
@@ -396,7 +396,7 @@ void vtkFixedPointCompositeShadeHelperGenerateImageOneTrilin(
 // the ray.
 template <class T>
 void vtkFixedPointCompositeShadeHelperGenerateImageTwoDependentTrilin(
-  T* data, int threadID, int threadCount, vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vol)
+  T* data, int firstTile, int tileStride, vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vol)
 {
   VTKKWRCHelper_InitializationAndLoopStartShadeTrilin
   VTKKWRCHelper_InitializeCompositeMultiTrilin
@@ -477,7 +477,7 @@ void vtkFixedPointCompositeShadeHelperGenerateImageTwoDependentTrilin(
 // move on to the next sample along the ray.
 template <class T>
 void vtkFixedPointCompositeShadeHelperGenerateImageFourDependentTrilin(
-  T* data, int threadID, int threadCount, vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vol)
+  T* data, int firstTile, int tileStride, vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vol)
 {
   VTKKWRCHelper_InitializationAndLoopStartShadeTrilin
   VTKKWRCHelper_InitializeCompositeMultiTrilin
@@ -560,7 +560,7 @@ void vtkFixedPointCompositeShadeHelperGenerateImageFourDependentTrilin(
 // move on to the next sample along the ray.
 template <class T>
 void vtkFixedPointCompositeShadeHelperGenerateImageIndependentTrilin(
-  T* data, int threadID, int threadCount, vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vol)
+  T* data, int firstTile, int tileStride, vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vol)
 {
   VTKKWRCHelper_InitializeWeights
   VTKKWRCHelper_InitializationAndLoopStartShadeTrilin
@@ -636,7 +636,7 @@ void vtkFixedPointCompositeShadeHelperGenerateImageIndependentTrilin(
 }
 
 void vtkFixedPointVolumeRayCastCompositeShadeHelper::GenerateImage(
-  int threadID, int threadCount, vtkVolume* vol, vtkFixedPointVolumeRayCastMapper* mapper)
+  int firstTile, int tileStride, vtkVolume* vol, vtkFixedPointVolumeRayCastMapper* mapper)
 {
   void* data = mapper->GetCurrentScalars()->GetVoidPointer(0);
   int scalarType = mapper->GetCurrentScalars()->GetDataType();
@@ -653,7 +653,7 @@ void vtkFixedPointVolumeRayCastCompositeShadeHelper::GenerateImage(
         switch (scalarType)
         {
           vtkTemplateMacro(vtkFixedPointCompositeShadeHelperGenerateImageOneSimpleNN(
-            static_cast<VTK_TT*>(data), threadID, threadCount, mapper, vol));
+            static_cast<VTK_TT*>(data), firstTile, tileStride, mapper, vol));
         }
       }
       else
@@ -661,7 +661,7 @@ void vtkFixedPointVolumeRayCastCompositeShadeHelper::GenerateImage(
         switch (scalarType)
         {
           vtkTemplateMacro(vtkFixedPointCompositeShadeHelperGenerateImageOneNN(
-            static_cast<VTK_TT*>(data), threadID, threadCount, mapper, vol));
+            static_cast<VTK_TT*>(data), firstTile, tileStride, mapper, vol));
         }
       }
     }
@@ -671,7 +671,7 @@ void vtkFixedPointVolumeRayCastCompositeShadeHelper::GenerateImage(
       switch (scalarType)
       {
         vtkTemplateMacro(vtkFixedPointCompositeShadeHelperGenerateImageIndependentNN(
-          static_cast<VTK_TT*>(data), threadID, threadCount, mapper, vol));
+          static_cast<VTK_TT*>(data), firstTile, tileStride, mapper, vol));
       }
     }
     // Dependent (color) components
@@ -684,7 +684,7 @@ void vtkFixedPointVolumeRayCastCompositeShadeHelper::GenerateImage(
         switch (scalarType)
         {
           vtkTemplateMacro(vtkFixedPointCompositeShadeHelperGenerateImageTwoDependentNN(
-            static_cast<VTK_TT*>(data), threadID, threadCount, mapper, vol));
+            static_cast<VTK_TT*>(data), firstTile, tileStride, mapper, vol));
         }
       }
       // Four components - they must be unsigned char, the first three directly
@@ -695,7 +695,7 @@ void vtkFixedPointVolumeRayCastCompositeShadeHelper::GenerateImage(
         if (scalarType == VTK_UNSIGNED_CHAR)
         {
           vtkFixedPointCompositeShadeHelperGenerateImageFourDependentNN(
-            static_cast<unsigned char*>(data), threadID, threadCount, mapper, vol);
+            static_cast<unsigned char*>(data), firstTile, tileStride, mapper, vol);
         }
         else
         {
@@ -716,7 +716,7 @@ void vtkFixedPointVolumeRayCastCompositeShadeHelper::GenerateImage(
         switch (scalarType)
         {
           vtkTemplateMacro(vtkFixedPointCompositeShadeHelperGenerateImageOneSimpleTrilin(
-            static_cast<VTK_TT*>(data), threadID, threadCount, mapper, vol));
+            static_cast<VTK_TT*>(data), firstTile, tileStride, mapper, vol));
         }
       }
       // Scale != 1.0 or shift != 0.0 - must apply scale/shift in inner loop
@@ -725,7 +725,7 @@ void vtkFixedPointVolumeRayCastCompositeShadeHelper::GenerateImage(
         switch (scalarType)
         {
           vtkTemplateMacro(vtkFixedPointCompositeShadeHelperGenerateImageOneTrilin(
-            static_cast<VTK_TT*>(data), threadID, threadCount, mapper, vol));
+            static_cast<VTK_TT*>(data), firstTile, tileStride, mapper, vol));
         }
       }
     }
@@ -735,7 +735,7 @@ void vtkFixedPointVolumeRayCastCompositeShadeHelper::GenerateImage(
       switch (scalarType)
       {
         vtkTemplateMacro(vtkFixedPointCompositeShadeHelperGenerateImageIndependentTrilin(
-          static_cast<VTK_TT*>(data), threadID, threadCount, mapper, vol));
+          static_cast<VTK_TT*>(data), firstTile, tileStride, mapper, vol));
       }
     }
     // Dependent components
@@ -748,7 +748,7 @@ void vtkFixedPointVolumeRayCastCompositeShadeHelper::GenerateImage(
         switch (scalarType)
         {
           vtkTemplateMacro(vtkFixedPointCompositeShadeHelperGenerateImageTwoDependentTrilin(
-            static_cast<VTK_TT*>(data), threadID, threadCount, mapper, vol));
+            static_cast<VTK_TT*>(data), firstTile, tileStride, mapper, vol));
         }
       }
       // Four components - they must be unsigned char, the first three directly
@@ -759,7 +759,7 @@ void vtkFixedPointVolumeRayCastCompositeShadeHelper::GenerateImage(
         if (scalarType == VTK_UNSIGNED_CHAR)
         {
           vtkFixedPointCompositeShadeHelperGenerateImageFourDependentTrilin(
-            static_cast<unsigned char*>(data), threadID, threadCount, mapper, vol);
+            static_cast<unsigned char*>(data), firstTile, tileStride, mapper, vol);
         }
         else
         {
@@ -810,6 +810,8 @@
   mapper->GetTableScale(scale);                                                                    \
                                                                                                    \
   int* rowBounds = mapper->GetRowBounds();                                                         \
+  int numberOfTiles = mapper->GetNumberOfImageTiles();                                             \
+  int tileBounds[4];                                                                               \
   unsigned short* image = mapper->GetRayCastImage()->GetImage();                                   \
   vtkRenderWindow* renWin = mapper->GetRenderWindow();                                             \
   int components = 1;                                                                              \
@@ -932,22 +934,13 @@
   vtkIdType dDHinc = dim[0] * dirOffset + dirOffset;
 
 #define VTKKWRCHelper_OuterInitialization                                                          \
-  if (j % threadCount != threadID)                                                                 \
-  {                                                                                                \
-    continue;                                                                                      \
-  }                                                                                                \
-  if (!threadID)                                                                                   \
-  {                                                                                                \
-    if (renWin->CheckAbortStatus())                                                                \
-    {                                                                                              \
-      break;                                                                                       \
-    }                                                                                              \
-  }                                                                                                \
-  else if (renWin->GetAbortRender())                                                               \
+  if (renWin->GetAbortRender())                                                                    \
   {                                                                                                \
     break;                                                                                         \
   }                                                                                                \
-  imagePtr = image + 4 * (j * imageMemorySize[0] + rowBounds[j * 2]);
+  int rowStart = std::max(rowBounds[j * 2], tileBounds[0]);                                        \
+  int rowEnd = std::min(rowBounds[j * 2 + 1], tileBounds[1]);                                      \
+  imagePtr = image + 4 * (j * imageMemorySize[0] + rowStart);
 
 #define VTKKWRCHelper_InnerInitialization                                                          \
   unsigned int numSteps;                                                                           \
@@ -1102,77 +1095,98 @@
 
 #define VTKKWRCHelper_InitializationAndLoopStartNN                                                 \
   VTKKWRCHelper_InitializeVariables                                                                \
-  for (j = 0; j < imageInUseSize[1]; j++)                                                          \
+  for (int tile = firstTile; tile < numberOfTiles; tile += tileStride)                             \
   {                                                                                                \
-    VTKKWRCHelper_OuterInitialization                                                              \
-    for (i = rowBounds[j * 2]; i <= rowBounds[j * 2 + 1]; i++)                                     \
+    mapper->GetImageTileBounds(tile, tileBounds);                                                  \
+    for (j = tileBounds[2]; j <= tileBounds[3]; j++)                                               \
     {                                                                                              \
-      VTKKWRCHelper_InnerInitialization
+      VTKKWRCHelper_OuterInitialization                                                            \
+      for (i = rowStart; i <= rowEnd; i++)                                                         \
+      {                                                                                            \
+        VTKKWRCHelper_InnerInitialization
 
 #define VTKKWRCHelper_InitializationAndLoopStartGONN                                               \
   VTKKWRCHelper_InitializeVariables                                                                \
   VTKKWRCHelper_InitializeVariablesGO                                                              \
-  for (j = 0; j < imageInUseSize[1]; j++)                                                          \
+  for (int tile = firstTile; tile < numberOfTiles; tile += tileStride)                             \
   {                                                                                                \
-    VTKKWRCHelper_OuterInitialization                                                              \
-    for (i = rowBounds[j * 2]; i <= rowBounds[j * 2 + 1]; i++)                                     \
+    mapper->GetImageTileBounds(tile, tileBounds);                                                  \
+    for (j = tileBounds[2]; j <= tileBounds[3]; j++)                                               \
     {                                                                                              \
-      VTKKWRCHelper_InnerInitialization
+      VTKKWRCHelper_OuterInitialization                                                            \
+      for (i = rowStart; i <= rowEnd; i++)                                                         \
+      {                                                                                            \
+        VTKKWRCHelper_InnerInitialization
 
 #define VTKKWRCHelper_InitializationAndLoopStartShadeNN                                            \
   VTKKWRCHelper_InitializeVariables                                                                \
   VTKKWRCHelper_InitializeVariablesShade                                                           \
-  for (j = 0; j < imageInUseSize[1]; j++)                                                          \
+  for (int tile = firstTile; tile < numberOfTiles; tile += tileStride)                             \
   {                                                                                                \
-    VTKKWRCHelper_OuterInitialization                                                              \
-    for (i = rowBounds[j * 2]; i <= rowBounds[j * 2 + 1]; i++)                                     \
+    mapper->GetImageTileBounds(tile, tileBounds);                                                  \
+    for (j = tileBounds[2]; j <= tileBounds[3]; j++)                                               \
     {                                                                                              \
-      VTKKWRCHelper_InnerInitialization
+      VTKKWRCHelper_OuterInitialization                                                            \
+      for (i = rowStart; i <= rowEnd; i++)                                                         \
+      {                                                                                            \
+        VTKKWRCHelper_InnerInitialization
 
 #define VTKKWRCHelper_InitializationAndLoopStartGOShadeNN                                          \
   VTKKWRCHelper_InitializeVariables                                                                \
   VTKKWRCHelper_InitializeVariablesGO                                                              \
   VTKKWRCHelper_InitializeVariablesShade                                                           \
-  for (j = 0; j < imageInUseSize[1]; j++)                                                          \
+  for (int tile = firstTile; tile < numberOfTiles; tile += tileStride)                             \
   {                                                                                                \
-    VTKKWRCHelper_OuterInitialization                                                              \
-    for (i = rowBounds[j * 2]; i <= rowBounds[j * 2 + 1]; i++)                                     \
+    mapper->GetImageTileBounds(tile, tileBounds);                                                  \
+    for (j = tileBounds[2]; j <= tileBounds[3]; j++)                                               \
     {                                                                                              \
-      VTKKWRCHelper_InnerInitialization
+      VTKKWRCHelper_OuterInitialization                                                            \
+      for (i = rowStart; i <= rowEnd; i++)                                                         \
+      {                                                                                            \
+        VTKKWRCHelper_InnerInitialization
 
 #define VTKKWRCHelper_InitializationAndLoopStartTrilin                                             \
   VTKKWRCHelper_InitializeVariables                                                                \
   VTKKWRCHelper_InitializeTrilinVariables                                                          \
-  for (j = 0; j < imageInUseSize[1]; j++)                                                          \
+  for (int tile = firstTile; tile < numberOfTiles; tile += tileStride)                             \
   {                                                                                                \
-    VTKKWRCHelper_OuterInitialization                                                              \
-    for (i = rowBounds[j * 2]; i <= rowBounds[j * 2 + 1]; i++)                                     \
+    mapper->GetImageTileBounds(tile, tileBounds);                                                  \
+    for (j = tileBounds[2]; j <= tileBounds[3]; j++)                                               \
     {                                                                                              \
-      VTKKWRCHelper_InnerInitialization
+      VTKKWRCHelper_OuterInitialization                                                            \
+      for (i = rowStart; i <= rowEnd; i++)                                                         \
+      {                                                                                            \
+        VTKKWRCHelper_InnerInitialization
 
 #define VTKKWRCHelper_InitializationAndLoopStartGOTrilin                                           \
   VTKKWRCHelper_InitializeVariables                                                                \
   VTKKWRCHelper_InitializeVariablesGO                                                              \
   VTKKWRCHelper_InitializeTrilinVariables                                                          \
   VTKKWRCHelper_InitializeTrilinVariablesGO                                                        \
-  for (j = 0; j < imageInUseSize[1]; j++)                                                          \
+  for (int tile = firstTile; tile < numberOfTiles; tile += tileStride)                             \
   {                                                                                                \
-    VTKKWRCHelper_OuterInitialization                                                              \
-    for (i = rowBounds[j * 2]; i <= rowBounds[j * 2 + 1]; i++)                                     \
+    mapper->GetImageTileBounds(tile, tileBounds);                                                  \
+    for (j = tileBounds[2]; j <= tileBounds[3]; j++)                                               \
     {                                                                                              \
-      VTKKWRCHelper_InnerInitialization
+      VTKKWRCHelper_OuterInitialization                                                            \
+      for (i = rowStart; i <= rowEnd; i++)                                                         \
+      {                                                                                            \
+        VTKKWRCHelper_InnerInitialization
 
 #define VTKKWRCHelper_InitializationAndLoopStartShadeTrilin                                        \
   VTKKWRCHelper_InitializeVariables                                                                \
   VTKKWRCHelper_InitializeVariablesShade                                                           \
   VTKKWRCHelper_InitializeTrilinVariables                                                          \
   VTKKWRCHelper_InitializeTrilinVariablesShade                                                     \
-  for (j = 0; j < imageInUseSize[1]; j++)                                                          \
+  for (int tile = firstTile; tile < numberOfTiles; tile += tileStride)                             \
   {                                                                                                \
-    VTKKWRCHelper_OuterInitialization                                                              \
-    for (i = rowBounds[j * 2]; i <= rowBounds[j * 2 + 1]; i++)                                     \
+    mapper->GetImageTileBounds(tile, tileBounds);                                                  \
+    for (j = tileBounds[2]; j <= tileBounds[3]; j++)                                               \
     {                                                                                              \
-      VTKKWRCHelper_InnerInitialization
+      VTKKWRCHelper_OuterInitialization                                                            \
+      for (i = rowStart; i <= rowEnd; i++)                                                         \
+      {                                                                                            \
+        VTKKWRCHelper_InnerInitialization
 
 #define VTKKWRCHelper_InitializationAndLoopStartGOShadeTrilin                                      \
   VTKKWRCHelper_InitializeVariables                                                                \
@@ -1181,21 +1195,19 @@
   VTKKWRCHelper_InitializeTrilinVariables                                                          \
   VTKKWRCHelper_InitializeTrilinVariablesShade                                                     \
   VTKKWRCHelper_InitializeTrilinVariablesGO                                                        \
-  for (j = 0; j < imageInUseSize[1]; j++)                                                          \
+  for (int tile = firstTile; tile < numberOfTiles; tile += tileStride)                             \
   {                                                                                                \
-    VTKKWRCHelper_OuterInitialization                                                              \
-    for (i = rowBounds[j * 2]; i <= rowBounds[j * 2 + 1]; i++)                                     \
+    mapper->GetImageTileBounds(tile, tileBounds);                                                  \
+    for (j = tileBounds[2]; j <= tileBounds[3]; j++)                                               \
     {                                                                                              \
-      VTKKWRCHelper_InnerInitialization
+      VTKKWRCHelper_OuterInitialization                                                            \
+      for (i = rowStart; i <= rowEnd; i++)                                                         \
+      {                                                                                            \
+        VTKKWRCHelper_InnerInitialization
 
 #define VTKKWRCHelper_IncrementAndLoopEnd                                                          \
   imagePtr += 4;                                                                                   \
   }                                                                                                \
-  if ((j / threadCount) % 8 == 7 && threadID == 0)                                                 \
-  {                                                                                                \
-    double fargs[1];                                                                               \
-    fargs[0] = static_cast<double>(j) / static_cast<float>(imageInUseSize[1] - 1);                 \
-    mapper->InvokeEvent(vtkCommand::VolumeMapperRenderProgressEvent, fargs);                       \
   }                                                                                                \
   }
 
@@ -1279,6 +1291,8 @@
 #include "vtkObject.h"
 #include "vtkRenderingVolumeModule.h" // For export macro
 
+#include <algorithm> // for std::max
+
 VTK_ABI_NAMESPACE_BEGIN
 class vtkFixedPointVolumeRayCastMapper;
 class vtkVolume;
@@ -30,7 +30,7 @@ vtkFixedPointVolumeRayCastMIPHelper::~vtkFixedPointVolumeRayCastMIPHelper() = de
 // we will convert it to unsigned short using the scale/shift, then use this
 // index to lookup the final color/opacity.
 template <class T>
-void vtkFixedPointMIPHelperGenerateImageOneNN(T* data, int threadID, int threadCount,
+void vtkFixedPointMIPHelperGenerateImageOneNN(T* data, int firstTile, int tileStride,
   vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vtkNotUsed(vol))
 {
   VTKKWRCHelper_InitializationAndLoopStartNN
@@ -114,7 +114,7 @@ void vtkFixedPointMIPHelperGenerateImageOneNN(T* data, int threadID, int threadC
 // then use first component to look up a color (2 component data) or first three
 // as the color directly (four component data). Lookup alpha off the last component.
 template <class T>
-void vtkFixedPointMIPHelperGenerateImageDependentNN(T* data, int threadID, int threadCount,
+void vtkFixedPointMIPHelperGenerateImageDependentNN(T* data, int firstTile, int tileStride,
   vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vtkNotUsed(vol))
 {
   VTKKWRCHelper_InitializationAndLoopStartNN
@@ -188,7 +188,7 @@ void vtkFixedPointMIPHelperGenerateImageDependentNN(T* data, int threadID, int t
 // blend these into one final color.
 template <class T>
 void vtkFixedPointMIPHelperGenerateImageIndependentNN(
-  T* data, int threadID, int threadCount, vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vol)
+  T* data, int firstTile, int tileStride, vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vol)
 {
   VTKKWRCHelper_InitializeWeights
   VTKKWRCHelper_InitializationAndLoopStartNN
@@ -253,7 +253,7 @@ void vtkFixedPointMIPHelperGenerateImageIndependentNN(
 // interpolation to compute the index. We find the maximum index along
 // the ray, and then use this to look up a final color.
 template <class T>
-void vtkFixedPointMIPHelperGenerateImageOneSimpleTrilin(T* dataPtr, int threadID, int threadCount,
+void vtkFixedPointMIPHelperGenerateImageOneSimpleTrilin(T* dataPtr, int firstTile, int tileStride,
   vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vtkNotUsed(vol))
 {
   VTKKWRCHelper_InitializationAndLoopStartTrilin
@@ -345,7 +345,7 @@ void vtkFixedPointMIPHelperGenerateImageOneSimpleTrilin(T* dataPtr, int threadID
 // We find the maximum index along the ray, and then use this to look up a
 // final color.
 template <class T>
-void vtkFixedPointMIPHelperGenerateImageOneTrilin(T* dataPtr, int threadID, int threadCount,
+void vtkFixedPointMIPHelperGenerateImageOneTrilin(T* dataPtr, int firstTile, int tileStride,
   vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vtkNotUsed(vol))
 {
   VTKKWRCHelper_InitializationAndLoopStartTrilin
@@ -415,7 +415,7 @@ void vtkFixedPointMIPHelperGenerateImageOneTrilin(T* dataPtr, int threadID, int
 // check if we can terminate at this point (if the accumulated opacity is
 // higher than some threshold).
 template <class T>
-void vtkFixedPointMIPHelperGenerateImageDependentTrilin(T* dataPtr, int threadID, int threadCount,
+void vtkFixedPointMIPHelperGenerateImageDependentTrilin(T* dataPtr, int firstTile, int tileStride,
   vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vtkNotUsed(vol))
 {
   VTKKWRCHelper_InitializationAndLoopStartTrilin
@@ -502,7 +502,7 @@ void vtkFixedPointMIPHelperGenerateImageDependentTrilin(T* dataPtr, int threadID
 // per component, then we look up a color/opacity for each component and blend
 // them according to the component weights.
 template <class T>
-void vtkFixedPointMIPHelperGenerateImageIndependentTrilin(T* dataPtr, int threadID, int threadCount,
+void vtkFixedPointMIPHelperGenerateImageIndependentTrilin(T* dataPtr, int firstTile, int tileStride,
   vtkFixedPointVolumeRayCastMapper* mapper, vtkVolume* vol)
 {
   VTKKWRCHelper_InitializeWeights
@@ -568,7 +568,7 @@ void vtkFixedPointMIPHelperGenerateImageIndependentTrilin(T* dataPtr, int thread
 }
 
 void vtkFixedPointVolumeRayCastMIPHelper::GenerateImage(
-  int threadID, int threadCount, vtkVolume* vol, vtkFixedPointVolumeRayCastMapper* mapper)
+  int firstTile, int tileStride, vtkVolume* vol, vtkFixedPointVolumeRayCastMapper* mapper)
 {
   void* dataPtr = mapper->GetCurrentScalars()->GetVoidPointer(0);
   int scalarType = mapper->GetCurrentScalars()->GetDataType();
@@ -582,7 +582,7 @@ void vtkFixedPointVolumeRayCastMIPHelper::GenerateImage(
       switch (scalarType)
       {
         vtkTemplateMacro(vtkFixedPointMIPHelperGenerateImageOneNN(
-          static_cast<VTK_TT*>(dataPtr), threadID, threadCount, mapper, vol));
+          static_cast<VTK_TT*>(dataPtr), firstTile, tileStride, mapper, vol));
       }
     }
     // More that one independent components
@@ -591,7 +591,7 @@ void vtkFixedPointVolumeRayCastMIPHelper::GenerateImage(
       switch (scalarType)
       {
         vtkTemplateMacro(vtkFixedPointMIPHelperGenerateImageIndependentNN(
-          static_cast<VTK_TT*>(dataPtr), threadID, threadCount, mapper, vol));
+          static_cast<VTK_TT*>(dataPtr), firstTile, tileStride, mapper, vol));
       }
     }
     // Dependent (color) components
@@ -600,7 +600,7 @@ void vtkFixedPointVolumeRayCastMIPHelper::GenerateImage(
       switch (scalarType)
       {
         vtkTemplateMacro(vtkFixedPointMIPHelperGenerateImageDependentNN(
-          static_cast<VTK_TT*>(dataPtr), threadID, threadCount, mapper, vol));
+          static_cast<VTK_TT*>(dataPtr), firstTile, tileStride, mapper, vol));
       }
     }
   }
@@ -616,7 +616,7 @@ void vtkFixedPointVolumeRayCastMIPHelper::GenerateImage(
         switch (scalarType)
         {
           vtkTemplateMacro(vtkFixedPointMIPHelperGenerateImageOneSimpleTrilin(
-            static_cast<VTK_TT*>(dataPtr), threadID, threadCount, mapper, vol));
+            static_cast<VTK_TT*>(dataPtr), firstTile, tileStride, mapper, vol));
         }
       }
       // Scale != 1.0 or shift != 0.0 - must apply scale/shift in inner loop
@@ -625,7 +625,7 @@ void vtkFixedPointVolumeRayCastMIPHelper::GenerateImage(
         switch (scalarType)
         {
           vtkTemplateMacro(vtkFixedPointMIPHelperGenerateImageOneTrilin(
-            static_cast<VTK_TT*>(dataPtr), threadID, threadCount, mapper, vol));
+            static_cast<VTK_TT*>(dataPtr), firstTile, tileStride, mapper, vol));
         }
       }
     }
@@ -635,7 +635,7 @@ void vtkFixedPointVolumeRayCastMIPHelper::GenerateImage(
       switch (scalarType)
       {
         vtkTemplateMacro(vtkFixedPointMIPHelperGenerateImageIndependentTrilin(
-          static_cast<VTK_TT*>(dataPtr), threadID, threadCount, mapper, vol));
+          static_cast<VTK_TT*>(dataPtr), firstTile, tileStride, mapper, vol));
       }
     }
     // Dependent components
@@ -644,7 +644,7 @@ void vtkFixedPointVolumeRayCastMIPHelper::GenerateImage(
       switch (scalarType)
       {
         vtkTemplateMacro(vtkFixedPointMIPHelperGenerateImageDependentTrilin(
-          static_cast<VTK_TT*>(dataPtr), threadID, threadCount, mapper, vol));
+          static_cast<VTK_TT*>(dataPtr), firstTile, tileStride, mapper, vol));
       }
     }
   }
@@ -26,6 +26,7 @@
 #include "vtkRayCastImageDisplayHelper.h"
 #include "vtkRenderWindow.h"
 #include "vtkRenderer.h"
+#include "vtkSMPTools.h"
 #include "vtkSphericalDirectionEncoder.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTimerLog.h"
@@ -33,6 +34,7 @@
 #include "vtkVolumeProperty.h"
 #include "vtkVolumeRayCastSpaceLeapingImageFilter.h"
 
+#include <algorithm>
 #include <cmath>
 #include <exception>
 
@@ -575,6 +577,7 @@ vtkFixedPointVolumeRayCastMapper::vtkFixedPointVolumeRayCastMapper()
 
   this->RowBounds = nullptr;
   this->OldRowBounds = nullptr;
+  this->ImageTileSize = 16;
 
   this->RenderTimeTable = nullptr;
   this->RenderVolumeTable = nullptr;
@@ -1204,14 +1207,103 @@ void vtkFixedPointVolumeRayCastMapper::PerSubVolumeInitialization(
 // This is the render method for the subvolume
 void vtkFixedPointVolumeRayCastMapper::RenderSubVolume()
 {
-  // Set the number of threads to use for ray casting,
-  // then set the execution method and do it.
   this->InvokeEvent(vtkCommand::VolumeMapperRenderStartEvent, nullptr);
-  this->Threader->SetSingleMethod(FixedPointVolumeRayCastMapper_CastRays, (void*)this);
-  this->Threader->SingleMethodExecute();
+
+  // The tiles are cast in batches so that the calling thread can check for an
+  // abort and report the progress between them, whatever the SMP backend.
+  // Within a batch, the tiles are dynamically scheduled on the threads.
+  const int numberOfTiles = this->GetNumberOfImageTiles();
+  const int numberOfBatches = 16;
+  const int batchSize = (numberOfTiles + numberOfBatches - 1) / numberOfBatches;
+  vtkSMPTools::LocalScope(vtkSMPTools::Config{ this->GetNumberOfThreads() },
+    [&]()
+    {
+      for (int batchStart = 0; batchStart < numberOfTiles; batchStart += batchSize)
+      {
+        if (this->RenderWindow->CheckAbortStatus())
+        {
+          break;
+        }
+        if (batchStart > 0)
+        {
+          double fargs[1];
+          fargs[0] = static_cast<double>(batchStart) / numberOfTiles;
+          this->InvokeEvent(vtkCommand::VolumeMapperRenderProgressEvent, fargs);
+        }
+        const int batchEnd = std::min(batchStart + batchSize, numberOfTiles);
+        vtkSMPTools::For(batchStart, batchEnd, 1,
+          [this, numberOfTiles](vtkIdType begin, vtkIdType end)
+          {
+            for (vtkIdType tile = begin; tile < end; ++tile)
+            {
+              this->CastImageTiles(static_cast<int>(tile), numberOfTiles);
+            }
+          });
+      }
+    });
+
   this->InvokeEvent(vtkCommand::VolumeMapperRenderEndEvent, nullptr);
 }
 
+//------------------------------------------------------------------------------
+int vtkFixedPointVolumeRayCastMapper::GetNumberOfImageTiles()
+{
+  int size[2];
+  this->RayCastImage->GetImageInUseSize(size);
+  const int tileSize = this->ImageTileSize;
+  return ((size[0] + tileSize - 1) / tileSize) * ((size[1] + tileSize - 1) / tileSize);
+}
+
+//------------------------------------------------------------------------------
+void vtkFixedPointVolumeRayCastMapper::GetImageTileBounds(int tile, int bounds[4])
+{
+  int size[2];
+  this->RayCastImage->GetImageInUseSize(size);
+  const int tileSize = this->ImageTileSize;
+  const int tilesPerRow = (size[0] + tileSize - 1) / tileSize;
+  bounds[0] = (tile % tilesPerRow) * tileSize;
+  bounds[1] = std::min(bounds[0] + tileSize, size[0]) - 1;
+  bounds[2] = (tile / tilesPerRow) * tileSize;
+  bounds[3] = std::min(bounds[2] + tileSize, size[1]) - 1;
+}
+
+//------------------------------------------------------------------------------
+void vtkFixedPointVolumeRayCastMapper::CastImageTiles(int firstTile, int tileStride)
+{
+  vtkVolume* vol = this->GetVolume();
+
+  if (this->GetBlendMode() == vtkVolumeMapper::MAXIMUM_INTENSITY_BLEND ||
+    this->GetBlendMode() == vtkVolumeMapper::MINIMUM_INTENSITY_BLEND)
+  {
+    this->MIPHelper->GenerateImage(firstTile, tileStride, vol, this);
+  }
+  else
+  {
+    if (this->ShadingRequired == 0)
+    {
+      if (this->GradientOpacityRequired == 0)
+      {
+        this->CompositeHelper->GenerateImage(firstTile, tileStride, vol, this);
+      }
+      else
+      {
+        this->CompositeGOHelper->GenerateImage(firstTile, tileStride, vol, this);
+      }
+    }
+    else
+    {
+      if (this->GradientOpacityRequired == 0)
+      {
+        this->CompositeShadeHelper->GenerateImage(firstTile, tileStride, vol, this);
+      }
+      else
+      {
+        this->CompositeGOShadeHelper->GenerateImage(firstTile, tileStride, vol, this);
+      }
+    }
+  }
+}
+
 // This method displays the image that has been created
 void vtkFixedPointVolumeRayCastMapper::DisplayRenderedImage(vtkRenderer* ren, vtkVolume* vol)
 {
@@ -1447,38 +1539,8 @@ VTK_THREAD_RETURN_TYPE FixedPointVolumeRayCastMapper_CastRays(void* arg)
     return VTK_THREAD_RETURN_VALUE;
   }
 
-  vtkVolume* vol = me->GetVolume();
-
-  if (me->GetBlendMode() == vtkVolumeMapper::MAXIMUM_INTENSITY_BLEND ||
-    me->GetBlendMode() == vtkVolumeMapper::MINIMUM_INTENSITY_BLEND)
-  {
-    me->GetMIPHelper()->GenerateImage(threadID, threadCount, vol, me);
-  }
-  else
-  {
-    if (me->GetShadingRequired() == 0)
-    {
-      if (me->GetGradientOpacityRequired() == 0)
-      {
-        me->GetCompositeHelper()->GenerateImage(threadID, threadCount, vol, me);
-      }
-      else
-      {
-        me->GetCompositeGOHelper()->GenerateImage(threadID, threadCount, vol, me);
-      }
-    }
-    else
-    {
-      if (me->GetGradientOpacityRequired() == 0)
-      {
-        me->GetCompositeShadeHelper()->GenerateImage(threadID, threadCount, vol, me);
-      }
-      else
-      {
-        me->GetCompositeGOShadeHelper()->GenerateImage(threadID, threadCount, vol, me);
-      }
-    }
-  }
+  // The image tiles are interleaved across the threads
+  me->CastImageTiles(threadID, threadCount);
 
   return VTK_THREAD_RETURN_VALUE;
 }
@@ -3177,6 +3239,7 @@ void vtkFixedPointVolumeRayCastMapper::PrintSelf(ostream& os, vtkIndent indent)
      << (this->LockSampleDistanceToInputSpacing ? "On\n" : "Off\n");
   os << indent << "Intermix Intersecting Geometry: "
      << (this->IntermixIntersectingGeometry ? "On\n" : "Off\n");
+  os << indent << "Image Tile Size: " << this->ImageTileSize << endl;
   os << indent << "Final Color Window: " << this->FinalColorWindow << endl;
   os << indent << "Final Color Level: " << this->FinalColorLevel << endl;
   os << indent << "Space leaping filter: " << this->SpaceLeapFilter << endl;
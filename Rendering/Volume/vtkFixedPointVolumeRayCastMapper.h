@@ -9,7 +9,9 @@
  * composite or MIP rendering, and can be intermixed with geometric data.
  * Space leaping is used to speed up the rendering process. In addition,
  * calculation are performed in 15 bit fixed point precision. This mapper
- * is threaded, and will interleave scan lines across processors.
+ * is threaded with vtkSMPTools: the image is split into small square tiles
+ * that are dynamically scheduled on the threads, so that threads finishing
+ * the empty parts of the image pick up more work instead of waiting.
  *
  * WARNING: This ray caster may not produce consistent results when
  * the number of threads exceeds 1. The class warns if the number of
@@ -172,13 +174,26 @@ public:
   ///@{
   /**
    * Set/Get the number of threads to use. This by default is equal to
-   * the number of available processors detected.
+   * the number of available processors detected. Ray casting uses at most
+   * this number of vtkSMPTools threads.
    * WARNING: If number of threads > 1, results may not be consistent.
    */
   void SetNumberOfThreads(int num);
   int GetNumberOfThreads();
   ///@}
 
+  ///@{
+  /**
+   * Set/Get the size, in pixels, of the square image tiles which are the
+   * unit of work scheduled on the threads. Smaller tiles balance the work
+   * better when the volume covers the image unevenly, larger tiles reduce
+   * the scheduling overhead. Default is 16, and the size is clamped to
+   * [1, 4096] so that the tile bounds computed in int do not overflow.
+   */
+  vtkSetClampMacro(ImageTileSize, int, 1, 4096);
+  vtkGetMacro(ImageTileSize, int);
+  ///@}
+
   ///@{
   /**
    * If IntermixIntersectingGeometry is turned on, the zbuffer will be
@@ -242,6 +257,14 @@ public:
   vtkGetObjectMacro(PreviousScalars, vtkDataArray);
 
   int* GetRowBounds() { return this->RowBounds; }
+
+  /**
+   * Number of image tiles of the image in use, and bounds (xmin, xmax, ymin,
+   * ymax) of a given tile. Used by the helpers to cast the rays of a tile.
+   */
+  int GetNumberOfImageTiles();
+  void GetImageTileBounds(int tile, int bounds[4]);
+
   unsigned short* GetColorTable(int c) { return this->ColorTable[c]; }
   unsigned short* GetScalarOpacityTable(int c) { return this->ScalarOpacityTable[c]; }
   unsigned short* GetGradientOpacityTable(int c) { return this->GradientOpacityTable[c]; }
@@ -354,6 +377,9 @@ protected:
 
   void CaptureZBuffer(vtkRenderer* ren);
 
+  // Cast the rays of the image tiles firstTile, firstTile + tileStride, ...
+  void CastImageTiles(int firstTile, int tileStride);
+
   friend VTK_THREAD_RETURN_TYPE FixedPointVolumeRayCastMapper_CastRays(void* arg);
   friend VTK_THREAD_RETURN_TYPE vtkFPVRCMSwitchOnDataType(void* arg);
 
@@ -378,6 +404,8 @@ protected:
   int* RowBounds;
   int* OldRowBounds;
 
+  int ImageTileSize;
+
   float* RenderTimeTable;
   vtkVolume** RenderVolumeTable;
   vtkRenderer** RenderRendererTable;
@@ -18,6 +18,8 @@
 #include "vtkPiecewiseFunction.h"
 #include "vtkPointData.h"
 #include "vtkRenderer.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkTransform.h"
 #include "vtkUnstructuredGrid.h"
@@ -26,14 +28,16 @@
 #include "vtkVolume.h"
 #include "vtkVolumeProperty.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cstdlib>
+#include <tuple>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkUnstructuredGridBunykRayCastFunction);
 
-#define VTK_BUNYKRCF_NUMLISTS 100000
-
 namespace
 {
 
@@ -477,6 +481,7 @@ vtkUnstructuredGridBunykRayCastFunction::vtkUnstructuredGridBunykRayCastFunction
   this->Points = nullptr;
   this->Image = nullptr;
   this->TriangleList = nullptr;
+  this->NumberOfTriangles = 0;
   this->TetraTriangles = nullptr;
   this->TetraTrianglesSize = 0;
   this->NumberOfPoints = 0;
@@ -510,13 +515,7 @@ vtkUnstructuredGridBunykRayCastFunction::~vtkUnstructuredGridBunykRayCastFunctio
     delete[] this->IntersectionBuffer[i];
   }
 
-  while (this->TriangleList)
-  {
-    Triangle* tmp;
-    tmp = this->TriangleList->Next;
-    delete this->TriangleList;
-    this->TriangleList = tmp;
-  }
+  delete[] this->TriangleList;
 
   this->ViewToWorldMatrix->Delete();
 }
@@ -728,29 +727,29 @@ void vtkUnstructuredGridBunykRayCastFunction::TransformPoints()
   this->ViewToWorldMatrix->DeepCopy(perspectiveTransform->GetMatrix());
   this->ViewToWorldMatrix->Invert();
 
-  double* origPtr;
-  double* transformedPtr = this->Points;
-  double in[4], out[4];
-  in[3] = 1.0;
   vtkUnstructuredGridBase* input = this->Mapper->GetInput();
-  int numPoints = input->GetNumberOfPoints();
+  vtkIdType numPoints = input->GetNumberOfPoints();
 
   // Loop through all the points and transform them
-  for (int i = 0; i < numPoints; i++)
-  {
-    origPtr = input->GetPoint(i);
-    in[0] = origPtr[0];
-    in[1] = origPtr[1];
-    in[2] = origPtr[2];
-    perspectiveMatrix->MultiplyPoint(in, out);
-    transformedPtr[0] =
-      (out[0] / out[3] + 1.0) / 2.0 * (double)this->ImageViewportSize[0] - this->ImageOrigin[0];
-    transformedPtr[1] =
-      (out[1] / out[3] + 1.0) / 2.0 * (double)this->ImageViewportSize[1] - this->ImageOrigin[1];
-    transformedPtr[2] = out[2] / out[3];
-
-    transformedPtr += 3;
-  }
+  vtkSMPTools::For(0, numPoints,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      double in[4], out[4];
+      in[3] = 1.0;
+      double* transformedPtr = this->Points + 3 * begin;
+      for (vtkIdType i = begin; i < end; i++)
+      {
+        input->GetPoint(i, in);
+        perspectiveMatrix->MultiplyPoint(in, out);
+        transformedPtr[0] = (out[0] / out[3] + 1.0) / 2.0 * (double)this->ImageViewportSize[0] -
+          this->ImageOrigin[0];
+        transformedPtr[1] = (out[1] / out[3] + 1.0) / 2.0 * (double)this->ImageViewportSize[1] -
+          this->ImageOrigin[1];
+        transformedPtr[2] = out[2] / out[3];
+
+        transformedPtr += 3;
+      }
+    });
 
   perspectiveTransform->Delete();
   perspectiveMatrix->Delete();
@@ -758,7 +757,8 @@ void vtkUnstructuredGridBunykRayCastFunction::TransformPoints()
 
 // This is done once per change in the data - build a list of
 // enumerated triangles (up to four per tetra). Don't store
-// duplicates, so we'll have to search for them.
+// duplicates: the faces of all the tetra are sorted in parallel
+// so that the faces shared by two tetra are next to each other.
 void vtkUnstructuredGridBunykRayCastFunction::UpdateTriangleList()
 {
   int needsUpdate = 0;
@@ -784,31 +784,12 @@ void vtkUnstructuredGridBunykRayCastFunction::UpdateTriangleList()
   }
 
   // Clear out the old triangle list
-  while (this->TriangleList)
-  {
-    Triangle* tmp;
-    tmp = this->TriangleList->Next;
-    delete this->TriangleList;
-    this->TriangleList = tmp;
-  }
+  delete[] this->TriangleList;
   this->TriangleList = nullptr;
-
-  // A temporary structure to reduce search time - VTK_BUNYKRCF_NUMLISTS small
-  // lists instead of one big one
-  Triangle* tmpList[VTK_BUNYKRCF_NUMLISTS];
-
-  vtkIdType i;
-  for (i = 0; i < VTK_BUNYKRCF_NUMLISTS; i++)
-  {
-    tmpList[i] = nullptr;
-  }
+  this->NumberOfTriangles = 0;
 
   vtkIdType numCells = input->GetNumberOfCells();
 
-  // Provide a warnings for anomalous conditions.
-  int nonTetraWarningNeeded = 0;
-  int faceUsed3TimesWarning = 0;
-
   // Create a set of links from each tetra to the four triangles
   // This is redundant information, but saves time during rendering
 
@@ -823,96 +804,112 @@ void vtkUnstructuredGridBunykRayCastFunction::UpdateTriangleList()
     this->TetraTrianglesSize = numCells;
   }
 
-  // Loop through all the cells
-  vtkSmartPointer<vtkCellIterator> cellIter =
-    vtkSmartPointer<vtkCellIterator>::Take(input->NewCellIterator());
-  for (cellIter->InitTraversal(); !cellIter->IsDoneWithTraversal(); cellIter->GoToNextCell())
+  // Gather the four points of each tetra, -1 for the other cells
+  std::vector<vtkIdType> tetraPoints(4 * numCells, -1);
+  std::atomic<bool> nonTetraWarningNeeded(false);
+  vtkUnstructuredGrid* grid = vtkUnstructuredGrid::SafeDownCast(input);
+  if (grid)
   {
-    // We only handle tetra
-    if (cellIter->GetCellType() != VTK_TETRA)
-    {
-      nonTetraWarningNeeded = 1;
-      continue;
-    }
-
-    // Get the four points
-    i = cellIter->GetCellId();
-    vtkIdList* ptIds = cellIter->GetPointIds();
-    vtkIdType pts[4];
-    pts[0] = ptIds->GetId(0);
-    pts[1] = ptIds->GetId(1);
-    pts[2] = ptIds->GetId(2);
-    pts[3] = ptIds->GetId(3);
-
-    // Build each of the four triangles
-    int ii, jj;
-    for (jj = 0; jj < 4; jj++)
-    {
-      vtkIdType tri[3];
-      int idx = 0;
-      for (ii = 0; ii < 4; ii++)
+    vtkSMPThreadLocalObject<vtkIdList> localIds;
+    vtkCellArray* cells = grid->GetCells();
+    vtkSMPTools::For(0, numCells,
+      [&](vtkIdType begin, vtkIdType end)
       {
-        if (ii != jj)
+        vtkIdList* ids = localIds.Local();
+        for (vtkIdType i = begin; i < end; i++)
         {
-          tri[idx++] = pts[ii];
+          // We only handle tetra
+          if (grid->GetCellType(i) != VTK_TETRA)
+          {
+            nonTetraWarningNeeded.store(true, std::memory_order_relaxed);
+            continue;
+          }
+          vtkIdType npts;
+          const vtkIdType* pts;
+          cells->GetCellAtId(i, npts, pts, ids);
+          std::copy(pts, pts + 4, tetraPoints.begin() + 4 * i);
         }
-      }
-
-      if (tri[0] > tri[1])
-      {
-        vtkIdType tmptri = tri[0];
-        tri[0] = tri[1];
-        tri[1] = tmptri;
-      }
-      if (tri[1] > tri[2])
-      {
-        vtkIdType tmptri = tri[1];
-        tri[1] = tri[2];
-        tri[2] = tmptri;
-      }
-      if (tri[0] > tri[1])
-      {
-        vtkIdType tmptri = tri[0];
-        tri[0] = tri[1];
-        tri[1] = tmptri;
-      }
-
-      // Do we have this triangle already?
-      Triangle* triPtr = tmpList[tri[0] % VTK_BUNYKRCF_NUMLISTS];
-      while (triPtr)
+      });
+  }
+  else
+  {
+    vtkSmartPointer<vtkCellIterator> cellIter =
+      vtkSmartPointer<vtkCellIterator>::Take(input->NewCellIterator());
+    for (cellIter->InitTraversal(); !cellIter->IsDoneWithTraversal(); cellIter->GoToNextCell())
+    {
+      // We only handle tetra
+      if (cellIter->GetCellType() != VTK_TETRA)
       {
-        if (triPtr->PointIndex[0] == tri[0] && triPtr->PointIndex[1] == tri[1] &&
-          triPtr->PointIndex[2] == tri[2])
-        {
-          break;
-        }
-        triPtr = triPtr->Next;
+        nonTetraWarningNeeded = true;
+        continue;
       }
+      vtkIdList* ptIds = cellIter->GetPointIds();
+      std::copy(ptIds->begin(), ptIds->begin() + 4,
+        tetraPoints.begin() + 4 * cellIter->GetCellId());
+    }
+  }
 
-      if (triPtr)
+  // Build each of the four triangles of the tetra, with sorted point ids.
+  // The face of index jj does not use the point jj of the tetra.
+  struct Face
+  {
+    vtkIdType PointIndex[3];
+    vtkIdType Id; // 4 * tetra + jj
+  };
+  std::vector<Face> faces(4 * numCells);
+  vtkSMPTools::For(0, numCells,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType i = begin; i < end; i++)
       {
-        if (triPtr->ReferredByTetra[1] != -1)
+        const vtkIdType* pts = tetraPoints.data() + 4 * i;
+        for (int jj = 0; jj < 4; jj++)
         {
-          faceUsed3TimesWarning = 1;
+          Face& face = faces[4 * i + jj];
+          int idx = 0;
+          for (int ii = 0; ii < 4; ii++)
+          {
+            if (ii != jj)
+            {
+              face.PointIndex[idx++] = pts[ii];
+            }
+          }
+          std::sort(face.PointIndex, face.PointIndex + 3);
+          face.Id = 4 * i + jj;
         }
-        triPtr->ReferredByTetra[1] = i;
-        this->TetraTriangles[i * 4 + jj] = triPtr;
-      }
-      else
-      {
-        Triangle* next = new Triangle;
-        next->PointIndex[0] = tri[0];
-        next->PointIndex[1] = tri[1];
-        next->PointIndex[2] = tri[2];
-        next->ReferredByTetra[0] = i;
-        next->ReferredByTetra[1] = -1;
-
-        next->Next = tmpList[tri[0] % VTK_BUNYKRCF_NUMLISTS];
-        tmpList[tri[0] % VTK_BUNYKRCF_NUMLISTS] = next;
-        this->TetraTriangles[i * 4 + jj] = next;
       }
+    });
+  vtkSMPTools::Sort(faces.begin(), faces.end(),
+    [](const Face& a, const Face& b)
+    {
+      return std::tie(a.PointIndex[0], a.PointIndex[1], a.PointIndex[2], a.Id) <
+        std::tie(b.PointIndex[0], b.PointIndex[1], b.PointIndex[2], b.Id);
+    });
+
+  // The faces of the other cells come first, then each triangle is a run of
+  // equal faces
+  const vtkIdType numFaces = static_cast<vtkIdType>(faces.size());
+  vtkIdType firstTetraFace = 0;
+  while (firstTetraFace < numFaces && faces[firstTetraFace].PointIndex[0] < 0)
+  {
+    this->TetraTriangles[faces[firstTetraFace++].Id] = nullptr;
+  }
+  std::vector<vtkIdType> runStarts;
+  int faceUsed3TimesWarning = 0;
+  for (vtkIdType k = firstTetraFace; k < numFaces; k++)
+  {
+    if (k == firstTetraFace ||
+      !std::equal(faces[k].PointIndex, faces[k].PointIndex + 3, faces[k - 1].PointIndex))
+    {
+      runStarts.push_back(k);
+    }
+    else if (k - runStarts.back() == 2)
+    {
+      faceUsed3TimesWarning = 1;
     }
   }
+  const vtkIdType numTriangles = static_cast<vtkIdType>(runStarts.size());
+  runStarts.push_back(numFaces);
 
   if (nonTetraWarningNeeded)
   {
@@ -923,20 +920,31 @@ void vtkUnstructuredGridBunykRayCastFunction::UpdateTriangleList()
     vtkWarningMacro("Degenerate topology - cell face used more than twice");
   }
 
-  // Put the list together
-  for (i = 0; i < VTK_BUNYKRCF_NUMLISTS; i++)
+  // Put the list together, the triangles are stored in one array and linked
+  // in order
+  if (numTriangles > 0)
   {
-    if (tmpList[i])
+    this->TriangleList = new Triangle[numTriangles];
+    this->NumberOfTriangles = numTriangles;
+  }
+  vtkSMPTools::For(0, numTriangles,
+    [&](vtkIdType begin, vtkIdType end)
     {
-      Triangle* last = tmpList[i];
-      while (last->Next)
+      for (vtkIdType t = begin; t < end; t++)
       {
-        last = last->Next;
+        const vtkIdType first = runStarts[t];
+        const vtkIdType last = runStarts[t + 1] - 1;
+        Triangle* triPtr = this->TriangleList + t;
+        std::copy(faces[first].PointIndex, faces[first].PointIndex + 3, triPtr->PointIndex);
+        triPtr->ReferredByTetra[0] = faces[first].Id / 4;
+        triPtr->ReferredByTetra[1] = (last > first) ? faces[last].Id / 4 : -1;
+        triPtr->Next = (t + 1 < numTriangles) ? triPtr + 1 : nullptr;
+        for (vtkIdType k = first; k <= last; k++)
+        {
+          this->TetraTriangles[faces[k].Id] = triPtr;
+        }
       }
-      last->Next = this->TriangleList;
-      this->TriangleList = tmpList[i];
-    }
-  }
+    });
 
   this->SavedTriangleListInput = input;
   this->SavedTriangleListMTime.Modified();
@@ -944,64 +952,66 @@ void vtkUnstructuredGridBunykRayCastFunction::UpdateTriangleList()
 
 void vtkUnstructuredGridBunykRayCastFunction::ComputeViewDependentInfo()
 {
-  Triangle* triPtr = this->TriangleList;
-  while (triPtr)
-  {
-    double P1[3], P2[3];
-    double A[3], B[3], C[3];
-
-    A[0] = this->Points[3 * triPtr->PointIndex[0]];
-    A[1] = this->Points[3 * triPtr->PointIndex[0] + 1];
-    A[2] = this->Points[3 * triPtr->PointIndex[0] + 2];
-    B[0] = this->Points[3 * triPtr->PointIndex[1]];
-    B[1] = this->Points[3 * triPtr->PointIndex[1] + 1];
-    B[2] = this->Points[3 * triPtr->PointIndex[1] + 2];
-    C[0] = this->Points[3 * triPtr->PointIndex[2]];
-    C[1] = this->Points[3 * triPtr->PointIndex[2] + 1];
-    C[2] = this->Points[3 * triPtr->PointIndex[2] + 2];
-
-    P1[0] = B[0] - A[0];
-    P1[1] = B[1] - A[1];
-    P1[2] = B[2] - A[2];
-
-    P2[0] = C[0] - A[0];
-    P2[1] = C[1] - A[1];
-    P2[2] = C[2] - A[2];
-
-    triPtr->Denominator = P1[0] * P2[1] - P2[0] * P1[1];
-
-    if (triPtr->Denominator < 0)
+  vtkSMPTools::For(0, this->NumberOfTriangles,
+    [&](vtkIdType begin, vtkIdType end)
     {
-      double T[3];
-      triPtr->Denominator = -triPtr->Denominator;
-      T[0] = P1[0];
-      T[1] = P1[1];
-      T[2] = P1[2];
-      P1[0] = P2[0];
-      P1[1] = P2[1];
-      P1[2] = P2[2];
-      P2[0] = T[0];
-      P2[1] = T[1];
-      P2[2] = T[2];
-      vtkIdType tmpIndex = triPtr->PointIndex[1];
-      triPtr->PointIndex[1] = triPtr->PointIndex[2];
-      triPtr->PointIndex[2] = tmpIndex;
-    }
-
-    triPtr->P1X = P1[0];
-    triPtr->P1Y = P1[1];
-    triPtr->P2X = P2[0];
-    triPtr->P2Y = P2[1];
-
-    double result[3];
-    vtkMath::Cross(P1, P2, result);
-    triPtr->A = result[0];
-    triPtr->B = result[1];
-    triPtr->C = result[2];
-    triPtr->D = -(A[0] * result[0] + A[1] * result[1] + A[2] * result[2]);
+      for (Triangle* triPtr = this->TriangleList + begin; triPtr != this->TriangleList + end;
+           ++triPtr)
+      {
+        double P1[3], P2[3];
+        double A[3], B[3], C[3];
+
+        A[0] = this->Points[3 * triPtr->PointIndex[0]];
+        A[1] = this->Points[3 * triPtr->PointIndex[0] + 1];
+        A[2] = this->Points[3 * triPtr->PointIndex[0] + 2];
+        B[0] = this->Points[3 * triPtr->PointIndex[1]];
+        B[1] = this->Points[3 * triPtr->PointIndex[1] + 1];
+        B[2] = this->Points[3 * triPtr->PointIndex[1] + 2];
+        C[0] = this->Points[3 * triPtr->PointIndex[2]];
+        C[1] = this->Points[3 * triPtr->PointIndex[2] + 1];
+        C[2] = this->Points[3 * triPtr->PointIndex[2] + 2];
+
+        P1[0] = B[0] - A[0];
+        P1[1] = B[1] - A[1];
+        P1[2] = B[2] - A[2];
+
+        P2[0] = C[0] - A[0];
+        P2[1] = C[1] - A[1];
+        P2[2] = C[2] - A[2];
+
+        triPtr->Denominator = P1[0] * P2[1] - P2[0] * P1[1];
+
+        if (triPtr->Denominator < 0)
+        {
+          double T[3];
+          triPtr->Denominator = -triPtr->Denominator;
+          T[0] = P1[0];
+          T[1] = P1[1];
+          T[2] = P1[2];
+          P1[0] = P2[0];
+          P1[1] = P2[1];
+          P1[2] = P2[2];
+          P2[0] = T[0];
+          P2[1] = T[1];
+          P2[2] = T[2];
+          vtkIdType tmpIndex = triPtr->PointIndex[1];
+          triPtr->PointIndex[1] = triPtr->PointIndex[2];
+          triPtr->PointIndex[2] = tmpIndex;
+        }
 
-    triPtr = triPtr->Next;
-  }
+        triPtr->P1X = P1[0];
+        triPtr->P1Y = P1[1];
+        triPtr->P2X = P2[0];
+        triPtr->P2Y = P2[1];
+
+        double result[3];
+        vtkMath::Cross(P1, P2, result);
+        triPtr->A = result[0];
+        triPtr->B = result[1];
+        triPtr->C = result[2];
+        triPtr->D = -(A[0] * result[0] + A[1] * result[1] + A[2] * result[2]);
+      }
+    });
 }
 
 void vtkUnstructuredGridBunykRayCastFunction::ComputePixelIntersections()
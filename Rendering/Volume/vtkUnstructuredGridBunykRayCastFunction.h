@@ -213,7 +213,9 @@ protected:
   Triangle** TetraTriangles;
   vtkIdType TetraTrianglesSize;
 
+  // The triangles are allocated in one array, and linked in that order
   Triangle* TriangleList;
+  vtkIdType NumberOfTriangles;
 
   // Compute whether a boundary triangle is front facing by
   // looking at the fourth point in the tetra to see if it is
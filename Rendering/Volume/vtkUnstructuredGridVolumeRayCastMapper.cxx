@@ -16,6 +16,9 @@
 #include "vtkRayCastImageDisplayHelper.h"
 #include "vtkRenderWindow.h"
 #include "vtkRenderer.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
 #include "vtkTimerLog.h"
 #include "vtkTransform.h"
 #include "vtkUnstructuredGrid.h"
@@ -26,13 +29,45 @@
 #include "vtkUnstructuredGridVolumeRayCastIterator.h"
 #include "vtkVolumeProperty.h"
 
+#include <algorithm>
 #include <cmath>
 
 VTK_ABI_NAMESPACE_BEGIN
-VTK_THREAD_RETURN_TYPE UnstructuredGridVolumeRayCastMapper_CastRays(void* arg);
-
 vtkStandardNewMacro(vtkUnstructuredGridVolumeRayCastMapper);
 
+class vtkUnstructuredGridVolumeRayCastMapper::RayCastBuffers
+{
+public:
+  vtkSmartPointer<vtkUnstructuredGridVolumeRayCastIterator> Iterator;
+  vtkSmartPointer<vtkIdList> IntersectedCells;
+  vtkSmartPointer<vtkDoubleArray> IntersectionLengths;
+  vtkSmartPointer<vtkDataArray> NearIntersections;
+  vtkSmartPointer<vtkDataArray> FarIntersections;
+
+  void Initialize(vtkUnstructuredGridVolumeRayCastMapper* self)
+  {
+    this->Iterator = vtk::TakeSmartPointer(self->RayCastFunction->NewIterator());
+    const vtkIdType maxIntersections = this->Iterator->GetMaxNumberOfIntersections();
+    this->IntersectionLengths = vtkSmartPointer<vtkDoubleArray>::New();
+    this->IntersectionLengths->Allocate(maxIntersections);
+    this->NearIntersections =
+      vtk::TakeSmartPointer(vtkDataArray::CreateDataArray(self->Scalars->GetDataType()));
+    this->NearIntersections->Allocate(maxIntersections);
+    if (self->CellScalars)
+    {
+      this->IntersectedCells = vtkSmartPointer<vtkIdList>::New();
+      this->IntersectedCells->Allocate(maxIntersections);
+      this->FarIntersections = this->NearIntersections;
+    }
+    else
+    {
+      this->FarIntersections =
+        vtk::TakeSmartPointer(vtkDataArray::CreateDataArray(self->Scalars->GetDataType()));
+      this->FarIntersections->Allocate(maxIntersections);
+    }
+  }
+};
+
 vtkCxxSetObjectMacro(vtkUnstructuredGridVolumeRayCastMapper, RayCastFunction,
   vtkUnstructuredGridVolumeRayCastFunction);
 vtkCxxSetObjectMacro(
@@ -51,6 +86,7 @@ vtkUnstructuredGridVolumeRayCastMapper::vtkUnstructuredGridVolumeRayCastMapper()
 
   this->Threader = vtkMultiThreader::New();
   this->NumberOfThreads = this->Threader->GetNumberOfThreads();
+  this->ImageTileSize = 16;
 
   this->Image = nullptr;
 
@@ -374,65 +410,47 @@ void vtkUnstructuredGridVolumeRayCastMapper::Render(vtkRenderer* ren, vtkVolume*
   this->CurrentVolume = vol;
   this->CurrentRenderer = ren;
 
-  // Create iterators and buffers here to prevent race conditions.
-  this->RayCastIterators = new vtkUnstructuredGridVolumeRayCastIterator*[this->NumberOfThreads];
-  this->IntersectedCellsBuffer = new vtkIdList*[this->NumberOfThreads];
-  this->IntersectionLengthsBuffer = new vtkDoubleArray*[this->NumberOfThreads];
-  this->NearIntersectionsBuffer = new vtkDataArray*[this->NumberOfThreads];
-  this->FarIntersectionsBuffer = new vtkDataArray*[this->NumberOfThreads];
-  for (i = 0; i < this->NumberOfThreads; i++)
+  // The image tiles are dynamically scheduled on the threads, each thread
+  // creating its iterator and buffers the first time it casts a tile. The
+  // tiles are cast in batches so that the calling thread checks for an abort
+  // and reports the progress between them, whatever the SMP backend.
   {
-    this->RayCastIterators[i] = this->RayCastFunction->NewIterator();
-    this->IntersectionLengthsBuffer[i] = vtkDoubleArray::New();
-    this->IntersectionLengthsBuffer[i]->Allocate(
-      this->RayCastIterators[i]->GetMaxNumberOfIntersections());
-    this->NearIntersectionsBuffer[i] = vtkDataArray::CreateDataArray(this->Scalars->GetDataType());
-    this->NearIntersectionsBuffer[i]->Allocate(
-      this->RayCastIterators[i]->GetMaxNumberOfIntersections());
-    if (this->CellScalars)
-    {
-      this->IntersectedCellsBuffer[i] = vtkIdList::New();
-      this->IntersectedCellsBuffer[i]->Allocate(
-        this->RayCastIterators[i]->GetMaxNumberOfIntersections());
-      this->FarIntersectionsBuffer[i] = this->NearIntersectionsBuffer[i];
-    }
-    else
-    {
-      this->IntersectedCellsBuffer[i] = nullptr;
-      this->FarIntersectionsBuffer[i] = vtkDataArray::CreateDataArray(this->Scalars->GetDataType());
-      this->FarIntersectionsBuffer[i]->Allocate(
-        this->RayCastIterators[i]->GetMaxNumberOfIntersections());
-    }
+    vtkSMPThreadLocal<RayCastBuffers> buffers;
+    vtkRenderWindow* renWin = ren->GetRenderWindow();
+    const int numberOfTiles = this->GetNumberOfImageTiles();
+    const int numberOfBatches = 16;
+    const int batchSize = (numberOfTiles + numberOfBatches - 1) / numberOfBatches;
+    vtkSMPTools::LocalScope(vtkSMPTools::Config{ this->NumberOfThreads },
+      [&]()
+      {
+        for (int batchStart = 0; batchStart < numberOfTiles; batchStart += batchSize)
+        {
+          this->UpdateProgress(static_cast<double>(batchStart) / numberOfTiles);
+          if (renWin->CheckAbortStatus())
+          {
+            break;
+          }
+          const int batchEnd = std::min(batchStart + batchSize, numberOfTiles);
+          vtkSMPTools::For(batchStart, batchEnd, 1,
+            [&](vtkIdType begin, vtkIdType end)
+            {
+              RayCastBuffers& local = buffers.Local();
+              if (!local.Iterator)
+              {
+                local.Initialize(this);
+              }
+              for (vtkIdType tile = begin; tile < end; ++tile)
+              {
+                this->CastTileRays(static_cast<int>(tile), local);
+              }
+            });
+        }
+      });
   }
 
-  // Set the number of threads to use for ray casting,
-  // then set the execution method and do it.
-  this->Threader->SetNumberOfThreads(this->NumberOfThreads);
-  this->Threader->SetSingleMethod(UnstructuredGridVolumeRayCastMapper_CastRays, (void*)this);
-  this->Threader->SingleMethodExecute();
-
   // We don't need these anymore
   this->CurrentVolume = nullptr;
   this->CurrentRenderer = nullptr;
-  for (i = 0; i < this->NumberOfThreads; i++)
-  {
-    this->RayCastIterators[i]->Delete();
-    this->IntersectionLengthsBuffer[i]->Delete();
-    this->NearIntersectionsBuffer[i]->Delete();
-    if (this->CellScalars)
-    {
-      this->IntersectedCellsBuffer[i]->Delete();
-    }
-    else
-    {
-      this->FarIntersectionsBuffer[i]->Delete();
-    }
-  }
-  delete[] this->RayCastIterators;
-  delete[] this->IntersectedCellsBuffer;
-  delete[] this->IntersectionLengthsBuffer;
-  delete[] this->NearIntersectionsBuffer;
-  delete[] this->FarIntersectionsBuffer;
 
   if (!ren->GetRenderWindow()->GetAbortRender())
   {
@@ -464,25 +482,6 @@ void vtkUnstructuredGridVolumeRayCastMapper::Render(vtkRenderer* ren, vtkVolume*
   this->UpdateProgress(1.0);
 }
 
-VTK_THREAD_RETURN_TYPE UnstructuredGridVolumeRayCastMapper_CastRays(void* arg)
-{
-  // Get the info out of the input structure
-  int threadID = ((vtkMultiThreader::ThreadInfo*)(arg))->ThreadID;
-  int threadCount = ((vtkMultiThreader::ThreadInfo*)(arg))->NumberOfThreads;
-  vtkUnstructuredGridVolumeRayCastMapper* me =
-    (vtkUnstructuredGridVolumeRayCastMapper*)((vtkMultiThreader::ThreadInfo*)arg)->UserData;
-
-  if (!me)
-  {
-    vtkGenericWarningMacro("The volume does not have a ray cast mapper!");
-    return VTK_THREAD_RETURN_VALUE;
-  }
-
-  me->CastRays(threadID, threadCount);
-
-  return VTK_THREAD_RETURN_VALUE;
-}
-
 template <class T>
 inline void vtkUGVRCMLookupCopy(
   const T* src, T* dest, vtkIdType* lookup, int numcomponents, int numtuples)
@@ -501,40 +500,47 @@ inline void vtkUGVRCMLookupCopy(
 
 void vtkUnstructuredGridVolumeRayCastMapper::CastRays(int threadID, int threadCount)
 {
-  int i, j;
-  unsigned char* ucptr;
-
   vtkRenderWindow* renWin = this->CurrentRenderer->GetRenderWindow();
-  vtkUnstructuredGridVolumeRayCastIterator* iterator = this->RayCastIterators[threadID];
-
-  vtkIdList* intersectedCells = this->IntersectedCellsBuffer[threadID];
-  vtkDoubleArray* intersectionLengths = this->IntersectionLengthsBuffer[threadID];
-  vtkDataArray* nearIntersections = this->NearIntersectionsBuffer[threadID];
-  vtkDataArray* farIntersections = this->FarIntersectionsBuffer[threadID];
+  RayCastBuffers buffers;
+  buffers.Initialize(this);
 
-  for (j = 0; j < this->ImageInUseSize[1]; j++)
+  const int numberOfTiles = this->GetNumberOfImageTiles();
+  for (int tile = threadID; tile < numberOfTiles && !renWin->GetAbortRender();
+       tile += threadCount)
   {
-    if (j % threadCount != threadID)
-    {
-      continue;
-    }
+    this->CastTileRays(tile, buffers);
+  }
+}
 
-    if (!threadID)
-    {
-      this->UpdateProgress((double)j / this->ImageInUseSize[1]);
-      if (renWin->CheckAbortStatus())
-      {
-        break;
-      }
-    }
-    else if (renWin->GetAbortRender())
-    {
-      break;
-    }
+//------------------------------------------------------------------------------
+int vtkUnstructuredGridVolumeRayCastMapper::GetNumberOfImageTiles()
+{
+  const int tileSize = this->ImageTileSize;
+  return ((this->ImageInUseSize[0] + tileSize - 1) / tileSize) *
+    ((this->ImageInUseSize[1] + tileSize - 1) / tileSize);
+}
 
-    ucptr = this->Image + 4 * j * this->ImageMemorySize[0];
+//------------------------------------------------------------------------------
+void vtkUnstructuredGridVolumeRayCastMapper::CastTileRays(int tile, RayCastBuffers& buffers)
+{
+  vtkUnstructuredGridVolumeRayCastIterator* iterator = buffers.Iterator;
+  vtkIdList* intersectedCells = buffers.IntersectedCells;
+  vtkDoubleArray* intersectionLengths = buffers.IntersectionLengths;
+  vtkDataArray* nearIntersections = buffers.NearIntersections;
+  vtkDataArray* farIntersections = buffers.FarIntersections;
+
+  const int tileSize = this->ImageTileSize;
+  const int tilesPerRow = (this->ImageInUseSize[0] + tileSize - 1) / tileSize;
+  const int iMin = (tile % tilesPerRow) * tileSize;
+  const int iMax = std::min(iMin + tileSize, this->ImageInUseSize[0]);
+  const int jMin = (tile / tilesPerRow) * tileSize;
+  const int jMax = std::min(jMin + tileSize, this->ImageInUseSize[1]);
+
+  for (int j = jMin; j < jMax; j++)
+  {
+    unsigned char* ucptr = this->Image + 4 * (j * this->ImageMemorySize[0] + iMin);
 
-    for (i = 0; i < this->ImageInUseSize[0]; i++)
+    for (int i = iMin; i < iMax; i++)
     {
       int x = i + this->ImageOrigin[0];
       int y = j + this->ImageOrigin[1];
@@ -687,6 +693,7 @@ void vtkUnstructuredGridVolumeRayCastMapper::PrintSelf(ostream& os, vtkIndent in
      << (this->IntermixIntersectingGeometry ? "On\n" : "Off\n");
 
   os << indent << "Number Of Threads: " << this->NumberOfThreads << "\n";
+  os << indent << "Image Tile Size: " << this->ImageTileSize << "\n";
 
   if (this->RayCastFunction)
   {
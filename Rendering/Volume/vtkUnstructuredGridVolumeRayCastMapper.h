@@ -6,6 +6,9 @@
  * @brief   A software mapper for unstructured volumes
  *
  * This is a software ray caster for rendering volumes in vtkUnstructuredGrid.
+ * The image is split into small square tiles that are dynamically scheduled
+ * on the threads with vtkSMPTools, each thread using its own ray cast
+ * iterator.
  *
  * @sa
  * vtkVolumeMapper
@@ -18,14 +21,11 @@
 #include "vtkUnstructuredGridVolumeMapper.h"
 
 VTK_ABI_NAMESPACE_BEGIN
-class vtkDoubleArray;
-class vtkIdList;
 class vtkMultiThreader;
 class vtkRayCastImageDisplayHelper;
 class vtkRenderer;
 class vtkTimerLog;
 class vtkUnstructuredGridVolumeRayCastFunction;
-class vtkUnstructuredGridVolumeRayCastIterator;
 class vtkUnstructuredGridVolumeRayIntegrator;
 class vtkVolume;
 
@@ -80,12 +80,22 @@ public:
   ///@{
   /**
    * Set/Get the number of threads to use. This by default is equal to
-   * the number of available processors detected.
+   * the number of available processors detected. Ray casting uses at most
+   * this number of vtkSMPTools threads.
    */
   vtkSetMacro(NumberOfThreads, int);
   vtkGetMacro(NumberOfThreads, int);
   ///@}
 
+  ///@{
+  /**
+   * Set/Get the size, in pixels, of the square image tiles which are the
+   * unit of work scheduled on the threads. Default is 16, at most 4096.
+   */
+  vtkSetClampMacro(ImageTileSize, int, 1, 4096);
+  vtkGetMacro(ImageTileSize, int);
+  ///@}
+
   ///@{
   /**
    * If IntermixIntersectingGeometry is turned on, the zbuffer will be
@@ -131,6 +141,9 @@ public:
   vtkGetVectorMacro(ImageOrigin, int, 2);
   vtkGetVectorMacro(ImageViewportSize, int, 2);
 
+  /**
+   * Cast the rays of the image tiles threadID, threadID + threadCount, ...
+   */
   void CastRays(int threadID, int threadCount);
 
 protected:
@@ -144,6 +157,7 @@ protected:
 
   vtkMultiThreader* Threader;
   int NumberOfThreads;
+  int ImageTileSize;
 
   vtkRayCastImageDisplayHelper* ImageDisplayHelper;
 
@@ -192,15 +206,9 @@ protected:
   double GetMinimumBoundsDepth(vtkRenderer* ren, vtkVolume* vol);
 
   vtkUnstructuredGridVolumeRayCastFunction* RayCastFunction;
-  vtkUnstructuredGridVolumeRayCastIterator** RayCastIterators;
   vtkUnstructuredGridVolumeRayIntegrator* RayIntegrator;
   vtkUnstructuredGridVolumeRayIntegrator* RealRayIntegrator;
 
-  vtkIdList** IntersectedCellsBuffer;
-  vtkDoubleArray** IntersectionLengthsBuffer;
-  vtkDataArray** NearIntersectionsBuffer;
-  vtkDataArray** FarIntersectionsBuffer;
-
   vtkVolume* CurrentVolume;
   vtkRenderer* CurrentRenderer;
 
@@ -210,6 +218,12 @@ protected:
 private:
   vtkUnstructuredGridVolumeRayCastMapper(const vtkUnstructuredGridVolumeRayCastMapper&) = delete;
   void operator=(const vtkUnstructuredGridVolumeRayCastMapper&) = delete;
+
+  // Iterator and intersection buffers used by one thread
+  class RayCastBuffers;
+
+  int GetNumberOfImageTiles();
+  void CastTileRays(int tile, RayCastBuffers& buffers);
 };
 
 VTK_ABI_NAMESPACE_END
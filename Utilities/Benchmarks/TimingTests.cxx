@@ -37,6 +37,18 @@ int main(int argc, char* argv[])
 
   a.TestsToRun.push_back(new manyActorTest("ManyActors"));
 
+  a.TestsToRun.push_back(new labelPlacementTest("LabelPlacement", false));
+  a.TestsToRun.push_back(new labelPlacementTest("LabelPlacementReused", true));
+
+  a.TestsToRun.push_back(new compressedArrayTest("CompressedArrayRead"));
+
+  a.TestsToRun.push_back(new firstTouchTest("FilterKernelsSerialTouch", false));
+  a.TestsToRun.push_back(new firstTouchTest("FilterKernelsFirstTouch", true));
+
+  a.TestsToRun.push_back(new kdTreeBuildTest("KdTreeBuild"));
+
+  a.TestsToRun.push_back(new spatialReorderTest("SpatialReorder"));
+
   // process them
   return a.ParseCommandLineArguments(argc, argv);
 }
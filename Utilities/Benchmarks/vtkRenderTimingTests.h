@@ -727,6 +727,505 @@ public:
 protected:
 };
 
+VTK_ABI_NAMESPACE_END
+
+/*=========================================================================
+Define a test for label placement
+=========================================================================*/
+#include "vtkActor2D.h"
+#include "vtkDoubleArray.h"
+#include "vtkLabelPlacementMapper.h"
+#include "vtkPointSetToLabelHierarchy.h"
+#include "vtkPointSource.h"
+#include "vtkStringArray.h"
+
+VTK_ABI_NAMESPACE_BEGIN
+class labelPlacementTest : public vtkRTTest
+{
+public:
+  labelPlacementTest(const char* name, bool reusePlacement)
+    : vtkRTTest(name)
+  {
+    this->ReusePlacement = reusePlacement;
+  }
+
+  const char* GetSummaryResultName() override { return "labels"; }
+
+  const char* GetSecondSummaryResultName() override { return "frames/sec"; }
+
+  vtkRTTestResult Run(vtkRTTestSequence* ats, int /*argc*/, char* /* argv */[]) override
+  {
+    int res1, res2;
+    ats->GetSequenceNumbers(res1, res2);
+
+    // ------------------------------------------------------------
+    // Create labels with random priorities
+    // ------------------------------------------------------------
+    vtkNew<vtkPointSource> points;
+    points->SetNumberOfPoints(10000 * res1 * res2);
+    points->SetRadius(100.0);
+    points->Update();
+    vtkPolyData* pd = points->GetOutput();
+    vtkIdType numLabels = pd->GetNumberOfPoints();
+    vtkNew<vtkDoubleArray> priorities;
+    priorities->SetName("Priority");
+    priorities->SetNumberOfValues(numLabels);
+    vtkNew<vtkStringArray> labels;
+    labels->SetName("Label");
+    labels->SetNumberOfValues(numLabels);
+    for (vtkIdType i = 0; i < numLabels; ++i)
+    {
+      priorities->SetValue(i, vtkMath::Random());
+      labels->SetValue(i, "Label " + std::to_string(i));
+    }
+    pd->GetPointData()->AddArray(priorities);
+    pd->GetPointData()->AddArray(labels);
+
+    vtkNew<vtkPointSetToLabelHierarchy> hierarchy;
+    hierarchy->SetInputData(pd);
+    hierarchy->SetPriorityArrayName("Priority");
+    hierarchy->SetLabelArrayName("Label");
+    double startTime = vtkTimerLog::GetUniversalTime();
+    hierarchy->Update();
+    double hierarchyTime = vtkTimerLog::GetUniversalTime() - startTime;
+
+    vtkNew<vtkLabelPlacementMapper> mapper;
+    mapper->SetInputConnection(hierarchy->GetOutputPort());
+    if (this->ReusePlacement)
+    {
+      mapper->SetPlacementReuseTolerance(4.0);
+    }
+    vtkNew<vtkActor2D> actor;
+    actor->SetMapper(mapper);
+
+    // create a rendering window and renderer
+    vtkNew<vtkRenderer> ren1;
+    vtkNew<vtkRenderWindow> renWindow;
+    renWindow->AddRenderer(ren1.Get());
+    ren1->AddActor(actor.Get());
+
+    // set the size/color of our window
+    renWindow->SetSize(this->GetRenderWidth(), this->GetRenderHeight());
+    ren1->SetBackground(0.2, 0.3, 0.5);
+
+    // draw the resulting scene
+    startTime = vtkTimerLog::GetUniversalTime();
+    renWindow->Render();
+    double firstFrameTime = vtkTimerLog::GetUniversalTime() - startTime;
+
+    // small camera motions, as while interacting
+    int frameCount = 80;
+    for (int i = 0; i < frameCount; i++)
+    {
+      ren1->GetActiveCamera()->Azimuth(0.1);
+      renWindow->Render();
+      if ((vtkTimerLog::GetUniversalTime() - startTime - firstFrameTime) > this->TargetTime * 1.5)
+      {
+        frameCount = i + 1;
+        break;
+      }
+    }
+    double subsequentFrameTime =
+      (vtkTimerLog::GetUniversalTime() - startTime - firstFrameTime) / frameCount;
+
+    vtkRTTestResult result;
+    result.Results["hierarchy time"] = hierarchyTime;
+    result.Results["first frame time"] = firstFrameTime;
+    result.Results["subsequent frame time"] = subsequentFrameTime;
+    result.Results["frames/sec"] = 1.0 / subsequentFrameTime;
+    result.Results["labels"] = numLabels;
+
+    return result;
+  }
+
+protected:
+  bool ReusePlacement;
+};
+
+VTK_ABI_NAMESPACE_END
+
+/*=========================================================================
+Define a test for reading a compressed array
+=========================================================================*/
+#include "vtkArrayDispatch.h"
+#include "vtkCompressedArray.h"
+#include "vtkDataArrayRange.h"
+
+VTK_ABI_NAMESPACE_BEGIN
+class compressedArrayTest : public vtkRTTest
+{
+public:
+  compressedArrayTest(const char* name)
+    : vtkRTTest(name)
+  {
+  }
+
+  const char* GetSummaryResultName() override { return "Mvalues/sec"; }
+
+  const char* GetSecondSummaryResultName() override { return "Mvalues"; }
+
+  vtkRTTestResult Run(vtkRTTestSequence* ats, int /*argc*/, char* /* argv */[]) override
+  {
+    int res1;
+    ats->GetSequenceNumbers(res1);
+
+    // ------------------------------------------------------------
+    // Create a smooth vector field
+    // ------------------------------------------------------------
+    vtkIdType numTuples = 100000 * res1;
+    vtkNew<vtkDoubleArray> field;
+    field->SetNumberOfComponents(3);
+    field->SetNumberOfTuples(numTuples);
+    for (vtkIdType i = 0; i < numTuples; ++i)
+    {
+      const double t = 1e-4 * static_cast<double>(i);
+      field->SetTuple3(i, std::sin(t), std::cos(t), 2.0);
+    }
+
+    double startTime = vtkTimerLog::GetUniversalTime();
+    vtkNew<vtkCompressedArray<double>> compressed;
+    compressed->SetBackend(std::make_shared<vtkCompressedImplicitBackend<double>>(field));
+    compressed->SetNumberOfComponents(3);
+    compressed->SetNumberOfTuples(numTuples);
+    double compressionTime = vtkTimerLog::GetUniversalTime() - startTime;
+
+    double sum = 0.0;
+    double aosTime = this->TimeSum(field, sum);
+    double compressedTime = this->TimeSum(compressed, sum);
+
+    vtkRTTestResult result;
+    result.Results["compression time"] = compressionTime;
+    result.Results["compression ratio"] =
+      static_cast<double>(field->GetActualMemorySize()) / compressed->GetActualMemorySize();
+    result.Results["AOS read time"] = aosTime;
+    result.Results["compressed read time"] = compressedTime;
+    result.Results["Mvalues"] = 1.0e-6 * 3 * numTuples;
+    result.Results["Mvalues/sec"] = 1.0e-6 * 3 * numTuples / compressedTime;
+
+    return result;
+  }
+
+protected:
+  struct SumWorker
+  {
+    template <typename ArrayT>
+    void operator()(ArrayT* array, double& sum)
+    {
+      sum = 0.0;
+      for (const auto value : vtk::DataArrayValueRange<3>(array))
+      {
+        sum += value;
+      }
+    }
+  };
+
+  // time the sum of the values through vtkArrayDispatch, as filters read them
+  double TimeSum(vtkDataArray* array, double& sum)
+  {
+    using Dispatcher = vtkArrayDispatch::DispatchByArray<
+      vtkTypeList::Create<vtkDoubleArray, vtkCompressedArray<double>>>;
+    SumWorker worker;
+    double startTime = vtkTimerLog::GetUniversalTime();
+    Dispatcher::Execute(array, worker, sum);
+    return vtkTimerLog::GetUniversalTime() - startTime;
+  }
+};
+
+VTK_ABI_NAMESPACE_END
+
+/*=========================================================================
+Define a test for filter kernels on arrays first touched in parallel
+=========================================================================*/
+#include "vtkDataArray.h"
+#include "vtkFloatArray.h"
+#include "vtkSMPTools.h"
+
+VTK_ABI_NAMESPACE_BEGIN
+class firstTouchTest : public vtkRTTest
+{
+public:
+  firstTouchTest(const char* name, bool parallelFirstTouch)
+    : vtkRTTest(name)
+  {
+    this->ParallelFirstTouch = parallelFirstTouch;
+  }
+
+  const char* GetSummaryResultName() override { return "Mpoints/sec"; }
+
+  const char* GetSecondSummaryResultName() override { return "Mpoints"; }
+
+  vtkRTTestResult Run(vtkRTTestSequence* ats, int /*argc*/, char* /* argv */[]) override
+  {
+    int res1;
+    ats->GetSequenceNumbers(res1);
+
+    const bool firstTouch = vtkDataArray::GetParallelFirstTouch();
+    vtkDataArray::SetParallelFirstTouch(this->ParallelFirstTouch);
+
+    // ------------------------------------------------------------
+    // Create the input points from a single thread, as a reader does
+    // ------------------------------------------------------------
+    vtkIdType numPoints = 1000000 * res1;
+    vtkNew<vtkFloatArray> points;
+    points->SetNumberOfComponents(3);
+    points->SetNumberOfTuples(numPoints);
+    for (vtkIdType i = 0; i < numPoints; ++i)
+    {
+      const float t = 1e-5f * static_cast<float>(i);
+      points->SetTuple3(i, std::sin(t), std::cos(t), t);
+    }
+
+    // ------------------------------------------------------------
+    // Run the kernels of an elevation and a transform filter, which
+    // allocate their output and fill it from the threads
+    // ------------------------------------------------------------
+    double elevationTime = 0.0;
+    double transformTime = 0.0;
+    int runCount = 20;
+    for (int run = 0; run < runCount; ++run)
+    {
+      double startTime = vtkTimerLog::GetUniversalTime();
+      vtkNew<vtkFloatArray> elevation;
+      elevation->SetNumberOfTuples(numPoints);
+      vtkSMPTools::For(0, numPoints,
+        [&](vtkIdType begin, vtkIdType end)
+        {
+          const float* x = points->GetPointer(3 * begin);
+          float* out = elevation->GetPointer(begin);
+          for (vtkIdType i = begin; i < end; ++i, x += 3)
+          {
+            *out++ = 0.25f * x[0] + 0.5f * x[1] + x[2];
+          }
+        });
+      elevationTime += vtkTimerLog::GetUniversalTime() - startTime;
+
+      startTime = vtkTimerLog::GetUniversalTime();
+      vtkNew<vtkFloatArray> transformed;
+      transformed->SetNumberOfComponents(3);
+      transformed->SetNumberOfTuples(numPoints);
+      vtkSMPTools::For(0, numPoints,
+        [&](vtkIdType begin, vtkIdType end)
+        {
+          const float* x = points->GetPointer(3 * begin);
+          float* out = transformed->GetPointer(3 * begin);
+          for (vtkIdType i = begin; i < end; ++i, x += 3, out += 3)
+          {
+            out[0] = 0.8f * x[0] - 0.6f * x[1] + 1.0f;
+            out[1] = 0.6f * x[0] + 0.8f * x[1] - 2.0f;
+            out[2] = 2.0f * x[2];
+          }
+        });
+      transformTime += vtkTimerLog::GetUniversalTime() - startTime;
+
+      if (elevationTime + transformTime > this->TargetTime * 1.5)
+      {
+        runCount = run + 1;
+        break;
+      }
+    }
+    vtkDataArray::SetParallelFirstTouch(firstTouch);
+
+    vtkRTTestResult result;
+    result.Results["elevation time"] = elevationTime / runCount;
+    result.Results["transform time"] = transformTime / runCount;
+    result.Results["Mpoints"] = 1.0e-6 * numPoints;
+    result.Results["Mpoints/sec"] =
+      1.0e-6 * numPoints * 2 * runCount / (elevationTime + transformTime);
+
+    return result;
+  }
+
+protected:
+  bool ParallelFirstTouch;
+};
+
+VTK_ABI_NAMESPACE_END
+
+/*=========================================================================
+Define a test for building a k-d tree with several threads
+=========================================================================*/
+#include "vtkKdTree.h"
+
+VTK_ABI_NAMESPACE_BEGIN
+class kdTreeBuildTest : public vtkRTTest
+{
+public:
+  kdTreeBuildTest(const char* name)
+    : vtkRTTest(name)
+  {
+  }
+
+  const char* GetSummaryResultName() override { return "speedup"; }
+
+  const char* GetSecondSummaryResultName() override { return "Mpoints"; }
+
+  vtkRTTestResult Run(vtkRTTestSequence* ats, int /*argc*/, char* /* argv */[]) override
+  {
+    int res1;
+    ats->GetSequenceNumbers(res1);
+
+    // ------------------------------------------------------------
+    // Create random points, half of them on a few planes so that
+    // the medians are repeated
+    // ------------------------------------------------------------
+    vtkIdType numPoints = 100000 * res1;
+    vtkNew<vtkPoints> points;
+    points->SetDataTypeToFloat();
+    points->SetNumberOfPoints(numPoints);
+    for (vtkIdType i = 0; i < numPoints; ++i)
+    {
+      double x[3] = { vtkMath::Random(), vtkMath::Random(), vtkMath::Random() };
+      if (i % 2 == 0)
+      {
+        x[0] = std::floor(16.0 * x[0]) / 16.0;
+      }
+      points->SetPoint(i, x);
+    }
+
+    double serialTime = 0.0;
+    vtkSMPTools::LocalScope(vtkSMPTools::Config{ 1 },
+      [&]() { serialTime = this->TimeBuild(points); });
+    double parallelTime = this->TimeBuild(points);
+
+    vtkRTTestResult result;
+    result.Results["serial build time"] = serialTime;
+    result.Results["parallel build time"] = parallelTime;
+    result.Results["speedup"] = serialTime / parallelTime;
+    result.Results["Mpoints"] = 1.0e-6 * numPoints;
+
+    return result;
+  }
+
+protected:
+  double TimeBuild(vtkPoints* points)
+  {
+    vtkNew<vtkKdTree> kdTree;
+    double startTime = vtkTimerLog::GetUniversalTime();
+    kdTree->BuildLocatorFromPoints(points);
+    return vtkTimerLog::GetUniversalTime() - startTime;
+  }
+};
+
+VTK_ABI_NAMESPACE_END
+
+/*=========================================================================
+Define a test for the effect of vtkSpatialReorder on downstream filters
+=========================================================================*/
+#include "vtkContour3DLinearGrid.h"
+#include "vtkIdList.h"
+#include "vtkImageData.h"
+#include "vtkPolyDataNormals.h"
+#include "vtkSpatialReorder.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+VTK_ABI_NAMESPACE_BEGIN
+class spatialReorderTest : public vtkRTTest
+{
+public:
+  spatialReorderTest(const char* name)
+    : vtkRTTest(name)
+  {
+  }
+
+  const char* GetSummaryResultName() override { return "speedup"; }
+
+  const char* GetSecondSummaryResultName() override { return "Mcells"; }
+
+  vtkRTTestResult Run(vtkRTTestSequence* ats, int /*argc*/, char* /* argv */[]) override
+  {
+    int res1;
+    ats->GetSequenceNumbers(res1);
+
+    // ------------------------------------------------------------
+    // Create the voxels of a wavelet with shuffled points and cells
+    // ------------------------------------------------------------
+    const int size = 40 * res1;
+    vtkNew<vtkRTAnalyticSource> wavelet;
+    wavelet->SetWholeExtent(0, size, 0, size, 0, size);
+    wavelet->Update();
+    vtkSmartPointer<vtkUnstructuredGrid> shuffled = this->Shuffle(wavelet->GetOutput());
+
+    double startTime = vtkTimerLog::GetUniversalTime();
+    vtkNew<vtkSpatialReorder> reorder;
+    reorder->SetInputData(shuffled);
+    reorder->Update();
+    double reorderTime = vtkTimerLog::GetUniversalTime() - startTime;
+
+    double shuffledTime = this->TimeFilters(shuffled);
+    double reorderedTime =
+      this->TimeFilters(vtkUnstructuredGrid::SafeDownCast(reorder->GetOutput()));
+
+    vtkRTTestResult result;
+    result.Results["reorder time"] = reorderTime;
+    result.Results["shuffled filters time"] = shuffledTime;
+    result.Results["reordered filters time"] = reorderedTime;
+    result.Results["speedup"] = shuffledTime / reorderedTime;
+    result.Results["Mcells"] = 1.0e-6 * shuffled->GetNumberOfCells();
+
+    return result;
+  }
+
+protected:
+  vtkSmartPointer<vtkUnstructuredGrid> Shuffle(vtkImageData* image)
+  {
+    const vtkIdType numPts = image->GetNumberOfPoints();
+    const vtkIdType numCells = image->GetNumberOfCells();
+    std::mt19937 generator(5489);
+    std::vector<vtkIdType> pointOrder(numPts), cellOrder(numCells), pointMap(numPts);
+    std::iota(pointOrder.begin(), pointOrder.end(), 0);
+    std::iota(cellOrder.begin(), cellOrder.end(), 0);
+    std::shuffle(pointOrder.begin(), pointOrder.end(), generator);
+    std::shuffle(cellOrder.begin(), cellOrder.end(), generator);
+
+    vtkDataArray* inScalars = image->GetPointData()->GetScalars();
+    vtkNew<vtkPoints> points;
+    points->SetNumberOfPoints(numPts);
+    vtkNew<vtkFloatArray> scalars;
+    scalars->SetName(inScalars->GetName());
+    scalars->SetNumberOfValues(numPts);
+    for (vtkIdType i = 0; i < numPts; ++i)
+    {
+      points->SetPoint(i, image->GetPoint(pointOrder[i]));
+      scalars->SetValue(i, static_cast<float>(inScalars->GetTuple1(pointOrder[i])));
+      pointMap[pointOrder[i]] = i;
+    }
+
+    auto grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+    grid->SetPoints(points);
+    grid->GetPointData()->SetScalars(scalars);
+    grid->Allocate(numCells);
+    vtkNew<vtkIdList> ids;
+    for (vtkIdType cellId : cellOrder)
+    {
+      image->GetCellPoints(cellId, ids);
+      for (vtkIdType& ptId : *ids)
+      {
+        ptId = pointMap[ptId];
+      }
+      grid->InsertNextCell(VTK_VOXEL, ids);
+    }
+    return grid;
+  }
+
+  // time a contour and the normals of the contour, which gather the points of the cells
+  double TimeFilters(vtkUnstructuredGrid* grid)
+  {
+    double startTime = vtkTimerLog::GetUniversalTime();
+    vtkNew<vtkContour3DLinearGrid> contour;
+    contour->SetInputData(grid);
+    contour->GenerateValues(5, 80.0, 240.0);
+    vtkNew<vtkPolyDataNormals> normals;
+    normals->SetInputConnection(contour->GetOutputPort());
+    normals->Update();
+    return vtkTimerLog::GetUniversalTime() - startTime;
+  }
+};
+
 VTK_ABI_NAMESPACE_END
 #endif
 // VTK-HeaderTest-Exclude: vtkRenderTimingTests.h